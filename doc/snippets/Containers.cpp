@@ -25,23 +25,30 @@
 */
 
 #include <cstdio>
+#include <cstdlib>
 #include <string>
 #ifdef __linux__
 #include <fcntl.h>
 #include <unistd.h>
 #endif
 
+#include "Corrade/Containers/AllocationTag.h"
 #include "Corrade/Containers/Array.h"
 #include "Corrade/Containers/ArrayTuple.h"
+#include "Corrade/Containers/ArrayTupleBlob.h"
 #include "Corrade/Containers/BigEnumSet.hpp"
 #include "Corrade/Containers/GrowableArray.h"
 #include "Corrade/Containers/EnumSet.hpp"
+#include "Corrade/Containers/FlatMap.h"
 #include "Corrade/Containers/LinkedList.h"
+#include "Corrade/Containers/ObjectPool.h"
 #include "Corrade/Containers/Optional.h"
 #include "Corrade/Containers/Pair.h"
 #include "Corrade/Containers/Pointer.h"
 #include "Corrade/Containers/Reference.h"
 #include "Corrade/Containers/ScopeGuard.h"
+#include "Corrade/Containers/SharedArray.h"
+#include "Corrade/Containers/SlotMap.h"
 #include "Corrade/Containers/StaticArray.h"
 #include "Corrade/Containers/StridedArrayView.h"
 #include "Corrade/Containers/String.h"
@@ -285,6 +292,20 @@ Containers::Array<char, UnmapBuffer> array{data, bufferSize, UnmapBuffer{buffer}
 /* [Array-usage-deleter] */
 }
 
+{
+std::size_t size{};
+/* [Array-usage-deleter-stateless] */
+struct Free {
+    void operator()(int* data, std::size_t) { std::free(data); }
+};
+
+int* data = reinterpret_cast<int*>(std::malloc(size*sizeof(int)));
+
+// Two pointers in size, the deleter call can get inlined
+Containers::Array<int, Free> array{data, size};
+/* [Array-usage-deleter-stateless] */
+}
+
 {
 struct Face {
     int vertexCount;
@@ -563,6 +584,48 @@ Containers::ArrayTuple data{
 }
 #endif
 
+{
+/* [ArrayTuple-usage-zero-filled] */
+struct CallocAllocator {
+    enum: bool { ZeroFilled = true };
+
+    std::pair<char*, void(*)(char*, std::size_t)>
+    operator()(std::size_t size, std::size_t) const {
+        return {static_cast<char*>(std::calloc(size, 1)),
+                [](char* data, std::size_t) { std::free(data); }};
+    }
+};
+
+Containers::ArrayView<float> weights;
+Containers::ArrayView<std::uint32_t> counts;
+Containers::ArrayTuple data{
+    {{ValueInit, 64*1024*1024, weights},
+     {ValueInit, 64*1024*1024, counts}},
+    CallocAllocator{}
+};
+/* [ArrayTuple-usage-zero-filled] */
+}
+
+#if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+{
+Containers::ArrayView<const std::uint64_t> latencies;
+Containers::ArrayView<const float> averages;
+/* [arrayTupleBlob] */
+Utility::Directory::write("measurements.bin",
+    Containers::arrayTupleBlob({latencies, averages}));
+
+DOXYGEN_ELLIPSIS()
+
+Containers::Array<const char, Utility::Directory::MapDeleter> blob =
+    Utility::Directory::mapRead("measurements.bin");
+Containers::ArrayView<const std::uint64_t> mappedLatencies;
+Containers::ArrayView<const float> mappedAverages;
+if(!Containers::arrayTupleBlobViews(blob, {mappedLatencies, mappedAverages}))
+    Utility::Fatal{} << "Invalid file";
+/* [arrayTupleBlob] */
+}
+#endif
+
 {
 /* [StaticArrayView-usage] */
 Containers::ArrayView<int> data;
@@ -688,6 +751,133 @@ class Item: public Containers::LinkedListItem<Item> {
 /* [LinkedListItem-usage] */
 }
 
+{
+/* [AllocationTag-usage] */
+static Containers::AllocationTag meshTag{"meshes"};
+
+Containers::Array<float> positions;
+{
+    Containers::AllocationTagScope scope{meshTag};
+    positions = Containers::Array<float>{ValueInit, 3*1000};
+}
+
+// Still attributed to meshTag even though released outside of the scope
+positions = nullptr;
+/* [AllocationTag-usage] */
+}
+
+{
+/* [AllocationTag-print] */
+for(const Containers::AllocationTag* tag = Containers::AllocationTag::first();
+    tag; tag = tag->next())
+    Utility::Debug{} << *tag;
+/* [AllocationTag-print] */
+}
+
+{
+/* [ObjectPool-usage] */
+struct Particle {
+    float position[3];
+    float velocity[3];
+};
+
+Containers::ObjectPool pool{sizeof(Particle), alignof(Particle)};
+
+Containers::PoolPointer<Particle> a = Containers::poolPointer<Particle>(pool);
+Containers::PoolPointer<Particle> b = Containers::poolPointer<Particle>(pool,
+    Particle{{1.0f, 0.0f, 0.0f}, {0.0f, 2.0f, 0.0f}});
+
+// Both objects get destructed and returned to the pool at the end of scope
+/* [ObjectPool-usage] */
+static_cast<void>(a);
+static_cast<void>(b);
+}
+
+{
+/* [PoolAllocated-usage] */
+class Node: public Containers::LinkedListItem<Node>,
+            public Containers::PoolAllocated<Node> {
+    // ...
+};
+
+Containers::LinkedList<Node> list;
+list.insert(new Node); // allocated from Node::objectPool()
+list.insert(new Node);
+
+list.erase(list.first()); // returned to Node::objectPool()
+/* [PoolAllocated-usage] */
+}
+
+{
+using namespace Containers::Literals;
+/* [FlatMap] */
+Containers::Array<Containers::String> names{Corrade::InPlaceInit, {
+    "AnyImageImporter", "PngImporter", "JpegImporter"}};
+Containers::Array<int> priorities{Corrade::InPlaceInit, {0, 10, 5}};
+
+/* Sorted once on construction */
+Containers::FlatMap<Containers::String, int> map{
+    std::move(names), std::move(priorities)};
+
+/* No temporary String allocated for the lookup */
+if(int* priority = map.find("PngImporter"_s))
+    *priority += 1;
+/* [FlatMap] */
+}
+
+{
+/* [SlotMap-usage] */
+struct Entity {
+    float position[3];
+    float velocity[3];
+};
+
+Containers::SlotMap<Entity> entities;
+Containers::SlotMapHandle a = entities.insert({{0.0f, 1.0f, 0.0f}, {}});
+Containers::SlotMapHandle b = entities.insert({{}, {1.0f, 0.0f, 0.0f}});
+
+/* Iteration goes over a contiguous array */
+for(Entity& entity: entities)
+    for(std::size_t i = 0; i != 3; ++i)
+        entity.position[i] += entity.velocity[i];
+
+entities.erase(a);
+
+/* Handles to erased values are detected */
+if(Entity* entity = entities.find(a))
+    DOXYGEN_ELLIPSIS(static_cast<void>(entity));
+/* [SlotMap-usage] */
+static_cast<void>(b);
+}
+
+{
+/* [SharedArray-usage] */
+Containers::SharedArray<float> data{Corrade::ValueInit, 1024*1024};
+
+/* Only the reference count gets incremented, no copy */
+Containers::SharedArray<float> copy = data;
+Containers::SharedArray<float> firstHalf = data.prefix(data.size()/2);
+
+// pass copy and firstHalf to other threads ...
+/* [SharedArray-usage] */
+static_cast<void>(copy);
+static_cast<void>(firstHalf);
+}
+
+{
+/* [SharedArray-allocator] */
+Containers::Array<int> array;
+Containers::arrayAppend<Containers::ArraySharedAllocator>(array, {1, 2, 3});
+
+/* Takes over the memory without a copy */
+Containers::SharedArray<int> shared = std::move(array);
+
+/* Gives the memory back without a copy, since it's the only reference */
+array = shared.release();
+Containers::arrayAppend<Containers::ArraySharedAllocator>(array, 4);
+/* [SharedArray-allocator] */
+}
+
 {
 /* [optional] */
 std::string value;
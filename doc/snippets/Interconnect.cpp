@@ -26,8 +26,10 @@
 
 #include <string>
 
+#include "Corrade/Interconnect/ConcurrentSignal.h"
 #include "Corrade/Interconnect/Emitter.h"
 #include "Corrade/Interconnect/Receiver.h"
+#include "Corrade/Interconnect/Signal.h"
 #include "Corrade/Interconnect/StateMachine.h"
 
 using namespace Corrade;
@@ -204,4 +206,44 @@ p.step(Input::TakeDocument);
 /* [StateMachine-step] */
 }
 
+
+{
+/* [Signal] */
+class Slider {
+    public:
+        Interconnect::Signal<float> valueChanged;
+
+        void setValue(float value) {
+            _value = value;
+            valueChanged.emit(value);
+        }
+
+    private:
+        float _value;
+};
+
+Slider slider;
+Interconnect::connect(slider.valueChanged, [](float value) {
+    Utility::Debug{} << "Value changed to" << value;
+});
+/* [Signal] */
+}
+
+
+{
+/* [ConcurrentSignal] */
+Interconnect::ConcurrentSignal<int> jobFinished;
+
+/* Can be called from any thread, even while the signal is being emitted */
+Interconnect::Connection c = Interconnect::connect(jobFinished, [](int id) {
+    Utility::Debug{} << "Job" << id << "finished";
+});
+
+/* Can be emitted from multiple threads at once */
+jobFinished.emit(3);
+
+Interconnect::disconnect(jobFinished, c);
+/* [ConcurrentSignal] */
+}
+
 }
@@ -27,8 +27,8 @@
 #include <string>
 #include <vector>
 
-#include "Corrade/PluginManager/AbstractManager.h"
 #include "Corrade/PluginManager/AbstractPlugin.h"
+#include "Corrade/PluginManager/Manager.h"
 #include "Corrade/Utility/Directory.h"
 #include "Corrade/Utility/Macros.h"
 
@@ -42,7 +42,7 @@ class AbstractFilesystem: public PluginManager::AbstractPlugin {
             return "cz.mosra.corrade.AbstractFilesystem/1.0";
         }
 
-        std::vector<std::string> pluginSearchPaths() {
+        static std::vector<std::string> pluginSearchPaths() {
             return {
                 "corrade/filesystems",
                 Utility::Directory::join(CMAKE_INSTALL_PREFIX, "lib/corrade/filesystems")
@@ -76,5 +76,18 @@ if(loadState & (PluginManager::LoadState::WrongPluginVersion|
 }
 /* [LoadStates] */
 }
+
+{
+PluginManager::Manager<AbstractFilesystem> manager;
+/* [Manager-reinstantiate] */
+manager.setHotReloadEnabled(true);
+Containers::Pointer<AbstractFilesystem> filesystem =
+    manager.loadAndInstantiate("ZipFilesystem");
+
+// in the main loop
+if(!manager.reloadChangedPlugins().empty())
+    filesystem = manager.reinstantiate(*filesystem);
+/* [Manager-reinstantiate] */
+}
 #endif
 }
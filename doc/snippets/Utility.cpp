@@ -31,25 +31,32 @@
 #include <sstream>
 
 #include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/Optional.h"
 #include "Corrade/Containers/Pair.h"
 #include "Corrade/Containers/Reference.h"
 #include "Corrade/Containers/StridedArrayView.h"
 #include "Corrade/Utility/Algorithms.h"
 #include "Corrade/Utility/Arguments.h"
 #include "Corrade/Utility/Assert.h"
+#if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)) || defined(CORRADE_TARGET_EMSCRIPTEN)
+#include "Corrade/Utility/AsyncFileIO.h"
+#endif
 #include "Corrade/Utility/Configuration.h"
 #include "Corrade/Utility/DebugStl.h"
 #include "Corrade/Utility/Directory.h"
 #include "Corrade/Utility/Endianness.h"
 #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)) || defined(CORRADE_TARGET_EMSCRIPTEN)
+#include "Corrade/Utility/FileAppender.h"
 #include "Corrade/Utility/FileWatcher.h"
 #endif
 #include "Corrade/Utility/Format.h"
 #include "Corrade/Utility/FormatStl.h"
+#include "Corrade/Utility/Json.h"
 #include "Corrade/Utility/Macros.h"
 #include "Corrade/Utility/Memory.h"
 #include "Corrade/Utility/Sha1.h"
 #include "Corrade/Utility/StlMath.h"
+#include "Corrade/Utility/System.h"
 
 /* [Tweakable-disable-header] */
 #define CORRADE_TWEAKABLE
@@ -413,6 +420,16 @@ for(Foo& f: data) new(&f) Foo{index++};
 /* [allocateAligned-NoInit] */
 }
 
+{
+/* [allocatePages] */
+/* 4 GB of particle positions, zero-initialized by the system on first write */
+Containers::Optional<Containers::Array<float>> positions =
+    Utility::allocatePages<float>(1024*1024*1024,
+        Utility::PageAllocationFlag::HugePages);
+if(!positions) Utility::Fatal{} << "Out of memory";
+/* [allocatePages] */
+}
+
 {
 /* [Configuration-usage] */
 Utility::Configuration conf{"my.conf"};
@@ -725,6 +742,52 @@ Utility::formatInto(stdout, "Hello, {}!", "world");
 }
 
 #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)) || defined(CORRADE_TARGET_EMSCRIPTEN)
+{
+/* [AsyncFileIO] */
+std::vector<std::string> filenames = DOXYGEN_ELLIPSIS({});
+Containers::Array<Containers::Array<char>> data{filenames.size()};
+
+Utility::AsyncFileIO io;
+for(std::size_t i = 0; i != filenames.size(); ++i)
+    io.read(filenames[i], data[i]);
+io.submit();
+
+// do other work while the files are being read
+
+if(!io.wait()) {
+    // some files failed to load
+}
+/* [AsyncFileIO] */
+}
+
+{
+/* [FileAppender] */
+Utility::FileAppender log{"events.log"};
+log.setFlushInterval(500);
+
+// in the main application loop, flushed if the buffer is full or once 500 ms
+// passed since the oldest record
+log.appendString("frame rendered\n");
+/* [FileAppender] */
+}
+
+{
+/* [Json] */
+Containers::Optional<Utility::Json> json = Utility::Json::fromFile("scene.json");
+if(!json) Utility::Fatal{} << "Can't load the scene";
+
+// print names of all top-level keys and parse only the "version" value
+const Utility::JsonToken& root = json->root();
+for(const Utility::JsonToken* key = root.firstChild(); key != root.next();
+    key = key->next())
+{
+    Utility::Debug{} << key->asString();
+    if(key->asString() == "version")
+        Utility::Debug{} << *key->firstChild()->parseUnsignedLong();
+}
+/* [Json] */
+}
+
 {
 /* [FileWatcher] */
 Utility::FileWatcher watcher{"settings.conf"};
@@ -885,6 +948,14 @@ Utility::Debug{} << sha1.digest().hexString();
 Utility::Debug{} << Utility::Sha1::digest("corrade");
 /* [Sha1-usage] */
 }
+
+{
+/* [System-setThreadAffinity] */
+Containers::Array<unsigned int> cpus = Utility::System::numaNodeCpus(0);
+if(!cpus.empty()) Utility::System::setThreadAffinity(cpus);
+Utility::System::setThreadName("worker");
+/* [System-setThreadAffinity] */
+}
 }
 
 typedef std::pair<int, int> T;
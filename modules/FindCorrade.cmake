@@ -78,6 +78,8 @@
 #  CORRADE_BUILD_MULTITHREADED  - Defined if compiled in a way that makes it
 #   possible to safely use certain Corrade features simultaneously in multiple
 #   threads
+#  CORRADE_BUILD_ALLOCATION_TRACKING - Defined if compiled with memory
+#   allocated by containers being tracked in Containers::AllocationTag
 #  CORRADE_TARGET_UNIX          - Defined if compiled for some Unix flavor
 #   (Linux, BSD, macOS)
 #  CORRADE_TARGET_APPLE         - Defined if compiled for Apple platforms
@@ -317,6 +319,7 @@ set(_corradeFlags
     BUILD_STATIC
     BUILD_STATIC_UNIQUE_GLOBALS
     BUILD_MULTITHREADED
+    BUILD_ALLOCATION_TRACKING
     TARGET_UNIX
     TARGET_APPLE
     TARGET_IOS
@@ -539,6 +542,15 @@ foreach(_component ${Corrade_FIND_COMPONENTS})
                 set_property(TARGET Corrade::${_component} APPEND PROPERTY
                     INTERFACE_LINK_LIBRARIES "log")
             endif()
+            # The AsyncFileIO thread pool, FileAppender and ConcurrentSignal
+            # need pthread linked explicitly on older glibc versions. Other
+            # libraries get it transitively through Utility.
+            if(NOT CORRADE_TARGET_EMSCRIPTEN)
+                set(THREADS_PREFER_PTHREAD_FLAG TRUE)
+                find_package(Threads REQUIRED)
+                set_property(TARGET Corrade::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES Threads::Threads)
+            endif()
         endif()
 
         # Find library includes
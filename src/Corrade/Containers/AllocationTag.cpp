@@ -0,0 +1,197 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AllocationTag.h"
+
+#include <mutex>
+#ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+#include <unordered_map>
+#include <utility>
+#endif
+
+#include "Corrade/Containers/allocationTrackingHelpers.h"
+#include "Corrade/Utility/Debug.h"
+#include "Corrade/Utility/Macros.h"
+
+namespace Corrade { namespace Containers {
+
+namespace Implementation {
+
+struct AllocationTracker {
+    static void allocated(AllocationTag& tag, const std::size_t size) {
+        ++tag._allocationCount;
+        tag._allocatedBytes += size;
+        const std::size_t live = tag._liveBytes += size;
+        std::size_t peak = tag._peakBytes;
+        while(live > peak && !tag._peakBytes.compare_exchange_weak(peak, live)) {}
+    }
+
+    static void deallocated(AllocationTag& tag, const std::size_t size) {
+        tag._liveBytes -= size;
+    }
+};
+
+}
+
+namespace {
+
+struct State {
+    std::mutex mutex;
+    AllocationTag* first{};
+    #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+    /* Tag and size for every tracked allocation */
+    std::unordered_map<const void*, std::pair<AllocationTag*, std::size_t>> allocations;
+    #endif
+};
+
+/* Intentionally leaked, as containers destroyed during static destruction
+   may still need to access it */
+State& state() {
+    static State& state = *new State;
+    return state;
+}
+
+/* Can't use a dynamic initializer here as CORRADE_THREAD_LOCAL might be
+   __thread, which doesn't support those */
+#ifdef CORRADE_BUILD_MULTITHREADED
+CORRADE_THREAD_LOCAL
+#endif
+AllocationTag* currentTag = nullptr;
+
+}
+
+AllocationTag& AllocationTag::untagged() {
+    /* Intentionally leaked, for the same reason as state() */
+    static AllocationTag& tag = *new AllocationTag{"untagged"};
+    return tag;
+}
+
+AllocationTag& AllocationTag::current() {
+    return currentTag ? *currentTag : untagged();
+}
+
+AllocationTag* AllocationTag::first() {
+    /* Ensure the untagged tag is always in the list */
+    untagged();
+
+    State& s = state();
+    std::lock_guard<std::mutex> lock{s.mutex};
+    return s.first;
+}
+
+AllocationTag::AllocationTag(const char* const name): _name{name}, _liveBytes{}, _peakBytes{}, _allocationCount{}, _allocatedBytes{} {
+    State& s = state();
+    std::lock_guard<std::mutex> lock{s.mutex};
+    _next = s.first;
+    s.first = this;
+}
+
+AllocationTag::~AllocationTag() {
+    State& s = state();
+    std::lock_guard<std::mutex> lock{s.mutex};
+    for(AllocationTag** tag = &s.first; *tag; tag = &(*tag)->_next) {
+        if(*tag != this) continue;
+        *tag = _next;
+        break;
+    }
+
+    #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+    for(auto it = s.allocations.begin(); it != s.allocations.end(); ) {
+        if(it->second.first == this) it = s.allocations.erase(it);
+        else ++it;
+    }
+    #endif
+}
+
+void AllocationTag::resetPeak() {
+    _peakBytes = std::size_t(_liveBytes);
+}
+
+AllocationTagScope::AllocationTagScope(AllocationTag& tag): _previous{currentTag} {
+    currentTag = &tag;
+}
+
+AllocationTagScope::~AllocationTagScope() {
+    currentTag = _previous;
+}
+
+Utility::Debug& operator<<(Utility::Debug& debug, const AllocationTag& value) {
+    return debug << "Containers::AllocationTag(" << Utility::Debug::nospace << value.name() << Utility::Debug::nospace << "):" << value.liveBytes() << "live bytes," << value.peakBytes() << "peak bytes," << value.allocationCount() << "allocations," << value.allocatedBytes() << "allocated bytes";
+}
+
+#ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+namespace Implementation {
+
+void trackAllocation(const void* const pointer, const std::size_t size) {
+    if(!pointer) return;
+
+    AllocationTag& tag = AllocationTag::current();
+    State& s = state();
+    {
+        std::lock_guard<std::mutex> lock{s.mutex};
+        std::pair<AllocationTag*, std::size_t>& allocation = s.allocations[pointer];
+        /* If there's a stale record for the same address (which can happen
+           only if the memory was freed through a path that isn't tracked),
+           remove it from its tag first */
+        if(allocation.first) AllocationTracker::deallocated(*allocation.first, allocation.second);
+        allocation = {&tag, size};
+    }
+    AllocationTracker::allocated(tag, size);
+}
+
+void trackReallocation(const void* const oldPointer, const void* const newPointer, const std::size_t size) {
+    /* Fetching the current tag outside of the lock as it may need to create
+       the untagged one, which locks as well */
+    AllocationTag* tag = &AllocationTag::current();
+    State& s = state();
+    {
+        std::lock_guard<std::mutex> lock{s.mutex};
+        auto found = s.allocations.find(oldPointer);
+        if(found != s.allocations.end()) {
+            tag = found->second.first;
+            AllocationTracker::deallocated(*tag, found->second.second);
+            s.allocations.erase(found);
+        }
+        if(newPointer) s.allocations[newPointer] = {tag, size};
+    }
+    if(newPointer) AllocationTracker::allocated(*tag, size);
+}
+
+void trackDeallocation(const void* const pointer) {
+    if(!pointer) return;
+
+    State& s = state();
+    std::lock_guard<std::mutex> lock{s.mutex};
+    auto found = s.allocations.find(pointer);
+    if(found == s.allocations.end()) return;
+    AllocationTracker::deallocated(*found->second.first, found->second.second);
+    s.allocations.erase(found);
+}
+
+}
+#endif
+
+}}
@@ -0,0 +1,260 @@
+#ifndef Corrade_Containers_AllocationTag_h
+#define Corrade_Containers_AllocationTag_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::AllocationTag, @ref Corrade::Containers::AllocationTagScope
+ * @m_since_latest
+ */
+
+#include <atomic>
+#include <cstddef>
+
+#include "Corrade/Containers/Containers.h"
+#include "Corrade/Utility/Utility.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Containers {
+
+namespace Implementation {
+    struct AllocationTracker;
+}
+
+/**
+@brief Allocation tag
+@m_since_latest
+
+Accumulates statistics about memory allocated by Corrade containers while the
+tag is active. Tags are meant to be global objects, with an
+@ref AllocationTagScope marking the code whose allocations should be
+attributed to a particular tag. Allocations done outside of any scope are
+attributed to the @ref untagged() tag. Every allocation stays attributed to the
+tag that was active when it was made, even if it's deallocated from a
+different scope or thread.
+
+@snippet Containers.cpp AllocationTag-usage
+
+All existing tags, including @ref untagged(), can be iterated using
+@ref first() and @ref next() and printed with @ref Utility::Debug:
+
+@snippet Containers.cpp AllocationTag-print
+
+@section Containers-AllocationTag-tracked Tracked allocations
+
+The tracking is done only if Corrade is built with
+@ref CORRADE_BUILD_ALLOCATION_TRACKING enabled. Otherwise the tags and scopes
+are still available, but all statistics stay at zero and the containers have
+no tracking code compiled in at all. With the option enabled, the following is
+tracked:
+
+-   @ref Array instances created with the @ref DefaultInit, @ref ValueInit,
+    @ref NoInit, @ref DirectInit and @ref InPlaceInit constructors
+-   allocations done through @ref ArrayNewAllocator and
+    @ref ArrayMallocAllocator, i.e. growable arrays
+-   heap allocations of @ref String
+-   @ref ArrayTuple instances created with the default allocator
+
+Memory passed to a container by the user, such as with the
+@ref Array::Array(T*, std::size_t, D) constructor, or memory coming from
+custom allocators isn't tracked. Releasing the memory from a container with
+@ref Array::release(), @ref String::release() or @ref ArrayTuple::release()
+stops tracking it as well.
+
+Every tracked allocation is recorded in a global hash map protected by a
+mutex, which is needed to attribute the deallocation back to the right tag.
+The option is thus meant for diagnostic builds and not for production use.
+
+@section Containers-AllocationTag-multithreading Thread safety
+
+The statistics are updated atomically, so tags can be used from multiple
+threads at once. If Corrade is built with @ref CORRADE_BUILD_MULTITHREADED,
+the tag set by @ref AllocationTagScope is thread-local. Tags shouldn't be
+created or destroyed while iterating the list of tags.
+*/
+class CORRADE_UTILITY_EXPORT AllocationTag {
+    public:
+        /**
+         * @brief Tag for allocations done outside of any scope
+         *
+         * Named @cpp "untagged" @ce.
+         */
+        static AllocationTag& untagged();
+
+        /**
+         * @brief Currently active tag
+         *
+         * The tag set by the innermost @ref AllocationTagScope in the
+         * current thread, or @ref untagged() if there's no scope.
+         */
+        static AllocationTag& current();
+
+        /**
+         * @brief First tag in the list of all tags
+         *
+         * Use @ref next() to iterate over the rest. The list always contains
+         * at least @ref untagged().
+         */
+        static AllocationTag* first();
+
+        /**
+         * @brief Constructor
+         * @param name      Tag name, used for @ref Utility::Debug output
+         *
+         * Adds the tag to the list of all tags. The @p name isn't copied and
+         * is expected to stay in scope for the whole tag lifetime, so usually
+         * it's a string literal.
+         */
+        explicit AllocationTag(const char* name);
+
+        /** @brief Copying is not allowed */
+        AllocationTag(const AllocationTag&) = delete;
+
+        /** @brief Moving is not allowed */
+        AllocationTag(AllocationTag&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Removes the tag from the list of all tags. Allocations still
+         * attributed to the tag are not tracked anymore. The tag shouldn't be
+         * active in any @ref AllocationTagScope at that point.
+         */
+        ~AllocationTag();
+
+        /** @brief Copying is not allowed */
+        AllocationTag& operator=(const AllocationTag&) = delete;
+
+        /** @brief Moving is not allowed */
+        AllocationTag& operator=(AllocationTag&&) = delete;
+
+        /** @brief Next tag in the list of all tags */
+        AllocationTag* next() { return _next; }
+        const AllocationTag* next() const { return _next; } /**< @overload */
+
+        /** @brief Tag name */
+        const char* name() const { return _name; }
+
+        /**
+         * @brief Live bytes
+         *
+         * Count of bytes that are currently allocated and attributed to this
+         * tag.
+         */
+        std::size_t liveBytes() const { return _liveBytes; }
+
+        /**
+         * @brief Peak bytes
+         *
+         * Maximum value of @ref liveBytes() since the tag was created or
+         * since the last call to @ref resetPeak().
+         */
+        std::size_t peakBytes() const { return _peakBytes; }
+
+        /**
+         * @brief Allocation count
+         *
+         * Count of allocations and reallocations attributed to this tag since
+         * it was created. Sampling it periodically gives the allocation rate.
+         */
+        std::size_t allocationCount() const { return _allocationCount; }
+
+        /**
+         * @brief Allocated bytes
+         *
+         * Sum of bytes of all allocations and reallocations attributed to this
+         * tag since it was created, including memory that was deallocated
+         * since.
+         */
+        std::size_t allocatedBytes() const { return _allocatedBytes; }
+
+        /**
+         * @brief Reset peak bytes
+         *
+         * Sets @ref peakBytes() to the current value of @ref liveBytes().
+         */
+        void resetPeak();
+
+    private:
+        friend Implementation::AllocationTracker;
+
+        const char* _name;
+        AllocationTag* _next;
+        std::atomic<std::size_t> _liveBytes,
+            _peakBytes,
+            _allocationCount,
+            _allocatedBytes;
+};
+
+/**
+@brief Allocation tag scope
+@m_since_latest
+
+Makes given @ref AllocationTag the @ref AllocationTag::current() one for the
+lifetime of the instance, restoring the previous one on destruction. Scopes
+can be nested.
+*/
+class CORRADE_UTILITY_EXPORT AllocationTagScope {
+    public:
+        /** @brief Constructor */
+        explicit AllocationTagScope(AllocationTag& tag);
+
+        /** @brief Copying is not allowed */
+        AllocationTagScope(const AllocationTagScope&) = delete;
+
+        /** @brief Moving is not allowed */
+        AllocationTagScope(AllocationTagScope&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Restores the tag that was current before this scope was created.
+         */
+        ~AllocationTagScope();
+
+        /** @brief Copying is not allowed */
+        AllocationTagScope& operator=(const AllocationTagScope&) = delete;
+
+        /** @brief Moving is not allowed */
+        AllocationTagScope& operator=(AllocationTagScope&&) = delete;
+
+    private:
+        AllocationTag* _previous;
+};
+
+/**
+@debugoperator{AllocationTag}
+@m_since_latest
+
+Prints the tag name together with @ref AllocationTag::liveBytes(),
+@ref AllocationTag::peakBytes(), @ref AllocationTag::allocationCount() and
+@ref AllocationTag::allocatedBytes().
+*/
+CORRADE_UTILITY_EXPORT Utility::Debug& operator<<(Utility::Debug& debug, const AllocationTag& value);
+
+}}
+
+#endif
@@ -37,6 +37,7 @@
 
 #include "Corrade/Tags.h"
 #include "Corrade/Containers/ArrayView.h"
+#include "Corrade/Containers/allocationTrackingHelpers.h"
 #include "Corrade/Containers/constructHelpers.h"
 
 namespace Corrade { namespace Containers {
@@ -49,16 +50,60 @@ namespace Implementation {
         void(*operator()() const)(T*, std::size_t) { return nullptr; }
     };
 
+    /* Storage for Array members. Deleters that are stateless classes aren't
+       stored at all and a default-constructed instance is used instead,
+       making the Array just two words in size. Not done via an empty base
+       optimization on D itself as that would break with final classes. */
+    template<class T, class D, bool = std::is_empty<D>::value && std::is_default_constructible<D>::value> struct ArrayStorage {
+        /* GCC <=4.8 breaks on _deleter{} */
+        explicit ArrayStorage(T* data, std::size_t size, D deleter) noexcept: _data{data}, _size{size}, _deleter(deleter) {}
+
+        D deleter() const { return _deleter; }
+        void setDeleter(D deleter) { _deleter = deleter; }
+
+        T* _data;
+        std::size_t _size;
+        D _deleter;
+    };
+    template<class T, class D> struct ArrayStorage<T, D, true> {
+        explicit ArrayStorage(T* data, std::size_t size, D) noexcept: _data{data}, _size{size} {}
+
+        D deleter() const { return D{}; }
+        void setDeleter(D) {}
+
+        T* _data;
+        std::size_t _size;
+    };
+
+    /* Only the default deleter frees memory that Array itself tracked, the
+       NoInit deleter and growable allocators untrack it on their own and
+       any other custom deleter doesn't free tracked memory at all -- it may
+       for example be a no-op deleter of a view on another Array */
     template<class T, class D> struct CallDeleter {
         void operator()(D deleter, T* data, std::size_t size) const {
             deleter(data, size);
         }
+
+        #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+        void release(D, T*) const {}
+        #endif
     };
     template<class T> struct CallDeleter<T, void(*)(T*, std::size_t)> {
         void operator()(void(*deleter)(T*, std::size_t), T* data, std::size_t size) const {
             if(deleter) deleter(data, size);
-            else delete[] data;
+            else {
+                #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+                trackDeallocation(data);
+                #endif
+                delete[] data;
+            }
         }
+
+        #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+        void release(void(*deleter)(T*, std::size_t), T* data) const {
+            if(!deleter) trackDeallocation(data);
+        }
+        #endif
     };
 
     template<class T> T* noInitAllocate(std::size_t size, typename std::enable_if<std::is_trivial<T>::value>::type* = nullptr) {
@@ -75,6 +120,9 @@ namespace Implementation {
         return [](T* data, std::size_t size) {
             if(data) for(T *it = data, *end = data + size; it != end; ++it)
                 it->~T();
+            #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+            trackDeallocation(data);
+            #endif
             delete[] reinterpret_cast<char*>(data);
         };
     }
@@ -168,6 +216,14 @@ deleter type can be used:
 
 @snippet Containers.cpp Array-usage-deleter
 
+If the deleter type is a stateless class, it's not stored in the instance at
+all and a default-constructed instance is used on destruction instead. Compared
+to a function pointer there's no extra word for storing it and the deletion
+doesn't need to go through an indirect call, which may be useful if a large
+amount of small arrays is kept around:
+
+@snippet Containers.cpp Array-usage-deleter-stateless
+
 @section Containers-Array-growable Growable arrays
 
 The @ref Array class provides no reallocation or growing capabilities on its
@@ -301,7 +357,7 @@ template<class T, class D = void(*)(T*, std::size_t)>
 #else
 template<class T, class D>
 #endif
-class Array {
+class Array: Implementation::ArrayStorage<T, D> {
     /* Ideally this could be derived from ArrayView<T>, avoiding a lot of
        redundant code, however I'm unable to find a way to add const/non-const
        overloads of all slicing functions and also prevent const Array<T>& from
@@ -319,8 +375,7 @@ class Array {
            C++. */
         template<class U, class V = typename std::enable_if<std::is_same<std::nullptr_t, U>::value>::type> /*implicit*/ Array(U) noexcept:
         #endif
-            /* GCC <=4.8 breaks on _deleter{} */
-            _data{nullptr}, _size{0}, _deleter(Implementation::DefaultDeleter<D>{}()) {}
+            Storage{nullptr, 0, Implementation::DefaultDeleter<D>{}()} {}
 
         /**
          * @brief Default constructor
@@ -328,8 +383,7 @@ class Array {
          * Creates a zero-sized array. Move an @ref Array with a nonzero size
          * onto the instance to make it useful.
          */
-        /* GCC <=4.8 breaks on _deleter{} */
-        /*implicit*/ Array() noexcept: _data(nullptr), _size(0), _deleter(Implementation::DefaultDeleter<D>{}()) {}
+        /*implicit*/ Array() noexcept: Storage{nullptr, 0, Implementation::DefaultDeleter<D>{}()} {}
 
         /**
          * @brief Construct a default-initialized array
@@ -342,7 +396,11 @@ class Array {
          * @ref Array(NoInitT, std::size_t) variant instead.
          * @see @ref DefaultInit, @ref std::is_trivial
          */
-        explicit Array(Corrade::DefaultInitT, std::size_t size): _data{size ? new T[size] : nullptr}, _size{size}, _deleter{nullptr} {}
+        explicit Array(Corrade::DefaultInitT, std::size_t size): Storage{size ? new T[size] : nullptr, size, nullptr} {
+            #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+            Implementation::trackAllocation(_data, size*sizeof(T));
+            #endif
+        }
 
         /**
          * @brief Construct a value-initialized array
@@ -351,9 +409,18 @@ class Array {
          * (i.e. builtin types are zero-initialized, default constructor called
          * otherwise). This is the same as @ref Array(std::size_t). If the size
          * is zero, no allocation is done.
+         *
+         * The memory is always allocated with @cpp new[] @ce and zeroed up
+         * front. To get large zero-filled memory lazily from the operating
+         * system instead, use @ref arrayResize(Array<T>&, ValueInitT, std::size_t)
+         * with @ref ArrayMallocAllocator on an empty array.
          * @see @ref ValueInit, @ref Array(DefaultInitT, std::size_t)
          */
-        explicit Array(Corrade::ValueInitT, std::size_t size): _data{size ? new T[size]() : nullptr}, _size{size}, _deleter{nullptr} {}
+        explicit Array(Corrade::ValueInitT, std::size_t size): Storage{size ? new T[size]() : nullptr, size, nullptr} {
+            #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+            Implementation::trackAllocation(_data, size*sizeof(T));
+            #endif
+        }
 
         /**
          * @brief Construct an array without initializing its contents
@@ -381,7 +448,11 @@ class Array {
          *      @ref array(std::initializer_list<T>), @ref deleter(),
          *      @ref std::is_trivial
          */
-        explicit Array(Corrade::NoInitT, std::size_t size): _data{size ? Implementation::noInitAllocate<T>(size) : nullptr}, _size{size}, _deleter{Implementation::noInitDeleter<T>()} {}
+        explicit Array(Corrade::NoInitT, std::size_t size): Storage{size ? Implementation::noInitAllocate<T>(size) : nullptr, size, Implementation::noInitDeleter<T>()} {
+            #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+            Implementation::trackAllocation(_data, size*sizeof(T));
+            #endif
+        }
 
         /**
          * @brief Construct a direct-initialized array
@@ -422,8 +493,7 @@ class Array {
          * @p deleter. See class documentation for more information about
          * custom deleters and @ref ArrayView for non-owning array wrapper.
          */
-        /* GCC <=4.8 breaks on _deleter{} */
-        explicit Array(T* data, std::size_t size, D deleter = Implementation::DefaultDeleter<D>{}()): _data{data}, _size{size}, _deleter(deleter) {}
+        explicit Array(T* data, std::size_t size, D deleter = Implementation::DefaultDeleter<D>{}()): Storage{data, size, deleter} {}
 
         /** @brief Copying is not allowed */
         Array(const Array<T, D>&) = delete;
@@ -441,7 +511,9 @@ class Array {
          *
          * Calls @ref deleter() on the owned @ref data().
          */
-        ~Array() { Implementation::CallDeleter<T, D>{}(_deleter, _data, _size); }
+        ~Array() {
+            Implementation::CallDeleter<T, D>{}(Storage::deleter(), _data, _size);
+        }
 
         /** @brief Copying is not allowed */
         Array<T, D>& operator=(const Array<T, D>&) = delete;
@@ -499,7 +571,7 @@ class Array {
          * @cpp operator delete[] @ce.
          * @see @ref Array(T*, std::size_t, D)
          */
-        D deleter() const { return _deleter; }
+        D deleter() const { return Storage::deleter(); }
 
         /** @brief Array size */
         std::size_t size() const { return _size; }
@@ -683,9 +755,10 @@ class Array {
         T* release();
 
     private:
-        T* _data;
-        std::size_t _size;
-        D _deleter;
+        typedef Implementation::ArrayStorage<T, D> Storage;
+
+        using Storage::_data;
+        using Storage::_size;
 };
 
 /** @relatesalso Array
@@ -749,10 +822,10 @@ template<class T> std::size_t arraySize(const Array<T>& view) {
     return view.size();
 }
 
-template<class T, class D> inline Array<T, D>::Array(Array<T, D>&& other) noexcept: _data{other._data}, _size{other._size}, _deleter{other._deleter} {
+template<class T, class D> inline Array<T, D>::Array(Array<T, D>&& other) noexcept: Storage{other._data, other._size, other.deleter()} {
     other._data = nullptr;
     other._size = 0;
-    other._deleter = D{};
+    other.Storage::setDeleter(D{});
 }
 
 template<class T, class D> template<class ...Args> Array<T, D>::Array(Corrade::DirectInitT, std::size_t size, Args&&... args): Array{Corrade::NoInit, size} {
@@ -779,7 +852,9 @@ template<class T, class D> inline Array<T, D>& Array<T, D>::operator=(Array<T, D
     using std::swap;
     swap(_data, other._data);
     swap(_size, other._size);
-    swap(_deleter, other._deleter);
+    const D deleter = Storage::deleter();
+    Storage::setDeleter(other.deleter());
+    other.Storage::setDeleter(deleter);
     return *this;
 }
 
@@ -803,9 +878,12 @@ template<class T, class D> T& Array<T, D>::back() {
 
 template<class T, class D> inline T* Array<T, D>::release() {
     T* const data = _data;
+    #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+    Implementation::CallDeleter<T, D>{}.release(Storage::deleter(), data);
+    #endif
     _data = nullptr;
     _size = 0;
-    _deleter = D{};
+    Storage::setDeleter(D{});
     return data;
 }
 
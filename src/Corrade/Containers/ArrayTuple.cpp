@@ -26,8 +26,11 @@
 
 #include "ArrayTuple.h"
 
+#include <cstring>
+
 #include "Corrade/Containers/Array.h"
 #include "Corrade/Containers/StridedArrayView.h"
+#include "Corrade/Containers/allocationTrackingHelpers.h"
 
 namespace Corrade { namespace Containers {
 
@@ -154,10 +157,20 @@ ArrayTuple deleter pointer is `nullptr`, which makes the class simply do
 
 */
 
-ArrayTuple::ArrayTuple(const ArrayView<const Item>& items): ArrayTuple{items, [](std::size_t size, std::size_t) -> std::pair<char*, std::nullptr_t> {
-    /** @todo use the alignment param once we implement aligned alloc */
-    return {size ? new char[size] : nullptr, nullptr};
-}} {}
+ArrayTuple::ArrayTuple(const ArrayView<const Item>& items) {
+    std::nullptr_t* deleterDestination = nullptr;
+    const Item arrayDeleterItem{nullptr, deleterDestination};
+    std::size_t destructibleItemCount;
+    bool arrayDeleterItemNeeded;
+    /** @todo use the alignment once we implement aligned alloc */
+    _size = sizeAlignmentFor(items, arrayDeleterItem, destructibleItemCount, arrayDeleterItemNeeded).first;
+    _data = _size ? new char[_size] : nullptr;
+    create(items, arrayDeleterItem, destructibleItemCount, arrayDeleterItemNeeded, false);
+
+    #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+    Implementation::trackAllocation(_data, _size);
+    #endif
+}
 
 ArrayTuple::ArrayTuple(): _data{}, _size{}, _deleter{} {}
 
@@ -170,6 +183,9 @@ ArrayTuple::ArrayTuple(ArrayTuple&& other) noexcept: _data{other._data}, _size{o
 }
 
 ArrayTuple::~ArrayTuple() {
+    #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+    Implementation::trackDeallocation(_data);
+    #endif
     if(_deleter) _deleter(_data, _size);
     else delete[] _data;
 }
@@ -215,7 +231,14 @@ ArrayTuple::operator Array<char>() && {
         "Containers::ArrayTuple: conversion to Array allowed only with trivially destructible types and a stateless destructor", {});
     const Deleter deleter = _deleter;
     const std::size_t size = _size;
-    return Array<char>{release(), size, deleter};
+    /* Not using release() because that would stop the allocation from being
+       tracked, while here the ownership is just passed to another
+       container */
+    char* const data = _data;
+    _data = nullptr;
+    _size = 0;
+    _deleter = nullptr;
+    return Array<char>{data, size, deleter};
 }
 
 std::pair<std::size_t, std::size_t> ArrayTuple::sizeAlignmentFor(const ArrayView<const Item>& items, const Item& arrayDeleterItem, std::size_t& destructibleItemCount, bool& arrayDeleterItemNeeded) {
@@ -263,7 +286,7 @@ std::pair<std::size_t, std::size_t> ArrayTuple::sizeAlignmentFor(const ArrayView
     return {offset, maxAlignment};
 }
 
-void ArrayTuple::create(const ArrayView<const Item>& items, const Item& arrayDeleterItem, const std::size_t destructibleItemCount, const bool arrayDeleterItemNeeded) {
+void ArrayTuple::create(const ArrayView<const Item>& items, const Item& arrayDeleterItem, const std::size_t destructibleItemCount, const bool arrayDeleterItemNeeded, const bool zeroFilled) {
     /* If we have destructible entries, store the total count and calculate the
        (unaligned) offset for the first array. If we don't have them, don't
        store anything -- the first array will be right at the start. */
@@ -282,8 +305,12 @@ void ArrayTuple::create(const ArrayView<const Item>& items, const Item& arrayDel
             involved, like in the tests */
         offset = alignFor(offset, items[i]._elementAlignment);
 
-        /* If the item has a default constructor, call it on each element */
-        if(items[i]._constructor)
+        /* If the item is value-initialized by zero-filling, do that, unless
+           the allocator gave us zero-filled memory already. Otherwise, if the
+           item has a default constructor, call it on each element. */
+        if(items[i]._zeroInitialize) {
+            if(!zeroFilled) std::memset(_data + offset, 0, items[i]._elementCount*items[i]._elementSize);
+        } else if(items[i]._constructor)
             for(std::size_t j = 0; j != items[i]._elementCount; ++j)
                 items[i]._constructor(_data + offset + j*items[i]._elementSize);
 
@@ -361,13 +388,16 @@ void ArrayTuple::create(const ArrayView<const Item>& items, const Item& arrayDel
 
 char* ArrayTuple::release() {
     char* const data = _data;
+    #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+    Implementation::trackDeallocation(data);
+    #endif
     _data = nullptr;
     _size = 0;
     _deleter = nullptr;
     return data;
 }
 
-ArrayTuple::Item::Item(Corrade::NoInitT, const std::size_t size, const std::size_t elementSize, const std::size_t elementAlignment, StridedArrayView2D<char>& outputView): _elementSize{elementSize}, _elementAlignment{elementAlignment}, _elementCount{size}, _constructor{}, _destructor{}, _destinationPointer{&reinterpret_cast<void*&>(Implementation::dataRef(outputView))} {
+ArrayTuple::Item::Item(Corrade::NoInitT, const std::size_t size, const std::size_t elementSize, const std::size_t elementAlignment, StridedArrayView2D<char>& outputView): _elementSize{elementSize}, _elementAlignment{elementAlignment}, _elementCount{size}, _constructor{}, _destructor{}, _destinationPointer{&reinterpret_cast<void*&>(Implementation::dataRef(outputView))}, _zeroInitialize{} {
     /* Populate size of the output view. Pointer gets updated inside create(). */
     outputView = {{nullptr, size*elementSize}, {size, elementSize}};
 }
@@ -49,6 +49,11 @@ namespace Implementation {
     template<class T> T*& dataRef(Containers::ArrayView<T>&);
     template<unsigned dimensions, class T> T*& dataRef(Containers::StridedArrayView<dimensions, T>&);
     template<unsigned dimensions> std::size_t sizeProduct(const StridedDimensions<dimensions, std::size_t>&);
+
+    /* Whether an ArrayTuple allocator reports returning zero-filled memory
+       via a ZeroFilled member, false also for lambdas and function pointers */
+    template<class A, class = void> struct ArrayTupleAllocatorZeroFilled: std::false_type {};
+    template<class A> struct ArrayTupleAllocatorZeroFilled<A, typename std::enable_if<A::ZeroFilled>::type>: std::true_type {};
 }
 #endif
 
@@ -114,6 +119,21 @@ offloaded to disk in case of a memory pressure:
 See the @ref ArrayTuple(const ArrayView<const Item>&, A) constructor
 documentation for a detailed description of the allocator and deleter
 signature.
+
+Value-initialized items of trivial types are zero-filled after allocation,
+which touches every page of the memory up front. If the allocator returns
+memory that's known to be zero-filled already, such as from
+@ref std::calloc() or an anonymous memory map, it can report that via a
+@cpp ZeroFilled @ce member and the zero-filling is skipped, letting the
+operating system provide the zeroed pages lazily on first access:
+
+@snippet Containers.cpp ArrayTuple-usage-zero-filled
+
+As the memory contains absolute pointers and destructor function pointers, the
+class itself isn't suitable for saving to a file and loading back. For that,
+arrays of trivially copyable types can be put into a relocatable blob using
+@ref arrayTupleBlob() and then accessed directly from a memory-mapped file
+using @ref arrayTupleBlobViews().
 */
 class CORRADE_UTILITY_EXPORT ArrayTuple {
     public:
@@ -168,6 +188,13 @@ class CORRADE_UTILITY_EXPORT ArrayTuple {
          * temporary location before being called (to prevent it from freeing
          * the memory from under itself) and its destructor is called
          * afterwards.
+         *
+         * If @p allocator is a class with a @cpp ZeroFilled @ce member
+         * (either a @cpp static constexpr bool @ce or an enum value) that's
+         * @cpp true @ce, the returned memory is assumed to be zero-filled and
+         * value-initialized items of trivial types aren't zero-filled again.
+         * Items of non-trivial types get their default constructor called
+         * regardless.
          */
         template<class A> explicit ArrayTuple(const ArrayView<const Item>& items, A allocator);
         /** @overload */
@@ -260,7 +287,7 @@ class CORRADE_UTILITY_EXPORT ArrayTuple {
     private:
         static std::pair<std::size_t, std::size_t> sizeAlignmentFor(const ArrayView<const Item>& items, const Item& arrayDeleterItem, std::size_t& destructibleItemCount, bool& arrayDeleterItemNeeded);
 
-        void create(const ArrayView<const Item>& items, const Item& arrayDeleterItem, std::size_t destructibleItemCount, bool arrayDeleterItemNeeded);
+        void create(const ArrayView<const Item>& items, const Item& arrayDeleterItem, std::size_t destructibleItemCount, bool arrayDeleterItemNeeded, bool zeroFilled);
 
         char* _data;
         std::size_t _size;
@@ -394,7 +421,12 @@ class CORRADE_UTILITY_EXPORT ArrayTuple::Item {
         template<class T> explicit Item(Corrade::ValueInitT, std::size_t size, T*& destinationPointer): Item{Corrade::NoInit, size, destinationPointer} {
             static_assert(std::is_default_constructible<T>::value,
                 "can't default-init a type with no default constructor, use NoInit instead and manually initialize each item");
-            _constructor = [](void* data) {
+            /* Trivial types are value-initialized by zero-filling the whole
+               range at once instead of calling a constructor on each
+               element */
+            if(std::is_trivial<T>::value)
+                _zeroInitialize = true;
+            else _constructor = [](void* data) {
                 /* Default-construct the T and work around various compiler
                    issues, see construct() for details */
                 Implementation::construct(*static_cast<T*>(data));
@@ -417,7 +449,8 @@ class CORRADE_UTILITY_EXPORT ArrayTuple::Item {
                 Implementation::callDeleter<T>
                 #endif
             },
-            _destinationPointer{&reinterpret_cast<void*&>(destinationPointer)}
+            _destinationPointer{&reinterpret_cast<void*&>(destinationPointer)},
+            _zeroInitialize{}
         {}
 
         /* The three following constructors are used by
@@ -428,12 +461,12 @@ class CORRADE_UTILITY_EXPORT ArrayTuple::Item {
            delete[] that might (or might not) get used */
         explicit Item(void*, std::nullptr_t*& deleterDestination): _elementSize{0}, _elementAlignment{0}, _elementCount{1}, _constructor{}, _destructor{[](char* data, std::size_t) {
             delete[] data;
-        }}, _destinationPointer{reinterpret_cast<void**>(&deleterDestination)} {}
+        }}, _destinationPointer{reinterpret_cast<void**>(&deleterDestination)}, _zeroInitialize{} {}
 
         /* Otherwise, if the deleter is a stateless function pointer, we let
            the destructor pointer empty. The pointer, once it's known, will be
            saved to the location provided via _outputPointer. */
-        explicit Item(void*, void(**& deleterDestination)(char*, std::size_t)): _elementSize{sizeof(void(*)(char*, std::size_t))}, _elementAlignment{0}, _elementCount{1}, _constructor{}, _destructor{}, _destinationPointer{reinterpret_cast<void**>(&deleterDestination)} {}
+        explicit Item(void*, void(**& deleterDestination)(char*, std::size_t)): _elementSize{sizeof(void(*)(char*, std::size_t))}, _elementAlignment{0}, _elementCount{1}, _constructor{}, _destructor{}, _destinationPointer{reinterpret_cast<void**>(&deleterDestination)}, _zeroInitialize{} {}
 
         /* Otherwise, if stateful, we need a wrapper. The deleter function
            pointer retrieves the deleter state pointer, calls it and then
@@ -457,7 +490,7 @@ class CORRADE_UTILITY_EXPORT ArrayTuple::Item {
             #else
             Implementation::wrapStatefulDeleter<D>
             #endif
-        }, _destinationPointer{reinterpret_cast<void**>(&deleterDestination)} {}
+        }, _destinationPointer{reinterpret_cast<void**>(&deleterDestination)}, _zeroInitialize{} {}
 
         /* In case of a memory deleter item, element size is 0 for the default
            deleter, sizeof(void*) for stateless function pointers and size of
@@ -470,8 +503,9 @@ class CORRADE_UTILITY_EXPORT ArrayTuple::Item {
             /* element count is always 1 */
             _elementCount;
 
-        /* Constructor is null if using the NoInit constructor; in case of
-           memory deleters it's null always */
+        /* Constructor is null if using the NoInit constructor or if the type
+           is value-initialized by zero-filling; in case of memory deleters
+           it's null always */
         void(*_constructor)(void*);
 
         /* Destructor is set for non-trivially-destructible types; in case of
@@ -480,6 +514,10 @@ class CORRADE_UTILITY_EXPORT ArrayTuple::Item {
 
         /* Output pointer is always set */
         void** _destinationPointer;
+
+        /* Set if using the ValueInit constructor with a trivial type, in which
+           case the memory gets zero-filled instead of calling a constructor */
+        bool _zeroInitialize;
 };
 
 template<class A> ArrayTuple::ArrayTuple(const ArrayView<const Item>& items, A allocator) {
@@ -505,8 +543,9 @@ template<class A> ArrayTuple::ArrayTuple(const ArrayView<const Item>& items, A a
     /* Create the internal state, which, in case the deleter is not default,
        will populate the deleterDestination pointer above. To which we then
        save the deleter -- either its state for a stateful one, or a function
-       pointer for a stateless one. */
-    create(items, arrayDeleterItem, destructibleItemCount, arrayDeleterItemNeeded);
+       pointer for a stateless one. If the allocator reports the memory is
+       already zero-filled, trivial value-initialized items are left as-is. */
+    create(items, arrayDeleterItem, destructibleItemCount, arrayDeleterItemNeeded, Implementation::ArrayTupleAllocatorZeroFilled<A>::value);
     /* Doing a placement-new initialization as calling a copy constructor to an
        uninitialized memory may not do the right thing. In case it's a plain
        function pointer, the two are equivalent. Also using a helper
@@ -0,0 +1,228 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ArrayTupleBlob.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/Debug.h"
+
+namespace Corrade { namespace Containers {
+
+/*
+
+### Blob layout
+
+Unlike ArrayTuple, which stores absolute pointers and destructor function
+pointers in its memory, everything in the blob is expressed relative to the
+blob start so it can be used from an arbitrary location such as a
+memory-mapped file. All values are in the platform endianness and the layout
+is the same on 32- and 64-bit platforms:
+
+Offset          | Size      | Contents
+----------------+-----------+------------------------------------
+0               | 4         | Magic, `CTB` followed by a zero byte
+4               | 2         | `0x0102`, for detecting endianness mismatch
+6               | 1         | Version, currently `1`
+7               | 1         | Reserved, `0`
+8               | 4         | Count of items (N)
+12              | 4         | Max alignment of all items
+16              | 8         | Total blob size
+24              | 24        | First Item record:
+24              | 8         |   -   offset of the data from blob start
+32              | 8         |   -   count of elements
+40              | 4         |   -   size of each element
+44              | 4         |   -   alignment of each element
+48              | 24        | Second Item record
+...             | ...       | (remaining items)
+24 + N*24       | ...       | Data of the first item, aligned to its
+                |           | alignment
+...             | ...       | (remaining data)
+
+Padding between the data is zero-filled so the output is deterministic.
+
+*/
+
+namespace {
+
+constexpr char Magic[4]{'C', 'T', 'B', '\0'};
+constexpr std::uint16_t EndianMarker = 0x0102;
+constexpr std::uint8_t Version = 1;
+
+struct Header {
+    char magic[4];
+    std::uint16_t endian;
+    std::uint8_t version;
+    std::uint8_t reserved;
+    std::uint32_t itemCount;
+    std::uint32_t alignment;
+    std::uint64_t size;
+};
+
+struct Item {
+    std::uint64_t offset;
+    std::uint64_t elementCount;
+    std::uint32_t elementSize;
+    std::uint32_t elementAlignment;
+};
+
+static_assert(sizeof(Header) == 24 && sizeof(Item) == 24, "unexpected blob header layout");
+
+}
+
+Array<char> arrayTupleBlob(const ArrayView<const ArrayTupleBlobItem> items) {
+    /* Calculate offsets of all items and the total size */
+    Array<Item> records{Corrade::NoInit, items.size()};
+    std::size_t alignment = 1;
+    std::size_t offset = sizeof(Header) + items.size()*sizeof(Item);
+    for(std::size_t i = 0; i != items.size(); ++i) {
+        const ArrayTupleBlobItem& item = items[i];
+        CORRADE_ASSERT(item.elementSize(),
+            "Containers::arrayTupleBlob(): expected a non-zero element size for item" << i, {});
+        CORRADE_ASSERT(item.elementAlignment() && !(item.elementAlignment() & (item.elementAlignment() - 1)),
+            "Containers::arrayTupleBlob(): expected alignment of item" << i << "to be a power of two, got" << item.elementAlignment(), {});
+
+        offset = (offset + item.elementAlignment() - 1) & ~(item.elementAlignment() - 1);
+        records[i].offset = offset;
+        records[i].elementCount = item.elementCount();
+        records[i].elementSize = item.elementSize();
+        records[i].elementAlignment = item.elementAlignment();
+        offset += item.elementSize()*item.elementCount();
+        if(item.elementAlignment() > alignment)
+            alignment = item.elementAlignment();
+    }
+
+    /* Value-initialized so the padding is deterministic */
+    Array<char> out{Corrade::ValueInit, offset};
+
+    Header header;
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.endian = EndianMarker;
+    header.version = Version;
+    header.reserved = 0;
+    header.itemCount = items.size();
+    header.alignment = alignment;
+    header.size = offset;
+    std::memcpy(out.data(), &header, sizeof(Header));
+    if(!records.empty())
+        std::memcpy(out.data() + sizeof(Header), records.data(), records.size()*sizeof(Item));
+
+    for(std::size_t i = 0; i != items.size(); ++i) {
+        const std::size_t size = items[i].elementSize()*items[i].elementCount();
+        if(size) std::memcpy(out.data() + records[i].offset, items[i].data(), size);
+    }
+
+    return out;
+}
+
+Array<char> arrayTupleBlob(const std::initializer_list<ArrayTupleBlobItem> items) {
+    return arrayTupleBlob(arrayView(items));
+}
+
+bool arrayTupleBlobViews(const ArrayView<const void> blob, const ArrayView<const ArrayTupleBlobView> views) {
+    /* The blob doesn't need to be aligned for the header and item records,
+       they're always copied out */
+    if(blob.size() < sizeof(Header)) {
+        Utility::Error{} << "Containers::arrayTupleBlobViews(): expected at least" << sizeof(Header) << "bytes but got" << blob.size();
+        return false;
+    }
+
+    const char* const data = static_cast<const char*>(blob.data());
+    Header header;
+    std::memcpy(&header, data, sizeof(Header));
+
+    if(std::memcmp(header.magic, Magic, sizeof(Magic)) != 0) {
+        Utility::Error{} << "Containers::arrayTupleBlobViews(): invalid signature";
+        return false;
+    }
+    if(header.endian != EndianMarker) {
+        Utility::Error{} << "Containers::arrayTupleBlobViews(): blob has a different endianness";
+        return false;
+    }
+    if(header.version != Version) {
+        Utility::Error{} << "Containers::arrayTupleBlobViews(): unsupported version" << unsigned(header.version);
+        return false;
+    }
+    if(header.size != blob.size()) {
+        Utility::Error{} << "Containers::arrayTupleBlobViews(): expected" << header.size << "bytes but got" << blob.size();
+        return false;
+    }
+    if(header.itemCount != views.size()) {
+        Utility::Error{} << "Containers::arrayTupleBlobViews(): expected" << views.size() << "items but the blob has" << header.itemCount;
+        return false;
+    }
+    /* Size is at least sizeof(Header) so the multiplication can't overflow
+       for an item count that passed the check above */
+    if(blob.size() - sizeof(Header) < std::uint64_t(header.itemCount)*sizeof(Item)) {
+        Utility::Error{} << "Containers::arrayTupleBlobViews(): blob too small for" << header.itemCount << "item records";
+        return false;
+    }
+    if(!header.alignment || (header.alignment & (header.alignment - 1))) {
+        Utility::Error{} << "Containers::arrayTupleBlobViews(): invalid alignment" << header.alignment;
+        return false;
+    }
+    if(reinterpret_cast<std::uintptr_t>(data) % header.alignment) {
+        Utility::Error{} << "Containers::arrayTupleBlobViews(): expected the blob to be aligned to" << header.alignment << "bytes";
+        return false;
+    }
+
+    /* Validate everything first so the views are left untouched on
+       failure */
+    const std::size_t dataBegin = sizeof(Header) + views.size()*sizeof(Item);
+    for(std::size_t i = 0; i != views.size(); ++i) {
+        Item item;
+        std::memcpy(&item, data + sizeof(Header) + i*sizeof(Item), sizeof(Item));
+
+        if(item.elementSize != views[i].elementSize() || item.elementAlignment != views[i].elementAlignment()) {
+            Utility::Error{} << "Containers::arrayTupleBlobViews(): expected item" << i << "to have element size" << views[i].elementSize() << "and alignment" << views[i].elementAlignment() << "but got" << item.elementSize << "and" << item.elementAlignment;
+            return false;
+        }
+        if(item.offset < dataBegin || item.offset > blob.size() || item.elementCount > (blob.size() - item.offset)/item.elementSize) {
+            Utility::Error{} << "Containers::arrayTupleBlobViews(): item" << i << "out of bounds";
+            return false;
+        }
+        if(item.offset % item.elementAlignment || item.elementAlignment > header.alignment) {
+            Utility::Error{} << "Containers::arrayTupleBlobViews(): item" << i << "not aligned to" << item.elementAlignment << "bytes";
+            return false;
+        }
+    }
+
+    for(std::size_t i = 0; i != views.size(); ++i) {
+        Item item;
+        std::memcpy(&item, data + sizeof(Header) + i*sizeof(Item), sizeof(Item));
+        views[i].set(data + item.offset, item.elementCount);
+    }
+
+    return true;
+}
+
+bool arrayTupleBlobViews(const ArrayView<const void> blob, const std::initializer_list<ArrayTupleBlobView> views) {
+    return arrayTupleBlobViews(blob, arrayView(views));
+}
+
+}}
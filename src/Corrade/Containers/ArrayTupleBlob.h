@@ -0,0 +1,196 @@
+#ifndef Corrade_Containers_ArrayTupleBlob_h
+#define Corrade_Containers_ArrayTupleBlob_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::ArrayTupleBlobItem, @ref Corrade::Containers::ArrayTupleBlobView, function @ref Corrade::Containers::arrayTupleBlob(), @ref Corrade::Containers::arrayTupleBlobViews()
+ * @m_since_latest
+ */
+
+#include <initializer_list>
+#include <type_traits>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/initializeHelpers.h"
+#include "Corrade/Utility/TypeTraits.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Containers {
+
+/**
+@brief Array tuple blob item
+@m_since_latest
+
+A view on contents of a single array to be stored in a blob created with
+@ref arrayTupleBlob(). Only trivially copyable types are allowed, as the data
+get copied bit by bit.
+@see @ref ArrayTupleBlobView
+*/
+class ArrayTupleBlobItem {
+    public:
+        /**
+         * @brief Construct from a view
+         *
+         * Takes element size and alignment from @p T.
+         */
+        template<class T> /*implicit*/ ArrayTupleBlobItem(ArrayView<T> view): _data{view.data()}, _elementSize{sizeof(T)}, _elementAlignment{alignof(T)}, _elementCount{view.size()} {
+            static_assert(
+                #ifdef CORRADE_STD_IS_TRIVIALLY_TRAITS_SUPPORTED
+                std::is_trivially_copyable<T>::value
+                #else
+                Implementation::IsTriviallyCopyableOnOldGcc<T>::value
+                #endif
+                , "only trivially copyable types can be stored in a blob");
+        }
+
+        /**
+         * @brief Construct from a type-erased view
+         *
+         * Expects that @p elementAlignment is a power of two.
+         */
+        explicit ArrayTupleBlobItem(const void* data, std::size_t elementSize, std::size_t elementAlignment, std::size_t elementCount) noexcept: _data{data}, _elementSize{elementSize}, _elementAlignment{elementAlignment}, _elementCount{elementCount} {}
+
+        /** @brief Data pointer */
+        const void* data() const { return _data; }
+
+        /** @brief Element size */
+        std::size_t elementSize() const { return _elementSize; }
+
+        /** @brief Element alignment */
+        std::size_t elementAlignment() const { return _elementAlignment; }
+
+        /** @brief Element count */
+        std::size_t elementCount() const { return _elementCount; }
+
+    private:
+        const void* _data;
+        std::size_t _elementSize,
+            _elementAlignment,
+            _elementCount;
+};
+
+/**
+@brief Array tuple blob view
+@m_since_latest
+
+References an output @ref ArrayView that gets pointed to contents of a single
+array stored in a blob by @ref arrayTupleBlobViews().
+@see @ref ArrayTupleBlobItem
+*/
+class ArrayTupleBlobView {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * The @p outputView is expected to stay in scope until
+         * @ref arrayTupleBlobViews() is called. Element size and alignment of
+         * the stored array is expected to match @p T.
+         */
+        template<class T> /*implicit*/ ArrayTupleBlobView(ArrayView<const T>& outputView): _elementSize{sizeof(T)}, _elementAlignment{alignof(T)}, _outputView{&outputView}, _setter{
+            /* MSVC 2015 has problems with T in lambdas, so using a function
+               instead */
+            setter<T>} {}
+
+        /** @brief Element size */
+        std::size_t elementSize() const { return _elementSize; }
+
+        /** @brief Element alignment */
+        std::size_t elementAlignment() const { return _elementAlignment; }
+
+        /**
+         * @brief Set the output view
+         *
+         * Used internally by @ref arrayTupleBlobViews().
+         */
+        void set(const void* data, std::size_t elementCount) const {
+            _setter(_outputView, data, elementCount);
+        }
+
+    private:
+        template<class T> static void setter(void* outputView, const void* data, std::size_t elementCount) {
+            *static_cast<ArrayView<const T>*>(outputView) = {static_cast<const T*>(data), elementCount};
+        }
+
+        std::size_t _elementSize,
+            _elementAlignment;
+        void* _outputView;
+        void(*_setter)(void*, const void*, std::size_t);
+};
+
+/**
+@brief Serialize arrays into a relocatable blob
+@m_since_latest
+
+Creates a versioned binary blob containing a header, a table with an offset,
+element size, alignment and count for each item and then contents of all
+@p items, each aligned to its element alignment, similarly to how
+@ref ArrayTuple lays out its items. The item references are offsets relative
+to the start of the blob, so the blob can be saved to a file and later used
+directly from memory-mapped file contents with @ref arrayTupleBlobViews(),
+without any parsing or copying:
+
+@snippet Containers.cpp arrayTupleBlob
+
+The blob has to be aligned to the largest alignment of all items in order to
+be usable. Memory returned by @ref Utility::Directory::mapRead() is aligned to
+the page size, allocations done by this function only to
+@cpp 2*sizeof(void*) @ce. Padding is zero-filled and the output is
+deterministic. As the blob is in the platform endianness, it can't be used on a
+platform with a different endianness.
+*/
+CORRADE_UTILITY_EXPORT Array<char> arrayTupleBlob(ArrayView<const ArrayTupleBlobItem> items);
+
+/**
+@overload
+@m_since_latest
+*/
+CORRADE_UTILITY_EXPORT Array<char> arrayTupleBlob(std::initializer_list<ArrayTupleBlobItem> items);
+
+/**
+@brief Get views on arrays stored in a blob
+@m_since_latest
+
+Checks that @p blob is a valid blob created with @ref arrayTupleBlob() with
+the same count of items as @p views and with matching element sizes and
+alignments, and then points each of @p views to data of the corresponding item
+in @p blob. Only the header and the item table are read, the contents are not
+touched. If the blob is invalid or doesn't match @p views, prints a message to
+@ref Utility::Error, returns @cpp false @ce and leaves @p views untouched.
+
+The views are valid only for as long as @p blob is.
+*/
+CORRADE_UTILITY_EXPORT bool arrayTupleBlobViews(ArrayView<const void> blob, ArrayView<const ArrayTupleBlobView> views);
+
+/**
+@overload
+@m_since_latest
+*/
+CORRADE_UTILITY_EXPORT bool arrayTupleBlobViews(ArrayView<const void> blob, std::initializer_list<ArrayTupleBlobView> views);
+
+}}
+
+#endif
@@ -38,9 +38,14 @@
 namespace Corrade { namespace Containers {
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
+class AllocationTag;
+class AllocationTagScope;
+
 template<class T, class = void(*)(T*, std::size_t)> class Array;
 template<class> class ArrayView;
 class ArrayTuple;
+class ArrayTupleBlobItem;
+class ArrayTupleBlobView;
 template<std::size_t, class> class StaticArrayView;
 template<class T> using ArrayView1 = StaticArrayView<1, T>;
 template<class T> using ArrayView2 = StaticArrayView<2, T>;
@@ -63,17 +68,26 @@ template<class T> using StridedArrayView3D = StridedArrayView<3, T>;
 template<class T> using StridedArrayView4D = StridedArrayView<4, T>;
 
 template<class T, typename std::underlying_type<T>::type fullValue = typename std::underlying_type<T>::type(~0)> class EnumSet;
+template<class, class> class FlatMap;
+template<class> class FlatSet;
+
 template<class> class LinkedList;
 template<class Derived, class List = LinkedList<Derived>> class LinkedListItem;
 
+class ObjectPool;
 template<class> class Optional;
 template<class, class> class Pair;
 template<class> class Pointer;
+template<class> class PoolAllocated;
+template<class> class PoolPointer;
 template<class> class Reference;
 template<class> class MoveReference;
 template<class> class AnyReference;
 
 class ScopeGuard;
+template<class> class SharedArray;
+template<class> class SlotMap;
+class SlotMapHandle;
 
 class String;
 template<class> class BasicStringView;
@@ -0,0 +1,364 @@
+#ifndef Corrade_Containers_FlatMap_h
+#define Corrade_Containers_FlatMap_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::FlatMap, @ref Corrade::Containers::FlatSet
+ * @m_since_latest
+ */
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/constructHelpers.h"
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/Move.h"
+#include "Corrade/Utility/visibility.h"
+#ifndef CORRADE_NO_DEBUG
+#include "Corrade/Utility/Debug.h"
+#endif
+
+namespace Corrade { namespace Containers {
+
+namespace Implementation {
+    /* Fills the indices with a stable sorted order of the keys. Implemented
+       in a source file through a type-erased comparator to avoid pulling in
+       <algorithm> and having a std::sort() instantiation per key type. */
+    CORRADE_UTILITY_EXPORT void flatSortIndices(const ArrayView<std::size_t>& indices, bool(*less)(const void*, std::size_t, std::size_t), const void* keys);
+
+    template<class K> bool flatKeyLess(const void* keys, std::size_t a, std::size_t b) {
+        return static_cast<const K*>(keys)[a] < static_cast<const K*>(keys)[b];
+    }
+
+    inline bool flatIsSorted(const ArrayView<const std::size_t>& indices) {
+        for(std::size_t i = 0; i != indices.size(); ++i)
+            if(indices[i] != i) return false;
+        return true;
+    }
+
+    /* Lower bound search where the only data-dependent operation in the loop
+       is a conditional select, which compilers turn into a cmov. Compared to
+       a classic binary search there's no unpredictable branch to mispredict
+       and the loop runs a fixed amount of iterations for a given size. */
+    template<class K, class L> std::size_t flatLowerBound(const K* const keys, std::size_t size, const L& key) {
+        if(!size) return 0;
+        const K* base = keys;
+        while(size > 1) {
+            const std::size_t half = size/2;
+            base = base[half] < key ? base + half : base;
+            size -= half;
+        }
+        return base - keys + (*base < key);
+    }
+}
+
+/**
+@brief Flat sorted map
+@tparam K   Key type
+@tparam V   Value type
+@m_since_latest
+
+Associative container storing keys and values in two separate sorted
+@ref Array instances. Compared to @ref std::map, which allocates every node
+separately, there's just two allocations in total, iteration goes linearly
+through memory and a lookup touches only the key array, making this
+container a better fit for read-mostly data such as plugin registries,
+configuration indices or resource tables.
+
+The map is constructed from unsorted key and value arrays at once, sorting
+them just once instead of rebalancing a tree after each insertion. The set
+of keys is immutable afterwards, values can be modified through
+@ref values() or @ref find(). To change the keys, construct a new map. The
+key type is expected to provide @cpp operator< @ce, lookup with
+@ref find(), @ref contains() and @ref lowerBound() can be done with any type
+that's comparable to the key type using @cpp operator< @ce --- for example
+a @ref FlatMap with @ref String keys can be queried with a @ref StringView
+without having to allocate a temporary @ref String:
+
+@snippet Containers.cpp FlatMap
+
+@see @ref FlatSet
+*/
+template<class K, class V> class FlatMap {
+    public:
+        typedef K KeyType;      /**< @brief Key type */
+        typedef V ValueType;    /**< @brief Value type */
+
+        /**
+         * @brief Default constructor
+         *
+         * Creates an empty map.
+         */
+        /*implicit*/ FlatMap() noexcept = default;
+
+        /**
+         * @brief Construct from unsorted keys and values
+         *
+         * Expects that both arrays have the same size and that there are no
+         * duplicate keys. The arrays are sorted by key, if they're sorted
+         * already, they're taken over without any reallocation.
+         */
+        explicit FlatMap(Array<K>&& keys, Array<V>&& values);
+
+        /** @brief Copying is not allowed */
+        FlatMap(const FlatMap<K, V>&) = delete;
+
+        /** @brief Move constructor */
+        FlatMap(FlatMap<K, V>&&) noexcept = default;
+
+        /** @brief Copying is not allowed */
+        FlatMap<K, V>& operator=(const FlatMap<K, V>&) = delete;
+
+        /** @brief Move assignment */
+        FlatMap<K, V>& operator=(FlatMap<K, V>&&) noexcept = default;
+
+        /** @brief Count of items in the map */
+        std::size_t size() const { return _keys.size(); }
+
+        /** @brief Whether the map is empty */
+        bool empty() const { return _keys.empty(); }
+
+        /**
+         * @brief Sorted keys
+         *
+         * Values corresponding to the keys are at the same indices in
+         * @ref values().
+         */
+        ArrayView<const K> keys() const { return _keys; }
+
+        /**
+         * @brief Values
+         *
+         * In order of the corresponding @ref keys().
+         */
+        ArrayView<V> values() { return _values; }
+        ArrayView<const V> values() const { return _values; } /**< @overload */
+
+        /**
+         * @brief Index of the first key that's not less than given key
+         *
+         * If all keys are less than @p key, returns @ref size(). Executes in
+         * @f$ \mathcal{O}(\log n) @f$ time.
+         */
+        template<class L> std::size_t lowerBound(const L& key) const {
+            return Implementation::flatLowerBound(_keys.data(), _keys.size(), key);
+        }
+
+        /**
+         * @brief Whether the map contains given key
+         *
+         * @see @ref find()
+         */
+        template<class L> bool contains(const L& key) const {
+            return find(key);
+        }
+
+        /**
+         * @brief Find a value corresponding to given key
+         *
+         * If the key isn't present, returns @cpp nullptr @ce.
+         * @see @ref contains(), @ref operator[]()
+         */
+        template<class L> V* find(const L& key) {
+            return const_cast<V*>(static_cast<const FlatMap<K, V>&>(*this).find(key));
+        }
+        template<class L> const V* find(const L& key) const; /**< @overload */
+
+        /**
+         * @brief Value corresponding to given key
+         *
+         * Expects that the key is present. Use @ref find() if you're not sure.
+         */
+        template<class L> V& operator[](const L& key) {
+            return const_cast<V&>(static_cast<const FlatMap<K, V>&>(*this)[key]);
+        }
+        template<class L> const V& operator[](const L& key) const; /**< @overload */
+
+    private:
+        Array<K> _keys;
+        Array<V> _values;
+};
+
+/**
+@brief Flat sorted set
+@tparam K   Key type
+@m_since_latest
+
+Stores unique keys in a sorted @ref Array. See @ref FlatMap for rationale and
+usage details, the same applies here. Unlike with @ref FlatMap, duplicate keys
+in the input are allowed and get removed on construction.
+*/
+template<class K> class FlatSet {
+    public:
+        typedef K KeyType;      /**< @brief Key type */
+
+        /**
+         * @brief Default constructor
+         *
+         * Creates an empty set.
+         */
+        /*implicit*/ FlatSet() noexcept = default;
+
+        /**
+         * @brief Construct from unsorted keys
+         *
+         * The keys are sorted and for duplicate keys only the first
+         * occurence is kept. If the array is sorted and unique already, it's
+         * taken over without any reallocation.
+         */
+        explicit FlatSet(Array<K>&& keys);
+
+        /** @brief Copying is not allowed */
+        FlatSet(const FlatSet<K>&) = delete;
+
+        /** @brief Move constructor */
+        FlatSet(FlatSet<K>&&) noexcept = default;
+
+        /** @brief Copying is not allowed */
+        FlatSet<K>& operator=(const FlatSet<K>&) = delete;
+
+        /** @brief Move assignment */
+        FlatSet<K>& operator=(FlatSet<K>&&) noexcept = default;
+
+        /** @brief Count of keys in the set */
+        std::size_t size() const { return _keys.size(); }
+
+        /** @brief Whether the set is empty */
+        bool empty() const { return _keys.empty(); }
+
+        /** @brief Sorted keys */
+        ArrayView<const K> keys() const { return _keys; }
+
+        /** @brief Pointer to the first key */
+        const K* begin() const { return _keys.begin(); }
+        const K* cbegin() const { return _keys.cbegin(); } /**< @overload */
+
+        /** @brief Pointer to (one item after) the last key */
+        const K* end() const { return _keys.end(); }
+        const K* cend() const { return _keys.cend(); } /**< @overload */
+
+        /**
+         * @brief Index of the first key that's not less than given key
+         *
+         * If all keys are less than @p key, returns @ref size(). Executes in
+         * @f$ \mathcal{O}(\log n) @f$ time.
+         */
+        template<class L> std::size_t lowerBound(const L& key) const {
+            return Implementation::flatLowerBound(_keys.data(), _keys.size(), key);
+        }
+
+        /**
+         * @brief Whether the set contains given key
+         *
+         * @see @ref find()
+         */
+        template<class L> bool contains(const L& key) const {
+            return find(key);
+        }
+
+        /**
+         * @brief Find given key
+         *
+         * If the key isn't present, returns @cpp nullptr @ce.
+         * @see @ref contains()
+         */
+        template<class L> const K* find(const L& key) const;
+
+    private:
+        Array<K> _keys;
+};
+
+template<class K, class V> FlatMap<K, V>::FlatMap(Array<K>&& keys, Array<V>&& values) {
+    CORRADE_ASSERT(keys.size() == values.size(),
+        "Containers::FlatMap: expected key and value arrays to have the same size but got" << keys.size() << "and" << values.size(), );
+
+    Array<std::size_t> order{Corrade::NoInit, keys.size()};
+    Implementation::flatSortIndices(order, Implementation::flatKeyLess<K>, keys.data());
+
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 1; i < order.size(); ++i)
+        CORRADE_ASSERT(keys[order[i - 1]] < keys[order[i]],
+            "Containers::FlatMap: duplicate key at input indices" << order[i - 1] << "and" << order[i], );
+    #endif
+
+    /* Take over the arrays directly if they're sorted already, including
+       their deleters */
+    if(Implementation::flatIsSorted(order)) {
+        _keys = Utility::move(keys);
+        _values = Utility::move(values);
+        return;
+    }
+
+    _keys = Array<K>{Corrade::NoInit, order.size()};
+    _values = Array<V>{Corrade::NoInit, order.size()};
+    for(std::size_t i = 0; i != order.size(); ++i) {
+        Implementation::construct(_keys[i], Utility::move(keys[order[i]]));
+        Implementation::construct(_values[i], Utility::move(values[order[i]]));
+    }
+}
+
+template<class K, class V> template<class L> const V* FlatMap<K, V>::find(const L& key) const {
+    const std::size_t i = lowerBound(key);
+    return i != _keys.size() && !(key < _keys[i]) ? _values.data() + i : nullptr;
+}
+
+template<class K, class V> template<class L> const V& FlatMap<K, V>::operator[](const L& key) const {
+    const V* const found = find(key);
+    CORRADE_ASSERT(found,
+        "Containers::FlatMap::operator[](): key not found", *_values.data());
+    return *found;
+}
+
+template<class K> FlatSet<K>::FlatSet(Array<K>&& keys) {
+    Array<std::size_t> order{Corrade::NoInit, keys.size()};
+    Implementation::flatSortIndices(order, Implementation::flatKeyLess<K>, keys.data());
+
+    /* Remove duplicates. The sort is stable, so the first occurence of each
+       key is the one that's kept. */
+    std::size_t uniqueCount = 0;
+    for(std::size_t i = 0; i != order.size(); ++i)
+        if(!uniqueCount || keys[order[uniqueCount - 1]] < keys[order[i]])
+            order[uniqueCount++] = order[i];
+
+    /* Take over the array directly if it's sorted and unique already,
+       including its deleter */
+    if(uniqueCount == order.size() && Implementation::flatIsSorted(order)) {
+        _keys = Utility::move(keys);
+        return;
+    }
+
+    _keys = Array<K>{Corrade::NoInit, uniqueCount};
+    for(std::size_t i = 0; i != uniqueCount; ++i)
+        Implementation::construct(_keys[i], Utility::move(keys[order[i]]));
+}
+
+template<class K> template<class L> const K* FlatSet<K>::find(const L& key) const {
+    const std::size_t i = lowerBound(key);
+    return i != _keys.size() && !(key < _keys[i]) ? _keys.data() + i : nullptr;
+}
+
+}}
+
+#endif
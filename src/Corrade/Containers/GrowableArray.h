@@ -107,6 +107,9 @@ template<class T> struct ArrayNewAllocator {
     static T* allocate(std::size_t capacity) {
         char* const memory = new char[capacity*sizeof(T) + AllocationOffset];
         reinterpret_cast<std::size_t*>(memory)[0] = capacity;
+        #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+        Implementation::trackAllocation(memory + AllocationOffset, capacity*sizeof(T) + AllocationOffset);
+        #endif
         return reinterpret_cast<T*>(memory + AllocationOffset);
     }
 
@@ -128,6 +131,9 @@ template<class T> struct ArrayNewAllocator {
      * store its capacity.
      */
     static void deallocate(T* data) {
+        #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+        Implementation::trackDeallocation(data);
+        #endif
         delete[] (reinterpret_cast<char*>(data) - AllocationOffset);
     }
 
@@ -231,6 +237,31 @@ template<class T> struct ArrayMallocAllocator {
         const std::size_t inBytes = capacity*sizeof(T) + AllocationOffset;
         char* const memory = static_cast<char*>(std::malloc(inBytes));
         reinterpret_cast<std::size_t*>(memory)[0] = inBytes;
+        #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+        Implementation::trackAllocation(memory + AllocationOffset, inBytes);
+        #endif
+        return reinterpret_cast<T*>(memory + AllocationOffset);
+    }
+
+    /**
+     * @brief Allocate a zero-filled array of given capacity
+     * @m_since_latest
+     *
+     * Like @ref allocate(), but using @ref std::calloc(). Used by
+     * @ref arrayResize(Array<T>&, ValueInitT, std::size_t) for large
+     * allocations, where the operating system provides zero-filled pages
+     * lazily on first access instead of them being zeroed up front.
+     */
+    static T* allocateZeroed(std::size_t capacity) {
+        const std::size_t inBytes = capacity*sizeof(T) + AllocationOffset;
+        char* const memory = static_cast<char*>(std::calloc(inBytes, 1));
+        /* Not writing the header through a null pointer, failing loudly the
+           same way a failed new[] would instead */
+        CORRADE_INTERNAL_ASSERT(memory);
+        reinterpret_cast<std::size_t*>(memory)[0] = inBytes;
+        #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+        Implementation::trackAllocation(memory + AllocationOffset, inBytes);
+        #endif
         return reinterpret_cast<T*>(memory + AllocationOffset);
     }
 
@@ -254,6 +285,9 @@ template<class T> struct ArrayMallocAllocator {
      * store its capacity.
      */
     static void deallocate(T* data) {
+        #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+        Implementation::trackDeallocation(data);
+        #endif
         if(data) std::free(reinterpret_cast<char*>(data) - AllocationOffset);
     }
 
@@ -568,6 +602,13 @@ Similar to @ref arrayResize(Array<T>&, DefaultInitT, std::size_t) except that
 the new elements at the end are not default-initialized, but value-initialized
 (i.e., trivial types zero-initialized and default constructor called
 otherwise).
+
+If the array isn't growable and thus needs to be reallocated, @p Allocator is
+@ref ArrayMallocAllocator or a derivative and the newly added elements are at
+least 128 kB large, the memory is allocated using
+@ref ArrayMallocAllocator::allocateZeroed() instead of being zeroed after
+allocation. Allocations of such size get zero-filled pages directly from the
+operating system, which are only faulted in once accessed.
 @see @ref Array::size(), @ref arrayIsGrowable(), @ref Containers-Array-growable
 */
 template<class T, class Allocator = ArrayAllocator<T>> void arrayResize(Array<T>& array, Corrade::ValueInitT, std::size_t size);
@@ -1024,6 +1065,40 @@ template<class T> inline void arrayDestruct(T* begin, T* const end, typename std
     for(; begin < end; ++begin) begin->~T();
 }
 
+/* Used by arrayResize(ValueInit). If the array doesn't have the growable
+   deleter and thus needs a fresh allocation anyway, the allocator is able to
+   give back zero-filled memory and the new part is large enough, allocate the
+   zeroed memory directly instead of zeroing it after. Returns false if the
+   optimization isn't applicable. The std::conditional is to avoid
+   instantiating ArrayMallocAllocator<T> for non-trivially-copyable types, which
+   would trigger its static_assert. */
+template<class T, class Allocator> struct ArrayResizeLazyZero: std::conditional<IsLazyZeroAllocatable<T>::value, std::is_base_of<ArrayMallocAllocator<T>, Allocator>, std::false_type>::type {};
+
+template<class T, class Allocator> bool arrayResizeLazyZero(Array<T>& array, const std::size_t size, typename std::enable_if<ArrayResizeLazyZero<T, Allocator>::value>::type* = nullptr) {
+    /* Direct access & value caching to speed up debug builds */
+    auto& arrayGuts = reinterpret_cast<ArrayGuts<T>&>(array);
+    if(arrayGuts.deleter == Allocator::deleter || size <= arrayGuts.size || (size - arrayGuts.size)*sizeof(T) < LazyZeroAllocationThreshold)
+        return false;
+
+    T* const newArray = Allocator::allocateZeroed(size);
+    arrayMoveConstruct<T>(arrayGuts.data, newArray, arrayGuts.size);
+    array = Array<T>{newArray, size, Allocator::deleter};
+
+    #ifdef _CORRADE_CONTAINERS_SANITIZER_ENABLED
+    __sanitizer_annotate_contiguous_container(
+        Allocator::base(arrayGuts.data),
+        arrayGuts.data + arrayGuts.size,
+        arrayGuts.data + arrayGuts.size,
+        arrayGuts.data + arrayGuts.size);
+    #endif
+
+    return true;
+}
+
+template<class T, class Allocator> bool arrayResizeLazyZero(Array<T>&, std::size_t, typename std::enable_if<!ArrayResizeLazyZero<T, Allocator>::value>::type* = nullptr) {
+    return false;
+}
+
 template<class T> inline std::size_t arrayGrowth(const std::size_t currentCapacity, const std::size_t desiredCapacity) {
     /** @todo pick a nice value when current = 0 and desired > 1 */
     const std::size_t currentCapacityInBytes = sizeof(T)*currentCapacity + Implementation::AllocatorTraits<T>::Offset;
@@ -1049,7 +1124,11 @@ template<class T> inline std::size_t arrayGrowth(const std::size_t currentCapaci
 }
 
 template<class T> void ArrayNewAllocator<T>::reallocate(T*& array, const std::size_t prevSize, const std::size_t newCapacity) {
-    T* newArray = allocate(newCapacity);
+    /* Not using allocate() and deallocate() in order to have the allocation
+       tracked as a reallocation, keeping the original tag */
+    char* const memory = new char[newCapacity*sizeof(T) + AllocationOffset];
+    reinterpret_cast<std::size_t*>(memory)[0] = newCapacity;
+    T* newArray = reinterpret_cast<T*>(memory + AllocationOffset);
     static_assert(std::is_nothrow_move_constructible<T>::value,
         "noexcept move-constructible type is required");
     for(T *src = array, *end = src + prevSize, *dst = newArray; src != end; ++src, ++dst)
@@ -1060,7 +1139,10 @@ template<class T> void ArrayNewAllocator<T>::reallocate(T*& array, const std::si
         new(dst) T{Utility::move(*src)};
         #endif
     for(T *it = array, *end = array + prevSize; it < end; ++it) it->~T();
-    deallocate(array);
+    #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+    Implementation::trackReallocation(array, newArray, newCapacity*sizeof(T) + AllocationOffset);
+    #endif
+    delete[] (reinterpret_cast<char*>(array) - AllocationOffset);
     array = newArray;
 }
 
@@ -1068,6 +1150,9 @@ template<class T> void ArrayMallocAllocator<T>::reallocate(T*& array, std::size_
     const std::size_t inBytes = newCapacity*sizeof(T) + AllocationOffset;
     char* const memory = static_cast<char*>(std::realloc(reinterpret_cast<char*>(array) - AllocationOffset, inBytes));
     reinterpret_cast<std::size_t*>(memory)[0] = inBytes;
+    #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+    Implementation::trackReallocation(array, memory + AllocationOffset, inBytes);
+    #endif
     array = reinterpret_cast<T*>(memory + AllocationOffset);
 }
 
@@ -1195,6 +1280,8 @@ template<class T, class Allocator> void arrayResize(Array<T>& array, Corrade::De
 }
 
 template<class T, class Allocator> void arrayResize(Array<T>& array, Corrade::ValueInitT, const std::size_t size) {
+    if(Implementation::arrayResizeLazyZero<T, Allocator>(array, size)) return;
+
     const std::size_t prevSize = array.size();
     arrayResize<T, Allocator>(array, Corrade::NoInit, size);
     Implementation::arrayConstruct(Corrade::ValueInit, array + prevSize, array.end());
@@ -1284,7 +1371,7 @@ template<class T, class Allocator> inline T& arrayAppend(Array<T>& array, const
 }
 
 template<class T, class Allocator> inline ArrayView<T> arrayAppend(Array<T>& array, const std::initializer_list<T> values) {
-    return arrayAppend(array, {values.begin(), values.size()});
+    return arrayAppend<T, Allocator>(array, ArrayView<const T>{values.begin(), values.size()});
 }
 
 template<class T, class Allocator> inline ArrayView<T> arrayAppend(Array<T>& array, const ArrayView<const T> values) {
@@ -0,0 +1,310 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ObjectPool.h"
+
+#include <atomic>
+#include <mutex>
+#ifdef CORRADE_BUILD_MULTITHREADED
+#include <thread>
+#endif
+
+#include "Corrade/Utility/Debug.h"
+#include "Corrade/Utility/Macros.h"
+
+namespace Corrade { namespace Containers {
+
+struct ObjectPool::Shard {
+    std::mutex mutex;
+    /* Head of an intrusive list going through the first bytes of each free
+       object */
+    void* freeList{};
+    /* Head of an intrusive list going through the first bytes of each slab
+       allocation */
+    void* slabs{};
+    std::size_t slabCount{};
+    /* Objects allocated minus objects deallocated without going through a
+       cache. Signed because objects allocated from one shard can be
+       deallocated to another. */
+    std::ptrdiff_t objectCount{};
+};
+
+struct ObjectPool::Cache {
+    /* Index of the thread owning this cache, zero if not claimed yet. Once
+       claimed, the cache belongs to the thread for the whole pool lifetime. */
+    std::atomic<std::size_t> owner{};
+    /* Intrusive list of free objects, same as in Shard, accessed only by the
+       owner thread */
+    void* freeList{};
+    std::size_t freeCount{};
+    /* Objects allocated minus objects deallocated through this cache.
+       Written only by the owner thread, read by objectCount(). Signed for
+       the same reason as in Shard. */
+    std::atomic<std::ptrdiff_t> objectCount{};
+    /* So caches of different threads don't share a cache line */
+    char padding[64];
+};
+
+namespace {
+
+/* Zero means an unused cacheLookup entry */
+std::atomic<std::size_t> poolCounter{0};
+
+#ifdef CORRADE_BUILD_MULTITHREADED
+std::atomic<std::size_t> threadCounter{0};
+/* Zero means not assigned yet. Can't use a dynamic initializer here as
+   CORRADE_THREAD_LOCAL might be __thread, which doesn't support those. */
+CORRADE_THREAD_LOCAL std::size_t threadIndex = 0;
+
+/* Caches of pools this thread used most recently, replaced in a round-robin
+   fashion. Pool IDs are never reused, so entries of pools that no longer
+   exist never match again. */
+enum: std::size_t { CacheLookupSize = 4 };
+struct CacheLookup {
+    std::size_t pool;
+    void* cache;
+};
+CORRADE_THREAD_LOCAL CacheLookup cacheLookup[CacheLookupSize]{};
+CORRADE_THREAD_LOCAL std::size_t cacheLookupNext = 0;
+#endif
+
+}
+
+ObjectPool::ObjectPool(const std::size_t objectSize, const std::size_t objectAlignment, const std::size_t slabObjectCount): _objectSize{objectSize}, _objectAlignment{objectAlignment}, _slabObjectCount{slabObjectCount}, _stride{}, _id{++poolCounter}, _shardCount{}, _cacheCount{}, _shards{}, _caches{} {
+    CORRADE_ASSERT(objectSize,
+        "Containers::ObjectPool: object size expected to be non-zero", );
+    CORRADE_ASSERT(objectAlignment && !(objectAlignment & (objectAlignment - 1)),
+        "Containers::ObjectPool: object alignment expected to be a power of two but got" << objectAlignment, );
+    CORRADE_ASSERT(slabObjectCount,
+        "Containers::ObjectPool: slab object count expected to be non-zero", );
+
+    /* Each free object stores a pointer to the next one, so it has to be
+       large and aligned enough for that */
+    if(_objectAlignment < alignof(void*)) _objectAlignment = alignof(void*);
+    _stride = _objectSize < sizeof(void*) ? sizeof(void*) : _objectSize;
+    _stride = (_stride + _objectAlignment - 1) & ~(_objectAlignment - 1);
+
+    _shardCount = 1;
+    _cacheCount = 1;
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    /* Shard count is fixed for the whole lifetime of the pool so the thread to
+       shard mapping stays stable. Twice as many caches to have some left for
+       threads that come and go. */
+    _shardCount = std::thread::hardware_concurrency();
+    if(!_shardCount) _shardCount = 1;
+    else if(_shardCount > 64) _shardCount = 64;
+    _cacheCount = _shardCount*2;
+    #endif
+    _shards = new Shard[_shardCount];
+    _caches = new Cache[_cacheCount];
+}
+
+ObjectPool::~ObjectPool() {
+    CORRADE_ASSERT(!objectCount(),
+        "Containers::ObjectPool: destroyed with" << objectCount() << "objects still allocated", );
+
+    /* Objects in the caches are all in the slabs, so there's nothing extra to
+       free for them */
+    for(std::size_t i = 0; i != _shardCount; ++i) {
+        void* slab = _shards[i].slabs;
+        while(slab) {
+            void* const next = *static_cast<void**>(slab);
+            delete[] static_cast<char*>(slab);
+            slab = next;
+        }
+    }
+
+    delete[] _caches;
+    delete[] _shards;
+}
+
+std::size_t ObjectPool::slabCount() const {
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != _shardCount; ++i) {
+        std::lock_guard<std::mutex> lock{_shards[i].mutex};
+        count += _shards[i].slabCount;
+    }
+    return count;
+}
+
+std::size_t ObjectPool::objectCount() const {
+    std::ptrdiff_t count = 0;
+    for(std::size_t i = 0; i != _shardCount; ++i) {
+        std::lock_guard<std::mutex> lock{_shards[i].mutex};
+        count += _shards[i].objectCount;
+    }
+    for(std::size_t i = 0; i != _cacheCount; ++i)
+        count += _caches[i].objectCount.load(std::memory_order_relaxed);
+    return count;
+}
+
+ObjectPool::Shard& ObjectPool::currentShard() {
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    if(!threadIndex) threadIndex = ++threadCounter;
+    return _shards[(threadIndex - 1) % _shardCount];
+    #else
+    return *_shards;
+    #endif
+}
+
+ObjectPool::Cache* ObjectPool::currentCache() {
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    for(const CacheLookup& i: cacheLookup)
+        if(i.pool == _id) return static_cast<Cache*>(i.cache);
+
+    if(!threadIndex) threadIndex = ++threadCounter;
+
+    /* Not used recently, find a cache this thread already owns or claim a
+       free one. If all are owned by other threads, this thread goes to the
+       shards directly. */
+    Cache* cache = nullptr;
+    for(std::size_t i = 0; i != _cacheCount && !cache; ++i)
+        if(_caches[i].owner.load(std::memory_order_relaxed) == threadIndex)
+            cache = _caches + i;
+    for(std::size_t i = 0; i != _cacheCount && !cache; ++i) {
+        std::size_t expected = 0;
+        if(_caches[i].owner.compare_exchange_strong(expected, threadIndex))
+            cache = _caches + i;
+    }
+
+    cacheLookup[cacheLookupNext++ % CacheLookupSize] = {_id, cache};
+    return cache;
+    #else
+    return _caches;
+    #endif
+}
+
+void* ObjectPool::allocateSlab(Shard& shard) {
+    /* The slab starts with a pointer to the next slab, after which the
+       objects follow, aligned to the desired alignment. Over-allocating by
+       the alignment so it can be satisfied no matter what new[] returns. */
+    char* const slab = new char[sizeof(void*) + _objectAlignment - 1 + _stride*_slabObjectCount];
+    *reinterpret_cast<void**>(slab) = shard.slabs;
+    shard.slabs = slab;
+    ++shard.slabCount;
+
+    /* Link all objects in the slab into a free list, the first one being the
+       head */
+    const std::size_t dataStart = reinterpret_cast<std::size_t>(slab) + sizeof(void*);
+    char* const data = slab + sizeof(void*) + (((dataStart + _objectAlignment - 1) & ~(_objectAlignment - 1)) - dataStart);
+    for(std::size_t i = 0; i != _slabObjectCount - 1; ++i)
+        *reinterpret_cast<void**>(data + i*_stride) = data + (i + 1)*_stride;
+    *reinterpret_cast<void**>(data + (_slabObjectCount - 1)*_stride) = nullptr;
+    return data;
+}
+
+void ObjectPool::refill(Cache& cache) {
+    Shard& shard = currentShard();
+    std::lock_guard<std::mutex> lock{shard.mutex};
+
+    /* Nothing free in the shard, give a whole new slab to the cache */
+    if(!shard.freeList) {
+        cache.freeList = allocateSlab(shard);
+        cache.freeCount = _slabObjectCount;
+        return;
+    }
+
+    /* Otherwise take at most a slab worth of objects from the front */
+    void* last = shard.freeList;
+    std::size_t count = 1;
+    for(; count != _slabObjectCount && *static_cast<void**>(last); ++count)
+        last = *static_cast<void**>(last);
+    cache.freeList = shard.freeList;
+    cache.freeCount = count;
+    shard.freeList = *static_cast<void**>(last);
+    *static_cast<void**>(last) = nullptr;
+}
+
+void ObjectPool::flush(Cache& cache) {
+    /* Keep a slab worth of the most recently deallocated objects in the
+       cache, as those are the most likely to be still in CPU caches, and
+       give the rest back to the shard */
+    void* keepLast = cache.freeList;
+    for(std::size_t i = 1; i != _slabObjectCount; ++i)
+        keepLast = *static_cast<void**>(keepLast);
+    void* const first = *static_cast<void**>(keepLast);
+    *static_cast<void**>(keepLast) = nullptr;
+    void* last = first;
+    while(*static_cast<void**>(last)) last = *static_cast<void**>(last);
+    cache.freeCount = _slabObjectCount;
+
+    Shard& shard = currentShard();
+    std::lock_guard<std::mutex> lock{shard.mutex};
+    *static_cast<void**>(last) = shard.freeList;
+    shard.freeList = first;
+}
+
+void* ObjectPool::allocate() {
+    Cache* const cache = currentCache();
+
+    /* No cache available for this thread, allocate from the shard directly */
+    if(!cache) {
+        Shard& shard = currentShard();
+        std::lock_guard<std::mutex> lock{shard.mutex};
+        if(!shard.freeList) shard.freeList = allocateSlab(shard);
+
+        void* const out = shard.freeList;
+        shard.freeList = *static_cast<void**>(out);
+        ++shard.objectCount;
+        return out;
+    }
+
+    if(!cache->freeList) refill(*cache);
+
+    void* const out = cache->freeList;
+    cache->freeList = *static_cast<void**>(out);
+    --cache->freeCount;
+    /* Only this thread writes the counter, no need for an atomic increment */
+    cache->objectCount.store(cache->objectCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return out;
+}
+
+void ObjectPool::deallocate(void* const object) {
+    if(!object) return;
+
+    Cache* const cache = currentCache();
+
+    /* No cache available for this thread, deallocate to the shard directly */
+    if(!cache) {
+        Shard& shard = currentShard();
+        std::lock_guard<std::mutex> lock{shard.mutex};
+        *static_cast<void**>(object) = shard.freeList;
+        shard.freeList = object;
+        --shard.objectCount;
+        return;
+    }
+
+    *static_cast<void**>(object) = cache->freeList;
+    cache->freeList = object;
+    ++cache->freeCount;
+    cache->objectCount.store(cache->objectCount.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+
+    /* Don't let the cache grow indefinitely if this thread deallocates more
+       than it allocates, give the excess back so other threads can use it */
+    if(cache->freeCount == 2*_slabObjectCount) flush(*cache);
+}
+
+}}
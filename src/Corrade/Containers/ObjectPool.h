@@ -0,0 +1,427 @@
+#ifndef Corrade_Containers_ObjectPool_h
+#define Corrade_Containers_ObjectPool_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::ObjectPool, @ref Corrade::Containers::PoolPointer, @ref Corrade::Containers::PoolAllocated, function @ref Corrade::Containers::poolPointer()
+ * @m_since_latest
+ */
+
+#include <cstddef>
+#include <type_traits>
+#include <utility> /* std::swap() */
+
+#include "Corrade/Tags.h"
+#include "Corrade/Containers/Containers.h"
+#include "Corrade/Containers/constructHelpers.h"
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/Move.h"
+#include "Corrade/Utility/visibility.h"
+#ifndef CORRADE_NO_DEBUG
+#include "Corrade/Utility/Debug.h"
+#endif
+
+namespace Corrade { namespace Containers {
+
+/**
+@brief Fixed-size object pool
+@m_since_latest
+
+Allocates memory for objects of a single size in slabs of
+@ref slabObjectCount() objects, handing them out from intrusive free lists.
+Compared to calling @cpp new @ce and @cpp delete @ce for each object
+separately this makes allocation and deallocation a constant-time list
+operation in the common case and keeps objects allocated together close to
+each other in memory.
+
+The pool only manages raw memory, use @ref PoolPointer / @ref poolPointer()
+for an owning wrapper that constructs the object in pool memory and returns it
+to the pool on destruction, or derive from @ref PoolAllocated to make
+@cpp new @ce and @cpp delete @ce of a particular type go through a pool.
+
+@snippet Containers.cpp ObjectPool-usage
+
+@section Containers-ObjectPool-multithreading Thread safety
+
+If Corrade is compiled with @ref CORRADE_BUILD_MULTITHREADED enabled, the pool
+is safe to use from multiple threads. Each thread gets its own cache with a
+free list that it allocates from and deallocates to without any locking. An
+empty cache is refilled with up to @ref slabObjectCount() objects at once and
+if a cache accumulates twice as many free objects, the excess is given back.
+The refills and flushes go to several shards of free lists and slabs, each
+protected with its own lock and assigned to a subset of threads, so threads
+don't contend with each other even there unless there's more of them than
+there are shards. Objects allocated by one thread can be freely deallocated by
+another.
+
+The caches are assigned to the first thread that uses them and stay with the
+thread for the whole lifetime of the pool. There's twice as many caches as
+there are shards, if they're all taken, remaining threads allocate from and
+deallocate to the shards directly, with a lock for every operation. Free
+objects in caches of threads that exited are unused until the pool is
+destroyed.
+
+If @ref CORRADE_BUILD_MULTITHREADED is not enabled, the pool has just a single
+cache and a single shard.
+
+Memory of the slabs is released only when the pool is destroyed. It's expected
+that all objects are deallocated at that point.
+*/
+class CORRADE_UTILITY_EXPORT ObjectPool {
+    public:
+        /**
+         * @brief Constructor
+         * @param objectSize        Size of a single object in bytes
+         * @param objectAlignment   Alignment of a single object in bytes
+         * @param slabObjectCount   Count of objects allocated at once
+         *
+         * Expects that @p objectSize and @p slabObjectCount are non-zero and
+         * @p objectAlignment is a power of two. No memory is allocated
+         * until the first call to @ref allocate().
+         */
+        explicit ObjectPool(std::size_t objectSize, std::size_t objectAlignment, std::size_t slabObjectCount = 64);
+
+        /** @brief Copying is not allowed */
+        ObjectPool(const ObjectPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        ObjectPool(ObjectPool&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Releases all slabs. Expects that all objects allocated from the
+         * pool were deallocated.
+         */
+        ~ObjectPool();
+
+        /** @brief Copying is not allowed */
+        ObjectPool& operator=(const ObjectPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        ObjectPool& operator=(ObjectPool&&) = delete;
+
+        /** @brief Object size in bytes */
+        std::size_t objectSize() const { return _objectSize; }
+
+        /** @brief Object alignment in bytes */
+        std::size_t objectAlignment() const { return _objectAlignment; }
+
+        /** @brief Count of objects allocated at once */
+        std::size_t slabObjectCount() const { return _slabObjectCount; }
+
+        /**
+         * @brief Count of allocated slabs
+         *
+         * Slabs are never released until the pool is destroyed, so this value
+         * only grows.
+         */
+        std::size_t slabCount() const;
+
+        /**
+         * @brief Count of objects currently allocated
+         *
+         * @see @ref allocate(), @ref deallocate()
+         */
+        std::size_t objectCount() const;
+
+        /**
+         * @brief Allocate memory for a single object
+         *
+         * Returns uninitialized memory of at least @ref objectSize() bytes
+         * aligned to @ref objectAlignment(). If there's no free object left,
+         * allocates a new slab.
+         * @see @ref deallocate()
+         */
+        void* allocate();
+
+        /**
+         * @brief Deallocate memory of a single object
+         *
+         * The @p object is expected to be allocated from this pool and
+         * already destructed. Passing @cpp nullptr @ce is a no-op.
+         */
+        void deallocate(void* object);
+
+    private:
+        struct Shard;
+        struct Cache;
+
+        CORRADE_UTILITY_LOCAL Shard& currentShard();
+        CORRADE_UTILITY_LOCAL Cache* currentCache();
+        CORRADE_UTILITY_LOCAL void* allocateSlab(Shard& shard);
+        CORRADE_UTILITY_LOCAL void refill(Cache& cache);
+        CORRADE_UTILITY_LOCAL void flush(Cache& cache);
+
+        std::size_t _objectSize, _objectAlignment, _slabObjectCount, _stride;
+        /* Unique for every pool ever created, used to look up the
+           thread-local caches */
+        std::size_t _id;
+        std::size_t _shardCount, _cacheCount;
+        Shard* _shards;
+        Cache* _caches;
+};
+
+/**
+@brief Owning pointer to an object allocated from an @ref ObjectPool
+@m_since_latest
+
+Like @ref Pointer, but on destruction the object is destructed and its memory
+is returned to the @ref ObjectPool it was allocated from instead of calling
+@cpp delete @ce on it. Usually created via @ref poolPointer(). The pool is
+expected to outlive all pointers referencing it.
+
+@snippet Containers.cpp ObjectPool-usage
+*/
+template<class T> class PoolPointer {
+    static_assert(!std::is_array<T>::value, "arrays are not supported");
+
+    public:
+        /** @brief Value type */
+        typedef T Type;
+
+        /**
+         * @brief Default constructor
+         *
+         * Creates a @cpp nullptr @ce pointer not associated with any pool.
+         */
+        /*implicit*/ PoolPointer(std::nullptr_t = nullptr) noexcept: _pointer{}, _pool{} {}
+
+        /**
+         * @brief Take over an existing object
+         *
+         * The @p pointer is expected to be constructed in memory allocated
+         * from @p pool.
+         */
+        explicit PoolPointer(T* pointer, ObjectPool& pool) noexcept: _pointer{pointer}, _pool{&pool} {}
+
+        /**
+         * @brief Construct an object in-place
+         *
+         * Allocates memory from @p pool and passes @p args to the object
+         * constructor. Expects that the pool object size and alignment is
+         * large enough for @p T.
+         */
+        template<class ...Args> explicit PoolPointer(Corrade::InPlaceInitT, ObjectPool& pool, Args&&... args): _pointer{}, _pool{&pool} {
+            CORRADE_ASSERT(sizeof(T) <= pool.objectSize() && alignof(T) <= pool.objectAlignment(),
+                "Containers::PoolPointer: can't fit a type of size" << sizeof(T) << "and alignment" << alignof(T) << "into a pool of size" << pool.objectSize() << "and alignment" << pool.objectAlignment(), );
+            _pointer = static_cast<T*>(pool.allocate());
+            Implementation::construct(*_pointer, Utility::forward<Args>(args)...);
+        }
+
+        /** @brief Copying is not allowed */
+        PoolPointer(const PoolPointer<T>&) = delete;
+
+        /** @brief Move constructor */
+        PoolPointer(PoolPointer<T>&& other) noexcept: _pointer{other._pointer}, _pool{other._pool} {
+            other._pointer = nullptr;
+        }
+
+        /**
+         * @brief Destructor
+         *
+         * Destructs the object and returns its memory to the pool.
+         */
+        ~PoolPointer() { destroy(); }
+
+        /** @brief Copying is not allowed */
+        PoolPointer<T>& operator=(const PoolPointer<T>&) = delete;
+
+        /** @brief Move assignment */
+        PoolPointer<T>& operator=(PoolPointer<T>&& other) noexcept {
+            std::swap(_pointer, other._pointer);
+            std::swap(_pool, other._pool);
+            return *this;
+        }
+
+        /** @brief Equality comparison to a null pointer */
+        bool operator==(std::nullptr_t) const { return !_pointer; }
+
+        /** @brief Non-equality comparison to a null pointer */
+        bool operator!=(std::nullptr_t) const { return _pointer; }
+
+        /** @brief Whether the pointer is non-null */
+        explicit operator bool() const { return _pointer; }
+
+        /**
+         * @brief Pool the object belongs to
+         *
+         * Can be @cpp nullptr @ce for a default-constructed instance.
+         */
+        ObjectPool* pool() const { return _pool; }
+
+        /**
+         * @brief Underlying pointer value
+         *
+         * @see @ref operator bool(), @ref operator->(), @ref release()
+         */
+        T* get() { return _pointer; }
+        const T* get() const { return _pointer; } /**< @overload */
+
+        /**
+         * @brief Access the underlying pointer
+         *
+         * Expects that the pointer is not @cpp nullptr @ce.
+         */
+        T* operator->() {
+            CORRADE_ASSERT(_pointer, "Containers::PoolPointer: the pointer is null", nullptr);
+            return _pointer;
+        }
+
+        /** @overload */
+        const T* operator->() const {
+            CORRADE_ASSERT(_pointer, "Containers::PoolPointer: the pointer is null", nullptr);
+            return _pointer;
+        }
+
+        /**
+         * @brief Access the underlying pointer
+         *
+         * Expects that the pointer is not @cpp nullptr @ce.
+         */
+        T& operator*() {
+            CORRADE_ASSERT(_pointer, "Containers::PoolPointer: the pointer is null", *_pointer);
+            return *_pointer;
+        }
+
+        /** @overload */
+        const T& operator*() const {
+            CORRADE_ASSERT(_pointer, "Containers::PoolPointer: the pointer is null", *_pointer);
+            return *_pointer;
+        }
+
+        /**
+         * @brief Reset the pointer
+         *
+         * Destructs the stored object and returns its memory to the pool.
+         */
+        void reset() {
+            destroy();
+            _pointer = nullptr;
+        }
+
+        /**
+         * @brief Release the pointer ownership
+         *
+         * Resets the stored pointer to @cpp nullptr @ce, returning the
+         * previous value. The caller is then responsible for destructing the
+         * object and returning its memory to @ref pool().
+         */
+        T* release() {
+            T* const out = _pointer;
+            _pointer = nullptr;
+            return out;
+        }
+
+    private:
+        void destroy() {
+            if(!_pointer) return;
+            _pointer->~T();
+            _pool->deallocate(_pointer);
+        }
+
+        T* _pointer;
+        ObjectPool* _pool;
+};
+
+/** @relates PoolPointer
+@brief Equality comparison of a null pointer and a pool pointer
+@m_since_latest
+
+See @ref PoolPointer::operator==(std::nullptr_t) const for more information.
+*/
+template<class T> bool operator==(std::nullptr_t, const PoolPointer<T>& b) { return b == nullptr; }
+
+/** @relates PoolPointer
+@brief Non-equality comparison of a null pointer and a pool pointer
+@m_since_latest
+
+See @ref PoolPointer::operator!=(std::nullptr_t) const for more information.
+*/
+template<class T> bool operator!=(std::nullptr_t, const PoolPointer<T>& b) { return b != nullptr; }
+
+/** @relatesalso PoolPointer
+@brief Make a pool pointer
+@m_since_latest
+
+Convenience alternative to
+@ref PoolPointer::PoolPointer(Corrade::InPlaceInitT, ObjectPool&, Args&&... args).
+*/
+template<class T, class ...Args> inline PoolPointer<T> poolPointer(ObjectPool& pool, Args&&... args) {
+    return PoolPointer<T>{Corrade::InPlaceInit, pool, Utility::forward<Args>(args)...};
+}
+
+/**
+@brief Base for classes allocated from an @ref ObjectPool
+@m_since_latest
+
+Provides class-specific @cpp operator new @ce and @cpp operator delete @ce that
+allocate instances of @p Derived from a single process-wide @ref ObjectPool
+returned by @ref objectPool(). Useful especially for @ref LinkedListItem
+subclasses --- @ref LinkedList calls @cpp delete @ce on its items, so with
+this base both creating the items and erasing them from the list goes through
+the pool without any other change in the code:
+
+@snippet Containers.cpp PoolAllocated-usage
+
+Allocations of a size different from @cpp sizeof(Derived) @ce, such as
+allocations of further subclasses, are passed through to the global
+@cpp operator new @ce and @cpp operator delete @ce. Deleting through a base
+pointer thus requires a @cpp virtual @ce destructor, which is the case with
+@ref LinkedListItem.
+
+The pool is created on first use and intentionally never destroyed, to avoid
+issues with static destruction order. See @ref ObjectPool for details about
+thread safety.
+*/
+template<class Derived> class PoolAllocated {
+    public:
+        /** @brief Pool used for allocating instances of @p Derived */
+        static ObjectPool& objectPool() {
+            static ObjectPool& pool = *new ObjectPool{sizeof(Derived), alignof(Derived)};
+            return pool;
+        }
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        static void* operator new(std::size_t size) {
+            if(size != sizeof(Derived)) return ::operator new(size);
+            return objectPool().allocate();
+        }
+
+        static void operator delete(void* pointer, std::size_t size) {
+            if(size != sizeof(Derived)) ::operator delete(pointer);
+            else objectPool().deallocate(pointer);
+        }
+        #endif
+
+    protected:
+        ~PoolAllocated() = default;
+};
+
+}}
+
+#endif
@@ -0,0 +1,65 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SharedArray.h"
+
+#include <atomic>
+
+namespace Corrade { namespace Containers { namespace Implementation {
+
+namespace {
+
+/* The reference count is right after the capacity */
+static_assert(sizeof(std::atomic<std::size_t>) == sizeof(std::size_t),
+    "std::atomic<std::size_t> doesn't fit into the header");
+
+inline std::atomic<std::size_t>& referenceCount(void* const base) {
+    return *reinterpret_cast<std::atomic<std::size_t>*>(static_cast<std::size_t*>(base) + 1);
+}
+
+}
+
+void arraySharedInitialize(void* const base) {
+    new(&referenceCount(base)) std::atomic<std::size_t>{1};
+}
+
+void arraySharedAcquire(void* const base) {
+    /* Relaxed is enough, a new reference can be only made from an existing
+       one, which already guarantees the memory is alive */
+    referenceCount(base).fetch_add(1, std::memory_order_relaxed);
+}
+
+bool arraySharedRelease(void* const base) {
+    /* Release so all accesses through this reference happen before the
+       deallocation, acquire for the thread that does the deallocation */
+    return referenceCount(base).fetch_sub(1, std::memory_order_acq_rel) == 1;
+}
+
+std::size_t arraySharedReferenceCount(const void* const base) {
+    return referenceCount(const_cast<void*>(base)).load(std::memory_order_acquire);
+}
+
+}}}
@@ -0,0 +1,489 @@
+#ifndef Corrade_Containers_SharedArray_h
+#define Corrade_Containers_SharedArray_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::SharedArray, @ref Corrade::Containers::ArraySharedAllocator
+ * @m_since_latest
+ */
+
+#include <cstring>
+#include <initializer_list>
+#include <new>
+
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/visibility.h"
+#ifndef CORRADE_NO_DEBUG
+#include "Corrade/Utility/Debug.h"
+#endif
+
+namespace Corrade { namespace Containers {
+
+namespace Implementation {
+
+template<class T> struct SharedAllocatorTraits {
+    enum: std::size_t {
+        /* Capacity and a reference count. Both are std::size_t, so if the
+           type alignment is less than twice of that, it's a multiple of
+           it. */
+        Offset = alignof(T) < 2*sizeof(std::size_t) ? 2*sizeof(std::size_t) :
+            (alignof(T) < Implementation::DefaultAllocationAlignment ?
+                alignof(T) : Implementation::DefaultAllocationAlignment)
+    };
+};
+
+/* The reference count is a std::atomic placed in the allocation header.
+   Manipulated only through these to avoid including <atomic> here. */
+CORRADE_UTILITY_EXPORT void arraySharedInitialize(void* base);
+CORRADE_UTILITY_EXPORT void arraySharedAcquire(void* base);
+CORRADE_UTILITY_EXPORT bool arraySharedRelease(void* base);
+CORRADE_UTILITY_EXPORT std::size_t arraySharedReferenceCount(const void* base);
+
+}
+
+/**
+@brief Growable array allocator with space for a reference count
+@m_since_latest
+
+Like @ref ArrayMallocAllocator, but reserves space for an atomic reference
+count next to the capacity at the beginning of the allocation. Arrays
+allocated with it can be turned into a @ref SharedArray and back without any
+copy. Usable with the growable array utilities the same way as
+@ref ArrayMallocAllocator:
+
+@snippet Containers.cpp SharedArray-allocator
+*/
+template<class T> struct ArraySharedAllocator {
+    static_assert(
+        #ifdef CORRADE_STD_IS_TRIVIALLY_TRAITS_SUPPORTED
+        std::is_trivially_copyable<T>::value
+        #else
+        Implementation::IsTriviallyCopyableOnOldGcc<T>::value
+        #endif
+        , "only trivially copyable types are usable with this allocator");
+
+    typedef T Type; /**< Pointer type */
+
+    enum: std::size_t {
+        /**
+         * Offset at the beginning of the allocation to store allocation
+         * capacity and a reference count. At least as large as two
+         * @ref std::size_t. If the type alignment is larger than that, then
+         * it's equal to type alignment, but only at most as large as the
+         * default allocation alignment.
+         */
+        AllocationOffset = Implementation::SharedAllocatorTraits<T>::Offset
+    };
+
+    /**
+     * @brief Allocate an array of given capacity
+     *
+     * @ref std::malloc()'s an @cpp char @ce array with an extra space to store
+     * @p capacity and a reference count *before* the front, returning it
+     * cast to @cpp T* @ce. The reference count is set to @cpp 1 @ce.
+     */
+    static T* allocate(std::size_t capacity) {
+        const std::size_t inBytes = capacity*sizeof(T) + AllocationOffset;
+        char* const memory = static_cast<char*>(std::malloc(inBytes));
+        reinterpret_cast<std::size_t*>(memory)[0] = inBytes;
+        Implementation::arraySharedInitialize(memory);
+        #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+        Implementation::trackAllocation(memory + AllocationOffset, inBytes);
+        #endif
+        return reinterpret_cast<T*>(memory + AllocationOffset);
+    }
+
+    /**
+     * @brief Reallocate an array to given capacity
+     *
+     * Calls @ref std::realloc() on @p array (offset by the space to store
+     * the header) and then updates the stored capacity to @p newCapacity.
+     * Only unique arrays are reallocated, so the reference count is always
+     * @cpp 1 @ce and doesn't need updating.
+     */
+    static void reallocate(T*& array, std::size_t prevSize, std::size_t newCapacity);
+
+    /**
+     * @brief Deallocate an array
+     *
+     * Calls @ref std::free() on a pointer offset by the extra space needed to
+     * store its header.
+     */
+    static void deallocate(T* data) {
+        #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+        Implementation::trackDeallocation(data);
+        #endif
+        if(data) std::free(reinterpret_cast<char*>(data) - AllocationOffset);
+    }
+
+    /**
+     * @brief Grow the array
+     *
+     * Behaves the same as @ref ArrayMallocAllocator::grow().
+     */
+    static std::size_t grow(T* array, std::size_t desired) {
+        return Implementation::arrayGrowth<T>(array ? capacity(array) : 0, desired);
+    }
+
+    /**
+     * @brief Array capacity
+     *
+     * Retrieves the capacity that's stored *before* the front of the @p array.
+     */
+    static std::size_t capacity(T* array) {
+        return (*reinterpret_cast<std::size_t*>(reinterpret_cast<char*>(array) - AllocationOffset) - AllocationOffset)/sizeof(T);
+    }
+
+    /**
+     * @brief Array base address
+     *
+     * Returns the address with @ref AllocationOffset subtracted.
+     */
+    static void* base(T* array) {
+        return reinterpret_cast<char*>(array) - AllocationOffset;
+    }
+
+    /**
+     * @brief Array deleter
+     *
+     * Since the types have trivial destructors, directly delegates into
+     * @ref deallocate(). The @p size parameter is unused.
+     */
+    static void deleter(T* data, std::size_t size) {
+        static_cast<void>(size);
+        deallocate(data);
+    }
+};
+
+/**
+@brief Shared array
+@tparam T   Element type
+@m_since_latest
+
+Immutable array with shared ownership, for passing a large buffer to
+multiple threads or subsystems without copying it or managing its lifetime
+manually through non-owning @ref ArrayView instances. Copying a
+@ref SharedArray only increments a reference count, the memory is freed
+once the last instance referencing it is destroyed. The reference count is
+atomic, so instances referencing the same memory can be copied and destroyed
+from multiple threads at the same time.
+
+The reference count is stored in the allocation itself, next to the
+capacity, using the @ref ArraySharedAllocator layout. That means there's
+just a single allocation, and a @ref SharedArray can be constructed from an
+@ref Array allocated with @ref ArraySharedAllocator without a copy. Arrays
+using any other deleter get copied into a new allocation on construction.
+
+@snippet Containers.cpp SharedArray-usage
+
+@section Containers-SharedArray-slicing Slicing
+
+The @ref slice(), @ref prefix() and @ref suffix() functions return a new
+@ref SharedArray that references a sub-range of the same allocation, keeping
+the whole allocation alive. No data is copied.
+
+@section Containers-SharedArray-unique Conversion to a unique array
+
+If the instance is the only one referencing the memory, @ref release()
+turns it into a unique growable @ref Array using @ref ArraySharedAllocator
+without any allocation. Otherwise the viewed range is copied into a new
+allocation.
+
+Only trivially copyable types are supported, same as with
+@ref ArrayMallocAllocator.
+*/
+template<class T> class SharedArray {
+    public:
+        typedef T Type;     /**< @brief Element type */
+
+        /**
+         * @brief Default constructor
+         *
+         * Creates an empty array, which doesn't allocate anything.
+         */
+        /*implicit*/ SharedArray() noexcept: _base{}, _data{}, _size{} {}
+
+        /**
+         * @brief Construct a value-initialized array
+         *
+         * Zero-size arrays don't allocate anything.
+         */
+        explicit SharedArray(Corrade::ValueInitT, std::size_t size);
+
+        /**
+         * @brief Construct an array without initializing its contents
+         *
+         * Zero-size arrays don't allocate anything.
+         */
+        explicit SharedArray(Corrade::NoInitT, std::size_t size);
+
+        /**
+         * @brief Construct a value-initialized array
+         *
+         * Alias to @ref SharedArray(ValueInitT, std::size_t).
+         */
+        explicit SharedArray(std::size_t size): SharedArray{Corrade::ValueInit, size} {}
+
+        /** @brief Construct a list-initialized array */
+        explicit SharedArray(Corrade::InPlaceInitT, std::initializer_list<T> list);
+
+        /**
+         * @brief Construct from a unique array
+         *
+         * If @p array uses @ref ArraySharedAllocator, its memory is taken
+         * over without a copy. Otherwise its contents are copied to a new
+         * allocation.
+         */
+        /*implicit*/ SharedArray(Array<T>&& array);
+
+        /**
+         * @brief Copy constructor
+         *
+         * Increments the reference count.
+         */
+        SharedArray(const SharedArray<T>& other) noexcept;
+
+        /** @brief Move constructor */
+        SharedArray(SharedArray<T>&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Decrements the reference count and frees the memory if it was the
+         * last reference.
+         */
+        ~SharedArray();
+
+        /** @brief Copy assignment */
+        SharedArray<T>& operator=(const SharedArray<T>& other) noexcept;
+
+        /** @brief Move assignment */
+        SharedArray<T>& operator=(SharedArray<T>&& other) noexcept;
+
+        /** @brief Conversion to an array view */
+        /*implicit*/ operator ArrayView<const T>() const noexcept {
+            return {_data, _size};
+        }
+
+        /** @brief Array data */
+        const T* data() const { return _data; }
+
+        /** @brief Array size */
+        std::size_t size() const { return _size; }
+
+        /** @brief Whether the array is empty */
+        bool empty() const { return !_size; }
+
+        /**
+         * @brief Count of instances referencing the same memory
+         *
+         * Returns @cpp 0 @ce for a default-constructed or zero-size array.
+         * In a multithreaded scenario, the value may be out of date by the
+         * time it's returned, unless it's @cpp 1 @ce.
+         */
+        std::size_t referenceCount() const {
+            return _base ? Implementation::arraySharedReferenceCount(ArraySharedAllocator<T>::base(_base)) : 0;
+        }
+
+        /** @brief Pointer to the first element */
+        const T* begin() const { return _data; }
+        const T* cbegin() const { return _data; } /**< @overload */
+
+        /** @brief Pointer to (one item after) the last element */
+        const T* end() const { return _data + _size; }
+        const T* cend() const { return _data + _size; } /**< @overload */
+
+        /**
+         * @brief Element access
+         *
+         * Expects that @p i is less than @ref size().
+         */
+        const T& operator[](std::size_t i) const;
+
+        /**
+         * @brief Shared array slice
+         *
+         * Returns an array referencing the same memory, with the reference
+         * count incremented. Expects that
+         * @p begin @cpp <= @ce @p end @cpp <= @ce @ref size().
+         */
+        SharedArray<T> slice(std::size_t begin, std::size_t end) const;
+
+        /**
+         * @brief Shared array prefix
+         *
+         * Equivalent to @cpp slice(0, end) @ce.
+         */
+        SharedArray<T> prefix(std::size_t end) const {
+            return slice(0, end);
+        }
+
+        /**
+         * @brief Shared array suffix
+         *
+         * Equivalent to @cpp slice(begin, size()) @ce.
+         */
+        SharedArray<T> suffix(std::size_t begin) const {
+            return slice(begin, _size);
+        }
+
+        /**
+         * @brief Release to a unique array
+         *
+         * If this is the only instance referencing the memory, the viewed
+         * range is moved to the front of the allocation if needed and the
+         * memory is returned in a growable @ref Array using
+         * @ref ArraySharedAllocator without any allocation. Otherwise the
+         * viewed range is copied into a new array. The instance is empty
+         * afterwards.
+         */
+        Array<T> release();
+
+    private:
+        void releaseReference();
+
+        /* Start of the allocation as returned by ArraySharedAllocator, null
+           for empty arrays */
+        T* _base;
+        const T* _data;
+        std::size_t _size;
+};
+
+template<class T> void ArraySharedAllocator<T>::reallocate(T*& array, std::size_t, const std::size_t newCapacity) {
+    const std::size_t inBytes = newCapacity*sizeof(T) + AllocationOffset;
+    char* const memory = static_cast<char*>(std::realloc(reinterpret_cast<char*>(array) - AllocationOffset, inBytes));
+    reinterpret_cast<std::size_t*>(memory)[0] = inBytes;
+    #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+    Implementation::trackReallocation(array, memory + AllocationOffset, inBytes);
+    #endif
+    array = reinterpret_cast<T*>(memory + AllocationOffset);
+}
+
+template<class T> SharedArray<T>::SharedArray(Corrade::ValueInitT, const std::size_t size): SharedArray{Corrade::NoInit, size} {
+    for(std::size_t i = 0; i != size; ++i) new(_base + i) T();
+}
+
+template<class T> SharedArray<T>::SharedArray(Corrade::NoInitT, const std::size_t size): _base{size ? ArraySharedAllocator<T>::allocate(size) : nullptr}, _data{_base}, _size{size} {}
+
+template<class T> SharedArray<T>::SharedArray(Corrade::InPlaceInitT, const std::initializer_list<T> list): SharedArray{Corrade::NoInit, list.size()} {
+    if(list.size()) std::memcpy(_base, list.begin(), list.size()*sizeof(T));
+}
+
+template<class T> SharedArray<T>::SharedArray(Array<T>&& array) {
+    _size = array.size();
+
+    /* Take over the memory if it has the header already. The reference count
+       is 1 for all arrays with this deleter, as they're unique. */
+    if(array.deleter() == ArraySharedAllocator<T>::deleter) {
+        _base = array.release();
+        _data = _base;
+        return;
+    }
+
+    _base = _size ? ArraySharedAllocator<T>::allocate(_size) : nullptr;
+    _data = _base;
+    if(_size) std::memcpy(_base, array.data(), _size*sizeof(T));
+}
+
+template<class T> SharedArray<T>::SharedArray(const SharedArray<T>& other) noexcept: _base{other._base}, _data{other._data}, _size{other._size} {
+    if(_base) Implementation::arraySharedAcquire(ArraySharedAllocator<T>::base(_base));
+}
+
+template<class T> SharedArray<T>::SharedArray(SharedArray<T>&& other) noexcept: _base{other._base}, _data{other._data}, _size{other._size} {
+    other._base = nullptr;
+    other._data = nullptr;
+    other._size = 0;
+}
+
+template<class T> SharedArray<T>::~SharedArray() {
+    releaseReference();
+}
+
+template<class T> SharedArray<T>& SharedArray<T>::operator=(const SharedArray<T>& other) noexcept {
+    /* Acquire first so self-assignment doesn't free the memory */
+    if(other._base) Implementation::arraySharedAcquire(ArraySharedAllocator<T>::base(other._base));
+    releaseReference();
+    _base = other._base;
+    _data = other._data;
+    _size = other._size;
+    return *this;
+}
+
+template<class T> SharedArray<T>& SharedArray<T>::operator=(SharedArray<T>&& other) noexcept {
+    using std::swap;
+    swap(_base, other._base);
+    swap(_data, other._data);
+    swap(_size, other._size);
+    return *this;
+}
+
+template<class T> const T& SharedArray<T>::operator[](const std::size_t i) const {
+    CORRADE_ASSERT(i < _size,
+        "Containers::SharedArray::operator[](): index" << i << "out of range for" << _size << "elements", _data[0]);
+    return _data[i];
+}
+
+template<class T> SharedArray<T> SharedArray<T>::slice(const std::size_t begin, const std::size_t end) const {
+    CORRADE_ASSERT(begin <= end && end <= _size,
+        "Containers::SharedArray::slice(): slice [" << Utility::Debug::nospace << begin << Utility::Debug::nospace << ":" << Utility::Debug::nospace << end << Utility::Debug::nospace << "] out of range for" << _size << "elements", {});
+    SharedArray<T> out{*this};
+    out._data = _data + begin;
+    out._size = end - begin;
+    return out;
+}
+
+template<class T> Array<T> SharedArray<T>::release() {
+    Array<T> out;
+
+    /* Unique, reuse the allocation. The data are trivially copyable, so they
+       can be simply moved to the front if needed. */
+    if(_base && Implementation::arraySharedReferenceCount(ArraySharedAllocator<T>::base(_base)) == 1) {
+        if(_data != _base) std::memmove(_base, _data, _size*sizeof(T));
+        out = Array<T>{_base, _size, ArraySharedAllocator<T>::deleter};
+
+    /* Otherwise copy the viewed range and drop the reference */
+    } else if(_size) {
+        out = Array<T>{ArraySharedAllocator<T>::allocate(_size), _size, ArraySharedAllocator<T>::deleter};
+        std::memcpy(out.data(), _data, _size*sizeof(T));
+        releaseReference();
+    } else releaseReference();
+
+    _base = nullptr;
+    _data = nullptr;
+    _size = 0;
+    return out;
+}
+
+template<class T> void SharedArray<T>::releaseReference() {
+    if(_base && Implementation::arraySharedRelease(ArraySharedAllocator<T>::base(_base)))
+        ArraySharedAllocator<T>::deallocate(_base);
+}
+
+}}
+
+#endif
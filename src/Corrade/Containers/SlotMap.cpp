@@ -1,5 +1,3 @@
-#ifndef Corrade_Interconnect_Implementation_ReceiverConnection_h
-#define Corrade_Interconnect_Implementation_ReceiverConnection_h
 /*
     This file is part of Corrade.
 
@@ -26,19 +24,14 @@
     DEALINGS IN THE SOFTWARE.
 */
 
-#include "Corrade/Containers/Reference.h"
-#include "Corrade/Interconnect/Connection.h"
+#include "SlotMap.h"
 
-namespace Corrade { namespace Interconnect { namespace Implementation {
-
-struct ReceiverConnection {
-    explicit ReceiverConnection(Emitter& emitter, Implementation::SignalData signal, Implementation::ConnectionData& data) noexcept: emitter{emitter}, signal{signal}, data{data} {}
-
-    Containers::Reference<Emitter> emitter;
-    Implementation::SignalData signal;
-    Containers::Reference<Implementation::ConnectionData> data;
-};
-
-}}}
+namespace Corrade { namespace Containers {
 
+#ifndef CORRADE_NO_DEBUG
+Utility::Debug& operator<<(Utility::Debug& debug, const SlotMapHandle value) {
+    return debug << "Containers::SlotMapHandle(" << Utility::Debug::nospace << value.index() << Utility::Debug::nospace << "," << value.generation() << Utility::Debug::nospace << ")";
+}
 #endif
+
+}}
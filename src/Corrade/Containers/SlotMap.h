@@ -0,0 +1,400 @@
+#ifndef Corrade_Containers_SlotMap_h
+#define Corrade_Containers_SlotMap_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::SlotMap, @ref Corrade::Containers::SlotMapHandle
+ * @m_since_latest
+ */
+
+#include <cstdint>
+#include <utility> /* std::swap() */
+
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/Move.h"
+#include "Corrade/Utility/visibility.h"
+#ifndef CORRADE_NO_DEBUG
+#include "Corrade/Utility/Debug.h"
+#endif
+
+namespace Corrade { namespace Containers {
+
+/**
+@brief Slot map handle
+@m_since_latest
+
+A 32-bit slot index combined with a 32-bit generation counter, referencing a
+value stored in a @ref SlotMap. Trivially copyable and of the same size as a
+pointer on 64-bit platforms, so it can be stored and passed around in places
+where a pointer to a value would be used otherwise. Unlike a pointer, a
+handle to a value that was erased from the map is detected as such, even if
+the slot got reused for another value since.
+
+A default-constructed handle is a null handle that's never valid.
+@see @ref SlotMap::contains()
+*/
+class SlotMapHandle {
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Creates a null handle.
+         */
+        constexpr /*implicit*/ SlotMapHandle() noexcept: _index{}, _generation{} {}
+
+        /**
+         * @brief Construct from a slot index and a generation
+         *
+         * Meant mainly for deserialization of handles obtained from
+         * @ref index() and @ref generation().
+         */
+        constexpr explicit SlotMapHandle(std::uint32_t index, std::uint32_t generation) noexcept: _index{index}, _generation{generation} {}
+
+        /** @brief Slot index */
+        constexpr std::uint32_t index() const { return _index; }
+
+        /**
+         * @brief Generation
+         *
+         * Generations of valid handles are always odd, a null handle has the
+         * generation set to @cpp 0 @ce.
+         */
+        constexpr std::uint32_t generation() const { return _generation; }
+
+        /**
+         * @brief Whether the handle is not null
+         *
+         * Doesn't check that the handle is valid in any @ref SlotMap, use
+         * @ref SlotMap::contains() for that.
+         */
+        constexpr explicit operator bool() const { return _generation; }
+
+        /** @brief Equality comparison */
+        constexpr bool operator==(SlotMapHandle other) const {
+            return _index == other._index && _generation == other._generation;
+        }
+
+        /** @brief Non-equality comparison */
+        constexpr bool operator!=(SlotMapHandle other) const {
+            return !operator==(other);
+        }
+
+    private:
+        std::uint32_t _index;
+        std::uint32_t _generation;
+};
+
+#ifndef CORRADE_NO_DEBUG
+/**
+@debugoperator{SlotMapHandle}
+@m_since_latest
+*/
+CORRADE_UTILITY_EXPORT Utility::Debug& operator<<(Utility::Debug& debug, SlotMapHandle value);
+#endif
+
+/**
+@brief Slot map
+@tparam T   Value type
+@m_since_latest
+
+Stores values in a densely packed growable @ref Array and references them
+through @ref SlotMapHandle instances that stay valid until the particular
+value is erased. Insertion and removal are @f$ \mathcal{O}(1) @f$, lookup of
+a value by a handle is two array accesses and iteration over all values goes
+linearly through memory without any holes, which makes this container
+suitable for large pools of objects that are created and destroyed often and
+processed in bulk.
+
+@snippet Containers.cpp SlotMap-usage
+
+@section Containers-SlotMap-storage Storage and handle validity
+
+Internally there's a slot array, where each slot stores an index into the
+dense value array together with a generation counter. A value is always
+referenced through its slot, so when a value gets erased, the last value
+gets moved into its place and only the slot of the moved value gets updated.
+Erased slots are put into a free list and reused by subsequent insertions,
+each reuse incrementing the generation so handles to erased values no longer
+match. The generation is 32-bit and wraps around only after the same slot is
+reused two billion times.
+
+Since values get moved on erasure, pointers and references to values
+obtained with @ref find() or @ref operator[]() are invalidated by
+@ref erase() as well as by any insertion that causes a reallocation. Use
+handles for long-term references.
+*/
+template<class T> class SlotMap {
+    public:
+        typedef T Type;     /**< @brief Value type */
+
+        /**
+         * @brief Default constructor
+         *
+         * Creates an empty map. No memory is allocated until the first
+         * insertion.
+         */
+        /*implicit*/ SlotMap() noexcept: _freeHead{~std::uint32_t{}} {}
+
+        /** @brief Copying is not allowed */
+        SlotMap(const SlotMap<T>&) = delete;
+
+        /** @brief Move constructor */
+        SlotMap(SlotMap<T>&& other) noexcept;
+
+        /** @brief Copying is not allowed */
+        SlotMap<T>& operator=(const SlotMap<T>&) = delete;
+
+        /** @brief Move assignment */
+        SlotMap<T>& operator=(SlotMap<T>&& other) noexcept;
+
+        /** @brief Count of values in the map */
+        std::size_t size() const { return _values.size(); }
+
+        /** @brief Whether the map is empty */
+        bool empty() const { return _values.empty(); }
+
+        /**
+         * @brief Count of slots
+         *
+         * Slots are reused after erasure, so this is the maximum count of
+         * values the map ever contained at once.
+         */
+        std::size_t slotCount() const { return _slots.size(); }
+
+        /**
+         * @brief Values
+         *
+         * Densely packed, in an unspecified order. A handle to the value at
+         * given position can be retrieved with @ref handle().
+         */
+        ArrayView<T> values() { return _values; }
+        ArrayView<const T> values() const { return _values; } /**< @overload */
+
+        /** @brief Pointer to the first value */
+        T* begin() { return _values.begin(); }
+        const T* begin() const { return _values.begin(); } /**< @overload */
+        const T* cbegin() const { return _values.cbegin(); } /**< @overload */
+
+        /** @brief Pointer to (one item after) the last value */
+        T* end() { return _values.end(); }
+        const T* end() const { return _values.end(); } /**< @overload */
+        const T* cend() const { return _values.cend(); } /**< @overload */
+
+        /**
+         * @brief Handle to a value at given position
+         *
+         * Expects that @p i is less than @ref size().
+         * @see @ref values()
+         */
+        SlotMapHandle handle(std::size_t i) const;
+
+        /**
+         * @brief Reserve memory for given count of values
+         *
+         * If @p capacity is less than the current count of values, does
+         * nothing.
+         */
+        void reserve(std::size_t capacity);
+
+        /**
+         * @brief Insert a value
+         *
+         * Reuses a slot from a previously erased value, if there's any.
+         * Executes in amortized @f$ \mathcal{O}(1) @f$ time.
+         * @see @ref emplace()
+         */
+        SlotMapHandle insert(const T& value) { return emplace(value); }
+        SlotMapHandle insert(T&& value) { return emplace(Utility::move(value)); } /**< @overload */
+
+        /**
+         * @brief Construct a value in place
+         *
+         * Same as @ref insert(), but constructs the value in place from
+         * @p args.
+         */
+        template<class ...Args> SlotMapHandle emplace(Args&&... args);
+
+        /**
+         * @brief Whether the map contains a value referenced by given handle
+         *
+         * Returns @cpp false @ce for a null handle, a handle to a value that
+         * was erased already or a handle from a different map that's out of
+         * bounds of this map.
+         */
+        bool contains(SlotMapHandle handle) const {
+            return handle.index() < _slots.size() && (handle.generation() & 1) && _slots[handle.index()].generation == handle.generation();
+        }
+
+        /**
+         * @brief Find a value referenced by given handle
+         *
+         * If the handle isn't valid, returns @cpp nullptr @ce.
+         * @see @ref contains(), @ref operator[]()
+         */
+        T* find(SlotMapHandle handle) {
+            return contains(handle) ? _values.data() + _slots[handle.index()].index : nullptr;
+        }
+        const T* find(SlotMapHandle handle) const {
+            return contains(handle) ? _values.data() + _slots[handle.index()].index : nullptr;
+        } /**< @overload */
+
+        /**
+         * @brief Value referenced by given handle
+         *
+         * Expects that the handle is valid. Use @ref find() if you're not
+         * sure.
+         */
+        T& operator[](SlotMapHandle handle);
+        const T& operator[](SlotMapHandle handle) const; /**< @overload */
+
+        /**
+         * @brief Erase a value referenced by given handle
+         *
+         * If the handle is valid, moves the last value in place of the
+         * erased one, puts the slot to a free list and returns
+         * @cpp true @ce. Otherwise returns @cpp false @ce. Executes in
+         * @f$ \mathcal{O}(1) @f$ time.
+         */
+        bool erase(SlotMapHandle handle);
+
+        /**
+         * @brief Erase all values
+         *
+         * All existing handles become invalid, the slots are put to a free
+         * list for reuse. Allocated memory is kept.
+         */
+        void clear();
+
+    private:
+        struct Slot {
+            /* For an occupied slot, index into _values. For a free slot, index
+               of the next free slot. */
+            std::uint32_t index;
+            /* Odd for occupied slots, even for free slots */
+            std::uint32_t generation;
+        };
+
+        Array<T> _values;
+        /* Slot index for each value in _values */
+        Array<std::uint32_t> _valueSlots;
+        Array<Slot> _slots;
+        std::uint32_t _freeHead;
+};
+
+template<class T> SlotMap<T>::SlotMap(SlotMap<T>&& other) noexcept: _values{Utility::move(other._values)}, _valueSlots{Utility::move(other._valueSlots)}, _slots{Utility::move(other._slots)}, _freeHead{other._freeHead} {
+    other._freeHead = ~std::uint32_t{};
+}
+
+template<class T> SlotMap<T>& SlotMap<T>::operator=(SlotMap<T>&& other) noexcept {
+    using std::swap;
+    swap(_values, other._values);
+    swap(_valueSlots, other._valueSlots);
+    swap(_slots, other._slots);
+    swap(_freeHead, other._freeHead);
+    return *this;
+}
+
+template<class T> SlotMapHandle SlotMap<T>::handle(const std::size_t i) const {
+    CORRADE_ASSERT(i < _values.size(),
+        "Containers::SlotMap::handle(): index" << i << "out of range for" << _values.size() << "values", {});
+    const std::uint32_t slot = _valueSlots[i];
+    return SlotMapHandle{slot, _slots[slot].generation};
+}
+
+template<class T> void SlotMap<T>::reserve(const std::size_t capacity) {
+    arrayReserve(_values, capacity);
+    arrayReserve(_valueSlots, capacity);
+    arrayReserve(_slots, capacity);
+}
+
+template<class T> template<class ...Args> SlotMapHandle SlotMap<T>::emplace(Args&&... args) {
+    CORRADE_ASSERT(_values.size() < ~std::uint32_t{},
+        "Containers::SlotMap::emplace(): slot count limit reached", {});
+
+    std::uint32_t slot;
+    if(_freeHead != ~std::uint32_t{}) {
+        slot = _freeHead;
+        _freeHead = _slots[slot].index;
+    } else {
+        slot = _slots.size();
+        arrayAppend(_slots, Slot{0, 0});
+    }
+
+    Slot& s = _slots[slot];
+    s.index = _values.size();
+    ++s.generation;
+    arrayAppend(_values, Corrade::InPlaceInit, Utility::forward<Args>(args)...);
+    arrayAppend(_valueSlots, slot);
+    return SlotMapHandle{slot, s.generation};
+}
+
+template<class T> T& SlotMap<T>::operator[](const SlotMapHandle handle) {
+    return const_cast<T&>(static_cast<const SlotMap<T>&>(*this)[handle]);
+}
+
+template<class T> const T& SlotMap<T>::operator[](const SlotMapHandle handle) const {
+    CORRADE_ASSERT(contains(handle),
+        "Containers::SlotMap::operator[](): invalid handle" << handle, *_values.data());
+    return _values[_slots[handle.index()].index];
+}
+
+template<class T> bool SlotMap<T>::erase(const SlotMapHandle handle) {
+    if(!contains(handle)) return false;
+
+    /* Move the last value in place of the erased one and update its slot */
+    Slot& slot = _slots[handle.index()];
+    const std::uint32_t index = slot.index;
+    const std::size_t last = _values.size() - 1;
+    if(index != last) {
+        _values[index] = Utility::move(_values[last]);
+        _valueSlots[index] = _valueSlots[last];
+        _slots[_valueSlots[index]].index = index;
+    }
+    arrayRemoveSuffix(_values);
+    arrayRemoveSuffix(_valueSlots);
+
+    /* Making the generation even marks the slot as free */
+    ++slot.generation;
+    slot.index = _freeHead;
+    _freeHead = handle.index();
+    return true;
+}
+
+template<class T> void SlotMap<T>::clear() {
+    for(const std::uint32_t slot: _valueSlots) {
+        ++_slots[slot].generation;
+        _slots[slot].index = _freeHead;
+        _freeHead = slot;
+    }
+    arrayRemoveSuffix(_values, _values.size());
+    arrayRemoveSuffix(_valueSlots, _valueSlots.size());
+}
+
+}}
+
+#endif
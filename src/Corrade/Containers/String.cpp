@@ -33,6 +33,7 @@
 #include "Corrade/Containers/Array.h"
 #include "Corrade/Containers/Pair.h"
 #include "Corrade/Containers/StaticArray.h"
+#include "Corrade/Containers/allocationTrackingHelpers.h"
 
 namespace Corrade { namespace Containers {
 
@@ -68,6 +69,9 @@ inline void String::construct(Corrade::NoInitT, const std::size_t size) {
         _large.data[size] = '\0';
         _large.size = size;
         _large.deleter = nullptr;
+        #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+        Implementation::trackAllocation(_large.data, size + 1);
+        #endif
     }
 }
 
@@ -91,8 +95,16 @@ inline void String::construct(const char* const data, const std::size_t size) {
 inline void String::destruct() {
     /* If not SSO, delete the data */
     if(_small.size & 0x80) return;
+    /* Only the default deleter frees memory that String tracked itself, a
+       custom one may for example be a no-op deleter of a view on another
+       String */
     if(_large.deleter) _large.deleter(_large.data, _large.size);
-    else delete[] _large.data;
+    else {
+        #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+        Implementation::trackDeallocation(_large.data);
+        #endif
+        delete[] _large.data;
+    }
 }
 
 inline Containers::Pair<const char*, std::size_t> String::dataInternal() const {
@@ -160,6 +172,9 @@ String::String(AllocatedInitT, const char* const data, const std::size_t size)
     _large.data[size] = '\0';
     _large.size = size;
     _large.deleter = nullptr;
+    #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+    Implementation::trackAllocation(_large.data, size + 1);
+    #endif
 }
 
 String::String(char* const data, const std::size_t size, void(*deleter)(char*, std::size_t)) noexcept
@@ -189,6 +204,9 @@ String::String(Corrade::ValueInitT, const std::size_t size): _large{} {
         _large.data = new char[size + 1]{};
         _large.size = size;
         _large.deleter = nullptr;
+        #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+        Implementation::trackAllocation(_large.data, size + 1);
+        #endif
     }
 }
 
@@ -623,6 +641,9 @@ char* String::release() {
     CORRADE_ASSERT(!(_small.size & 0x80),
         "Containers::String::release(): cannot call on a SSO instance", {});
     char* data = _large.data;
+    #ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+    if(!_large.deleter) Implementation::trackDeallocation(data);
+    #endif
 
     /* Create a zero-size small string to fullfil the guarantee of data() being
        always non-null and null-terminated. Since this makes the string switch
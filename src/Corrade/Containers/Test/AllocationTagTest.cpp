@@ -0,0 +1,520 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+
+#include "Corrade/Containers/AllocationTag.h"
+#include "Corrade/Containers/ArrayTuple.h"
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/Containers/String.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Numeric.h"
+#include "Corrade/Utility/DebugStl.h" /** @todo remove when <sstream> is gone */
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct AllocationTagTest: TestSuite::Tester {
+    explicit AllocationTagTest();
+
+    void construct();
+    void constructCopy();
+    void destruct();
+    void untagged();
+
+    void scope();
+    void scopeMultithreaded();
+
+    void trackArray();
+    void trackArrayRelease();
+    void trackArrayNotOwned();
+    void trackArrayView();
+    void trackGrowableArray();
+    void trackString();
+    void trackStringToArray();
+    void trackStringView();
+    void trackArrayTuple();
+    void trackDeallocateInDifferentScope();
+    void trackMultithreaded();
+    void resetPeak();
+
+    void debug();
+};
+
+AllocationTagTest::AllocationTagTest() {
+    addTests({&AllocationTagTest::construct,
+              &AllocationTagTest::constructCopy,
+              &AllocationTagTest::destruct,
+              &AllocationTagTest::untagged,
+
+              &AllocationTagTest::scope,
+              &AllocationTagTest::scopeMultithreaded,
+
+              &AllocationTagTest::trackArray,
+              &AllocationTagTest::trackArrayRelease,
+              &AllocationTagTest::trackArrayNotOwned,
+              &AllocationTagTest::trackArrayView,
+              &AllocationTagTest::trackGrowableArray,
+              &AllocationTagTest::trackString,
+              &AllocationTagTest::trackStringToArray,
+              &AllocationTagTest::trackStringView,
+              &AllocationTagTest::trackArrayTuple,
+              &AllocationTagTest::trackDeallocateInDifferentScope,
+              &AllocationTagTest::trackMultithreaded,
+              &AllocationTagTest::resetPeak,
+
+              &AllocationTagTest::debug});
+}
+
+bool isInList(const AllocationTag& tag) {
+    for(const AllocationTag* i = AllocationTag::first(); i; i = i->next())
+        if(i == &tag) return true;
+    return false;
+}
+
+void AllocationTagTest::construct() {
+    AllocationTag tag{"meshes"};
+    CORRADE_COMPARE(tag.name(), std::string{"meshes"});
+    CORRADE_COMPARE(tag.liveBytes(), 0);
+    CORRADE_COMPARE(tag.peakBytes(), 0);
+    CORRADE_COMPARE(tag.allocationCount(), 0);
+    CORRADE_COMPARE(tag.allocatedBytes(), 0);
+    CORRADE_VERIFY(isInList(tag));
+}
+
+void AllocationTagTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<AllocationTag>{});
+    CORRADE_VERIFY(!std::is_move_constructible<AllocationTag>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<AllocationTag>{});
+    CORRADE_VERIFY(!std::is_move_assignable<AllocationTag>{});
+    CORRADE_VERIFY(!std::is_copy_constructible<AllocationTagScope>{});
+    CORRADE_VERIFY(!std::is_move_constructible<AllocationTagScope>{});
+}
+
+void AllocationTagTest::destruct() {
+    AllocationTag a{"a"};
+    Containers::Pointer<AllocationTag> b{new AllocationTag{"b"}};
+    AllocationTag c{"c"};
+    CORRADE_VERIFY(isInList(a));
+    CORRADE_VERIFY(isInList(*b));
+    CORRADE_VERIFY(isInList(c));
+
+    const AllocationTag* bPointer = b.get();
+    b = nullptr;
+    CORRADE_VERIFY(isInList(a));
+    CORRADE_VERIFY(isInList(c));
+    for(const AllocationTag* i = AllocationTag::first(); i; i = i->next())
+        CORRADE_VERIFY(i != bPointer);
+}
+
+void AllocationTagTest::untagged() {
+    CORRADE_COMPARE(AllocationTag::untagged().name(), std::string{"untagged"});
+    CORRADE_VERIFY(isInList(AllocationTag::untagged()));
+    CORRADE_COMPARE(&AllocationTag::current(), &AllocationTag::untagged());
+}
+
+void AllocationTagTest::scope() {
+    AllocationTag a{"a"};
+    AllocationTag b{"b"};
+    CORRADE_COMPARE(&AllocationTag::current(), &AllocationTag::untagged());
+    {
+        AllocationTagScope scopeA{a};
+        CORRADE_COMPARE(&AllocationTag::current(), &a);
+        {
+            AllocationTagScope scopeB{b};
+            CORRADE_COMPARE(&AllocationTag::current(), &b);
+        }
+        CORRADE_COMPARE(&AllocationTag::current(), &a);
+    }
+    CORRADE_COMPARE(&AllocationTag::current(), &AllocationTag::untagged());
+}
+
+void AllocationTagTest::scopeMultithreaded() {
+    #if !defined(CORRADE_BUILD_MULTITHREADED) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_SKIP("CORRADE_BUILD_MULTITHREADED is not enabled or threads are not available on this platform.");
+    #else
+    AllocationTag a{"a"};
+    AllocationTagScope scope{a};
+
+    /* The scope is thread-local, so a different thread doesn't see it */
+    AllocationTag* current = nullptr;
+    std::thread thread{[&current]() {
+        current = &AllocationTag::current();
+    }};
+    thread.join();
+    CORRADE_COMPARE(current, &AllocationTag::untagged());
+    CORRADE_COMPARE(&AllocationTag::current(), &a);
+    #endif
+}
+
+void AllocationTagTest::trackArray() {
+    #ifndef CORRADE_BUILD_ALLOCATION_TRACKING
+    CORRADE_SKIP("CORRADE_BUILD_ALLOCATION_TRACKING is not enabled.");
+    #else
+    AllocationTag tag{"arrays"};
+    {
+        AllocationTagScope scope{tag};
+        Array<int> a{Corrade::ValueInit, 10};
+        Array<int> b{Corrade::NoInit, 5};
+        Array<std::string> c{Corrade::DefaultInit, 3};
+        Array<int> d{Corrade::InPlaceInit, {1, 2, 3}};
+        /* Empty arrays don't allocate */
+        Array<int> e{Corrade::ValueInit, 0};
+        CORRADE_COMPARE(tag.liveBytes(), 10*4 + 5*4 + 3*sizeof(std::string) + 3*4);
+        CORRADE_COMPARE(tag.allocationCount(), 4);
+
+        /* Moving doesn't change anything */
+        Array<int> f = Utility::move(a);
+        CORRADE_COMPARE(tag.liveBytes(), 10*4 + 5*4 + 3*sizeof(std::string) + 3*4);
+    }
+    CORRADE_COMPARE(tag.liveBytes(), 0);
+    CORRADE_COMPARE(tag.peakBytes(), 10*4 + 5*4 + 3*sizeof(std::string) + 3*4);
+    CORRADE_COMPARE(tag.allocationCount(), 4);
+    CORRADE_COMPARE(tag.allocatedBytes(), 10*4 + 5*4 + 3*sizeof(std::string) + 3*4);
+    #endif
+}
+
+void AllocationTagTest::trackArrayRelease() {
+    #ifndef CORRADE_BUILD_ALLOCATION_TRACKING
+    CORRADE_SKIP("CORRADE_BUILD_ALLOCATION_TRACKING is not enabled.");
+    #else
+    AllocationTag tag{"arrays"};
+    AllocationTagScope scope{tag};
+
+    Array<int> a{Corrade::ValueInit, 10};
+    CORRADE_COMPARE(tag.liveBytes(), 40);
+
+    /* The memory is not held by a container anymore */
+    int* data = a.release();
+    CORRADE_COMPARE(tag.liveBytes(), 0);
+
+    /* Giving it back to an array doesn't track it again */
+    {
+        Array<int> b{data, 10};
+        CORRADE_COMPARE(tag.liveBytes(), 0);
+    }
+    CORRADE_COMPARE(tag.liveBytes(), 0);
+    CORRADE_COMPARE(tag.allocationCount(), 1);
+    #endif
+}
+
+void AllocationTagTest::trackArrayNotOwned() {
+    #ifndef CORRADE_BUILD_ALLOCATION_TRACKING
+    CORRADE_SKIP("CORRADE_BUILD_ALLOCATION_TRACKING is not enabled.");
+    #else
+    AllocationTag tag{"arrays"};
+    AllocationTagScope scope{tag};
+
+    /* Memory coming from the user isn't tracked */
+    int data[3]{};
+    {
+        Array<int> a{data, 3, [](int*, std::size_t) {}};
+        CORRADE_COMPARE(tag.liveBytes(), 0);
+    }
+    CORRADE_COMPARE(tag.liveBytes(), 0);
+    CORRADE_COMPARE(tag.allocationCount(), 0);
+    #endif
+}
+
+void AllocationTagTest::trackArrayView() {
+    #ifndef CORRADE_BUILD_ALLOCATION_TRACKING
+    CORRADE_SKIP("CORRADE_BUILD_ALLOCATION_TRACKING is not enabled.");
+    #else
+    AllocationTag tag{"arrays"};
+    AllocationTagScope scope{tag};
+
+    /* A non-owning view dying before its owner doesn't untrack the owner
+       memory, neither does releasing it */
+    {
+        Array<int> a{Corrade::ValueInit, 10};
+        {
+            Array<int> view{a.data(), a.size(), [](int*, std::size_t) {}};
+        } {
+            Array<int> view{a.data(), a.size(), [](int*, std::size_t) {}};
+            CORRADE_VERIFY(view.release() == a.data());
+        }
+        CORRADE_COMPARE(tag.liveBytes(), 40);
+    }
+    CORRADE_COMPARE(tag.liveBytes(), 0);
+
+    /* A non-owning view outliving its owner doesn't untrack anything once
+       the owner is gone. Allocate another array so there's something that
+       could get untracked by accident. */
+    {
+        Array<int> other{Corrade::ValueInit, 5};
+        Array<int> view;
+        {
+            Array<int> a{Corrade::ValueInit, 10};
+            view = Array<int>{a.data(), a.size(), [](int*, std::size_t) {}};
+            CORRADE_COMPARE(tag.liveBytes(), 60);
+        }
+        CORRADE_COMPARE(tag.liveBytes(), 20);
+        view = Array<int>{};
+        CORRADE_COMPARE(tag.liveBytes(), 20);
+    }
+    CORRADE_COMPARE(tag.liveBytes(), 0);
+    CORRADE_COMPARE(tag.allocationCount(), 3);
+    #endif
+}
+
+void AllocationTagTest::trackGrowableArray() {
+    #ifndef CORRADE_BUILD_ALLOCATION_TRACKING
+    CORRADE_SKIP("CORRADE_BUILD_ALLOCATION_TRACKING is not enabled.");
+    #else
+    AllocationTag malloced{"malloc"};
+    AllocationTag newed{"new"};
+    {
+        Array<int> a;
+        Array<std::string> b;
+        {
+            AllocationTagScope scope{malloced};
+            arrayAppend(a, 1);
+            arrayAppend(a, 2);
+        }
+        {
+            AllocationTagScope scope{newed};
+            arrayAppend(b, std::string{"hello"});
+            arrayAppend(b, std::string{"world"});
+        }
+        CORRADE_COMPARE(malloced.liveBytes(), arrayCapacity(a)*4 + ArrayMallocAllocator<int>::AllocationOffset);
+        CORRADE_COMPARE(newed.liveBytes(), arrayCapacity(b)*sizeof(std::string) + ArrayNewAllocator<std::string>::AllocationOffset);
+
+        /* Reallocations outside of the scope are still attributed to the
+           original tag */
+        for(int i = 0; i != 100; ++i) arrayAppend(a, i);
+        for(int i = 0; i != 100; ++i) arrayAppend(b, std::string{"!"});
+        CORRADE_COMPARE(AllocationTag::current().name(), std::string{"untagged"});
+        CORRADE_COMPARE(malloced.liveBytes(), arrayCapacity(a)*4 + ArrayMallocAllocator<int>::AllocationOffset);
+        CORRADE_COMPARE(newed.liveBytes(), arrayCapacity(b)*sizeof(std::string) + ArrayNewAllocator<std::string>::AllocationOffset);
+        CORRADE_COMPARE_AS(malloced.allocationCount(), 2,
+            TestSuite::Compare::Greater);
+        CORRADE_COMPARE_AS(newed.allocationCount(), 2,
+            TestSuite::Compare::Greater);
+
+        /* Shrinking to a non-growable array allocates anew, outside of the
+           scope now */
+        arrayShrink(a);
+        CORRADE_COMPARE(malloced.liveBytes(), 0);
+    }
+    CORRADE_COMPARE(malloced.liveBytes(), 0);
+    CORRADE_COMPARE(newed.liveBytes(), 0);
+    #endif
+}
+
+void AllocationTagTest::trackString() {
+    #ifndef CORRADE_BUILD_ALLOCATION_TRACKING
+    CORRADE_SKIP("CORRADE_BUILD_ALLOCATION_TRACKING is not enabled.");
+    #else
+    AllocationTag tag{"strings"};
+    {
+        AllocationTagScope scope{tag};
+        /* SSO doesn't allocate */
+        String a = "hello";
+        String b{Corrade::ValueInit, 100};
+        String c{AllocatedInit, "hello"};
+        String d{Corrade::NoInit, 200};
+        CORRADE_COMPARE(tag.liveBytes(), 101 + 6 + 201);
+        CORRADE_COMPARE(tag.allocationCount(), 3);
+
+        /* Releasing stops the tracking */
+        delete[] d.release();
+        CORRADE_COMPARE(tag.liveBytes(), 101 + 6);
+    }
+    CORRADE_COMPARE(tag.liveBytes(), 0);
+    CORRADE_COMPARE(tag.peakBytes(), 101 + 6 + 201);
+    #endif
+}
+
+void AllocationTagTest::trackStringToArray() {
+    #ifndef CORRADE_BUILD_ALLOCATION_TRACKING
+    CORRADE_SKIP("CORRADE_BUILD_ALLOCATION_TRACKING is not enabled.");
+    #else
+    AllocationTag tag{"strings"};
+    {
+        AllocationTagScope scope{tag};
+        String a{Corrade::ValueInit, 100};
+
+        /* The ownership is passed to another container, so it's still
+           tracked */
+        Array<char> b = Utility::move(a);
+        CORRADE_COMPARE(tag.liveBytes(), 101);
+    }
+    CORRADE_COMPARE(tag.liveBytes(), 0);
+    #endif
+}
+
+void AllocationTagTest::trackStringView() {
+    #ifndef CORRADE_BUILD_ALLOCATION_TRACKING
+    CORRADE_SKIP("CORRADE_BUILD_ALLOCATION_TRACKING is not enabled.");
+    #else
+    AllocationTag tag{"strings"};
+    AllocationTagScope scope{tag};
+
+    /* A non-owning view dying before its owner doesn't untrack the owner
+       memory, neither does releasing it */
+    {
+        String a{Corrade::ValueInit, 100};
+        {
+            String view = String::nullTerminatedView(a);
+            CORRADE_VERIFY(view.deleter());
+            CORRADE_VERIFY(view.data() == a.data());
+        } {
+            String view = String::nullTerminatedView(a);
+            CORRADE_VERIFY(view.release() == a.data());
+        }
+        CORRADE_COMPARE(tag.liveBytes(), 101);
+    }
+    CORRADE_COMPARE(tag.liveBytes(), 0);
+
+    /* A non-owning view outliving its owner doesn't untrack anything once
+       the owner is gone */
+    {
+        String other{Corrade::ValueInit, 50};
+        String view;
+        {
+            String a{Corrade::ValueInit, 100};
+            view = String::nullTerminatedView(a);
+            CORRADE_COMPARE(tag.liveBytes(), 152);
+        }
+        CORRADE_COMPARE(tag.liveBytes(), 51);
+        view = String{};
+        CORRADE_COMPARE(tag.liveBytes(), 51);
+    }
+    CORRADE_COMPARE(tag.liveBytes(), 0);
+    CORRADE_COMPARE(tag.allocationCount(), 3);
+    #endif
+}
+
+void AllocationTagTest::trackArrayTuple() {
+    #ifndef CORRADE_BUILD_ALLOCATION_TRACKING
+    CORRADE_SKIP("CORRADE_BUILD_ALLOCATION_TRACKING is not enabled.");
+    #else
+    AllocationTag tag{"tuples"};
+    {
+        AllocationTagScope scope{tag};
+        ArrayView<int> ints;
+        ArrayView<char> chars;
+        ArrayTuple a{
+            {10, ints},
+            {3, chars}
+        };
+        CORRADE_COMPARE(tag.liveBytes(), a.size());
+        CORRADE_COMPARE(tag.allocationCount(), 1);
+
+        /* Conversion to an Array keeps it tracked */
+        Array<char> b = Utility::move(a);
+        CORRADE_COMPARE(tag.liveBytes(), b.size());
+    }
+    CORRADE_COMPARE(tag.liveBytes(), 0);
+    #endif
+}
+
+void AllocationTagTest::trackDeallocateInDifferentScope() {
+    #ifndef CORRADE_BUILD_ALLOCATION_TRACKING
+    CORRADE_SKIP("CORRADE_BUILD_ALLOCATION_TRACKING is not enabled.");
+    #else
+    AllocationTag a{"a"};
+    AllocationTag b{"b"};
+
+    Array<int> array;
+    {
+        AllocationTagScope scope{a};
+        array = Array<int>{Corrade::ValueInit, 10};
+    }
+    CORRADE_COMPARE(a.liveBytes(), 40);
+    {
+        AllocationTagScope scope{b};
+        array = nullptr;
+    }
+    CORRADE_COMPARE(a.liveBytes(), 0);
+    CORRADE_COMPARE(b.liveBytes(), 0);
+    CORRADE_COMPARE(b.allocationCount(), 0);
+    #endif
+}
+
+void AllocationTagTest::trackMultithreaded() {
+    #if !defined(CORRADE_BUILD_ALLOCATION_TRACKING) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_SKIP("CORRADE_BUILD_ALLOCATION_TRACKING is not enabled or threads are not available on this platform.");
+    #else
+    AllocationTag tag{"threads"};
+
+    auto work = [&tag]() {
+        AllocationTagScope scope{tag};
+        for(std::size_t i = 0; i != 1000; ++i) {
+            Array<int> a{Corrade::NoInit, 4};
+            String b{Corrade::ValueInit, 50};
+        }
+    };
+    std::thread a{work}, b{work}, c{work}, d{work};
+    a.join();
+    b.join();
+    c.join();
+    d.join();
+
+    CORRADE_COMPARE(tag.liveBytes(), 0);
+    CORRADE_COMPARE(tag.allocationCount(), 4*1000*2);
+    CORRADE_COMPARE(tag.allocatedBytes(), 4*1000*(16 + 51));
+    CORRADE_COMPARE_AS(tag.peakBytes(), 16 + 51,
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(tag.peakBytes(), 4*(16 + 51),
+        TestSuite::Compare::LessOrEqual);
+    #endif
+}
+
+void AllocationTagTest::resetPeak() {
+    #ifndef CORRADE_BUILD_ALLOCATION_TRACKING
+    CORRADE_SKIP("CORRADE_BUILD_ALLOCATION_TRACKING is not enabled.");
+    #else
+    AllocationTag tag{"peak"};
+    AllocationTagScope scope{tag};
+
+    Array<int> a{Corrade::ValueInit, 10};
+    {
+        Array<int> b{Corrade::ValueInit, 100};
+    }
+    CORRADE_COMPARE(tag.liveBytes(), 40);
+    CORRADE_COMPARE(tag.peakBytes(), 440);
+
+    tag.resetPeak();
+    CORRADE_COMPARE(tag.liveBytes(), 40);
+    CORRADE_COMPARE(tag.peakBytes(), 40);
+    #endif
+}
+
+void AllocationTagTest::debug() {
+    AllocationTag tag{"meshes"};
+
+    std::ostringstream out;
+    Utility::Debug{&out} << tag;
+    CORRADE_COMPARE(out.str(), "Containers::AllocationTag(meshes): 0 live bytes, 0 peak bytes, 0 allocations, 0 allocated bytes\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::AllocationTagTest)
@@ -76,6 +76,7 @@ struct ArrayTest: TestSuite::Tester {
     void construct();
     void constructDefaultInit();
     void constructValueInit();
+    void constructValueInitLarge();
     void constructNoInitNonTrivial();
     void constructNoInitTrivial();
     void constructDirectInit();
@@ -112,6 +113,7 @@ struct ArrayTest: TestSuite::Tester {
     void customDeleter();
     void customDeleterType();
     void customDeleterTypeConstruct();
+    void customDeleterTypeStateless();
 
     void cast();
     void size();
@@ -133,6 +135,7 @@ ArrayTest::ArrayTest() {
               &ArrayTest::construct,
               &ArrayTest::constructDefaultInit,
               &ArrayTest::constructValueInit,
+              &ArrayTest::constructValueInitLarge,
               &ArrayTest::constructNoInitNonTrivial,
               &ArrayTest::constructNoInitTrivial,
               &ArrayTest::constructDirectInit,
@@ -169,6 +172,7 @@ ArrayTest::ArrayTest() {
               &ArrayTest::customDeleter,
               &ArrayTest::customDeleterType,
               &ArrayTest::customDeleterTypeConstruct,
+              &ArrayTest::customDeleterTypeStateless,
 
               &ArrayTest::cast,
               &ArrayTest::size,
@@ -241,6 +245,27 @@ void ArrayTest::constructValueInit() {
     CORRADE_COMPARE(a[2], 0);
     CORRADE_COMPARE(a[3], 0);
     CORRADE_COMPARE(a[4], 0);
+
+    /* The default deleter is used */
+    CORRADE_VERIFY(!a.deleter());
+}
+
+void ArrayTest::constructValueInitLarge() {
+    /* 4 MB, which is above the threshold for lazily zeroed allocations in
+       arrayResize() */
+    Array a{Corrade::ValueInit, 1024*1024};
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(a.size(), 1024*1024);
+
+    /* The default deleter is used regardless of the size */
+    CORRADE_VERIFY(!a.deleter());
+
+    /* Values should be zero-initialized, and writable */
+    CORRADE_COMPARE(a[0], 0);
+    CORRADE_COMPARE(a[512*1024], 0);
+    CORRADE_COMPARE(a[1024*1024 - 1], 0);
+    a[512*1024] = 1337;
+    CORRADE_COMPARE(a[512*1024], 1337);
 }
 
 void ArrayTest::constructNoInitTrivial() {
@@ -813,6 +838,49 @@ void ArrayTest::customDeleterTypeConstruct() {
     CORRADE_VERIFY(true);
 }
 
+int StatelessDeleterDeletedCount = 0;
+
+struct StatelessDeleter {
+    void operator()(int*, std::size_t size) { StatelessDeleterDeletedCount += size; }
+};
+
+void ArrayTest::customDeleterTypeStateless() {
+    /* Stateless deleters aren't stored, stateful are */
+    CORRADE_COMPARE(sizeof(Containers::Array<int, StatelessDeleter>), 2*sizeof(void*));
+    CORRADE_COMPARE(sizeof(Containers::Array<int, CustomDeleter>), 3*sizeof(void*));
+    CORRADE_COMPARE(sizeof(Array), 3*sizeof(void*));
+
+    int data[25]{};
+    StatelessDeleterDeletedCount = 0;
+
+    {
+        Containers::Array<int, StatelessDeleter> a{data, 25};
+        CORRADE_VERIFY(a == data);
+        CORRADE_COMPARE(a.size(), 25);
+
+        /* Moving doesn't call the deleter */
+        Containers::Array<int, StatelessDeleter> b = std::move(a);
+        CORRADE_VERIFY(!a.data());
+        CORRADE_VERIFY(b == data);
+        CORRADE_COMPARE(StatelessDeleterDeletedCount, 0);
+
+        Containers::Array<int, StatelessDeleter> c{data, 5};
+        c = std::move(b);
+        CORRADE_VERIFY(c == data);
+        CORRADE_COMPARE(c.size(), 25);
+        CORRADE_COMPARE(b.size(), 5);
+        CORRADE_COMPARE(StatelessDeleterDeletedCount, 0);
+
+        /* Released array doesn't call the deleter */
+        Containers::Array<int, StatelessDeleter> d{data, 10};
+        CORRADE_VERIFY(d.release() == data);
+        CORRADE_VERIFY(!d.data());
+    }
+
+    /* Deleters of a zero-sized a and d also got called */
+    CORRADE_COMPARE(StatelessDeleterDeletedCount, 30);
+}
+
 void ArrayTest::cast() {
     Containers::Array<std::uint32_t> a{6};
     const Containers::Array<std::uint32_t> ca{6};
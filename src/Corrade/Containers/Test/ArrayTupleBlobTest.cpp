@@ -0,0 +1,373 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+
+#include "Corrade/Containers/ArrayTupleBlob.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/Directory.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct ArrayTupleBlobTest: TestSuite::Tester {
+    explicit ArrayTupleBlobTest();
+
+    void serialize();
+    void serializeEmpty();
+    void serializeEmptyArrays();
+    void serializeTypeErased();
+    void serializeInvalidElementSize();
+    void serializeInvalidAlignment();
+
+    void views();
+    void viewsFromFile();
+    void viewsTooSmall();
+    void viewsInvalidSignature();
+    void viewsInvalidEndianness();
+    void viewsInvalidVersion();
+    void viewsSizeMismatch();
+    void viewsItemCountMismatch();
+    void viewsItemTypeMismatch();
+    void viewsItemOutOfBounds();
+    void viewsItemMisaligned();
+    void viewsBlobMisaligned();
+};
+
+ArrayTupleBlobTest::ArrayTupleBlobTest() {
+    addTests({&ArrayTupleBlobTest::serialize,
+              &ArrayTupleBlobTest::serializeEmpty,
+              &ArrayTupleBlobTest::serializeEmptyArrays,
+              &ArrayTupleBlobTest::serializeTypeErased,
+              &ArrayTupleBlobTest::serializeInvalidElementSize,
+              &ArrayTupleBlobTest::serializeInvalidAlignment,
+
+              &ArrayTupleBlobTest::views,
+              &ArrayTupleBlobTest::viewsFromFile,
+              &ArrayTupleBlobTest::viewsTooSmall,
+              &ArrayTupleBlobTest::viewsInvalidSignature,
+              &ArrayTupleBlobTest::viewsInvalidEndianness,
+              &ArrayTupleBlobTest::viewsInvalidVersion,
+              &ArrayTupleBlobTest::viewsSizeMismatch,
+              &ArrayTupleBlobTest::viewsItemCountMismatch,
+              &ArrayTupleBlobTest::viewsItemTypeMismatch,
+              &ArrayTupleBlobTest::viewsItemOutOfBounds,
+              &ArrayTupleBlobTest::viewsItemMisaligned,
+              &ArrayTupleBlobTest::viewsBlobMisaligned});
+}
+
+struct alignas(16) Aligned {
+    float data[4];
+};
+
+/* Test data shared by most cases. A byte array first so the next item needs
+   padding, then a 16-byte-aligned type to test alignment. */
+const char Bytes[]{'a', 'b', 'c'};
+const int Ints[]{3, -7, 15, 2};
+const Aligned AlignedData[]{{{1.0f, 2.0f, 3.0f, 4.0f}}, {{5.0f, 6.0f, 7.0f, 8.0f}}};
+
+Array<char> makeBlob() {
+    return arrayTupleBlob({
+        arrayView(Bytes),
+        arrayView(Ints),
+        arrayView(AlignedData)
+    });
+}
+
+void ArrayTupleBlobTest::serialize() {
+    Array<char> blob = makeBlob();
+
+    /* 24 bytes header, 3*24 bytes item records, 3 bytes, 1 byte padding,
+       16 bytes ints, 12 bytes padding, 32 bytes aligned data */
+    CORRADE_COMPARE(blob.size(), 24 + 3*24 + 3 + 1 + 16 + 12 + 32);
+    CORRADE_COMPARE_AS(blob.prefix(4), arrayView({'C', 'T', 'B', '\0'}),
+        TestSuite::Compare::Container);
+
+    /* Contents copied at expected offsets, padding zeroed */
+    CORRADE_COMPARE_AS(blob.slice(96, 99), arrayView(Bytes),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(blob[99], '\0');
+    CORRADE_COMPARE_AS(arrayCast<const int>(blob.slice(100, 116)), arrayView(Ints),
+        TestSuite::Compare::Container);
+    const char zeros[12]{};
+    CORRADE_COMPARE_AS(blob.slice(116, 128), arrayView(zeros),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(reinterpret_cast<const Aligned*>(blob + 128)[1].data[2], 7.0f);
+
+    /* Serializing the same data again gives the same output */
+    CORRADE_COMPARE_AS(makeBlob(), blob,
+        TestSuite::Compare::Container);
+}
+
+void ArrayTupleBlobTest::serializeEmpty() {
+    Array<char> blob = arrayTupleBlob({});
+    CORRADE_COMPARE(blob.size(), 24);
+
+    CORRADE_VERIFY(arrayTupleBlobViews(blob, {}));
+}
+
+void ArrayTupleBlobTest::serializeEmptyArrays() {
+    Array<char> blob = arrayTupleBlob({
+        ArrayView<const int>{},
+        ArrayView<const Aligned>{}
+    });
+    /* The (empty) second item is still aligned */
+    CORRADE_COMPARE(blob.size(), 24 + 2*24 + 8);
+
+    ArrayView<const int> ints{Ints};
+    ArrayView<const Aligned> aligned{AlignedData};
+    CORRADE_VERIFY(arrayTupleBlobViews(blob, {ints, aligned}));
+    CORRADE_VERIFY(ints.empty());
+    CORRADE_VERIFY(aligned.empty());
+}
+
+void ArrayTupleBlobTest::serializeTypeErased() {
+    Array<char> blob = arrayTupleBlob({
+        ArrayTupleBlobItem{Ints, sizeof(int), alignof(int), 4}
+    });
+
+    ArrayView<const int> ints;
+    CORRADE_VERIFY(arrayTupleBlobViews(blob, {ints}));
+    CORRADE_COMPARE_AS(ints, arrayView(Ints),
+        TestSuite::Compare::Container);
+}
+
+void ArrayTupleBlobTest::serializeInvalidElementSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    arrayTupleBlob({
+        arrayView(Ints),
+        ArrayTupleBlobItem{Ints, 0, 4, 4}
+    });
+    CORRADE_COMPARE(out.str(), "Containers::arrayTupleBlob(): expected a non-zero element size for item 1\n");
+}
+
+void ArrayTupleBlobTest::serializeInvalidAlignment() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    arrayTupleBlob({
+        arrayView(Ints),
+        ArrayTupleBlobItem{Ints, 4, 0, 4},
+        ArrayTupleBlobItem{Ints, 4, 3, 4}
+    });
+    arrayTupleBlob({
+        ArrayTupleBlobItem{Ints, 4, 3, 4}
+    });
+    CORRADE_COMPARE(out.str(),
+        "Containers::arrayTupleBlob(): expected alignment of item 1 to be a power of two, got 0\n"
+        "Containers::arrayTupleBlob(): expected alignment of item 0 to be a power of two, got 3\n");
+}
+
+void ArrayTupleBlobTest::views() {
+    Array<char> blob = makeBlob();
+
+    ArrayView<const char> bytes;
+    ArrayView<const int> ints;
+    ArrayView<const Aligned> aligned;
+    CORRADE_VERIFY(arrayTupleBlobViews(blob, {bytes, ints, aligned}));
+
+    /* The views point directly into the blob */
+    CORRADE_COMPARE(static_cast<const void*>(bytes.data()), blob + 96);
+    CORRADE_COMPARE(static_cast<const void*>(ints.data()), blob + 100);
+    CORRADE_COMPARE(static_cast<const void*>(aligned.data()), blob + 128);
+    CORRADE_COMPARE_AS(bytes, arrayView(Bytes),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(ints, arrayView(Ints),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(aligned.size(), 2);
+    CORRADE_COMPARE(aligned[0].data[0], 1.0f);
+    CORRADE_COMPARE(aligned[1].data[3], 8.0f);
+}
+
+void ArrayTupleBlobTest::viewsFromFile() {
+    #if !defined(CORRADE_TARGET_UNIX) && (!defined(CORRADE_TARGET_WINDOWS) || defined(CORRADE_TARGET_WINDOWS_RT))
+    CORRADE_SKIP("Memory-mapping not available on this platform.");
+    #else
+    const std::string filename = Utility::Directory::join(Utility::Directory::tmp(), "corrade-arraytupleblob.bin");
+    CORRADE_VERIFY(Utility::Directory::write(filename, makeBlob()));
+
+    {
+        Array<const char, Utility::Directory::MapDeleter> mapped = Utility::Directory::mapRead(filename);
+        CORRADE_VERIFY(mapped);
+
+        ArrayView<const char> bytes;
+        ArrayView<const int> ints;
+        ArrayView<const Aligned> aligned;
+        CORRADE_VERIFY(arrayTupleBlobViews(mapped, {bytes, ints, aligned}));
+        CORRADE_COMPARE_AS(bytes, arrayView(Bytes),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(ints, arrayView(Ints),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE(aligned[1].data[1], 6.0f);
+    }
+
+    CORRADE_VERIFY(Utility::Directory::rm(filename));
+    #endif
+}
+
+void ArrayTupleBlobTest::viewsTooSmall() {
+    Array<char> blob = makeBlob();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!arrayTupleBlobViews(blob.prefix(23), {}));
+    CORRADE_COMPARE(out.str(), "Containers::arrayTupleBlobViews(): expected at least 24 bytes but got 23\n");
+}
+
+void ArrayTupleBlobTest::viewsInvalidSignature() {
+    Array<char> blob = makeBlob();
+    blob[2] = 'X';
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!arrayTupleBlobViews(blob, {}));
+    CORRADE_COMPARE(out.str(), "Containers::arrayTupleBlobViews(): invalid signature\n");
+}
+
+void ArrayTupleBlobTest::viewsInvalidEndianness() {
+    Array<char> blob = makeBlob();
+    std::swap(blob[4], blob[5]);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!arrayTupleBlobViews(blob, {}));
+    CORRADE_COMPARE(out.str(), "Containers::arrayTupleBlobViews(): blob has a different endianness\n");
+}
+
+void ArrayTupleBlobTest::viewsInvalidVersion() {
+    Array<char> blob = makeBlob();
+    blob[6] = 2;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!arrayTupleBlobViews(blob, {}));
+    CORRADE_COMPARE(out.str(), "Containers::arrayTupleBlobViews(): unsupported version 2\n");
+}
+
+void ArrayTupleBlobTest::viewsSizeMismatch() {
+    Array<char> blob = makeBlob();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!arrayTupleBlobViews(blob.except(1), {}));
+    CORRADE_COMPARE(out.str(), "Containers::arrayTupleBlobViews(): expected 160 bytes but got 159\n");
+}
+
+void ArrayTupleBlobTest::viewsItemCountMismatch() {
+    Array<char> blob = makeBlob();
+
+    ArrayView<const char> bytes;
+    ArrayView<const int> ints;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!arrayTupleBlobViews(blob, {bytes, ints}));
+    CORRADE_COMPARE(out.str(), "Containers::arrayTupleBlobViews(): expected 2 items but the blob has 3\n");
+}
+
+void ArrayTupleBlobTest::viewsItemTypeMismatch() {
+    Array<char> blob = makeBlob();
+
+    /* The first view is set only after everything is checked, so it stays
+       untouched */
+    ArrayView<const char> bytes;
+    ArrayView<const float> floats;
+    ArrayView<const Aligned> aligned;
+    ArrayView<const double> doubles;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!arrayTupleBlobViews(blob, {bytes, floats, doubles}));
+    CORRADE_VERIFY(!arrayTupleBlobViews(blob, {bytes, doubles, aligned}));
+    CORRADE_VERIFY(!bytes.data());
+    CORRADE_COMPARE(out.str(),
+        "Containers::arrayTupleBlobViews(): expected item 2 to have element size 8 and alignment 8 but got 16 and 16\n"
+        "Containers::arrayTupleBlobViews(): expected item 1 to have element size 8 and alignment 8 but got 4 and 4\n");
+}
+
+void ArrayTupleBlobTest::viewsItemOutOfBounds() {
+    Array<char> blob = makeBlob();
+    /* Increase element count of the second item */
+    *reinterpret_cast<std::uint64_t*>(blob + 24 + 24 + 8) = 16;
+
+    ArrayView<const char> bytes;
+    ArrayView<const int> ints;
+    ArrayView<const Aligned> aligned;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!arrayTupleBlobViews(blob, {bytes, ints, aligned}));
+    CORRADE_COMPARE(out.str(), "Containers::arrayTupleBlobViews(): item 1 out of bounds\n");
+}
+
+void ArrayTupleBlobTest::viewsItemMisaligned() {
+    Array<char> blob = makeBlob();
+    /* Shift offset of the third item */
+    *reinterpret_cast<std::uint64_t*>(blob + 24 + 2*24) -= 4;
+
+    ArrayView<const char> bytes;
+    ArrayView<const int> ints;
+    ArrayView<const Aligned> aligned;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!arrayTupleBlobViews(blob, {bytes, ints, aligned}));
+    CORRADE_COMPARE(out.str(), "Containers::arrayTupleBlobViews(): item 2 not aligned to 16 bytes\n");
+}
+
+void ArrayTupleBlobTest::viewsBlobMisaligned() {
+    Array<char> blob = makeBlob();
+    Array<char> storage{Corrade::ValueInit, blob.size() + 16};
+    /* Find an offset that's 4-byte but not 16-byte aligned */
+    std::size_t offset = 0;
+    while(reinterpret_cast<std::uintptr_t>(storage + offset) % 16 != 4)
+        ++offset;
+    std::memcpy(storage + offset, blob, blob.size());
+
+    ArrayView<const char> bytes;
+    ArrayView<const int> ints;
+    ArrayView<const Aligned> aligned;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!arrayTupleBlobViews(storage.slice(offset, offset + blob.size()), {bytes, ints, aligned}));
+    CORRADE_COMPARE(out.str(), "Containers::arrayTupleBlobViews(): expected the blob to be aligned to 16 bytes\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::ArrayTupleBlobTest)
@@ -29,6 +29,7 @@
    functions are forward-declared so it should work. */
 #include "Corrade/Containers/ArrayTuple.h"
 
+#include <cstring>
 #include <sstream>
 
 #include "Corrade/Containers/Array.h"
@@ -63,6 +64,9 @@ struct ArrayTupleTest: TestSuite::Tester {
     void constructMove();
 
     void constructBig();
+    void constructLargeValueInit();
+    void constructLargeValueInitNonTriviallyDestructible();
+    void constructValueInitZeroFilledAllocator();
 
     void allocatorAlignmentEmpty();
     template<int a> void allocatorAlignmentFromItems();
@@ -96,6 +100,9 @@ ArrayTupleTest::ArrayTupleTest() {
               &ArrayTupleTest::constructMove,
 
               &ArrayTupleTest::constructBig,
+              &ArrayTupleTest::constructLargeValueInit,
+              &ArrayTupleTest::constructLargeValueInitNonTriviallyDestructible,
+              &ArrayTupleTest::constructValueInitZeroFilledAllocator,
 
               &ArrayTupleTest::allocatorAlignmentEmpty,
               &ArrayTupleTest::allocatorAlignmentFromItems<1>,
@@ -845,6 +852,135 @@ void ArrayTupleTest::constructBig() {
     CORRADE_COMPARE(Big::destructed, 7);
 }
 
+void ArrayTupleTest::constructLargeValueInit() {
+    /* 4 MB, trivial items are zero-filled at once */
+    ArrayView<int> ints;
+    ArrayView<char> chars;
+    ArrayTuple data{
+        {1024*1024, ints},
+        {13, chars}
+    };
+
+    CORRADE_COMPARE(data.size(), 1024*1024*4 + 13);
+    CORRADE_COMPARE(static_cast<void*>(ints.data()), data.data());
+    CORRADE_COMPARE(static_cast<void*>(chars.data()), data.data() + 1024*1024*4);
+
+    /* The default deleter is used regardless of the size */
+    CORRADE_VERIFY(!data.deleter());
+
+    /* Everything is zeroed, and writable */
+    CORRADE_COMPARE(ints[0], 0);
+    CORRADE_COMPARE(ints[512*1024], 0);
+    CORRADE_COMPARE(ints[1024*1024 - 1], 0);
+    for(char i: chars) CORRADE_COMPARE(i, 0);
+    ints[512*1024] = 1337;
+    CORRADE_COMPARE(ints[512*1024], 1337);
+
+    /* The conversion to an Array works */
+    Array<char> array = Utility::move(data);
+    CORRADE_COMPARE(array.size(), 1024*1024*4 + 13);
+    CORRADE_VERIFY(!array.deleter());
+}
+
+void ArrayTupleTest::constructLargeValueInitNonTriviallyDestructible() {
+    Big::constructed = 0;
+    Big::destructed = 0;
+
+    {
+        ArrayView<int> ints;
+        ArrayView<Big> bigs;
+        ArrayTuple data{
+            {1024*1024, ints},
+            {7, bigs}
+        };
+
+        CORRADE_COMPARE(data.size(),
+            sizeof(void*) +         /* destructible item count */
+            2*(4*sizeof(void*)) +   /* one destructible item + deleter */
+            1024*1024*4 +           /* ints */
+            7*sizeof(Big)           /* bigs */
+        );
+        CORRADE_COMPARE(static_cast<void*>(ints.data()), data.data() +
+            sizeof(void*) + 2*(4*sizeof(void*)));
+        CORRADE_VERIFY(data.deleter());
+
+        /* Trivial types are zero-init'd, nontrivial had their constructor
+           called */
+        CORRADE_COMPARE(ints[0], 0);
+        CORRADE_COMPARE(ints[1024*1024 - 1], 0);
+        CORRADE_COMPARE(Big::constructed, 7);
+        CORRADE_COMPARE(Big::destructed, 0);
+    }
+
+    /* The destructors were called and the memory freed (which is checked by
+       sanitizers) */
+    CORRADE_COMPARE(Big::constructed, 7);
+    CORRADE_COMPARE(Big::destructed, 7);
+}
+
+template<bool zeroFilled> struct ZeroFilledAllocator {
+    enum: bool { ZeroFilled = zeroFilled };
+
+    std::pair<char*, void(*)(char*, std::size_t)> operator()(std::size_t size, std::size_t) const {
+        CORRADE_INTERNAL_ASSERT(size <= 256);
+        return {memory, [](char*, std::size_t) {}};
+    }
+
+    char* memory;
+};
+
+void ArrayTupleTest::constructValueInitZeroFilledAllocator() {
+    /* The memory isn't actually zero-filled, in order to verify that the
+       zero-fill is skipped for trivial types if the allocator says so */
+    alignas(16) char preallocated[256];
+
+    {
+        std::memset(preallocated, 0xcd, sizeof(preallocated));
+        Big::constructed = Big::destructed = 0;
+
+        ArrayView<int> ints;
+        ArrayView<Big> bigs;
+        ArrayView<char> chars;
+        ArrayTuple data{
+            {{Corrade::ValueInit, 3, ints},
+             {Corrade::ValueInit, 2, bigs},
+             {Corrade::ValueInit, 13, chars}},
+            ZeroFilledAllocator<true>{preallocated}
+        };
+        CORRADE_COMPARE(ints.size(), 3);
+        CORRADE_COMPARE(chars.size(), 13);
+
+        /* Trivial types are left untouched */
+        for(int i: ints) CORRADE_COMPARE(i, int(0xcdcdcdcd));
+        for(char i: chars) CORRADE_COMPARE(i, char(0xcd));
+
+        /* Non-trivial types still get constructed */
+        CORRADE_COMPARE(bigs.size(), 2);
+        CORRADE_COMPARE(Big::constructed, 2);
+    }
+
+    /* And destructed again */
+    CORRADE_COMPARE(Big::destructed, 2);
+
+    /* The allocator has to report true, not just have the member */
+    {
+        std::memset(preallocated, 0xcd, sizeof(preallocated));
+
+        ArrayView<int> ints;
+        ArrayView<char> chars;
+        ArrayTuple data{
+            {{Corrade::ValueInit, 3, ints},
+             {Corrade::ValueInit, 13, chars}},
+            ZeroFilledAllocator<false>{preallocated}
+        };
+        CORRADE_COMPARE(ints.size(), 3);
+        CORRADE_COMPARE(chars.size(), 13);
+
+        for(int i: ints) CORRADE_COMPARE(i, 0);
+        for(char i: chars) CORRADE_COMPARE(i, 0);
+    }
+}
+
 void ArrayTupleTest::allocatorAlignmentEmpty() {
     std::size_t alignmentRequirement = ~std::size_t{};
 
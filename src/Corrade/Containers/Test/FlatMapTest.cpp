@@ -0,0 +1,435 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Corrade/Containers/FlatMap.h"
+#include "Corrade/Containers/String.h"
+#include "Corrade/Containers/StringView.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/Utility/DebugStl.h" /** @todo remove when <sstream> is gone */
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct FlatMapTest: TestSuite::Tester {
+    explicit FlatMapTest();
+
+    void constructDefault();
+    void construct();
+    void constructSorted();
+    void constructNonTrivial();
+    void constructDifferentSize();
+    void constructDuplicateKey();
+    void constructCopy();
+    void constructMove();
+
+    void lowerBound();
+    void find();
+    void findHeterogeneous();
+    void access();
+    void accessNotFound();
+
+    void setConstructDefault();
+    void setConstruct();
+    void setConstructSorted();
+    void setConstructDuplicates();
+    void setConstructNonTrivial();
+    void setConstructCopy();
+    void setConstructMove();
+    void setLowerBound();
+    void setFind();
+    void setFindHeterogeneous();
+};
+
+using namespace Literals;
+
+FlatMapTest::FlatMapTest() {
+    addTests({&FlatMapTest::constructDefault,
+              &FlatMapTest::construct,
+              &FlatMapTest::constructSorted,
+              &FlatMapTest::constructNonTrivial,
+              &FlatMapTest::constructDifferentSize,
+              &FlatMapTest::constructDuplicateKey,
+              &FlatMapTest::constructCopy,
+              &FlatMapTest::constructMove,
+
+              &FlatMapTest::lowerBound,
+              &FlatMapTest::find,
+              &FlatMapTest::findHeterogeneous,
+              &FlatMapTest::access,
+              &FlatMapTest::accessNotFound,
+
+              &FlatMapTest::setConstructDefault,
+              &FlatMapTest::setConstruct,
+              &FlatMapTest::setConstructSorted,
+              &FlatMapTest::setConstructDuplicates,
+              &FlatMapTest::setConstructNonTrivial,
+              &FlatMapTest::setConstructCopy,
+              &FlatMapTest::setConstructMove,
+              &FlatMapTest::setLowerBound,
+              &FlatMapTest::setFind,
+              &FlatMapTest::setFindHeterogeneous});
+}
+
+void FlatMapTest::constructDefault() {
+    FlatMap<int, float> a;
+    const FlatMap<int, float>& ca = a;
+    CORRADE_VERIFY(a.empty());
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_VERIFY(a.keys().empty());
+    CORRADE_VERIFY(a.values().empty());
+    CORRADE_VERIFY(ca.values().empty());
+    CORRADE_COMPARE(a.lowerBound(3), 0);
+    CORRADE_VERIFY(!a.contains(3));
+    CORRADE_VERIFY(!a.find(3));
+    CORRADE_VERIFY(!ca.find(3));
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<FlatMap<int, float>>::value);
+}
+
+void FlatMapTest::construct() {
+    Array<int> keys{Corrade::InPlaceInit, {7, -3, 15, 0, 2}};
+    Array<float> values{Corrade::InPlaceInit, {0.7f, -0.3f, 1.5f, 0.0f, 0.2f}};
+    FlatMap<int, float> a{Utility::move(keys), Utility::move(values)};
+    CORRADE_VERIFY(!a.empty());
+    CORRADE_COMPARE(a.size(), 5);
+    CORRADE_COMPARE_AS(a.keys(), arrayView({-3, 0, 2, 7, 15}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(a.values(), arrayView({-0.3f, 0.0f, 0.2f, 0.7f, 1.5f}),
+        TestSuite::Compare::Container);
+}
+
+void FlatMapTest::constructSorted() {
+    Array<int> keys{Corrade::InPlaceInit, {-3, 0, 2, 7, 15}};
+    Array<float> values{Corrade::InPlaceInit, {-0.3f, 0.0f, 0.2f, 0.7f, 1.5f}};
+    const int* keyData = keys.data();
+    const float* valueData = values.data();
+
+    /* The arrays should get taken over without a reallocation */
+    FlatMap<int, float> a{Utility::move(keys), Utility::move(values)};
+    CORRADE_COMPARE(a.keys().data(), keyData);
+    CORRADE_COMPARE(a.values().data(), valueData);
+    CORRADE_COMPARE_AS(a.keys(), arrayView({-3, 0, 2, 7, 15}),
+        TestSuite::Compare::Container);
+}
+
+void FlatMapTest::constructNonTrivial() {
+    /* Using strings long enough to not be stored inline so the test verifies
+       they get moved and not copied */
+    Array<String> keys{3};
+    keys[0] = "a key that's definitely not going to fit into SSO"_s;
+    keys[1] = "another key that's also too long for a SSO"_s;
+    keys[2] = "a different key that's way too long for a SSO"_s;
+    Array<String> values{3};
+    values[0] = "a value that's definitely not going to fit into SSO"_s;
+    values[1] = "another value that's also too long for a SSO"_s;
+    values[2] = "a different value that's way too long for a SSO"_s;
+    const char* keyData = keys[1].data();
+    const char* valueData = values[1].data();
+
+    FlatMap<String, String> a{Utility::move(keys), Utility::move(values)};
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a.keys()[0], "a different key that's way too long for a SSO");
+    CORRADE_COMPARE(a.keys()[1], "a key that's definitely not going to fit into SSO");
+    CORRADE_COMPARE(a.keys()[2], "another key that's also too long for a SSO");
+    CORRADE_COMPARE(a.values()[0], "a different value that's way too long for a SSO");
+    CORRADE_COMPARE(a.values()[1], "a value that's definitely not going to fit into SSO");
+    CORRADE_COMPARE(a.values()[2], "another value that's also too long for a SSO");
+    CORRADE_COMPARE(a.keys()[2].data(), keyData);
+    CORRADE_COMPARE(a.values()[2].data(), valueData);
+}
+
+void FlatMapTest::constructDifferentSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    FlatMap<int, float>{Array<int>{3}, Array<float>{2}};
+    CORRADE_COMPARE(out.str(), "Containers::FlatMap: expected key and value arrays to have the same size but got 3 and 2\n");
+}
+
+void FlatMapTest::constructDuplicateKey() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    FlatMap<int, float>{Array<int>{Corrade::InPlaceInit, {3, 7, 1, 7}}, Array<float>{4}};
+    CORRADE_COMPARE(out.str(), "Containers::FlatMap: duplicate key at input indices 1 and 3\n");
+}
+
+void FlatMapTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<FlatMap<int, float>>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<FlatMap<int, float>>{});
+}
+
+void FlatMapTest::constructMove() {
+    FlatMap<int, float> a{Array<int>{Corrade::InPlaceInit, {3, 1}}, Array<float>{Corrade::InPlaceInit, {0.3f, 0.1f}}};
+    const int* keyData = a.keys().data();
+
+    FlatMap<int, float> b = Utility::move(a);
+    CORRADE_VERIFY(a.empty());
+    CORRADE_COMPARE(b.size(), 2);
+    CORRADE_COMPARE(b.keys().data(), keyData);
+
+    FlatMap<int, float> c;
+    c = Utility::move(b);
+    CORRADE_COMPARE(c.size(), 2);
+    CORRADE_COMPARE(c.keys().data(), keyData);
+    CORRADE_COMPARE(c.values()[1], 0.3f);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<FlatMap<int, float>>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<FlatMap<int, float>>::value);
+}
+
+void FlatMapTest::lowerBound() {
+    /* Verify against a linear search for all sizes up to some count, as the
+       search loop runs a different number of iterations for each */
+    for(std::size_t size = 0; size != 18; ++size) {
+        CORRADE_ITERATION(size);
+
+        Array<int> keys{Corrade::NoInit, size};
+        Array<int> values{Corrade::NoInit, size};
+        for(std::size_t i = 0; i != size; ++i)
+            keys[i] = values[i] = int(i*2);
+        FlatMap<int, int> a{Utility::move(keys), Utility::move(values)};
+
+        for(int key = -1; key <= int(size*2); ++key) {
+            std::size_t expected = 0;
+            while(expected != size && a.keys()[expected] < key) ++expected;
+            CORRADE_COMPARE(a.lowerBound(key), expected);
+        }
+    }
+}
+
+void FlatMapTest::find() {
+    FlatMap<int, float> a{Array<int>{Corrade::InPlaceInit, {7, -3, 15, 0, 2}},
+                          Array<float>{Corrade::InPlaceInit, {0.7f, -0.3f, 1.5f, 0.0f, 0.2f}}};
+    const FlatMap<int, float>& ca = a;
+
+    CORRADE_VERIFY(a.contains(15));
+    CORRADE_VERIFY(a.contains(-3));
+    CORRADE_VERIFY(!a.contains(1));
+    CORRADE_VERIFY(!a.contains(-4));
+    CORRADE_VERIFY(!a.contains(16));
+
+    float* found = a.find(2);
+    CORRADE_VERIFY(found);
+    CORRADE_COMPARE(*found, 0.2f);
+    CORRADE_COMPARE(found, a.values() + 2);
+    const float* cfound = ca.find(15);
+    CORRADE_VERIFY(cfound);
+    CORRADE_COMPARE(*cfound, 1.5f);
+    CORRADE_VERIFY(!a.find(1));
+    CORRADE_VERIFY(!ca.find(16));
+
+    /* Values are mutable through the lookup */
+    *a.find(0) = 3.5f;
+    CORRADE_COMPARE(a.values()[1], 3.5f);
+}
+
+void FlatMapTest::findHeterogeneous() {
+    Array<String> keys{Corrade::InPlaceInit, {"hello", "world", "this", "is"}};
+    FlatMap<String, int> a{Utility::move(keys), Array<int>{Corrade::InPlaceInit, {0, 1, 2, 3}}};
+
+    /* Lookup with a view and with a literal shouldn't need a temporary
+       String */
+    CORRADE_VERIFY(a.contains("world"_s));
+    CORRADE_VERIFY(a.contains("is"));
+    CORRADE_VERIFY(!a.contains("i"_s));
+    CORRADE_VERIFY(!a.contains("zebra"));
+    CORRADE_COMPARE(a.lowerBound("this"_s), 2);
+    CORRADE_COMPARE(a["hello"_s], 0);
+    CORRADE_COMPARE(a["this"], 2);
+}
+
+void FlatMapTest::access() {
+    FlatMap<int, float> a{Array<int>{Corrade::InPlaceInit, {7, -3, 15}},
+                          Array<float>{Corrade::InPlaceInit, {0.7f, -0.3f, 1.5f}}};
+    const FlatMap<int, float>& ca = a;
+
+    CORRADE_COMPARE(a[7], 0.7f);
+    CORRADE_COMPARE(ca[-3], -0.3f);
+
+    a[15] = 3.5f;
+    CORRADE_COMPARE(ca[15], 3.5f);
+}
+
+void FlatMapTest::accessNotFound() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FlatMap<int, float> a{Array<int>{Corrade::InPlaceInit, {7, -3, 15}},
+                          Array<float>{Corrade::InPlaceInit, {0.7f, -0.3f, 1.5f}}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    a[8];
+    CORRADE_COMPARE(out.str(), "Containers::FlatMap::operator[](): key not found\n");
+}
+
+void FlatMapTest::setConstructDefault() {
+    FlatSet<int> a;
+    CORRADE_VERIFY(a.empty());
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_VERIFY(a.keys().empty());
+    CORRADE_VERIFY(a.begin() == a.end());
+    CORRADE_COMPARE(a.lowerBound(3), 0);
+    CORRADE_VERIFY(!a.contains(3));
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<FlatSet<int>>::value);
+}
+
+void FlatMapTest::setConstruct() {
+    FlatSet<int> a{Array<int>{Corrade::InPlaceInit, {7, -3, 15, 0, 2}}};
+    CORRADE_VERIFY(!a.empty());
+    CORRADE_COMPARE(a.size(), 5);
+    CORRADE_COMPARE_AS(a.keys(), arrayView({-3, 0, 2, 7, 15}),
+        TestSuite::Compare::Container);
+
+    int sum = 0;
+    for(int i: a) sum = sum*2 + i;
+    CORRADE_COMPARE(sum, (((-3*2 + 0)*2 + 2)*2 + 7)*2 + 15);
+    CORRADE_COMPARE(a.cbegin(), a.begin());
+    CORRADE_COMPARE(a.cend(), a.end());
+}
+
+void FlatMapTest::setConstructSorted() {
+    Array<int> keys{Corrade::InPlaceInit, {-3, 0, 2, 7, 15}};
+    const int* keyData = keys.data();
+
+    FlatSet<int> a{Utility::move(keys)};
+    CORRADE_COMPARE(a.keys().data(), keyData);
+    CORRADE_COMPARE_AS(a.keys(), arrayView({-3, 0, 2, 7, 15}),
+        TestSuite::Compare::Container);
+}
+
+void FlatMapTest::setConstructDuplicates() {
+    FlatSet<int> a{Array<int>{Corrade::InPlaceInit, {7, -3, 7, 15, -3, -3, 2}}};
+    CORRADE_COMPARE_AS(a.keys(), arrayView({-3, 2, 7, 15}),
+        TestSuite::Compare::Container);
+
+    /* Sorted but with duplicates, has to be reallocated */
+    Array<int> sorted{Corrade::InPlaceInit, {1, 1, 2}};
+    const int* sortedData = sorted.data();
+    FlatSet<int> b{Utility::move(sorted)};
+    CORRADE_VERIFY(b.keys().data() != sortedData);
+    CORRADE_COMPARE_AS(b.keys(), arrayView({1, 2}),
+        TestSuite::Compare::Container);
+}
+
+void FlatMapTest::setConstructNonTrivial() {
+    Array<String> keys{4};
+    keys[0] = "a key that's definitely not going to fit into SSO"_s;
+    keys[1] = "another key that's also too long for a SSO"_s;
+    keys[2] = "a key that's definitely not going to fit into SSO"_s;
+    keys[3] = "a different key that's way too long for a SSO"_s;
+    /* The first occurence is kept */
+    const char* keyData = keys[0].data();
+
+    FlatSet<String> a{Utility::move(keys)};
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a.keys()[0], "a different key that's way too long for a SSO");
+    CORRADE_COMPARE(a.keys()[1], "a key that's definitely not going to fit into SSO");
+    CORRADE_COMPARE(a.keys()[2], "another key that's also too long for a SSO");
+    CORRADE_COMPARE(a.keys()[1].data(), keyData);
+}
+
+void FlatMapTest::setConstructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<FlatSet<int>>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<FlatSet<int>>{});
+}
+
+void FlatMapTest::setConstructMove() {
+    FlatSet<int> a{Array<int>{Corrade::InPlaceInit, {3, 1}}};
+    const int* keyData = a.keys().data();
+
+    FlatSet<int> b = Utility::move(a);
+    CORRADE_VERIFY(a.empty());
+    CORRADE_COMPARE(b.keys().data(), keyData);
+
+    FlatSet<int> c;
+    c = Utility::move(b);
+    CORRADE_COMPARE(c.keys().data(), keyData);
+    CORRADE_COMPARE(c.keys()[1], 3);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<FlatSet<int>>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<FlatSet<int>>::value);
+}
+
+void FlatMapTest::setLowerBound() {
+    for(std::size_t size = 0; size != 18; ++size) {
+        CORRADE_ITERATION(size);
+
+        Array<int> keys{Corrade::NoInit, size};
+        for(std::size_t i = 0; i != size; ++i)
+            keys[i] = int(i*2);
+        FlatSet<int> a{Utility::move(keys)};
+
+        for(int key = -1; key <= int(size*2); ++key) {
+            std::size_t expected = 0;
+            while(expected != size && a.keys()[expected] < key) ++expected;
+            CORRADE_COMPARE(a.lowerBound(key), expected);
+        }
+    }
+}
+
+void FlatMapTest::setFind() {
+    FlatSet<int> a{Array<int>{Corrade::InPlaceInit, {7, -3, 15, 0, 2}}};
+
+    CORRADE_VERIFY(a.contains(15));
+    CORRADE_VERIFY(a.contains(-3));
+    CORRADE_VERIFY(!a.contains(1));
+    CORRADE_VERIFY(!a.contains(-4));
+    CORRADE_VERIFY(!a.contains(16));
+
+    const int* found = a.find(7);
+    CORRADE_VERIFY(found);
+    CORRADE_COMPARE(found, a.begin() + 3);
+    CORRADE_VERIFY(!a.find(8));
+}
+
+void FlatMapTest::setFindHeterogeneous() {
+    FlatSet<String> a{Array<String>{Corrade::InPlaceInit, {"hello", "world", "this", "is"}}};
+
+    CORRADE_VERIFY(a.contains("world"_s));
+    CORRADE_VERIFY(a.contains("is"));
+    CORRADE_VERIFY(!a.contains("i"_s));
+    CORRADE_VERIFY(!a.contains("zebra"));
+    CORRADE_COMPARE(a.lowerBound("this"_s), 2);
+    const String* found = a.find("hello"_s);
+    CORRADE_VERIFY(found);
+    CORRADE_COMPARE(*found, "hello");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::FlatMapTest)
@@ -87,6 +87,7 @@ struct GrowableArrayTest: TestSuite::Tester {
     template<class T> void resizeNoInit();
     template<class T> void resizeDefaultInit();
     template<class T> void resizeValueInit();
+    void resizeValueInitLarge();
     void resizeDirectInit();
 
     template<class T, class Init> void resizeFromNonGrowableToLess();
@@ -255,6 +256,7 @@ GrowableArrayTest::GrowableArrayTest() {
               &GrowableArrayTest::resizeDefaultInit<Movable>,
               &GrowableArrayTest::resizeValueInit<int>,
               &GrowableArrayTest::resizeValueInit<Movable>,
+              &GrowableArrayTest::resizeValueInitLarge,
               &GrowableArrayTest::resizeDirectInit,
 
               &GrowableArrayTest::resizeFromNonGrowableToLess<int, Corrade::NoInitT>,
@@ -854,6 +856,43 @@ template<class T> void GrowableArrayTest::resizeValueInit() {
     VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<T>);
 }
 
+void GrowableArrayTest::resizeValueInitLarge() {
+    /* A non-growable array gets reallocated with calloc() if the new part is
+       above the threshold, the original contents should be preserved and the
+       rest zeroed */
+    Array<int> a{Corrade::InPlaceInit, {1, 2, 3}};
+    CORRADE_VERIFY(!arrayIsGrowable(a));
+    arrayResize(a, Corrade::ValueInit, 1024*1024);
+    CORRADE_VERIFY(arrayIsGrowable(a));
+    CORRADE_COMPARE(a.size(), 1024*1024);
+    CORRADE_COMPARE(arrayCapacity(a), 1024*1024);
+    CORRADE_COMPARE(a[0], 1);
+    CORRADE_COMPARE(a[1], 2);
+    CORRADE_COMPARE(a[2], 3);
+    CORRADE_COMPARE(a[3], 0);
+    CORRADE_COMPARE(a[512*1024], 0);
+    CORRADE_COMPARE(a[1024*1024 - 1], 0);
+    VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<int>);
+
+    /* Growing it further goes through the usual reallocation path */
+    arrayResize(a, Corrade::ValueInit, 2*1024*1024);
+    CORRADE_COMPARE(a.size(), 2*1024*1024);
+    CORRADE_COMPARE(a[2], 3);
+    CORRADE_COMPARE(a[1024*1024], 0);
+    CORRADE_COMPARE(a[2*1024*1024 - 1], 0);
+    VERIFY_SANITIZED_PROPERLY(a, ArrayAllocator<int>);
+
+    /* Resizing an empty array is the way to get a large lazily zeroed
+       allocation from scratch */
+    Array<int> b;
+    arrayResize(b, Corrade::ValueInit, 1024*1024);
+    CORRADE_VERIFY(arrayIsGrowable(b));
+    CORRADE_COMPARE(b.size(), 1024*1024);
+    CORRADE_COMPARE(b[0], 0);
+    CORRADE_COMPARE(b[1024*1024 - 1], 0);
+    VERIFY_SANITIZED_PROPERLY(b, ArrayAllocator<int>);
+}
+
 void GrowableArrayTest::resizeDirectInit() {
     /* This doesn't have any special handling for trivial/non-trivial types, no
        need to test twice */
@@ -1785,6 +1824,8 @@ void GrowableArrayTest::explicitAllocatorParameter() {
         Containers::ArrayView<int> view = arrayAppend<ArrayNewAllocator>(a, {8, 9, 10});
         CORRADE_COMPARE(view.size(), 3);
         CORRADE_COMPARE(view[2], 10);
+        /* The allocator should be propagated through the list overload */
+        CORRADE_VERIFY(arrayIsGrowable<ArrayNewAllocator>(a));
     } {
         const int values[]{11, 12, 13};
         Containers::ArrayView<int> view = arrayAppend<ArrayNewAllocator>(a, arrayView(values));
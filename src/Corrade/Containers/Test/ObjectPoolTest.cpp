@@ -0,0 +1,566 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+
+#include "Corrade/Containers/LinkedList.h"
+#include "Corrade/Containers/ObjectPool.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/DebugStl.h" /** @todo remove when <sstream> is gone */
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct ObjectPoolTest: TestSuite::Tester {
+    explicit ObjectPoolTest();
+
+    void resetCounters();
+
+    void construct();
+    void constructSmallObject();
+    void constructInvalid();
+
+    void allocateDeallocate();
+    void allocateAligned();
+    void allocateNewSlab();
+    void deallocateNullptr();
+    void allocateCacheRefillFlush();
+    void allocateMultithreaded();
+    void allocateMultithreadedNoCacheLeft();
+
+    void pointerConstructDefault();
+    void pointerConstructInPlace();
+    void pointerConstructMake();
+    void pointerConstructTooLarge();
+    void pointerConstructMove();
+    void pointerAccessInvalid();
+    void pointerReset();
+    void pointerRelease();
+
+    void allocatedLinkedList();
+    void allocatedSubclass();
+};
+
+struct Immovable {
+    static int constructed;
+    static int destructed;
+
+    explicit Immovable(int a = 0) noexcept: a{a} { ++constructed; }
+    Immovable(const Immovable&) = delete;
+    Immovable(Immovable&&) = delete;
+    ~Immovable() { ++destructed; }
+    Immovable& operator=(const Immovable&) = delete;
+    Immovable& operator=(Immovable&&) = delete;
+
+    int a;
+};
+
+int Immovable::constructed = 0;
+int Immovable::destructed = 0;
+
+ObjectPoolTest::ObjectPoolTest() {
+    addTests({&ObjectPoolTest::construct,
+              &ObjectPoolTest::constructSmallObject,
+              &ObjectPoolTest::constructInvalid,
+
+              &ObjectPoolTest::allocateDeallocate,
+              &ObjectPoolTest::allocateAligned,
+              &ObjectPoolTest::allocateNewSlab,
+              &ObjectPoolTest::deallocateNullptr,
+              &ObjectPoolTest::allocateCacheRefillFlush,
+              &ObjectPoolTest::allocateMultithreaded,
+              &ObjectPoolTest::allocateMultithreadedNoCacheLeft});
+
+    addTests({&ObjectPoolTest::pointerConstructDefault,
+              &ObjectPoolTest::pointerConstructInPlace,
+              &ObjectPoolTest::pointerConstructMake,
+              &ObjectPoolTest::pointerConstructTooLarge,
+              &ObjectPoolTest::pointerConstructMove,
+              &ObjectPoolTest::pointerAccessInvalid,
+              &ObjectPoolTest::pointerReset,
+              &ObjectPoolTest::pointerRelease}, &ObjectPoolTest::resetCounters, &ObjectPoolTest::resetCounters);
+
+    addTests({&ObjectPoolTest::allocatedLinkedList,
+              &ObjectPoolTest::allocatedSubclass});
+}
+
+void ObjectPoolTest::resetCounters() {
+    Immovable::constructed = Immovable::destructed = 0;
+}
+
+void ObjectPoolTest::construct() {
+    ObjectPool pool{24, 8, 16};
+    CORRADE_COMPARE(pool.objectSize(), 24);
+    CORRADE_COMPARE(pool.objectAlignment(), 8);
+    CORRADE_COMPARE(pool.slabObjectCount(), 16);
+    /* Nothing allocated upfront */
+    CORRADE_COMPARE(pool.slabCount(), 0);
+    CORRADE_COMPARE(pool.objectCount(), 0);
+
+    CORRADE_VERIFY(!std::is_copy_constructible<ObjectPool>{});
+    CORRADE_VERIFY(!std::is_move_constructible<ObjectPool>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<ObjectPool>{});
+    CORRADE_VERIFY(!std::is_move_assignable<ObjectPool>{});
+}
+
+void ObjectPoolTest::constructSmallObject() {
+    /* The free list needs a pointer in each object, so size and alignment
+       gets adjusted for that but the reported size is kept */
+    ObjectPool pool{1, 1};
+    CORRADE_COMPARE(pool.objectSize(), 1);
+    CORRADE_COMPARE(pool.objectAlignment(), alignof(void*));
+
+    void* a = pool.allocate();
+    void* b = pool.allocate();
+    CORRADE_COMPARE(reinterpret_cast<std::size_t>(a) % alignof(void*), 0);
+    CORRADE_COMPARE(reinterpret_cast<std::size_t>(b) % alignof(void*), 0);
+    CORRADE_VERIFY(a != b);
+    pool.deallocate(a);
+    pool.deallocate(b);
+}
+
+void ObjectPoolTest::constructInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        ObjectPool{0, 4};
+        ObjectPool{4, 3};
+        ObjectPool{4, 4, 0};
+    }
+    CORRADE_COMPARE(out.str(),
+        "Containers::ObjectPool: object size expected to be non-zero\n"
+        "Containers::ObjectPool: object alignment expected to be a power of two but got 3\n"
+        "Containers::ObjectPool: slab object count expected to be non-zero\n");
+}
+
+void ObjectPoolTest::allocateDeallocate() {
+    ObjectPool pool{sizeof(int), alignof(int), 4};
+
+    int* a = static_cast<int*>(pool.allocate());
+    int* b = static_cast<int*>(pool.allocate());
+    CORRADE_VERIFY(a);
+    CORRADE_VERIFY(b);
+    CORRADE_VERIFY(a != b);
+    CORRADE_COMPARE(pool.slabCount(), 1);
+    CORRADE_COMPARE(pool.objectCount(), 2);
+
+    /* Objects from the same slab are next to each other */
+    CORRADE_COMPARE(b - a, sizeof(void*)/sizeof(int));
+
+    *a = 3;
+    *b = 5;
+    CORRADE_COMPARE(*a, 3);
+    CORRADE_COMPARE(*b, 5);
+
+    pool.deallocate(a);
+    CORRADE_COMPARE(pool.objectCount(), 1);
+
+    /* The most recently deallocated object gets reused first */
+    int* c = static_cast<int*>(pool.allocate());
+    CORRADE_COMPARE(c, a);
+    CORRADE_COMPARE(pool.slabCount(), 1);
+    CORRADE_COMPARE(pool.objectCount(), 2);
+
+    pool.deallocate(b);
+    pool.deallocate(c);
+    CORRADE_COMPARE(pool.objectCount(), 0);
+    CORRADE_COMPARE(pool.slabCount(), 1);
+}
+
+void ObjectPoolTest::allocateAligned() {
+    ObjectPool pool{24, 64, 3};
+
+    void* objects[7];
+    for(void*& i: objects) {
+        i = pool.allocate();
+        CORRADE_COMPARE(reinterpret_cast<std::size_t>(i) % 64, 0);
+    }
+    CORRADE_COMPARE(pool.slabCount(), 3);
+
+    for(void* i: objects) pool.deallocate(i);
+}
+
+void ObjectPoolTest::allocateNewSlab() {
+    ObjectPool pool{16, 8, 2};
+
+    void* a = pool.allocate();
+    void* b = pool.allocate();
+    CORRADE_COMPARE(pool.slabCount(), 1);
+
+    void* c = pool.allocate();
+    CORRADE_VERIFY(c != a);
+    CORRADE_VERIFY(c != b);
+    CORRADE_COMPARE(pool.slabCount(), 2);
+    CORRADE_COMPARE(pool.objectCount(), 3);
+
+    /* Deallocating doesn't release the slabs */
+    pool.deallocate(a);
+    pool.deallocate(b);
+    pool.deallocate(c);
+    CORRADE_COMPARE(pool.slabCount(), 2);
+    CORRADE_COMPARE(pool.objectCount(), 0);
+}
+
+void ObjectPoolTest::deallocateNullptr() {
+    ObjectPool pool{16, 8};
+    pool.deallocate(nullptr);
+    CORRADE_COMPARE(pool.objectCount(), 0);
+}
+
+void ObjectPoolTest::allocateCacheRefillFlush() {
+    ObjectPool pool{16, 8, 4};
+
+    /* Three slabs worth of objects */
+    void* objects[12];
+    for(void*& i: objects) i = pool.allocate();
+    CORRADE_COMPARE(pool.slabCount(), 3);
+    CORRADE_COMPARE(pool.objectCount(), 12);
+
+    /* Deallocating all of them fills the thread cache up to two slabs worth
+       of objects, which then gives one slab worth back, and then again */
+    for(void* i: objects) pool.deallocate(i);
+    CORRADE_COMPARE(pool.slabCount(), 3);
+    CORRADE_COMPARE(pool.objectCount(), 0);
+
+    /* Allocating the same amount again takes the objects from the cache and
+       then refills it from what was given back, without any new slab */
+    void* objects2[12];
+    for(void*& i: objects2) i = pool.allocate();
+    CORRADE_COMPARE(pool.slabCount(), 3);
+    CORRADE_COMPARE(pool.objectCount(), 12);
+
+    /* All objects are distinct */
+    std::sort(objects, objects + 12);
+    std::sort(objects2, objects2 + 12);
+    CORRADE_VERIFY(std::unique(objects2, objects2 + 12) == objects2 + 12);
+    CORRADE_VERIFY(std::equal(objects, objects + 12, objects2));
+
+    /* One more needs a new slab */
+    void* another = pool.allocate();
+    CORRADE_COMPARE(pool.slabCount(), 4);
+
+    pool.deallocate(another);
+    for(void* i: objects2) pool.deallocate(i);
+    CORRADE_COMPARE(pool.objectCount(), 0);
+}
+
+void ObjectPoolTest::allocateMultithreaded() {
+    #if !defined(CORRADE_BUILD_MULTITHREADED) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_SKIP("CORRADE_BUILD_MULTITHREADED not enabled or threads not available");
+    #else
+    ObjectPool pool{sizeof(std::size_t), alignof(std::size_t), 16};
+
+    /* Each thread allocates objects, fills them with its own index and
+       deallocates every other in the end. Everything that's left gets
+       deallocated from the main thread. */
+    constexpr std::size_t ThreadCount = 4;
+    constexpr std::size_t ObjectCount = 1000;
+    std::size_t* objects[ThreadCount][ObjectCount];
+    bool corrupted[ThreadCount]{};
+    std::thread threads[ThreadCount];
+    for(std::size_t t = 0; t != ThreadCount; ++t) threads[t] = std::thread{[&, t]{
+        for(std::size_t i = 0; i != ObjectCount; ++i) {
+            objects[t][i] = static_cast<std::size_t*>(pool.allocate());
+            *objects[t][i] = t;
+        }
+        for(std::size_t i = 0; i != ObjectCount; ++i)
+            if(*objects[t][i] != t) corrupted[t] = true;
+        for(std::size_t i = 0; i < ObjectCount; i += 2)
+            pool.deallocate(objects[t][i]);
+    }};
+    for(std::thread& thread: threads) thread.join();
+
+    for(std::size_t t = 0; t != ThreadCount; ++t) {
+        CORRADE_ITERATION(t);
+        CORRADE_VERIFY(!corrupted[t]);
+    }
+    CORRADE_COMPARE(pool.objectCount(), ThreadCount*ObjectCount/2);
+
+    for(std::size_t t = 0; t != ThreadCount; ++t)
+        for(std::size_t i = 1; i < ObjectCount; i += 2)
+            pool.deallocate(objects[t][i]);
+    CORRADE_COMPARE(pool.objectCount(), 0);
+    #endif
+}
+
+void ObjectPoolTest::allocateMultithreadedNoCacheLeft() {
+    #if !defined(CORRADE_BUILD_MULTITHREADED) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_SKIP("CORRADE_BUILD_MULTITHREADED not enabled or threads not available");
+    #else
+    ObjectPool pool{sizeof(std::size_t), alignof(std::size_t), 4};
+
+    /* Caches stay with the threads that claimed them even after they exit,
+       so with enough threads the later ones have to use the shards directly.
+       There's at most 128 caches. */
+    constexpr std::size_t ThreadCount = 130;
+    constexpr std::size_t ObjectCount = 10;
+    std::size_t* objects[ThreadCount][ObjectCount];
+    bool corrupted[ThreadCount]{};
+    for(std::size_t t = 0; t != ThreadCount; ++t) std::thread{[&, t]{
+        for(std::size_t i = 0; i != ObjectCount; ++i) {
+            objects[t][i] = static_cast<std::size_t*>(pool.allocate());
+            *objects[t][i] = t;
+        }
+        for(std::size_t i = 0; i != ObjectCount; ++i)
+            if(*objects[t][i] != t) corrupted[t] = true;
+        for(std::size_t i = 0; i < ObjectCount; i += 2)
+            pool.deallocate(objects[t][i]);
+    }}.join();
+
+    for(std::size_t t = 0; t != ThreadCount; ++t) {
+        CORRADE_ITERATION(t);
+        CORRADE_VERIFY(!corrupted[t]);
+    }
+    CORRADE_COMPARE(pool.objectCount(), ThreadCount*ObjectCount/2);
+
+    for(std::size_t t = 0; t != ThreadCount; ++t)
+        for(std::size_t i = 1; i < ObjectCount; i += 2)
+            pool.deallocate(objects[t][i]);
+    CORRADE_COMPARE(pool.objectCount(), 0);
+    #endif
+}
+
+void ObjectPoolTest::pointerConstructDefault() {
+    PoolPointer<Immovable> a;
+    PoolPointer<Immovable> b = nullptr;
+    CORRADE_VERIFY(!a);
+    CORRADE_VERIFY(!b);
+    CORRADE_VERIFY(a == nullptr);
+    CORRADE_VERIFY(nullptr == b);
+    CORRADE_VERIFY(!a.pool());
+    CORRADE_VERIFY(!b.get());
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<PoolPointer<Immovable>>::value);
+}
+
+void ObjectPoolTest::pointerConstructInPlace() {
+    ObjectPool pool{sizeof(Immovable), alignof(Immovable)};
+    {
+        PoolPointer<Immovable> a{Corrade::InPlaceInit, pool, 17};
+        CORRADE_VERIFY(a);
+        CORRADE_VERIFY(a != nullptr);
+        CORRADE_VERIFY(nullptr != a);
+        CORRADE_COMPARE(a.pool(), &pool);
+        CORRADE_COMPARE(a->a, 17);
+        CORRADE_COMPARE(Immovable::constructed, 1);
+        CORRADE_COMPARE(pool.objectCount(), 1);
+    }
+
+    CORRADE_COMPARE(Immovable::destructed, 1);
+    CORRADE_COMPARE(pool.objectCount(), 0);
+}
+
+void ObjectPoolTest::pointerConstructMake() {
+    /* A pool with a larger object size can be used for smaller types */
+    ObjectPool pool{64, 16};
+    {
+        PoolPointer<Immovable> a = poolPointer<Immovable>(pool);
+        PoolPointer<Immovable> b = poolPointer<Immovable>(pool, 5);
+        CORRADE_COMPARE(a->a, 0);
+        CORRADE_COMPARE(b->a, 5);
+        CORRADE_COMPARE(Immovable::constructed, 2);
+        CORRADE_COMPARE(pool.objectCount(), 2);
+    }
+
+    CORRADE_COMPARE(Immovable::destructed, 2);
+    CORRADE_COMPARE(pool.objectCount(), 0);
+}
+
+void ObjectPoolTest::pointerConstructTooLarge() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct alignas(16) Aligned { char a[16]; };
+    struct Large { char a[32]; };
+
+    ObjectPool pool{16, 8};
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        PoolPointer<Large> a{Corrade::InPlaceInit, pool};
+        PoolPointer<Aligned> b{Corrade::InPlaceInit, pool};
+        CORRADE_VERIFY(!a);
+        CORRADE_VERIFY(!b);
+    }
+    CORRADE_COMPARE(pool.objectCount(), 0);
+    CORRADE_COMPARE(out.str(),
+        "Containers::PoolPointer: can't fit a type of size 32 and alignment 1 into a pool of size 16 and alignment 8\n"
+        "Containers::PoolPointer: can't fit a type of size 16 and alignment 16 into a pool of size 16 and alignment 8\n");
+}
+
+void ObjectPoolTest::pointerConstructMove() {
+    ObjectPool pool{sizeof(Immovable), alignof(Immovable)};
+    {
+        PoolPointer<Immovable> a = poolPointer<Immovable>(pool, 3);
+        Immovable* pointer = a.get();
+
+        PoolPointer<Immovable> b = Utility::move(a);
+        CORRADE_VERIFY(!a);
+        CORRADE_COMPARE(b.get(), pointer);
+        CORRADE_COMPARE(b.pool(), &pool);
+
+        PoolPointer<Immovable> c = poolPointer<Immovable>(pool, 5);
+        c = Utility::move(b);
+        CORRADE_COMPARE(c.get(), pointer);
+        CORRADE_COMPARE(c->a, 3);
+        CORRADE_COMPARE(b->a, 5);
+        CORRADE_COMPARE(Immovable::constructed, 2);
+        CORRADE_COMPARE(Immovable::destructed, 0);
+    }
+
+    CORRADE_COMPARE(Immovable::destructed, 2);
+    CORRADE_COMPARE(pool.objectCount(), 0);
+
+    CORRADE_VERIFY(!std::is_copy_constructible<PoolPointer<Immovable>>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<PoolPointer<Immovable>>{});
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<PoolPointer<Immovable>>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<PoolPointer<Immovable>>::value);
+}
+
+void ObjectPoolTest::pointerAccessInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct Innocent {
+        void foo() const {}
+    };
+
+    PoolPointer<Innocent> a;
+    const PoolPointer<Innocent> ca;
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        a->foo();
+        ca->foo();
+        (*a).foo();
+        (*ca).foo();
+    }
+    CORRADE_COMPARE(out.str(),
+        "Containers::PoolPointer: the pointer is null\n"
+        "Containers::PoolPointer: the pointer is null\n"
+        "Containers::PoolPointer: the pointer is null\n"
+        "Containers::PoolPointer: the pointer is null\n");
+}
+
+void ObjectPoolTest::pointerReset() {
+    ObjectPool pool{sizeof(Immovable), alignof(Immovable)};
+
+    PoolPointer<Immovable> a = poolPointer<Immovable>(pool, 3);
+    CORRADE_COMPARE(pool.objectCount(), 1);
+
+    a.reset();
+    CORRADE_VERIFY(!a);
+    CORRADE_COMPARE(Immovable::destructed, 1);
+    CORRADE_COMPARE(pool.objectCount(), 0);
+
+    /* Resetting a null pointer is a no-op */
+    a.reset();
+    CORRADE_COMPARE(Immovable::destructed, 1);
+}
+
+void ObjectPoolTest::pointerRelease() {
+    ObjectPool pool{sizeof(Immovable), alignof(Immovable)};
+
+    Immovable* pointer;
+    {
+        PoolPointer<Immovable> a = poolPointer<Immovable>(pool, 3);
+        pointer = a.release();
+        CORRADE_VERIFY(!a);
+    }
+    CORRADE_COMPARE(Immovable::destructed, 0);
+    CORRADE_COMPARE(pool.objectCount(), 1);
+
+    /* Give it back to a pointer to clean up */
+    PoolPointer<Immovable>{pointer, pool};
+    CORRADE_COMPARE(Immovable::destructed, 1);
+    CORRADE_COMPARE(pool.objectCount(), 0);
+}
+
+struct Node: LinkedListItem<Node>, PoolAllocated<Node> {
+    explicit Node(int value): value{value} {}
+
+    int value;
+};
+
+void ObjectPoolTest::allocatedLinkedList() {
+    /* Other test cases might have left something in the global pool */
+    const std::size_t objectCount = Node::objectPool().objectCount();
+    CORRADE_COMPARE(Node::objectPool().objectSize(), sizeof(Node));
+    CORRADE_COMPARE(Node::objectPool().objectAlignment(), alignof(Node));
+
+    {
+        LinkedList<Node> list;
+        list.insert(new Node{1});
+        list.insert(new Node{2});
+        list.insert(new Node{3});
+        CORRADE_COMPARE(Node::objectPool().objectCount(), objectCount + 3);
+        CORRADE_COMPARE(list.first()->value, 1);
+        CORRADE_COMPARE(list.last()->value, 3);
+
+        /* Erasing an item returns it to the pool */
+        list.erase(list.first());
+        CORRADE_COMPARE(Node::objectPool().objectCount(), objectCount + 2);
+    }
+
+    /* And so does the list destructor */
+    CORRADE_COMPARE(Node::objectPool().objectCount(), objectCount);
+}
+
+struct LargerNode: Node {
+    explicit LargerNode(int value): Node{value} {}
+
+    char data[128];
+};
+
+void ObjectPoolTest::allocatedSubclass() {
+    const std::size_t objectCount = Node::objectPool().objectCount();
+
+    /* A subclass of a different size goes through the global allocator, but
+       it still works with the list, which deletes it through a base pointer */
+    {
+        LinkedList<Node> list;
+        list.insert(new LargerNode{1});
+        list.insert(new Node{2});
+        CORRADE_COMPARE(Node::objectPool().objectCount(), objectCount + 1);
+    }
+
+    CORRADE_COMPARE(Node::objectPool().objectCount(), objectCount);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::ObjectPoolTest)
@@ -0,0 +1,486 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+
+#include "Corrade/Containers/SharedArray.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/TestSuite/Compare/Numeric.h"
+#include "Corrade/Utility/DebugStl.h" /** @todo remove when <sstream> is gone */
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct SharedArrayTest: TestSuite::Tester {
+    explicit SharedArrayTest();
+
+    void allocator();
+    void allocatorGrowable();
+    template<std::size_t alignment> void allocatorAlignment();
+
+    void constructDefault();
+    void constructValueInit();
+    void constructNoInit();
+    void constructSize();
+    void constructInPlaceInit();
+    void constructZeroSize();
+    void constructFromArray();
+    void constructFromArrayOtherDeleter();
+    void constructFromArrayEmpty();
+    void constructCopy();
+    void constructMove();
+    void copyAssign();
+    void moveAssign();
+
+    void convertView();
+    void access();
+    void accessOutOfRange();
+
+    void slice();
+    void sliceOutOfRange();
+
+    void releaseUnique();
+    void releaseUniqueSlice();
+    void releaseShared();
+    void releaseEmpty();
+
+    void multithreaded();
+};
+
+SharedArrayTest::SharedArrayTest() {
+    addTests({&SharedArrayTest::allocator,
+              &SharedArrayTest::allocatorGrowable,
+              &SharedArrayTest::allocatorAlignment<1>,
+              &SharedArrayTest::allocatorAlignment<2>,
+              &SharedArrayTest::allocatorAlignment<4>,
+              &SharedArrayTest::allocatorAlignment<8>,
+              &SharedArrayTest::allocatorAlignment<16>,
+
+              &SharedArrayTest::constructDefault,
+              &SharedArrayTest::constructValueInit,
+              &SharedArrayTest::constructNoInit,
+              &SharedArrayTest::constructSize,
+              &SharedArrayTest::constructInPlaceInit,
+              &SharedArrayTest::constructZeroSize,
+              &SharedArrayTest::constructFromArray,
+              &SharedArrayTest::constructFromArrayOtherDeleter,
+              &SharedArrayTest::constructFromArrayEmpty,
+              &SharedArrayTest::constructCopy,
+              &SharedArrayTest::constructMove,
+              &SharedArrayTest::copyAssign,
+              &SharedArrayTest::moveAssign,
+
+              &SharedArrayTest::convertView,
+              &SharedArrayTest::access,
+              &SharedArrayTest::accessOutOfRange,
+
+              &SharedArrayTest::slice,
+              &SharedArrayTest::sliceOutOfRange,
+
+              &SharedArrayTest::releaseUnique,
+              &SharedArrayTest::releaseUniqueSlice,
+              &SharedArrayTest::releaseShared,
+              &SharedArrayTest::releaseEmpty,
+
+              &SharedArrayTest::multithreaded});
+}
+
+void SharedArrayTest::allocator() {
+    int* data = ArraySharedAllocator<int>::allocate(5);
+    CORRADE_COMPARE(ArraySharedAllocator<int>::capacity(data), 5);
+    CORRADE_COMPARE(ArraySharedAllocator<int>::base(data), reinterpret_cast<char*>(data) - ArraySharedAllocator<int>::AllocationOffset);
+    CORRADE_COMPARE(Implementation::arraySharedReferenceCount(ArraySharedAllocator<int>::base(data)), 1);
+
+    ArraySharedAllocator<int>::reallocate(data, 5, 17);
+    CORRADE_COMPARE(ArraySharedAllocator<int>::capacity(data), 17);
+    CORRADE_COMPARE(Implementation::arraySharedReferenceCount(ArraySharedAllocator<int>::base(data)), 1);
+
+    ArraySharedAllocator<int>::deleter(data, 17);
+
+    /* The header has the capacity and the reference count */
+    CORRADE_COMPARE(std::size_t(ArraySharedAllocator<char>::AllocationOffset), 2*sizeof(std::size_t));
+}
+
+void SharedArrayTest::allocatorGrowable() {
+    Array<int> a;
+    arrayAppend<ArraySharedAllocator>(a, 1);
+    arrayAppend<ArraySharedAllocator>(a, {2, 3, 4, 5, 6});
+    CORRADE_VERIFY(arrayIsGrowable<ArraySharedAllocator>(a));
+    CORRADE_VERIFY(a.deleter() == ArraySharedAllocator<int>::deleter);
+    CORRADE_COMPARE_AS(arrayCapacity<ArraySharedAllocator>(a), 6,
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(a, arrayView({1, 2, 3, 4, 5, 6}),
+        TestSuite::Compare::Container);
+
+    arrayRemoveSuffix<ArraySharedAllocator>(a, 2);
+    CORRADE_COMPARE_AS(a, arrayView({1, 2, 3, 4}),
+        TestSuite::Compare::Container);
+}
+
+template<std::size_t alignment> void SharedArrayTest::allocatorAlignment() {
+    setTestCaseTemplateName(std::to_string(alignment));
+
+    struct alignas(alignment) Aligned {
+        char foo;
+    };
+
+    Aligned* data = ArraySharedAllocator<Aligned>::allocate(3);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(data) % alignment, 0);
+    CORRADE_COMPARE(std::size_t(ArraySharedAllocator<Aligned>::AllocationOffset) % alignment, 0);
+    ArraySharedAllocator<Aligned>::deallocate(data);
+}
+
+void SharedArrayTest::constructDefault() {
+    SharedArray<int> a;
+    CORRADE_VERIFY(a.empty());
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_VERIFY(!a.data());
+    CORRADE_COMPARE(a.referenceCount(), 0);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<SharedArray<int>>::value);
+}
+
+void SharedArrayTest::constructValueInit() {
+    SharedArray<int> a{Corrade::ValueInit, 3};
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a.referenceCount(), 1);
+    CORRADE_COMPARE_AS(a, arrayView({0, 0, 0}),
+        TestSuite::Compare::Container);
+}
+
+void SharedArrayTest::constructNoInit() {
+    SharedArray<int> a{Corrade::NoInit, 3};
+    CORRADE_VERIFY(a.data());
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a.referenceCount(), 1);
+}
+
+void SharedArrayTest::constructSize() {
+    SharedArray<int> a{3};
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE_AS(a, arrayView({0, 0, 0}),
+        TestSuite::Compare::Container);
+
+    /* Implicit construction from a size is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<std::size_t, SharedArray<int>>::value);
+}
+
+void SharedArrayTest::constructInPlaceInit() {
+    SharedArray<int> a{Corrade::InPlaceInit, {1, 2, 3}};
+    CORRADE_COMPARE(a.referenceCount(), 1);
+    CORRADE_COMPARE_AS(a, arrayView({1, 2, 3}),
+        TestSuite::Compare::Container);
+}
+
+void SharedArrayTest::constructZeroSize() {
+    SharedArray<int> a{Corrade::ValueInit, 0};
+    SharedArray<int> b{Corrade::InPlaceInit, {}};
+    CORRADE_VERIFY(!a.data());
+    CORRADE_VERIFY(!b.data());
+    CORRADE_COMPARE(a.referenceCount(), 0);
+    CORRADE_COMPARE(b.referenceCount(), 0);
+}
+
+void SharedArrayTest::constructFromArray() {
+    Array<int> array;
+    arrayAppend<ArraySharedAllocator>(array, {1, 2, 3});
+    const int* data = array.data();
+
+    /* Taken over without a copy */
+    SharedArray<int> a = Utility::move(array);
+    CORRADE_VERIFY(!array.data());
+    CORRADE_COMPARE(a.data(), data);
+    CORRADE_COMPARE(a.referenceCount(), 1);
+    CORRADE_COMPARE_AS(a, arrayView({1, 2, 3}),
+        TestSuite::Compare::Container);
+}
+
+void SharedArrayTest::constructFromArrayOtherDeleter() {
+    Array<int> array{Corrade::InPlaceInit, {1, 2, 3}};
+    const int* data = array.data();
+
+    /* Copied to a new allocation */
+    SharedArray<int> a = Utility::move(array);
+    CORRADE_VERIFY(a.data() != data);
+    CORRADE_COMPARE(a.referenceCount(), 1);
+    CORRADE_COMPARE_AS(a, arrayView({1, 2, 3}),
+        TestSuite::Compare::Container);
+}
+
+void SharedArrayTest::constructFromArrayEmpty() {
+    SharedArray<int> a = Array<int>{};
+    CORRADE_VERIFY(!a.data());
+    CORRADE_COMPARE(a.referenceCount(), 0);
+}
+
+void SharedArrayTest::constructCopy() {
+    SharedArray<int> a{Corrade::InPlaceInit, {1, 2, 3}};
+
+    SharedArray<int> b = a;
+    CORRADE_COMPARE(a.referenceCount(), 2);
+    CORRADE_COMPARE(b.referenceCount(), 2);
+    CORRADE_COMPARE(b.data(), a.data());
+    CORRADE_COMPARE(b.size(), 3);
+
+    {
+        SharedArray<int> c = b;
+        CORRADE_COMPARE(a.referenceCount(), 3);
+    }
+    CORRADE_COMPARE(a.referenceCount(), 2);
+
+    /* Copying an empty array does nothing */
+    SharedArray<int> empty;
+    SharedArray<int> d = empty;
+    CORRADE_COMPARE(d.referenceCount(), 0);
+
+    CORRADE_VERIFY(std::is_nothrow_copy_constructible<SharedArray<int>>::value);
+}
+
+void SharedArrayTest::constructMove() {
+    SharedArray<int> a{Corrade::InPlaceInit, {1, 2, 3}};
+    const int* data = a.data();
+
+    SharedArray<int> b = Utility::move(a);
+    CORRADE_VERIFY(!a.data());
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_COMPARE(b.data(), data);
+    CORRADE_COMPARE(b.size(), 3);
+    CORRADE_COMPARE(b.referenceCount(), 1);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<SharedArray<int>>::value);
+}
+
+void SharedArrayTest::copyAssign() {
+    SharedArray<int> a{Corrade::InPlaceInit, {1, 2, 3}};
+    SharedArray<int> b{Corrade::InPlaceInit, {4, 5}};
+    SharedArray<int> c = b;
+    CORRADE_COMPARE(b.referenceCount(), 2);
+
+    /* The previous reference is released */
+    c = a;
+    CORRADE_COMPARE(a.referenceCount(), 2);
+    CORRADE_COMPARE(b.referenceCount(), 1);
+    CORRADE_COMPARE(c.data(), a.data());
+    CORRADE_COMPARE(c.size(), 3);
+
+    /* Self-assignment shouldn't free anything */
+    SharedArray<int>& cc = c;
+    c = cc;
+    CORRADE_COMPARE(c.referenceCount(), 2);
+    CORRADE_COMPARE_AS(c, arrayView({1, 2, 3}),
+        TestSuite::Compare::Container);
+
+    CORRADE_VERIFY(std::is_nothrow_copy_assignable<SharedArray<int>>::value);
+}
+
+void SharedArrayTest::moveAssign() {
+    SharedArray<int> a{Corrade::InPlaceInit, {1, 2, 3}};
+    SharedArray<int> b{Corrade::InPlaceInit, {4, 5}};
+    const int* data = a.data();
+
+    b = Utility::move(a);
+    CORRADE_COMPARE(b.data(), data);
+    CORRADE_COMPARE(b.size(), 3);
+    CORRADE_COMPARE(b.referenceCount(), 1);
+
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<SharedArray<int>>::value);
+}
+
+void SharedArrayTest::convertView() {
+    const SharedArray<int> a{Corrade::InPlaceInit, {1, 2, 3}};
+    ArrayView<const int> view = a;
+    CORRADE_COMPARE(view.data(), a.data());
+    CORRADE_COMPARE(view.size(), 3);
+
+    /* Only a const view */
+    CORRADE_VERIFY(!std::is_convertible<const SharedArray<int>&, ArrayView<int>>::value);
+}
+
+void SharedArrayTest::access() {
+    const SharedArray<int> a{Corrade::InPlaceInit, {1, 2, 3}};
+    CORRADE_COMPARE(a[0], 1);
+    CORRADE_COMPARE(a[2], 3);
+    CORRADE_COMPARE(a.begin(), a.data());
+    CORRADE_COMPARE(a.cbegin(), a.data());
+    CORRADE_COMPARE(a.end(), a.data() + 3);
+    CORRADE_COMPARE(a.cend(), a.data() + 3);
+
+    int sum = 0;
+    for(int i: a) sum += i;
+    CORRADE_COMPARE(sum, 6);
+}
+
+void SharedArrayTest::accessOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const SharedArray<int> a{Corrade::InPlaceInit, {1, 2, 3}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    a[3];
+    CORRADE_COMPARE(out.str(), "Containers::SharedArray::operator[](): index 3 out of range for 3 elements\n");
+}
+
+void SharedArrayTest::slice() {
+    SharedArray<int> a{Corrade::InPlaceInit, {1, 2, 3, 4, 5}};
+
+    SharedArray<int> b = a.slice(1, 4);
+    CORRADE_COMPARE(b.data(), a.data() + 1);
+    CORRADE_COMPARE(a.referenceCount(), 2);
+    CORRADE_COMPARE_AS(b, arrayView({2, 3, 4}),
+        TestSuite::Compare::Container);
+
+    SharedArray<int> c = b.prefix(2);
+    CORRADE_COMPARE(c.data(), a.data() + 1);
+    CORRADE_COMPARE(a.referenceCount(), 3);
+    CORRADE_COMPARE_AS(c, arrayView({2, 3}),
+        TestSuite::Compare::Container);
+
+    SharedArray<int> d = b.suffix(1);
+    CORRADE_COMPARE(d.data(), a.data() + 2);
+    CORRADE_COMPARE_AS(d, arrayView({3, 4}),
+        TestSuite::Compare::Container);
+
+    /* The slices keep the whole allocation alive */
+    const int* data = a.data();
+    a = {};
+    CORRADE_COMPARE(b.referenceCount(), 3);
+    CORRADE_COMPARE(b.data(), data + 1);
+    CORRADE_COMPARE_AS(b, arrayView({2, 3, 4}),
+        TestSuite::Compare::Container);
+}
+
+void SharedArrayTest::sliceOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SharedArray<int> a{Corrade::InPlaceInit, {1, 2, 3}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    a.slice(2, 1);
+    a.slice(1, 4);
+    a.prefix(4);
+    a.suffix(4);
+    CORRADE_COMPARE(out.str(),
+        "Containers::SharedArray::slice(): slice [2:1] out of range for 3 elements\n"
+        "Containers::SharedArray::slice(): slice [1:4] out of range for 3 elements\n"
+        "Containers::SharedArray::slice(): slice [0:4] out of range for 3 elements\n"
+        "Containers::SharedArray::slice(): slice [4:3] out of range for 3 elements\n");
+}
+
+void SharedArrayTest::releaseUnique() {
+    SharedArray<int> a{Corrade::InPlaceInit, {1, 2, 3}};
+    const int* data = a.data();
+
+    Array<int> array = a.release();
+    CORRADE_VERIFY(!a.data());
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_COMPARE(array.data(), data);
+    CORRADE_VERIFY(arrayIsGrowable<ArraySharedAllocator>(array));
+    CORRADE_COMPARE_AS(array, arrayView({1, 2, 3}),
+        TestSuite::Compare::Container);
+
+    /* It's growable again and can be converted back without a copy */
+    arrayAppend<ArraySharedAllocator>(array, 4);
+    const int* grownData = array.data();
+    SharedArray<int> b = Utility::move(array);
+    CORRADE_COMPARE(b.data(), grownData);
+    CORRADE_COMPARE_AS(b, arrayView({1, 2, 3, 4}),
+        TestSuite::Compare::Container);
+}
+
+void SharedArrayTest::releaseUniqueSlice() {
+    SharedArray<int> a{Corrade::InPlaceInit, {1, 2, 3, 4, 5}};
+    const int* data = a.data();
+    SharedArray<int> b = a.slice(2, 4);
+    a = {};
+    CORRADE_COMPARE(b.referenceCount(), 1);
+
+    /* The slice gets moved to the front of the allocation */
+    Array<int> array = b.release();
+    CORRADE_COMPARE(array.data(), data);
+    CORRADE_COMPARE_AS(array, arrayView({3, 4}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(arrayCapacity<ArraySharedAllocator>(array), 5);
+}
+
+void SharedArrayTest::releaseShared() {
+    SharedArray<int> a{Corrade::InPlaceInit, {1, 2, 3, 4, 5}};
+    SharedArray<int> b = a.slice(1, 3);
+    CORRADE_COMPARE(a.referenceCount(), 2);
+
+    /* Copied, the reference gets dropped */
+    Array<int> array = b.release();
+    CORRADE_VERIFY(!b.data());
+    CORRADE_VERIFY(array.data() != a.data() + 1);
+    CORRADE_VERIFY(arrayIsGrowable<ArraySharedAllocator>(array));
+    CORRADE_COMPARE(a.referenceCount(), 1);
+    CORRADE_COMPARE_AS(array, arrayView({2, 3}),
+        TestSuite::Compare::Container);
+}
+
+void SharedArrayTest::releaseEmpty() {
+    SharedArray<int> a;
+    Array<int> array = a.release();
+    CORRADE_VERIFY(!array.data());
+    CORRADE_COMPARE(array.size(), 0);
+}
+
+void SharedArrayTest::multithreaded() {
+    #if defined(CORRADE_TARGET_EMSCRIPTEN) && !defined(__EMSCRIPTEN_PTHREADS__)
+    CORRADE_SKIP("Threads not available on this platform.");
+    #else
+    SharedArray<int> a{Corrade::InPlaceInit, {1, 2, 3}};
+
+    enum: std::size_t { ThreadCount = 4, IterationCount = 10000 };
+    std::thread threads[ThreadCount];
+    int sums[ThreadCount]{};
+    for(std::size_t i = 0; i != ThreadCount; ++i) {
+        threads[i] = std::thread{[&a, &sums, i]() {
+            for(std::size_t j = 0; j != IterationCount; ++j) {
+                SharedArray<int> copy = a;
+                SharedArray<int> slice = copy.suffix(1);
+                sums[i] += slice[1];
+            }
+        }};
+    }
+    for(std::thread& thread: threads) thread.join();
+
+    CORRADE_COMPARE(a.referenceCount(), 1);
+    for(int sum: sums) CORRADE_COMPARE(sum, 3*int(IterationCount));
+    #endif
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::SharedArrayTest)
@@ -0,0 +1,496 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/Containers/SlotMap.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/TestSuite/Compare/Numeric.h"
+#include "Corrade/Utility/DebugStl.h" /** @todo remove when <sstream> is gone */
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct SlotMapTest: TestSuite::Tester {
+    explicit SlotMapTest();
+
+    void handleConstructDefault();
+    void handleConstruct();
+    void handleCompare();
+    void handleDebug();
+
+    void constructDefault();
+    void constructCopy();
+    void constructMove();
+
+    void insert();
+    void emplace();
+    void emplaceMoveOnly();
+    void access();
+    void accessInvalid();
+    void handleAt();
+    void handleAtOutOfRange();
+
+    void erase();
+    void eraseLast();
+    void eraseInvalid();
+    void eraseReuseSlot();
+    void eraseNonTrivial();
+
+    void clear();
+    void reserve();
+    void iterate();
+    void stress();
+};
+
+SlotMapTest::SlotMapTest() {
+    addTests({&SlotMapTest::handleConstructDefault,
+              &SlotMapTest::handleConstruct,
+              &SlotMapTest::handleCompare,
+              &SlotMapTest::handleDebug,
+
+              &SlotMapTest::constructDefault,
+              &SlotMapTest::constructCopy,
+              &SlotMapTest::constructMove,
+
+              &SlotMapTest::insert,
+              &SlotMapTest::emplace,
+              &SlotMapTest::emplaceMoveOnly,
+              &SlotMapTest::access,
+              &SlotMapTest::accessInvalid,
+              &SlotMapTest::handleAt,
+              &SlotMapTest::handleAtOutOfRange,
+
+              &SlotMapTest::erase,
+              &SlotMapTest::eraseLast,
+              &SlotMapTest::eraseInvalid,
+              &SlotMapTest::eraseReuseSlot,
+              &SlotMapTest::eraseNonTrivial,
+
+              &SlotMapTest::clear,
+              &SlotMapTest::reserve,
+              &SlotMapTest::iterate,
+              &SlotMapTest::stress});
+}
+
+void SlotMapTest::handleConstructDefault() {
+    constexpr SlotMapHandle a;
+    CORRADE_VERIFY(!a);
+    CORRADE_COMPARE(a.index(), 0);
+    CORRADE_COMPARE(a.generation(), 0);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<SlotMapHandle>::value);
+    CORRADE_VERIFY(std::is_trivially_copyable<SlotMapHandle>::value);
+    CORRADE_COMPARE(sizeof(SlotMapHandle), 8);
+}
+
+void SlotMapTest::handleConstruct() {
+    constexpr SlotMapHandle a{17, 3};
+    CORRADE_VERIFY(a);
+    constexpr std::uint32_t index = a.index();
+    constexpr std::uint32_t generation = a.generation();
+    CORRADE_COMPARE(index, 17);
+    CORRADE_COMPARE(generation, 3);
+
+    /* Implicit construction from numbers is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<std::uint32_t, SlotMapHandle>::value);
+    /* Implicit conversion to bool is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<SlotMapHandle, bool>::value);
+}
+
+void SlotMapTest::handleCompare() {
+    constexpr SlotMapHandle a{17, 3};
+    constexpr SlotMapHandle b{17, 5};
+    constexpr SlotMapHandle c{16, 3};
+    constexpr bool equal = a == SlotMapHandle{17, 3};
+    constexpr bool nonEqual = a != b;
+    CORRADE_VERIFY(equal);
+    CORRADE_VERIFY(nonEqual);
+    CORRADE_VERIFY(a != c);
+    CORRADE_VERIFY(!(a == c));
+}
+
+void SlotMapTest::handleDebug() {
+    std::ostringstream out;
+    Utility::Debug{&out} << SlotMapHandle{17, 3} << SlotMapHandle{};
+    CORRADE_COMPARE(out.str(), "Containers::SlotMapHandle(17, 3) Containers::SlotMapHandle(0, 0)\n");
+}
+
+void SlotMapTest::constructDefault() {
+    SlotMap<int> a;
+    const SlotMap<int>& ca = a;
+    CORRADE_VERIFY(a.empty());
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_COMPARE(a.slotCount(), 0);
+    CORRADE_VERIFY(a.values().empty());
+    CORRADE_VERIFY(ca.values().empty());
+    CORRADE_VERIFY(!a.contains({}));
+    CORRADE_VERIFY(!a.find({}));
+    CORRADE_VERIFY(!ca.find(SlotMapHandle{0, 1}));
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<SlotMap<int>>::value);
+}
+
+void SlotMapTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<SlotMap<int>>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<SlotMap<int>>{});
+}
+
+void SlotMapTest::constructMove() {
+    SlotMap<int> a;
+    SlotMapHandle ha = a.insert(3);
+    SlotMapHandle hb = a.insert(5);
+    a.erase(ha);
+    const int* data = a.values().data();
+
+    SlotMap<int> b = Utility::move(a);
+    CORRADE_VERIFY(a.empty());
+    CORRADE_COMPARE(a.slotCount(), 0);
+    CORRADE_COMPARE(b.size(), 1);
+    CORRADE_COMPARE(b.values().data(), data);
+    CORRADE_COMPARE(b[hb], 5);
+
+    /* The moved-out instance should be in a usable state */
+    CORRADE_COMPARE(a.insert(7), (SlotMapHandle{0, 1}));
+
+    SlotMap<int> c;
+    c.insert(1);
+    c = Utility::move(b);
+    CORRADE_COMPARE(c.size(), 1);
+    CORRADE_COMPARE(c.values().data(), data);
+    CORRADE_COMPARE(c[hb], 5);
+
+    /* The free list should get moved as well */
+    CORRADE_COMPARE(c.insert(9), (SlotMapHandle{0, 3}));
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<SlotMap<int>>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<SlotMap<int>>::value);
+}
+
+void SlotMapTest::insert() {
+    SlotMap<int> a;
+    const int value = 15;
+    SlotMapHandle h1 = a.insert(value);
+    SlotMapHandle h2 = a.insert(-3);
+    SlotMapHandle h3 = a.insert(7);
+    CORRADE_COMPARE(h1, (SlotMapHandle{0, 1}));
+    CORRADE_COMPARE(h2, (SlotMapHandle{1, 1}));
+    CORRADE_COMPARE(h3, (SlotMapHandle{2, 1}));
+
+    CORRADE_VERIFY(!a.empty());
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a.slotCount(), 3);
+    CORRADE_COMPARE_AS(a.values(), arrayView({15, -3, 7}),
+        TestSuite::Compare::Container);
+    CORRADE_VERIFY(a.contains(h1));
+    CORRADE_VERIFY(a.contains(h2));
+    CORRADE_VERIFY(a.contains(h3));
+    CORRADE_VERIFY(!a.contains(SlotMapHandle{3, 1}));
+}
+
+void SlotMapTest::emplace() {
+    struct Foo {
+        explicit Foo(int a, float b): a{a}, b{b} {}
+        int a;
+        float b;
+    };
+
+    SlotMap<Foo> a;
+    SlotMapHandle h = a.emplace(3, 1.5f);
+    CORRADE_COMPARE(a.size(), 1);
+    CORRADE_COMPARE(a[h].a, 3);
+    CORRADE_COMPARE(a[h].b, 1.5f);
+}
+
+void SlotMapTest::emplaceMoveOnly() {
+    SlotMap<Pointer<int>> a;
+    SlotMapHandle h1 = a.emplace(new int{3});
+    SlotMapHandle h2 = a.insert(Pointer<int>{new int{5}});
+    CORRADE_COMPARE(*a[h1], 3);
+    CORRADE_COMPARE(*a[h2], 5);
+}
+
+void SlotMapTest::access() {
+    SlotMap<int> a;
+    const SlotMap<int>& ca = a;
+    SlotMapHandle h1 = a.insert(15);
+    SlotMapHandle h2 = a.insert(-3);
+
+    CORRADE_COMPARE(a[h1], 15);
+    CORRADE_COMPARE(ca[h2], -3);
+    CORRADE_COMPARE(a.find(h2), a.values() + 1);
+    CORRADE_COMPARE(ca.find(h1), ca.values() + 0);
+
+    a[h1] = 42;
+    *a.find(h2) = 7;
+    CORRADE_COMPARE_AS(a.values(), arrayView({42, 7}),
+        TestSuite::Compare::Container);
+}
+
+void SlotMapTest::accessInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SlotMap<int> a;
+    const SlotMap<int>& ca = a;
+    SlotMapHandle h = a.insert(15);
+    a.insert(-3);
+    a.erase(h);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    a[h];
+    ca[SlotMapHandle{}];
+    a[SlotMapHandle{2, 1}];
+    CORRADE_COMPARE(out.str(),
+        "Containers::SlotMap::operator[](): invalid handle Containers::SlotMapHandle(0, 1)\n"
+        "Containers::SlotMap::operator[](): invalid handle Containers::SlotMapHandle(0, 0)\n"
+        "Containers::SlotMap::operator[](): invalid handle Containers::SlotMapHandle(2, 1)\n");
+}
+
+void SlotMapTest::handleAt() {
+    SlotMap<int> a;
+    SlotMapHandle h1 = a.insert(15);
+    SlotMapHandle h2 = a.insert(-3);
+    SlotMapHandle h3 = a.insert(7);
+    a.erase(h1);
+
+    /* The last value got moved to the front */
+    CORRADE_COMPARE(a.handle(0), h3);
+    CORRADE_COMPARE(a.handle(1), h2);
+}
+
+void SlotMapTest::handleAtOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SlotMap<int> a;
+    a.insert(15);
+    a.insert(-3);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    a.handle(2);
+    CORRADE_COMPARE(out.str(), "Containers::SlotMap::handle(): index 2 out of range for 2 values\n");
+}
+
+void SlotMapTest::erase() {
+    SlotMap<int> a;
+    SlotMapHandle h1 = a.insert(15);
+    SlotMapHandle h2 = a.insert(-3);
+    SlotMapHandle h3 = a.insert(7);
+    SlotMapHandle h4 = a.insert(22);
+
+    CORRADE_VERIFY(a.erase(h2));
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a.slotCount(), 4);
+    CORRADE_VERIFY(!a.contains(h2));
+    CORRADE_VERIFY(!a.find(h2));
+
+    /* The last value is moved in place of the erased one, handles to it stay
+       valid */
+    CORRADE_COMPARE_AS(a.values(), arrayView({15, 22, 7}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(a[h1], 15);
+    CORRADE_COMPARE(a[h3], 7);
+    CORRADE_COMPARE(a[h4], 22);
+
+    /* Erasing again is a no-op */
+    CORRADE_VERIFY(!a.erase(h2));
+    CORRADE_COMPARE(a.size(), 3);
+}
+
+void SlotMapTest::eraseLast() {
+    SlotMap<int> a;
+    SlotMapHandle h1 = a.insert(15);
+    SlotMapHandle h2 = a.insert(-3);
+
+    CORRADE_VERIFY(a.erase(h2));
+    CORRADE_COMPARE_AS(a.values(), arrayView({15}),
+        TestSuite::Compare::Container);
+    CORRADE_VERIFY(a.erase(h1));
+    CORRADE_VERIFY(a.empty());
+    CORRADE_COMPARE(a.slotCount(), 2);
+}
+
+void SlotMapTest::eraseInvalid() {
+    SlotMap<int> a;
+    a.insert(15);
+
+    CORRADE_VERIFY(!a.erase(SlotMapHandle{}));
+    /* Out of range */
+    CORRADE_VERIFY(!a.erase(SlotMapHandle{1, 1}));
+    /* Wrong generation */
+    CORRADE_VERIFY(!a.erase(SlotMapHandle{0, 3}));
+    /* An even generation is never valid, even if it matches a free slot */
+    CORRADE_VERIFY(!a.erase(SlotMapHandle{0, 0}));
+    CORRADE_COMPARE(a.size(), 1);
+}
+
+void SlotMapTest::eraseReuseSlot() {
+    SlotMap<int> a;
+    SlotMapHandle h1 = a.insert(15);
+    SlotMapHandle h2 = a.insert(-3);
+    SlotMapHandle h3 = a.insert(7);
+    a.erase(h1);
+    a.erase(h3);
+
+    /* Slots are reused in the reverse order of erasure, with the generation
+       incremented */
+    SlotMapHandle h4 = a.insert(1);
+    SlotMapHandle h5 = a.insert(2);
+    SlotMapHandle h6 = a.insert(3);
+    CORRADE_COMPARE(h4, (SlotMapHandle{2, 3}));
+    CORRADE_COMPARE(h5, (SlotMapHandle{0, 3}));
+    CORRADE_COMPARE(h6, (SlotMapHandle{3, 1}));
+    CORRADE_COMPARE(a.slotCount(), 4);
+
+    /* Old handles to the reused slots are detected as stale */
+    CORRADE_VERIFY(!a.contains(h1));
+    CORRADE_VERIFY(!a.contains(h3));
+    CORRADE_VERIFY(!a.find(h1));
+    CORRADE_COMPARE(a[h2], -3);
+    CORRADE_COMPARE(a[h4], 1);
+    CORRADE_COMPARE(a[h5], 2);
+    CORRADE_COMPARE(a[h6], 3);
+}
+
+void SlotMapTest::eraseNonTrivial() {
+    SlotMap<Pointer<int>> a;
+    SlotMapHandle h1 = a.emplace(new int{3});
+    SlotMapHandle h2 = a.emplace(new int{5});
+    SlotMapHandle h3 = a.emplace(new int{7});
+    const int* pointer3 = a[h3].get();
+
+    CORRADE_VERIFY(a.erase(h1));
+    CORRADE_COMPARE(a.size(), 2);
+    /* The pointer got moved, not copied */
+    CORRADE_COMPARE(a[h3].get(), pointer3);
+    CORRADE_COMPARE(*a[h2], 5);
+    CORRADE_COMPARE(*a[h3], 7);
+}
+
+void SlotMapTest::clear() {
+    SlotMap<int> a;
+    SlotMapHandle h1 = a.insert(15);
+    SlotMapHandle h2 = a.insert(-3);
+    const int* data = a.values().data();
+
+    a.clear();
+    CORRADE_VERIFY(a.empty());
+    CORRADE_COMPARE(a.slotCount(), 2);
+    CORRADE_VERIFY(!a.contains(h1));
+    CORRADE_VERIFY(!a.contains(h2));
+
+    /* The memory and the slots are reused */
+    SlotMapHandle h3 = a.insert(1);
+    SlotMapHandle h4 = a.insert(2);
+    CORRADE_COMPARE(a.values().data(), data);
+    SlotMapHandle h5 = a.insert(3);
+    CORRADE_COMPARE(h3, (SlotMapHandle{1, 3}));
+    CORRADE_COMPARE(h4, (SlotMapHandle{0, 3}));
+    CORRADE_COMPARE(h5, (SlotMapHandle{2, 1}));
+    CORRADE_VERIFY(!a.contains(h1));
+    CORRADE_VERIFY(!a.contains(h2));
+}
+
+void SlotMapTest::reserve() {
+    SlotMap<int> a;
+    a.reserve(100);
+    CORRADE_VERIFY(a.empty());
+    CORRADE_COMPARE(a.slotCount(), 0);
+
+    a.insert(15);
+    const int* data = a.values().data();
+    for(int i = 0; i != 99; ++i) a.insert(i);
+    CORRADE_COMPARE(a.size(), 100);
+    CORRADE_COMPARE(a.values().data(), data);
+}
+
+void SlotMapTest::iterate() {
+    SlotMap<int> a;
+    const SlotMap<int>& ca = a;
+    a.insert(15);
+    SlotMapHandle h = a.insert(-3);
+    a.insert(7);
+    a.erase(h);
+
+    int sum = 0;
+    for(int& i: a) {
+        sum += i;
+        i *= 2;
+    }
+    CORRADE_COMPARE(sum, 22);
+
+    sum = 0;
+    for(const int& i: ca) sum += i;
+    CORRADE_COMPARE(sum, 44);
+    CORRADE_COMPARE(ca.cbegin(), ca.begin());
+    CORRADE_COMPARE(ca.cend(), ca.end());
+    CORRADE_COMPARE(ca.end() - ca.begin(), 2);
+}
+
+void SlotMapTest::stress() {
+    /* Interleaved insertions and erasures, verifying that all live handles
+       point to the expected values and all erased ones are stale */
+    SlotMap<int> a;
+    SlotMapHandle handles[64];
+    bool alive[64]{};
+    for(int round = 0; round != 8; ++round) {
+        CORRADE_ITERATION(round);
+
+        for(int i = 0; i != 64; ++i) if(!alive[i] && (i + round) % 3 != 0) {
+            handles[i] = a.insert(i*100 + round);
+            alive[i] = true;
+        }
+        for(int i = 0; i != 64; ++i) if(alive[i] && (i*7 + round) % 5 < 2) {
+            CORRADE_VERIFY(a.erase(handles[i]));
+            alive[i] = false;
+        }
+
+        std::size_t count = 0;
+        for(int i = 0; i != 64; ++i) {
+            CORRADE_COMPARE(a.contains(handles[i]), alive[i]);
+            if(alive[i]) {
+                CORRADE_COMPARE(a[handles[i]] / 100, i);
+                ++count;
+            }
+        }
+        CORRADE_COMPARE(a.size(), count);
+        CORRADE_COMPARE_AS(a.slotCount(), 64, TestSuite::Compare::LessOrEqual);
+
+        /* Handles retrieved from values point back to them */
+        for(std::size_t i = 0; i != a.size(); ++i)
+            CORRADE_COMPARE(a.find(a.handle(i)), a.values() + i);
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::SlotMapTest)
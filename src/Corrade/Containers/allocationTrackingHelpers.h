@@ -0,0 +1,59 @@
+#ifndef Corrade_Containers_allocationTrackingHelpers_h
+#define Corrade_Containers_allocationTrackingHelpers_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+
+#include "Corrade/configure.h"
+
+/* Hooks that containers call for memory they allocate themselves, implemented
+   in AllocationTag.cpp. If CORRADE_BUILD_ALLOCATION_TRACKING isn't enabled,
+   the hooks aren't even declared and all call sites are compiled out. */
+
+#ifdef CORRADE_BUILD_ALLOCATION_TRACKING
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Containers { namespace Implementation {
+
+/* Attributes a new allocation to AllocationTag::current(). Null pointers are
+   ignored. */
+CORRADE_UTILITY_EXPORT void trackAllocation(const void* pointer, std::size_t size);
+
+/* Moves the record of oldPointer to newPointer with a new size, keeping the
+   original tag. If oldPointer isn't tracked, it's treated as a new
+   allocation. */
+CORRADE_UTILITY_EXPORT void trackReallocation(const void* oldPointer, const void* newPointer, std::size_t size);
+
+/* Removes the record for given pointer. Pointers that aren't tracked, such as
+   memory the container didn't allocate itself or a record that was already
+   removed, are ignored. */
+CORRADE_UTILITY_EXPORT void trackDeallocation(const void* pointer);
+
+}}}
+#endif
+
+#endif
@@ -29,6 +29,7 @@
 #include <new>
 #include <cstddef>
 #include <cstring>
+#include <type_traits>
 
 #include "Corrade/configure.h"
 #include "Corrade/Tags.h"
@@ -62,6 +63,21 @@ enum: std::size_t {
         #endif
 };
 
+/* Value-initializing arrayResize() with ArrayMallocAllocator allocates new
+   parts of trivial types that are at least this large with std::calloc()
+   instead of zeroing every element. Allocations of this size are satisfied by
+   the libc allocator directly with an anonymous mmap() / VirtualAlloc(), which
+   the OS fills with zero pages lazily on first access, so a huge sparsely
+   written array doesn't get all its memory touched up front. Smaller
+   allocations are served from the heap, where calloc() has to memset()
+   anyway. */
+enum: std::size_t { LazyZeroAllocationThreshold = 128*1024 };
+
+/* Whether a value-initialized T can be represented by all-zero bytes coming
+   from std::calloc() */
+template<class T> struct IsLazyZeroAllocatable: std::integral_constant<bool,
+    std::is_trivial<T>::value && alignof(T) <= DefaultAllocationAlignment> {};
+
 template<class T> inline void arrayConstruct(Corrade::DefaultInitT, T*, T*, typename std::enable_if<
     #ifdef CORRADE_STD_IS_TRIVIALLY_TRAITS_SUPPORTED
     std::is_trivially_constructible<T>::value
@@ -115,6 +115,20 @@ read/write access to global data.
 #define CORRADE_BUILD_MULTITHREADED
 #undef CORRADE_BUILD_MULTITHREADED
 
+/**
+@brief Allocation tracking build
+@m_since_latest
+
+Defined if the library is built with memory allocated by containers being
+tracked and reported through @ref Corrade::Containers::AllocationTag. Disabled
+by default, in which case the tracking is compiled out completely. Note that
+with this option enabled, all code using the containers has to link to the
+@ref Corrade::Utility "Utility" library.
+@see @ref building-corrade, @ref corrade-cmake
+*/
+#define CORRADE_BUILD_ALLOCATION_TRACKING
+#undef CORRADE_BUILD_ALLOCATION_TRACKING
+
 /**
 @brief Debug build
 
@@ -0,0 +1,164 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ConcurrentSignal.h"
+
+#include <cstdint>
+#include <mutex>
+
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Utility/Algorithms.h"
+
+namespace Corrade { namespace Interconnect { namespace Implementation {
+
+namespace {
+
+struct Retired {
+    /* Either of these is set, the other is null */
+    ConcurrentConnectionList::Snapshot* snapshot;
+    ConnectionData* connection;
+    /* Bits of reader counters that weren't observed to be zero yet */
+    std::uint8_t pending;
+};
+
+}
+
+struct ConcurrentConnectionList::State {
+    /* Locked also in const functions */
+    mutable std::mutex mutex;
+    Containers::Array<Retired> retired;
+};
+
+ConcurrentConnectionList::ConcurrentConnectionList(): _current{new Snapshot}, _epoch{0}, _readers{}, _state{InPlaceInit} {}
+
+ConcurrentConnectionList::~ConcurrentConnectionList() {
+    /* Nobody is expected to be emitting anymore, so everything can be deleted
+       directly */
+    for(Retired& retired: _state->retired) {
+        delete retired.snapshot;
+        delete retired.connection;
+    }
+
+    Snapshot* const current = _current.load();
+    for(ConnectionData* data: current->connections) delete data;
+    delete current;
+}
+
+ConnectionData& ConcurrentConnectionList::append(ConnectionData&& data) {
+    ConnectionData* const out = new ConnectionData{std::move(data)};
+
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    const Containers::ArrayView<ConnectionData* const> current = _current.load()->connections;
+    Containers::Array<ConnectionData*> connections{NoInit, current.size() + 1};
+    Utility::copy(current, connections.prefix(current.size()));
+    connections.back() = out;
+    publish(std::move(connections), {});
+
+    return *out;
+}
+
+bool ConcurrentConnectionList::remove(const Connection& connection) {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+
+    /* The connection pointer might be dangling, so it's only compared to
+       connections that actually exist */
+    const Containers::ArrayView<ConnectionData* const> current = _current.load()->connections;
+    for(std::size_t i = 0; i != current.size(); ++i) {
+        if(current[i] != connection._data) continue;
+
+        Containers::Array<ConnectionData*> connections{NoInit, current.size() - 1};
+        Utility::copy(current.prefix(i), connections.prefix(i));
+        Utility::copy(current.suffix(i + 1), connections.suffix(i));
+        publish(std::move(connections), {&current[i], 1});
+        return true;
+    }
+
+    return false;
+}
+
+void ConcurrentConnectionList::clear() {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+
+    const Containers::ArrayView<ConnectionData* const> current = _current.load()->connections;
+    if(current.empty()) return;
+
+    publish({}, current);
+}
+
+bool ConcurrentConnectionList::contains(const Connection& connection) const {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+
+    for(ConnectionData* data: _current.load()->connections)
+        if(data == connection._data) return true;
+
+    return false;
+}
+
+void ConcurrentConnectionList::publish(Containers::Array<ConnectionData*>&& connections, const Containers::ArrayView<ConnectionData* const> removed) {
+    /* The removed connections are in the old snapshot, retire them first
+       before the snapshot gets potentially deleted */
+    for(ConnectionData* data: removed)
+        arrayAppend(_state->retired, InPlaceInit, nullptr, data, std::uint8_t(0x3));
+
+    /* Publish the new snapshot, from now on new readers will only see that
+       one, and retire the previous one */
+    Snapshot* const snapshot = new Snapshot{std::move(connections)};
+    arrayAppend(_state->retired, InPlaceInit, _current.exchange(snapshot), nullptr, std::uint8_t(0x3));
+
+    /* Make new readers go to the other counter, so the one that's used by the
+       readers of the old snapshot can drain */
+    ++_epoch;
+
+    reclaim();
+}
+
+void ConcurrentConnectionList::reclaim() {
+    /* Any reader that could have seen the retired items registered itself in
+       one of the counters before the items were retired and unregisters only
+       after it's done with them. So once a counter is observed to be zero
+       after the retirement, none of the readers counted by it can see the
+       items anymore. */
+    for(std::uint8_t i = 0; i != 2; ++i) {
+        if(_readers[i].load()) continue;
+        for(Retired& retired: _state->retired)
+            retired.pending &= ~(1 << i);
+    }
+
+    /* Delete items that are not visible to anybody anymore, keep the rest */
+    std::size_t kept = 0;
+    for(Retired& retired: _state->retired) {
+        if(retired.pending) {
+            _state->retired[kept++] = retired;
+            continue;
+        }
+
+        delete retired.snapshot;
+        delete retired.connection;
+    }
+    arrayResize(_state->retired, NoInit, kept);
+}
+
+}}}
@@ -0,0 +1,241 @@
+#ifndef Corrade_Interconnect_ConcurrentSignal_h
+#define Corrade_Interconnect_ConcurrentSignal_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Interconnect::ConcurrentSignal
+ * @m_since_latest
+ */
+
+#include <atomic>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/Interconnect/Emitter.h"
+
+namespace Corrade { namespace Interconnect {
+
+namespace Implementation {
+
+/* Read-copy-update list of connections. Writers are serialized with a mutex,
+   copy the current snapshot, modify it and atomically publish it. Readers
+   only register themselves in one of two reader counters, load the current
+   snapshot and go through it. Replaced snapshots and removed connections are
+   retired and deleted only once both reader counters were observed to be
+   zero after the retirement, which means no reader can be accessing them
+   anymore. The epoch is flipped on every write so new readers go to the
+   other counter and the old one can drain even under constant load. */
+class CORRADE_INTERCONNECT_EXPORT ConcurrentConnectionList {
+    public:
+        struct Snapshot {
+            Containers::Array<ConnectionData*> connections;
+        };
+
+        explicit ConcurrentConnectionList();
+        ~ConcurrentConnectionList();
+
+        /* All these lock the mutex */
+        ConnectionData& append(ConnectionData&& data);
+        bool remove(const Connection& connection);
+        void clear();
+        bool contains(const Connection& connection) const;
+
+        std::size_t count() const {
+            /* The snapshot is never freed while anybody can still look at it,
+               but that's only for readers that registered themselves, so the
+               count is read in the same way */
+            const std::size_t epoch = _epoch.load() & 1;
+            ++_readers[epoch];
+            const std::size_t count = _current.load()->connections.size();
+            --_readers[epoch];
+            return count;
+        }
+
+        template<class ...Args> void emit(Args&... args) {
+            const std::size_t epoch = _epoch.load() & 1;
+            ++_readers[epoch];
+            const Snapshot& snapshot = *_current.load();
+            for(ConnectionData* data: snapshot.connections)
+                reinterpret_cast<void(*)(ConnectionData::Storage&, Args&&...)>(data->call)(data->storage, std::forward<Args>(args)...);
+            --_readers[epoch];
+        }
+
+    private:
+        struct State;
+
+        /* Expects the mutex to be locked */
+        CORRADE_INTERCONNECT_LOCAL void publish(Containers::Array<ConnectionData*>&& connections, Containers::ArrayView<ConnectionData* const> removed);
+        CORRADE_INTERCONNECT_LOCAL void reclaim();
+
+        std::atomic<Snapshot*> _current;
+        std::atomic<std::size_t> _epoch;
+        mutable std::atomic<std::size_t> _readers[2];
+        Containers::Pointer<State> _state;
+};
+
+}
+
+/**
+@brief Thread-safe signal object
+@m_since_latest
+
+A variant of @ref Signal that can be emitted, connected and disconnected from
+multiple threads at the same time. Emitting is wait-free and doesn't take any
+locks, connecting and disconnecting is serialized with a mutex:
+
+@snippet Interconnect.cpp ConcurrentSignal
+
+@section Interconnect-ConcurrentSignal-implementation Implementation details
+
+The connections are stored in an immutable list that's atomically replaced
+with a modified copy on every @ref connect(ConcurrentSignal<Args...>&, Functor&&)
+or @ref disconnect(ConcurrentSignal<Args...>&, const Connection&). An
+@ref emit() then goes through whatever list was current at the time it started
+--- which means a slot can still get called shortly after it was disconnected
+from another thread, and a slot connected from another thread during an
+emit may not get called by it. The replaced lists and removed connections are
+deleted lazily during subsequent connects and disconnects, once no
+@ref emit() is accessing them anymore, or in the signal destructor.
+
+Compared to @ref Signal, connecting and disconnecting is linear in the count of
+connections, so this class is suited mainly for signals that are emitted much
+more often than they're connected to.
+
+@section Interconnect-ConcurrentSignal-limitations Limitations
+
+Only free functions, lambdas and function objects can be connected. Member
+function slots on a @ref Receiver are not supported, as the receiver lifetime
+tracking isn't thread-safe. The slots themselves are responsible for their
+own thread safety as they can be called from multiple threads at once.
+
+It's possible to connect and disconnect from inside a slot, even on the same
+signal. The signal object can't be destroyed while it's being emitted or
+connected to in another thread, or from inside its own slot.
+
+@see @ref interconnect, @ref Connection
+*/
+template<class ...Args> class ConcurrentSignal {
+    public:
+        explicit ConcurrentSignal() = default;
+
+        /** @brief Copying is not allowed */
+        ConcurrentSignal(const ConcurrentSignal<Args...>&) = delete;
+
+        /** @brief Moving is not allowed */
+        ConcurrentSignal(ConcurrentSignal<Args...>&&) = delete;
+
+        /** @brief Copying is not allowed */
+        ConcurrentSignal<Args...>& operator=(const ConcurrentSignal<Args...>&) = delete;
+
+        /** @brief Moving is not allowed */
+        ConcurrentSignal<Args...>& operator=(ConcurrentSignal<Args...>&&) = delete;
+
+        /**
+         * @brief Whether the signal is connected to any slot
+         *
+         * @see @ref connectionCount(), @ref isConnected()
+         */
+        bool hasConnections() const { return _connections.count(); }
+
+        /**
+         * @brief Count of slots connected to the signal
+         *
+         * @see @ref hasConnections()
+         */
+        std::size_t connectionCount() const { return _connections.count(); }
+
+        /**
+         * @brief Whether given connection still exists
+         *
+         * Checks if the @ref Connection object returned by
+         * @ref connect(ConcurrentSignal<Args...>&, Functor&&) still refers to
+         * an existing connection. It's the user responsibility to ensure that
+         * the @p connection corresponds to this signal.
+         * @see @ref hasConnections(),
+         *      @ref disconnect(ConcurrentSignal<Args...>&, const Connection&)
+         */
+        bool isConnected(const Connection& connection) const {
+            return _connections.contains(connection);
+        }
+
+        /**
+         * @brief Disconnect everything from the signal
+         *
+         * @see @ref disconnect(ConcurrentSignal<Args...>&, const Connection&)
+         */
+        void disconnectAll() { _connections.clear(); }
+
+        /**
+         * @brief Emit the signal
+         *
+         * Calls all connected slots in the order in which they were
+         * connected. Wait-free, can be called from multiple threads at once.
+         */
+        void emit(typename Implementation::Identity<Args>::Type... args) {
+            _connections.emit<Args...>(args...);
+        }
+
+    private:
+        /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<class Functor, class ...Args_> friend Connection connect(ConcurrentSignal<Args_...>&, Functor&&);
+        template<class ...Args_> friend bool disconnect(ConcurrentSignal<Args_...>&, const Connection&);
+        #endif
+
+        Implementation::ConcurrentConnectionList _connections;
+};
+
+/** @relatesalso ConcurrentSignal
+@brief Connect a thread-safe signal object to function slot
+@param signal        Signal
+@param slot          Slot
+@m_since_latest
+
+Equivalent to @ref connect(Signal<Args...>&, Functor&&) but for a
+@ref ConcurrentSignal. Can be called from multiple threads at once and while
+the signal is being emitted.
+*/
+template<class Functor, class ...Args> Connection connect(ConcurrentSignal<Args...>& signal, Functor&& slot) {
+    return Connection{signal._connections.append(Implementation::ConnectionData::createFunctor<Args...>(std::move(slot)))};
+}
+
+/** @relatesalso ConcurrentSignal
+@brief Disconnect a thread-safe signal object / slot connection
+@param signal       Signal
+@param connection   Connection handle returned by @ref connect(ConcurrentSignal<Args...>&, Functor&&)
+@m_since_latest
+
+Returns @cpp false @ce if the connection doesn't exist anymore. Can be called
+from multiple threads at once and while the signal is being emitted.
+*/
+template<class ...Args> bool disconnect(ConcurrentSignal<Args...>& signal, const Connection& connection) {
+    return signal._connections.remove(connection);
+}
+
+}}
+
+#endif
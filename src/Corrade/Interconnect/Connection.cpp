@@ -39,20 +39,28 @@ Connection::Connection(
     #endif
     Implementation::SignalData signal, Implementation::ConnectionData& data):
     #ifdef CORRADE_BUILD_DEPRECATED
-    _emitter{emitter},
+    _emitter{&emitter},
     #endif
-    _signal{signal}, _data{&data} {}
+    _signal{signal}, _state{data.state}, _data{&data}, _generation{data.generation} {}
+
+Connection::Connection(Implementation::ConnectionData& data):
+    #ifdef CORRADE_BUILD_DEPRECATED
+    _emitter{},
+    #endif
+    _signal{}, _state{data.state}, _data{&data}, _generation{data.generation} {}
 
 #ifdef CORRADE_BUILD_DEPRECATED
 /* LCOV_EXCL_START */
 bool Connection::isConnected() const {
     Utility::Warning{} << "Interconnect::Emitter::isConnected(): this function is dangerous, use Emitter::isConnected() instead";
+    CORRADE_ASSERT(_emitter, "Interconnect::Connection::isConnected(): not available for Signal connections, use Signal::isConnected() instead", {});
     return _emitter->isConnected(*this);
 }
 
 void Connection::disconnect() {
     Utility::Warning{} << "Interconnect::Connection::disconnect(): this function is dangerous, use Interconnect::disconnect() instead";
-    Interconnect::disconnect(_emitter, *this);
+    CORRADE_ASSERT(_emitter, "Interconnect::Connection::disconnect(): not available for Signal connections, use Interconnect::disconnect() instead", );
+    Interconnect::disconnect(*_emitter, *this);
 }
 /* LCOV_EXCL_STOP */
 #endif
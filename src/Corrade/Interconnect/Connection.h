@@ -31,11 +31,15 @@
  */
 
 #include <cstddef>
+#include <cstdint>
 
-#include "Corrade/Containers/Reference.h"
 #include "Corrade/Interconnect/Interconnect.h"
 #include "Corrade/Interconnect/visibility.h"
 
+#ifdef CORRADE_BUILD_DEPRECATED
+#include "Corrade/Utility/Macros.h"
+#endif
+
 namespace Corrade { namespace Interconnect {
 
 namespace Implementation {
@@ -94,14 +98,14 @@ namespace Implementation {
             /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
             #ifndef DOXYGEN_GENERATING_OUTPUT
             friend Interconnect::Emitter;
+            friend Interconnect::Connection;
             friend SignalDataHash;
             #endif
 
-            /* Still broken even on MSVC 2022. Maybe 2025 will be the year when
-               MSVC can finally do plain C++11? */
-            #if defined(CORRADE_TARGET_MSVC) && !defined(CORRADE_TARGET_CLANG_CL) && _MSC_VER < 1940
+            /* Used by the MSVC variant of create() and for connections
+               that are not made through a signal function, such as
+               Interconnect::Signal */
             SignalData(): data() {}
-            #endif
 
             std::size_t data[FunctionPointerSize];
     };
@@ -115,11 +119,11 @@ later using @ref Interconnect::disconnect(). Destruction of the @ref Connection
 object does not remove the connection, after that the only possibility to
 remove the connection is to disconnect the whole emitter or receiver or
 disconnect everything connected to given signal using
-@ref Emitter::disconnectSignal(), @ref Emitter::disconnectAllSignals() or
-@ref Receiver::disconnectAllSlots(), or destroy either the emitter or receiver
-object.
+@ref Emitter::disconnectSignal(), @ref Emitter::disconnectAllSignals(),
+@ref Signal::disconnectAll() or @ref Receiver::disconnectAllSlots(), or destroy
+either the emitter, the signal or the receiver object.
 
-@see @ref interconnect, @ref Emitter, @ref Receiver
+@see @ref interconnect, @ref Emitter, @ref Signal, @ref Receiver
 */
 class CORRADE_INTERCONNECT_EXPORT Connection {
     public:
@@ -176,20 +180,33 @@ class CORRADE_INTERCONNECT_EXPORT Connection {
             #endif
             Implementation::SignalData signal, Implementation::ConnectionData& data);
 
+        explicit Connection(Implementation::ConnectionData& data);
+
     private:
         /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
         #ifndef DOXYGEN_GENERATING_OUTPUT
         friend Emitter;
         friend Receiver;
+        friend Implementation::ConnectionList;
+        friend Implementation::ConcurrentConnectionList;
         friend CORRADE_INTERCONNECT_EXPORT bool disconnect(Emitter&, const Connection&);
         #endif
 
         #ifdef CORRADE_BUILD_DEPRECATED
-        Containers::Reference<Emitter> _emitter;
+        /* Null for connections made to a Signal */
+        Emitter* _emitter;
         #endif
         Implementation::SignalData _signal;
-        /* Note: this might become dangling at some point */
+        /* Emitter or Signal state owning the connection, null for
+           ConcurrentSignal connections. Compared before _data gets
+           dereferenced, as it's dangling once the owner is destroyed. */
+        Implementation::ConnectionState* _state;
+        /* Note: for Emitter and Signal connections this stays valid as long
+           as the emitter / signal exists, but might refer to a different
+           connection later, which is detected by comparing _generation. For
+           ConcurrentSignal connections it might become dangling. */
         Implementation::ConnectionData* _data;
+        std::uint32_t _generation;
 };
 
 }}
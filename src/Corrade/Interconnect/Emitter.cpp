@@ -27,8 +27,6 @@
 #include "Emitter.h"
 
 #include "Corrade/Interconnect/Receiver.h"
-#include "Corrade/Interconnect/Implementation/ReceiverConnection.h"
-#include "Corrade/Utility/Assert.h"
 
 namespace Corrade { namespace Interconnect {
 
@@ -58,80 +56,143 @@ ConnectionData::~ConnectionData() {
         storage.functor.destruct(storage);
 }
 
+ConnectionState::~ConnectionState() {
+    while(pool) {
+        ConnectionData* const next = pool->signalNext;
+        delete pool;
+        pool = next;
+    }
 }
 
-Emitter::Emitter(): _lastHandledSignal{0}, _connectionsChanged{false} {}
+ConnectionData& ConnectionList::append(ConnectionState& state, ConnectionData&& data) {
+    /* Reuse a previously removed connection, if there's any. The intrusive
+       links and the generation are kept by the move assignment. */
+    ConnectionData* out;
+    if(state.pool) {
+        out = state.pool;
+        state.pool = out->signalNext;
+        *out = std::move(data);
+        out->signalNext = nullptr;
+    } else out = new ConnectionData{std::move(data)};
+
+    /* Add connection to the end of the list */
+    out->state = &state;
+    out->signalList = this;
+    out->signalPrevious = last;
+    if(last) last->signalNext = out;
+    else first = out;
+    last = out;
+    ++state.connectionCount;
+    state.connectionsChanged = true;
+
+    /* Add connection to the front of the receiver list, if this is member
+       function connection */
+    if(out->type == ConnectionType::Member) {
+        Receiver& receiver = *out->storage.member.receiver;
+        out->receiverNext = receiver._connections;
+        if(receiver._connections)
+            receiver._connections->receiverPrevious = out;
+        receiver._connections = out;
+        ++receiver._connectionCount;
+    }
 
-Emitter::~Emitter() {
-    for(auto& connection: _connections) disconnectFromReceiver(connection.second);
+    return *out;
 }
 
-bool Emitter::isConnected(const Connection& connection) const {
-    auto range = _connections.equal_range(connection._signal);
-    for(auto it = range.first; it != range.second; ++it)
-        if(&it->second == &*connection._data) return true;
+void ConnectionList::remove(ConnectionData& data) {
+    if(data.signalPrevious) data.signalPrevious->signalNext = data.signalNext;
+    else first = data.signalNext;
+    if(data.signalNext) data.signalNext->signalPrevious = data.signalPrevious;
+    else last = data.signalPrevious;
+    --data.state->connectionCount;
+    data.state->connectionsChanged = true;
+
+    if(data.type == ConnectionType::Member) {
+        Receiver& receiver = *data.storage.member.receiver;
+        if(data.receiverPrevious)
+            data.receiverPrevious->receiverNext = data.receiverNext;
+        else receiver._connections = data.receiverNext;
+        if(data.receiverNext)
+            data.receiverNext->receiverPrevious = data.receiverPrevious;
+        --receiver._connectionCount;
+    }
 
-    return false;
+    /* Destroy the slot by swapping it with an empty one and put the
+       connection into the pool. Bumping the generation invalidates all
+       Connection handles referring to it. */
+    data = ConnectionData{ConnectionType::Free};
+    ++data.generation;
+    data.signalList = nullptr;
+    data.signalPrevious = nullptr;
+    data.receiverPrevious = nullptr;
+    data.receiverNext = nullptr;
+    data.signalNext = data.state->pool;
+    data.state->pool = &data;
 }
 
-Implementation::ConnectionData& Emitter::connectInternal(const Implementation::SignalData& signal, Implementation::ConnectionData&& data) {
-    /* Add connection to emitter */
-    Implementation::ConnectionData& out =
-    _connections.emplace(signal, std::move(data))->second;
-    _connectionsChanged = true;
+bool ConnectionList::remove(const ConnectionState& state, const Connection& connection) {
+    if(!contains(state, connection)) return false;
+
+    remove(*connection._data);
+    return true;
+}
 
-    /* Add connection to receiver, if this is member function connection */
-    if(data.type == Implementation::ConnectionType::Member)
-        out.storage.member.receiver->_connections.emplace_back(*this, signal, out);
+void ConnectionList::clear() {
+    while(first) remove(*first);
+}
 
-    /* Return reference to the final position */
-    return out;
+bool ConnectionList::contains(const ConnectionState& state, const Connection& connection) const {
+    return connection._state == &state &&
+           connection._data->signalList == this &&
+           connection._data->generation == connection._generation;
 }
 
-void Emitter::disconnectInternal(const Implementation::SignalData& signal) {
-    auto range = _connections.equal_range(signal);
-    for(auto it = range.first; it != range.second; ++it)
-        disconnectFromReceiver(it->second);
+std::size_t ConnectionList::count() const {
+    std::size_t count = 0;
+    for(const ConnectionData* data = first; data; data = data->signalNext)
+        ++count;
+    return count;
+}
 
-    _connections.erase(range.first, range.second);
-    _connectionsChanged = true;
 }
 
-void Emitter::disconnectAllSignals() {
-    for(auto it = _connections.begin(); it != _connections.end(); ++it)
-        disconnectFromReceiver(it->second);
+Emitter::Emitter() = default;
 
-    _connections.clear();
-    _connectionsChanged = true;
+Emitter::~Emitter() {
+    for(auto& signal: _connections) signal.second.clear();
 }
 
-void Emitter::disconnectFromReceiver(const Implementation::ConnectionData& data) {
-    if(data.type != Implementation::ConnectionType::Member) return;
+bool Emitter::hasSignalConnectionsInternal(const Implementation::SignalData& signal) const {
+    auto found = _connections.find(signal);
+    return found != _connections.end() && found->second.first;
+}
 
-    auto& receiverConnections = data.storage.member.receiver->_connections;
-    for(auto end = receiverConnections.end(), rit = receiverConnections.begin(); rit != end; ++rit) {
-        if(&*rit->data != &data) continue;
+std::size_t Emitter::signalConnectionCountInternal(const Implementation::SignalData& signal) const {
+    auto found = _connections.find(signal);
+    return found == _connections.end() ? 0 : found->second.count();
+}
 
-        receiverConnections.erase(rit);
-        return;
-    }
+bool Emitter::isConnected(const Connection& connection) const {
+    auto found = _connections.find(connection._signal);
+    return found != _connections.end() && found->second.contains(_state, connection);
+}
 
-    /* The connection must be found */
-    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+Implementation::ConnectionData& Emitter::connectInternal(const Implementation::SignalData& signal, Implementation::ConnectionData&& data) {
+    return _connections[signal].append(_state, std::move(data));
 }
 
-bool disconnect(Emitter& emitter, const Connection& connection) {
-    auto range = emitter._connections.equal_range(connection._signal);
-    for(auto it = range.first; it != range.second; ++it) {
-        if(&it->second != &*connection._data) continue;
-
-        emitter.disconnectFromReceiver(it->second);
-        emitter._connections.erase(it);
-        emitter._connectionsChanged = true;
-        return true;
-    }
+void Emitter::disconnectInternal(const Implementation::SignalData& signal) {
+    auto found = _connections.find(signal);
+    if(found != _connections.end()) found->second.clear();
+}
+
+void Emitter::disconnectAllSignals() {
+    for(auto& signal: _connections) signal.second.clear();
+}
 
-    return false;
+bool disconnect(Emitter& emitter, const Connection& connection) {
+    auto found = emitter._connections.find(connection._signal);
+    return found != emitter._connections.end() && found->second.remove(emitter._state, connection);
 }
 
 }}
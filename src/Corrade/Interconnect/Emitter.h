@@ -168,8 +168,109 @@ struct CORRADE_INTERCONNECT_EXPORT ConnectionData {
     void(*call)();
     std::uint32_t lastHandledSignal{};
     ConnectionType type;
+
+    /* Intrusive links, not touched by the move constructor / assignment. Each
+       connection is in a doubly-linked list of all connections of the same
+       signal and, if it's a member function connection, also in a
+       doubly-linked list of all connections of the receiver. That makes
+       removing a connection from either side O(1). */
+    ConnectionState* state{};
+    ConnectionList* signalList{};
+    ConnectionData* signalPrevious{};
+    ConnectionData* signalNext{};
+    ConnectionData* receiverPrevious{};
+    ConnectionData* receiverNext{};
+
+    /* Incremented every time the connection is removed, also not touched by
+       the move constructor / assignment. A Connection handle remembers the
+       value it was created with, so it no longer matches once the connection
+       is removed or its memory reused for another connection. */
+    std::uint32_t generation{};
+};
+
+/* Bookkeeping shared by all connection lists of an Emitter or owned by a
+   single Signal */
+struct CORRADE_INTERCONNECT_EXPORT ConnectionState {
+    explicit ConnectionState() noexcept = default;
+
+    ConnectionState(const ConnectionState&) = delete;
+    ConnectionState(ConnectionState&&) = delete;
+
+    /* Deletes the pooled connections */
+    ~ConnectionState();
+
+    ConnectionState& operator=(const ConnectionState&) = delete;
+    ConnectionState& operator=(ConnectionState&&) = delete;
+
+    std::size_t connectionCount{};
+    std::uint32_t lastHandledSignal{};
+    bool connectionsChanged{};
+
+    /* Removed connections, linked through signalNext and reused by
+       ConnectionList::append(). They're deleted only together with the state,
+       which means a Connection handle can be safely dereferenced and checked
+       against the generation for as long as its Emitter or Signal exists. */
+    ConnectionData* pool{};
 };
 
+/* Connections to a single signal, in the order in which they were made */
+struct CORRADE_INTERCONNECT_EXPORT ConnectionList {
+    /* Takes ownership of the connection and links it also to the receiver,
+       if it's a member function connection. Returns the actual location of
+       the connection. */
+    ConnectionData& append(ConnectionState& state, ConnectionData&& data);
+
+    /* Unlinks the connection from this list and from the receiver, destroys
+       its slot and puts it into the state pool */
+    void remove(ConnectionData& data);
+
+    /* Removes given connection if it's in this list. O(1), see contains(). */
+    bool remove(const ConnectionState& state, const Connection& connection);
+
+    void clear();
+
+    /* Checks whether given connection is in this list. The handle is first
+       checked to come from the same state, as connections from a different
+       one may be already deleted. After that the connection is known to be
+       only ever put back into the state pool and not deleted, so it's
+       dereferenced directly and its generation and list compared to what the
+       handle remembers. */
+    bool contains(const ConnectionState& state, const Connection& connection) const;
+    std::size_t count() const;
+
+    ConnectionData* first{};
+    ConnectionData* last{};
+};
+
+/* Calls all connections in the list. If the slots change the connections,
+   the list is gone through again, skipping the already called ones. */
+template<class ...Args> void emit(ConnectionState& state, const ConnectionList& list, Args&... args) {
+    state.connectionsChanged = false;
+    ++state.lastHandledSignal;
+
+    ConnectionData* data = list.first;
+    while(data) {
+        /* If not already handled, proceed and mark as such */
+        if(data->lastHandledSignal != state.lastHandledSignal) {
+            data->lastHandledSignal = state.lastHandledSignal;
+
+            reinterpret_cast<void(*)(ConnectionData::Storage&, Args&&...)>(data->call)(data->storage, std::forward<Args>(args)...);
+
+            /* Connections changed by the slot, the current one might be gone
+               now, go through again. The list itself stays at the same
+               location so it doesn't need to be looked up again. */
+            if(state.connectionsChanged) {
+                data = list.first;
+                state.connectionsChanged = false;
+                continue;
+            }
+        }
+
+        /* Nothing called or changed, next connection */
+        data = data->signalNext;
+    }
+}
+
 }
 
 /**
@@ -273,6 +374,14 @@ Note that the @ref Connection object is just a handle --- its destruction
 the connections. All emitter connections are automatically removed when emitter
 object is destroyed.
 
+Each connection is linked both into a list of its signal in the emitter and,
+for member function slots, into a list of the receiver. Connecting and removing
+a connection from either side is thus constant-time, and the cost of
+destroying an emitter or a receiver is linear in the count of its connections,
+regardless of how many connections the other side has. Only
+@ref disconnect() and @ref isConnected() have to go through connections of the
+same signal in order to verify that the @ref Connection handle is still valid.
+
 @note It is possible to connect given signal to given slot more than
     once, because there is no way to check whether the connection already
     exists. As a result, after signal is emitted, the slot function will be
@@ -344,7 +453,14 @@ Convoluted example:
 
 @snippet Interconnect.cpp Emitter-connect-receiver-multiple-inheritance
 
-@see @ref Receiver, @ref Connection
+@section Interconnect-Emitter-signal-objects Signal objects
+
+Each @ref emit() call needs to look up the connections to given signal in a
+hash map. For signals that are emitted very often, a @ref Signal object can be
+used instead --- it stores its connections directly and thus has no lookup
+overhead on emit.
+
+@see @ref Receiver, @ref Connection, @ref Signal
 @todo Allow move
 */
 class CORRADE_INTERCONNECT_EXPORT Emitter {
@@ -382,7 +498,7 @@ class CORRADE_INTERCONNECT_EXPORT Emitter {
          *      @ref signalConnectionCount()
          */
         bool hasSignalConnections() const {
-            return !_connections.empty();
+            return _state.connectionCount;
         }
 
         /**
@@ -392,7 +508,7 @@ class CORRADE_INTERCONNECT_EXPORT Emitter {
          *      @ref signalConnectionCount()
          */
         template<class Emitter, class ...Args> bool hasSignalConnections(Signal(Emitter::*signal)(Args...)) const {
-            return _connections.count(
+            return hasSignalConnectionsInternal(
                 /* Still broken even on MSVC 2022. Maybe 2025 will be the year
                    when MSVC can finally do plain C++11? */
                 #if !defined(CORRADE_TARGET_MSVC) || defined(CORRADE_TARGET_CLANG_CL) || _MSC_VER >= 1940
@@ -400,7 +516,7 @@ class CORRADE_INTERCONNECT_EXPORT Emitter {
                 #else
                 Implementation::SignalData::create<Emitter, Args...>(signal)
                 #endif
-                ) != 0;
+                );
         }
 
         /**
@@ -421,7 +537,7 @@ class CORRADE_INTERCONNECT_EXPORT Emitter {
          * @see @ref Receiver::slotConnectionCount(),
          *      @ref hasSignalConnections()
          */
-        std::size_t signalConnectionCount() const { return _connections.size(); }
+        std::size_t signalConnectionCount() const { return _state.connectionCount; }
 
         /**
          * @brief Count of slots connected to given signal
@@ -430,7 +546,7 @@ class CORRADE_INTERCONNECT_EXPORT Emitter {
          *      @ref hasSignalConnections()
          */
         template<class Emitter, class ...Args> std::size_t signalConnectionCount(Signal(Emitter::*signal)(Args...)) const {
-            return _connections.count(
+            return signalConnectionCountInternal(
                 /* Still broken even on MSVC 2022. Maybe 2025 will be the year
                    when MSVC can finally do plain C++11? */
                 #if !defined(CORRADE_TARGET_MSVC) || defined(CORRADE_TARGET_CLANG_CL) || _MSC_VER >= 1940
@@ -500,15 +616,20 @@ class CORRADE_INTERCONNECT_EXPORT Emitter {
         friend CORRADE_INTERCONNECT_EXPORT bool disconnect(Emitter&, const Connection&);
         #endif
 
-        /* Returns the actual location of the connection in the hashmap */
+        bool hasSignalConnectionsInternal(const Implementation::SignalData& signal) const;
+        std::size_t signalConnectionCountInternal(const Implementation::SignalData& signal) const;
+
+        /* Returns the actual location of the connection */
         Implementation::ConnectionData& connectInternal(const Implementation::SignalData& signal, Implementation::ConnectionData&& data);
-        CORRADE_INTERCONNECT_LOCAL void disconnectFromReceiver(const Implementation::ConnectionData& data);
 
         void disconnectInternal(const Implementation::SignalData& signal);
 
-        std::unordered_multimap<Implementation::SignalData, Implementation::ConnectionData, Implementation::SignalDataHash> _connections;
-        std::uint32_t _lastHandledSignal;
-        bool _connectionsChanged;
+        /* Entries are never removed from the map, only the lists get emptied,
+           so the ConnectionList references stay valid for the whole emitter
+           lifetime. The map size is bounded by the count of distinct signals
+           the emitter has. */
+        std::unordered_map<Implementation::SignalData, Implementation::ConnectionList, Implementation::SignalDataHash> _connections;
+        Implementation::ConnectionState _state;
 };
 
 /** @relatesalso Emitter
@@ -609,9 +730,7 @@ CORRADE_INTERCONNECT_EXPORT bool disconnect(Emitter& emitter, const Connection&
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template<class Emitter_, class ...Args> Emitter::Signal Emitter::emit(Signal(Emitter_::*signal)(Args...), typename Implementation::Identity<Args>::Type... args) {
-    _connectionsChanged = false;
-    ++_lastHandledSignal;
-    auto range = _connections.equal_range(
+    auto found = _connections.find(
         /* Still broken even on MSVC 2022. Maybe 2025 will be the year when
            MSVC can finally do plain C++11? */
         #if !defined(CORRADE_TARGET_MSVC) || defined(CORRADE_TARGET_CLANG_CL) || _MSC_VER >= 1940
@@ -620,37 +739,8 @@ template<class Emitter_, class ...Args> Emitter::Signal Emitter::emit(Signal(Emi
         Implementation::SignalData::create<Emitter_, Args...>(signal)
         #endif
         );
-    auto it = range.first;
-    while(it != range.second) {
-        /* Caching this actually helps *immensely* with debug runtime perf */
-        Implementation::ConnectionData& data = it->second;
-
-        /* If not already handled, proceed and mark as such */
-        if(data.lastHandledSignal != _lastHandledSignal) {
-            data.lastHandledSignal = _lastHandledSignal;
-
-            reinterpret_cast<void(*)(Implementation::ConnectionData::Storage&, Args&&...)>(data.call)(data.storage, std::forward<Args>(args)...);
-
-            /* Connections changed by the slot, go through again */
-            if(_connectionsChanged) {
-                range = _connections.equal_range(
-                    /* Still broken even on MSVC 2022. Maybe 2025 will be the
-                       year when MSVC can finally do plain C++11? */
-                    #if !defined(CORRADE_TARGET_MSVC) || defined(CORRADE_TARGET_CLANG_CL) || _MSC_VER >= 1940
-                    Implementation::SignalData(signal)
-                    #else
-                    Implementation::SignalData::create<Emitter_, Args...>(signal)
-                    #endif
-                    );
-                it = range.first;
-                _connectionsChanged = false;
-                continue;
-            }
-        }
-
-        /* Nothing called or changed, next connection */
-        ++it;
-    }
+    if(found != _connections.end())
+        Implementation::emit<Args...>(_state, found->second, args...);
 
     return Signal();
 }
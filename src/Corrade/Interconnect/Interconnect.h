@@ -36,12 +36,17 @@
 
 namespace Corrade { namespace Interconnect {
 
+template<class...> class ConcurrentSignal;
 class Connection;
 class Emitter;
 class Receiver;
+template<class...> class Signal;
 
 namespace Implementation {
+    class ConcurrentConnectionList;
     struct ConnectionData;
+    struct ConnectionList;
+    struct ConnectionState;
     class SignalData;
 }
 
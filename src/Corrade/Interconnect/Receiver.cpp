@@ -28,32 +28,19 @@
 
 #include "Corrade/Interconnect/Connection.h"
 #include "Corrade/Interconnect/Emitter.h"
-#include "Corrade/Interconnect/Implementation/ReceiverConnection.h"
-#include "Corrade/Utility/Assert.h"
 
 namespace Corrade { namespace Interconnect {
 
-Receiver::Receiver() = default;
+Receiver::Receiver(): _connections{}, _connectionCount{} {}
 
 Receiver::~Receiver() { disconnectAllSlots(); }
 
-bool Receiver::hasSlotConnections() const { return !_connections.empty(); }
+bool Receiver::hasSlotConnections() const { return _connectionCount; }
 
-std::size_t Receiver::slotConnectionCount() const { return _connections.size(); }
+std::size_t Receiver::slotConnectionCount() const { return _connectionCount; }
 
 void Receiver::disconnectAllSlots() {
-    for(Implementation::ReceiverConnection& connection: _connections) {
-        auto range = connection.emitter->_connections.equal_range(connection.signal);
-        for(auto it = range.first; it != range.second; ++it) {
-            if(&it->second != &*connection.data) continue;
-
-            connection.emitter->_connections.erase(it);
-            connection.emitter->_connectionsChanged = true;
-            break;
-        }
-    }
-
-    _connections.clear();
+    while(_connections) _connections->signalList->remove(*_connections);
 }
 
 }}
@@ -31,15 +31,12 @@
  */
 
 #include <cstddef>
-#include <vector>
 
 #include "Corrade/Interconnect/Interconnect.h"
 #include "Corrade/Interconnect/visibility.h"
 
 namespace Corrade { namespace Interconnect {
 
-namespace Implementation { struct ReceiverConnection; }
-
 /**
 @brief Receiver object
 
@@ -96,11 +93,13 @@ class CORRADE_INTERCONNECT_EXPORT Receiver {
     private:
         /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
         #ifndef DOXYGEN_GENERATING_OUTPUT
-        friend Implementation::ConnectionData;
-        friend Emitter;
+        friend Implementation::ConnectionList;
         #endif
 
-        std::vector<Implementation::ReceiverConnection> _connections;
+        /* Head of an intrusive list going through
+           Implementation::ConnectionData::receiverNext */
+        Implementation::ConnectionData* _connections;
+        std::size_t _connectionCount;
 };
 
 }}
@@ -0,0 +1,204 @@
+#ifndef Corrade_Interconnect_Signal_h
+#define Corrade_Interconnect_Signal_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Interconnect::Signal
+ * @m_since_latest
+ */
+
+#include "Corrade/Interconnect/Emitter.h"
+
+namespace Corrade { namespace Interconnect {
+
+/**
+@brief Signal object
+@m_since_latest
+
+An alternative to signals implemented as @ref Emitter member functions. The
+signal is a standalone object, usually a member of the class that emits it,
+that owns the list of its connections. Emitting it thus goes directly to the
+connected slots without any hashing or map lookup, which makes it suitable
+for signals that are emitted very often. Apart from that, the semantics are
+the same as with @ref Emitter signals --- connected member function slots are
+automatically disconnected when their @ref Receiver gets destroyed and all
+connections are removed when the signal object is destroyed.
+
+@snippet Interconnect.cpp Signal
+
+The argument count and types of the slot have to be exactly the same as the
+@p Args of the signal. Note that inside @ref Emitter subclasses the unqualified
+name @cpp Signal @ce refers to @ref Emitter::Signal, so the type has to be
+spelled as @cpp Interconnect::Signal @ce there.
+
+Unlike with @ref Emitter, there's no way to restrict emitting to the owning
+class, so @ref emit() is public. If that's a concern, keep the signal object
+private and expose just a reference to it or a connection function.
+
+@note The same restrictions as for @ref Emitter apply --- it's possible to add
+    or remove connections in a slot, but you can't destroy the signal object
+    from its own slot.
+
+@see @ref interconnect, @ref Connection
+*/
+template<class ...Args> class Signal {
+    public:
+        explicit Signal() noexcept = default;
+
+        /** @brief Copying is not allowed */
+        Signal(const Signal<Args...>&) = delete;
+
+        /** @brief Moving is not allowed */
+        Signal(Signal<Args...>&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Removes all connections.
+         */
+        ~Signal() { _connections.clear(); }
+
+        /** @brief Copying is not allowed */
+        Signal<Args...>& operator=(const Signal<Args...>&) = delete;
+
+        /** @brief Moving is not allowed */
+        Signal<Args...>& operator=(Signal<Args...>&&) = delete;
+
+        /**
+         * @brief Whether the signal is connected to any slot
+         *
+         * @see @ref connectionCount(), @ref isConnected()
+         */
+        bool hasConnections() const { return _state.connectionCount; }
+
+        /**
+         * @brief Count of slots connected to the signal
+         *
+         * @see @ref hasConnections()
+         */
+        std::size_t connectionCount() const { return _state.connectionCount; }
+
+        /**
+         * @brief Whether given connection still exists
+         *
+         * Checks if the @ref Connection object returned by
+         * @ref connect(Signal<Args...>&, Functor&&) or
+         * @ref connect(Signal<Args...>&, ReceiverObject&, void(Receiver::*)(Args...))
+         * still refers to an existing connection. It's the user responsibility
+         * to ensure that the @p connection corresponds to this signal.
+         * @see @ref hasConnections(),
+         *      @ref disconnect(Signal<Args...>&, const Connection&)
+         */
+        bool isConnected(const Connection& connection) const {
+            return _connections.contains(_state, connection);
+        }
+
+        /**
+         * @brief Disconnect everything from the signal
+         *
+         * @see @ref Receiver::disconnectAllSlots(),
+         *      @ref disconnect(Signal<Args...>&, const Connection&)
+         */
+        void disconnectAll() { _connections.clear(); }
+
+        /**
+         * @brief Emit the signal
+         *
+         * Calls all connected slots in the order in which they were
+         * connected.
+         */
+        void emit(typename Implementation::Identity<Args>::Type... args) {
+            Implementation::emit<Args...>(_state, _connections, args...);
+        }
+
+    private:
+        /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<class Functor, class ...Args_> friend Connection connect(Signal<Args_...>&, Functor&&);
+        template<class Receiver, class ReceiverObject, class ...Args_> friend Connection connect(Signal<Args_...>&, ReceiverObject&, void(Receiver::*)(Args_...));
+        template<class ...Args_> friend bool disconnect(Signal<Args_...>&, const Connection&);
+        #endif
+
+        Implementation::ConnectionList _connections;
+        Implementation::ConnectionState _state;
+};
+
+/** @relatesalso Signal
+@brief Connect a signal object to function slot
+@param signal        Signal
+@param slot          Slot
+@m_since_latest
+
+Equivalent to @ref connect(EmitterObject&, Interconnect::Emitter::Signal(Emitter::*)(Args...), Functor&&)
+but for a @ref Signal object. The argument count and types must be exactly the
+same.
+@see @ref Signal::hasConnections(), @ref Signal::isConnected(),
+    @ref Signal::connectionCount()
+*/
+template<class Functor, class ...Args> Connection connect(Signal<Args...>& signal, Functor&& slot) {
+    return Connection{signal._connections.append(signal._state, Implementation::ConnectionData::createFunctor<Args...>(std::move(slot)))};
+}
+
+/** @relatesalso Signal
+@brief Connect a signal object to member function slot
+@param signal        Signal
+@param receiver      Receiver
+@param slot          Slot
+@m_since_latest
+
+Equivalent to @ref connect(EmitterObject&, Interconnect::Emitter::Signal(Emitter::*)(Args...), ReceiverObject&, void(Receiver::*)(Args...))
+but for a @ref Signal object. The connection is automatically removed when
+@p receiver gets destroyed. The argument count and types must be exactly the
+same.
+@see @ref Signal::hasConnections(), @ref Signal::isConnected(),
+    @ref Signal::connectionCount()
+*/
+template<class Receiver, class ReceiverObject, class ...Args> Connection connect(Signal<Args...>& signal, ReceiverObject& receiver, void(Receiver::*slot)(Args...)) {
+    static_assert(std::is_base_of<Receiver, ReceiverObject>::value,
+        "Receiver object doesn't have given slot");
+
+    return Connection{signal._connections.append(signal._state, Implementation::ConnectionData::createMember<Receiver, ReceiverObject, Args...>(receiver, slot))};
+}
+
+/** @relatesalso Signal
+@brief Disconnect a signal object / slot connection
+@param signal       Signal
+@param connection   Connection handle returned by @ref connect(Signal<Args...>&, Functor&&)
+    or @ref connect(Signal<Args...>&, ReceiverObject&, void(Receiver::*)(Args...))
+@m_since_latest
+
+Returns @cpp false @ce if the connection doesn't exist anymore. It's the user
+responsibility to ensure that @p connection corresponds to given @p signal
+instance.
+*/
+template<class ...Args> bool disconnect(Signal<Args...>& signal, const Connection& connection) {
+    return signal._connections.remove(signal._state, connection);
+}
+
+}}
+
+#endif
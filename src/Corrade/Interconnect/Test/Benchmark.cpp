@@ -29,6 +29,7 @@
 #include "Corrade/Containers/Optional.h"
 #include "Corrade/Interconnect/Emitter.h"
 #include "Corrade/Interconnect/Receiver.h"
+#include "Corrade/Interconnect/Signal.h"
 #include "Corrade/TestSuite/Tester.h"
 
 namespace Corrade { namespace Interconnect { namespace Test { namespace {
@@ -55,6 +56,12 @@ struct Benchmark: TestSuite::Tester {
     void call1kSlotLambdas();
     void call1kSlotLambdasHeap();
     void call1kSlotMembers();
+
+    void connect1kSignalObjectFunctions();
+    void destruct1kSignalObjectMembersReceiverFirst();
+    void callSignalObjectFunction1000x();
+    void call1kSignalObjectFunctions();
+    void call1kSignalObjectMembers();
 };
 
 Benchmark::Benchmark() {
@@ -63,11 +70,8 @@ Benchmark::Benchmark() {
 
     addBenchmarks({&Benchmark::destructBaseline,
                    &Benchmark::destruct1kFunctions,
-                   &Benchmark::destruct1kMembersEmitterFirst}, 100);
-
-    /* Takes like two hours on libstdc++:
-       https://gcc.gnu.org/bugzilla/show_bug.cgi?id=41975 */
-    addBenchmarks({&Benchmark::destruct1kMembersReceiverFirst}, 10);
+                   &Benchmark::destruct1kMembersEmitterFirst,
+                   &Benchmark::destruct1kMembersReceiverFirst}, 100);
 
     addBenchmarks({&Benchmark::call1kFunctions,
                    &Benchmark::call1kStdFunctions,
@@ -80,6 +84,14 @@ Benchmark::Benchmark() {
                    &Benchmark::call1kSlotLambdas,
                    &Benchmark::call1kSlotLambdasHeap,
                    &Benchmark::call1kSlotMembers}, 25);
+
+    addBenchmarks({&Benchmark::connect1kSignalObjectFunctions}, 10);
+
+    addBenchmarks({&Benchmark::destruct1kSignalObjectMembersReceiverFirst}, 100);
+
+    addBenchmarks({&Benchmark::callSignalObjectFunction1000x,
+                   &Benchmark::call1kSignalObjectFunctions,
+                   &Benchmark::call1kSignalObjectMembers}, 25);
 }
 
 int globalOutput;
@@ -384,6 +396,77 @@ void Benchmark::call1kSlotMembers() {
     CORRADE_COMPARE(receiver.output, 1000*100);
 }
 
+void Benchmark::connect1kSignalObjectFunctions() {
+    Signal<> fire;
+
+    CORRADE_BENCHMARK(1000)
+        connect(fire, freeFunctionSlot);
+
+    CORRADE_COMPARE(fire.connectionCount(), 1000);
+}
+
+void Benchmark::destruct1kSignalObjectMembersReceiverFirst() {
+    Signal<> fire;
+
+    struct R: Receiver {
+        int output = 0;
+
+        void receive() { ++output; }
+    };
+
+    Containers::Optional<R> receiver{InPlaceInit};
+
+    for(std::size_t i = 0; i != 1000; ++i)
+        connect(fire, *receiver, &R::receive);
+
+    CORRADE_BENCHMARK(1)
+        receiver = Containers::NullOpt;
+}
+
+void Benchmark::callSignalObjectFunction1000x() {
+    globalOutput = 0;
+
+    Signal<> fire;
+    connect(fire, freeFunctionSlot);
+
+    CORRADE_BENCHMARK(100)
+        for(std::size_t i = 0; i != 1000; ++i)
+            fire.emit();
+
+    CORRADE_COMPARE(globalOutput, 1000*100);
+}
+
+void Benchmark::call1kSignalObjectFunctions() {
+    globalOutput = 0;
+
+    Signal<> fire;
+    for(std::size_t i = 0; i != 1000; ++i)
+        connect(fire, freeFunctionSlot);
+
+    CORRADE_BENCHMARK(100)
+        fire.emit();
+
+    CORRADE_COMPARE(globalOutput, 1000*100);
+}
+
+void Benchmark::call1kSignalObjectMembers() {
+    Signal<> fire;
+
+    struct R: Receiver {
+        int output = 0;
+
+        void receive() { ++output; }
+    } receiver;
+
+    for(std::size_t i = 0; i != 1000; ++i)
+        connect(fire, receiver, &R::receive);
+
+    CORRADE_BENCHMARK(100)
+        fire.emit();
+
+    CORRADE_COMPARE(receiver.output, 1000*100);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::Interconnect::Test::Benchmark)
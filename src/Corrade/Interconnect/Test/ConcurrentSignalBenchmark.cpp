@@ -0,0 +1,165 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#include <vector>
+#endif
+
+#include "Corrade/Interconnect/ConcurrentSignal.h"
+#include "Corrade/Interconnect/Signal.h"
+#include "Corrade/TestSuite/Tester.h"
+
+namespace Corrade { namespace Interconnect { namespace Test { namespace {
+
+struct ConcurrentSignalBenchmark: TestSuite::Tester {
+    explicit ConcurrentSignalBenchmark();
+
+    void callSignalFunction1000x();
+    void callConcurrentSignalFunction1000x();
+    void call1kConcurrentSignalFunctions();
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    void callConcurrentSignalFunction1000xThreaded();
+    void callConcurrentSignalFunction1000xThreadedWhileConnecting();
+    #endif
+};
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+constexpr std::size_t ThreadCount = 4;
+#endif
+
+ConcurrentSignalBenchmark::ConcurrentSignalBenchmark() {
+    addBenchmarks({&ConcurrentSignalBenchmark::callSignalFunction1000x,
+                   &ConcurrentSignalBenchmark::callConcurrentSignalFunction1000x,
+                   &ConcurrentSignalBenchmark::call1kConcurrentSignalFunctions,
+                   #ifndef CORRADE_TARGET_EMSCRIPTEN
+                   &ConcurrentSignalBenchmark::callConcurrentSignalFunction1000xThreaded,
+                   &ConcurrentSignalBenchmark::callConcurrentSignalFunction1000xThreadedWhileConnecting
+                   #endif
+                   }, 25);
+}
+
+std::atomic<std::size_t> globalOutput;
+
+CORRADE_NEVER_INLINE void freeFunctionSlot() {
+    globalOutput.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ConcurrentSignalBenchmark::callSignalFunction1000x() {
+    globalOutput = 0;
+
+    Signal<> fire;
+    connect(fire, freeFunctionSlot);
+
+    CORRADE_BENCHMARK(100)
+        for(std::size_t i = 0; i != 1000; ++i)
+            fire.emit();
+
+    CORRADE_COMPARE(globalOutput, 1000*100);
+}
+
+void ConcurrentSignalBenchmark::callConcurrentSignalFunction1000x() {
+    globalOutput = 0;
+
+    ConcurrentSignal<> fire;
+    connect(fire, freeFunctionSlot);
+
+    CORRADE_BENCHMARK(100)
+        for(std::size_t i = 0; i != 1000; ++i)
+            fire.emit();
+
+    CORRADE_COMPARE(globalOutput, 1000*100);
+}
+
+void ConcurrentSignalBenchmark::call1kConcurrentSignalFunctions() {
+    globalOutput = 0;
+
+    ConcurrentSignal<> fire;
+    for(std::size_t i = 0; i != 1000; ++i)
+        connect(fire, freeFunctionSlot);
+
+    CORRADE_BENCHMARK(100)
+        fire.emit();
+
+    CORRADE_COMPARE(globalOutput, 1000*100);
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void ConcurrentSignalBenchmark::callConcurrentSignalFunction1000xThreaded() {
+    globalOutput = 0;
+
+    ConcurrentSignal<> fire;
+    connect(fire, freeFunctionSlot);
+
+    /* Each thread emits 1000x, the measured time includes thread startup */
+    CORRADE_BENCHMARK(1) {
+        std::vector<std::thread> threads;
+        for(std::size_t i = 0; i != ThreadCount; ++i) threads.emplace_back([&fire]() {
+            for(std::size_t j = 0; j != 1000; ++j)
+                fire.emit();
+        });
+        for(std::thread& t: threads) t.join();
+    }
+
+    CORRADE_COMPARE(globalOutput, ThreadCount*1000);
+}
+
+void ConcurrentSignalBenchmark::callConcurrentSignalFunction1000xThreadedWhileConnecting() {
+    globalOutput = 0;
+
+    ConcurrentSignal<> fire;
+    connect(fire, freeFunctionSlot);
+
+    std::atomic<bool> done{false};
+    std::thread modifier{[&]() {
+        while(!done) {
+            Connection c = connect(fire, []() {});
+            disconnect(fire, c);
+        }
+    }};
+
+    CORRADE_BENCHMARK(1) {
+        std::vector<std::thread> threads;
+        for(std::size_t i = 0; i != ThreadCount; ++i) threads.emplace_back([&fire]() {
+            for(std::size_t j = 0; j != 1000; ++j)
+                fire.emit();
+        });
+        for(std::thread& t: threads) t.join();
+    }
+
+    done = true;
+    modifier.join();
+
+    CORRADE_COMPARE(globalOutput, ThreadCount*1000);
+}
+#endif
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Interconnect::Test::ConcurrentSignalBenchmark)
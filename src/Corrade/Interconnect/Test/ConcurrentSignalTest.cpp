@@ -0,0 +1,214 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+
+#include "Corrade/Containers/Optional.h"
+#include "Corrade/Interconnect/ConcurrentSignal.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/DebugStl.h"
+
+namespace Corrade { namespace Interconnect { namespace Test { namespace {
+
+struct ConcurrentSignalTest: TestSuite::Tester {
+    explicit ConcurrentSignalTest();
+
+    void connect();
+    void disconnect();
+    void disconnectAll();
+    void destroy();
+
+    void emit();
+    void changeConnectionsInSlot();
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    void multithreaded();
+    #endif
+};
+
+ConcurrentSignalTest::ConcurrentSignalTest() {
+    addTests({&ConcurrentSignalTest::connect,
+              &ConcurrentSignalTest::disconnect,
+              &ConcurrentSignalTest::disconnectAll,
+              &ConcurrentSignalTest::destroy,
+
+              &ConcurrentSignalTest::emit,
+              &ConcurrentSignalTest::changeConnectionsInSlot,
+
+              #ifndef CORRADE_TARGET_EMSCRIPTEN
+              &ConcurrentSignalTest::multithreaded
+              #endif
+              });
+}
+
+void ConcurrentSignalTest::connect() {
+    ConcurrentSignal<int> signal;
+    CORRADE_VERIFY(!signal.hasConnections());
+    CORRADE_COMPARE(signal.connectionCount(), 0);
+
+    Connection c1 = Interconnect::connect(signal, [](int) {});
+    Connection c2 = Interconnect::connect(signal, [](int) {});
+    CORRADE_VERIFY(signal.hasConnections());
+    CORRADE_COMPARE(signal.connectionCount(), 2);
+    CORRADE_VERIFY(signal.isConnected(c1));
+    CORRADE_VERIFY(signal.isConnected(c2));
+
+    ConcurrentSignal<int> another;
+    CORRADE_VERIFY(!another.isConnected(c1));
+}
+
+void ConcurrentSignalTest::disconnect() {
+    ConcurrentSignal<int> signal;
+    Connection c1 = Interconnect::connect(signal, [](int) {});
+    Connection c2 = Interconnect::connect(signal, [](int) {});
+    Connection c3 = Interconnect::connect(signal, [](int) {});
+
+    CORRADE_VERIFY(Interconnect::disconnect(signal, c2));
+    CORRADE_VERIFY(signal.isConnected(c1));
+    CORRADE_VERIFY(!signal.isConnected(c2));
+    CORRADE_VERIFY(signal.isConnected(c3));
+    CORRADE_COMPARE(signal.connectionCount(), 2);
+
+    /* Disconnecting the second time fails */
+    CORRADE_VERIFY(!Interconnect::disconnect(signal, c2));
+}
+
+void ConcurrentSignalTest::disconnectAll() {
+    ConcurrentSignal<int> signal;
+    Connection c1 = Interconnect::connect(signal, [](int) {});
+    Connection c2 = Interconnect::connect(signal, [](int) {});
+
+    signal.disconnectAll();
+    CORRADE_VERIFY(!signal.isConnected(c1));
+    CORRADE_VERIFY(!signal.isConnected(c2));
+    CORRADE_VERIFY(!signal.hasConnections());
+
+    /* Disconnecting everything the second time is a no-op */
+    signal.disconnectAll();
+    CORRADE_VERIFY(!signal.hasConnections());
+}
+
+int globalCounter;
+
+void ConcurrentSignalTest::destroy() {
+    struct Destructor {
+        int value = 3;
+        ~Destructor() { globalCounter += 7; }
+    } a;
+
+    {
+        ConcurrentSignal<int> signal;
+        Interconnect::connect(signal, [a](int) { globalCounter += a.value; });
+        globalCounter = 0;
+        signal.emit(0);
+        CORRADE_COMPARE(globalCounter, 3);
+    }
+
+    /* The heap-allocated lambda got destructed together with the signal */
+    CORRADE_COMPARE(globalCounter, 10);
+}
+
+void ConcurrentSignalTest::emit() {
+    ConcurrentSignal<int, const std::string&> signal;
+    std::vector<std::string> messages;
+    int money = 0;
+    Interconnect::connect(signal, [&](int price, const std::string& message) {
+        money += price;
+        messages.push_back(message);
+    });
+    Interconnect::connect(signal, [&](int, const std::string& message) {
+        messages.push_back(message + "!");
+    });
+
+    signal.emit(60, "hello");
+    CORRADE_COMPARE(money, 60);
+    CORRADE_COMPARE(messages, (std::vector<std::string>{"hello", "hello!"}));
+}
+
+void ConcurrentSignalTest::changeConnectionsInSlot() {
+    ConcurrentSignal<int> signal;
+
+    Containers::Optional<Connection> self;
+    int called = 0;
+    int newCalled = 0;
+    self = Interconnect::connect(signal, [&](int) {
+        ++called;
+        /* Disconnects itself and connects a new slot, which doesn't get
+           called until the next emit */
+        Interconnect::disconnect(signal, *self);
+        Interconnect::connect(signal, [&](int) { ++newCalled; });
+    });
+
+    signal.emit(0);
+    CORRADE_COMPARE(called, 1);
+    CORRADE_COMPARE(newCalled, 0);
+    CORRADE_COMPARE(signal.connectionCount(), 1);
+
+    signal.emit(0);
+    CORRADE_COMPARE(called, 1);
+    CORRADE_COMPARE(newCalled, 1);
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void ConcurrentSignalTest::multithreaded() {
+    ConcurrentSignal<int> signal;
+    std::atomic<int> sum{0};
+    Interconnect::connect(signal, [&sum](int value) { sum += value; });
+
+    /* Emit from a bunch of threads while another thread keeps connecting and
+       disconnecting another slot */
+    std::atomic<bool> done{false};
+    std::atomic<int> otherSum{0};
+    std::thread modifier{[&]() {
+        while(!done) {
+            Connection c = Interconnect::connect(signal, [&otherSum](int value) { otherSum += value; });
+            Interconnect::disconnect(signal, c);
+        }
+    }};
+
+    std::vector<std::thread> emitters;
+    for(std::size_t i = 0; i != 4; ++i) emitters.emplace_back([&signal]() {
+        for(std::size_t j = 0; j != 10000; ++j) signal.emit(1);
+    });
+    for(std::thread& t: emitters) t.join();
+    done = true;
+    modifier.join();
+
+    CORRADE_COMPARE(sum, 4*10000);
+    CORRADE_COMPARE(signal.connectionCount(), 1);
+    CORRADE_INFO("The temporary slot got called" << otherSum.load() << "times");
+}
+#endif
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Interconnect::Test::ConcurrentSignalTest)
@@ -0,0 +1,290 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <vector>
+
+#include "Corrade/Containers/Optional.h"
+#include "Corrade/Interconnect/Receiver.h"
+#include "Corrade/Interconnect/Signal.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/DebugStl.h"
+
+namespace Corrade { namespace Interconnect { namespace Test { namespace {
+
+struct SignalTest: TestSuite::Tester {
+    explicit SignalTest();
+
+    void connect();
+    void disconnect();
+    void disconnectAll();
+    void destroySignal();
+    void destroyReceiver();
+
+    void emit();
+    void emitInEmitterSubclass();
+    void changeConnectionsInSlot();
+    void deleteReceiverInSlot();
+};
+
+SignalTest::SignalTest() {
+    addTests({&SignalTest::connect,
+              &SignalTest::disconnect,
+              &SignalTest::disconnectAll,
+              &SignalTest::destroySignal,
+              &SignalTest::destroyReceiver,
+
+              &SignalTest::emit,
+              &SignalTest::emitInEmitterSubclass,
+              &SignalTest::changeConnectionsInSlot,
+              &SignalTest::deleteReceiverInSlot});
+}
+
+struct Postman {
+    Signal<int, const std::string&> newMessage;
+    Signal<int> paymentRequested;
+};
+
+class Mailbox: public Interconnect::Receiver {
+    public:
+        void addMessage(int price, const std::string& message) {
+            money += price;
+            messages.push_back(message);
+        }
+
+        void pay(int amount) {
+            money -= amount;
+        }
+
+        int money = 0;
+        std::vector<std::string> messages;
+};
+
+void SignalTest::connect() {
+    Postman postman;
+    Mailbox mailbox1, mailbox2;
+    CORRADE_VERIFY(!postman.newMessage.hasConnections());
+    CORRADE_COMPARE(postman.newMessage.connectionCount(), 0);
+
+    Connection connection = Interconnect::connect(postman.newMessage, mailbox1, &Mailbox::addMessage);
+    CORRADE_VERIFY(postman.newMessage.isConnected(connection));
+    CORRADE_VERIFY(!postman.paymentRequested.isConnected(connection));
+
+    Interconnect::connect(postman.paymentRequested, mailbox1, &Mailbox::pay);
+    Interconnect::connect(postman.newMessage, mailbox2, &Mailbox::addMessage);
+    Interconnect::connect(postman.paymentRequested, [](int) {});
+    CORRADE_VERIFY(postman.newMessage.hasConnections());
+    CORRADE_COMPARE(postman.newMessage.connectionCount(), 2);
+    CORRADE_VERIFY(postman.paymentRequested.hasConnections());
+    CORRADE_COMPARE(postman.paymentRequested.connectionCount(), 2);
+    CORRADE_COMPARE(mailbox1.slotConnectionCount(), 2);
+    CORRADE_COMPARE(mailbox2.slotConnectionCount(), 1);
+}
+
+void SignalTest::disconnect() {
+    Postman postman;
+    Mailbox mailbox1, mailbox2;
+
+    Connection connection = Interconnect::connect(postman.newMessage, mailbox1, &Mailbox::addMessage);
+    Interconnect::connect(postman.paymentRequested, mailbox1, &Mailbox::pay);
+    Interconnect::connect(postman.newMessage, mailbox2, &Mailbox::addMessage);
+
+    /* Disconnecting from a different signal fails */
+    CORRADE_VERIFY(!Interconnect::disconnect(postman.paymentRequested, connection));
+
+    CORRADE_VERIFY(Interconnect::disconnect(postman.newMessage, connection));
+    CORRADE_VERIFY(!postman.newMessage.isConnected(connection));
+    CORRADE_COMPARE(postman.newMessage.connectionCount(), 1);
+    CORRADE_COMPARE(mailbox1.slotConnectionCount(), 1);
+
+    /* Disconnecting the second time fails */
+    CORRADE_VERIFY(!Interconnect::disconnect(postman.newMessage, connection));
+
+    /* A new connection reuses the removed one internally, the old handle
+       still shouldn't match it */
+    Connection connection2 = Interconnect::connect(postman.newMessage, mailbox1, &Mailbox::addMessage);
+    CORRADE_VERIFY(postman.newMessage.isConnected(connection2));
+    CORRADE_VERIFY(!postman.newMessage.isConnected(connection));
+    CORRADE_VERIFY(!Interconnect::disconnect(postman.newMessage, connection));
+    CORRADE_VERIFY(postman.newMessage.isConnected(connection2));
+    CORRADE_COMPARE(mailbox1.slotConnectionCount(), 2);
+}
+
+void SignalTest::disconnectAll() {
+    Postman postman;
+    Mailbox mailbox1, mailbox2;
+
+    Connection c1 = Interconnect::connect(postman.newMessage, mailbox1, &Mailbox::addMessage);
+    Connection c2 = Interconnect::connect(postman.newMessage, mailbox2, &Mailbox::addMessage);
+    Connection c3 = Interconnect::connect(postman.paymentRequested, mailbox1, &Mailbox::pay);
+
+    postman.newMessage.disconnectAll();
+    CORRADE_VERIFY(!postman.newMessage.isConnected(c1));
+    CORRADE_VERIFY(!postman.newMessage.isConnected(c2));
+    CORRADE_VERIFY(postman.paymentRequested.isConnected(c3));
+    CORRADE_VERIFY(!postman.newMessage.hasConnections());
+    CORRADE_COMPARE(mailbox1.slotConnectionCount(), 1);
+    CORRADE_COMPARE(mailbox2.slotConnectionCount(), 0);
+}
+
+void SignalTest::destroySignal() {
+    Mailbox mailbox;
+    Postman postman2;
+
+    Postman* postman1 = new Postman;
+    Connection c1 = Interconnect::connect(postman1->newMessage, mailbox, &Mailbox::addMessage);
+    Interconnect::connect(postman1->paymentRequested, mailbox, &Mailbox::pay);
+    Connection c3 = Interconnect::connect(postman2.newMessage, mailbox, &Mailbox::addMessage);
+    CORRADE_COMPARE(mailbox.slotConnectionCount(), 3);
+
+    delete postman1;
+    CORRADE_VERIFY(postman2.newMessage.isConnected(c3));
+    CORRADE_COMPARE(mailbox.slotConnectionCount(), 1);
+
+    /* A handle from the destroyed signal shouldn't be treated as belonging to
+       the other one, and its connection shouldn't be accessed as it's
+       deleted already */
+    CORRADE_VERIFY(!postman2.newMessage.isConnected(c1));
+    CORRADE_VERIFY(!Interconnect::disconnect(postman2.newMessage, c1));
+    CORRADE_VERIFY(postman2.newMessage.isConnected(c3));
+}
+
+void SignalTest::destroyReceiver() {
+    Postman postman;
+    Mailbox* mailbox1 = new Mailbox;
+    Mailbox mailbox2;
+
+    Connection c1 = Interconnect::connect(postman.newMessage, *mailbox1, &Mailbox::addMessage);
+    Connection c2 = Interconnect::connect(postman.paymentRequested, *mailbox1, &Mailbox::pay);
+    Connection c3 = Interconnect::connect(postman.newMessage, mailbox2, &Mailbox::addMessage);
+
+    delete mailbox1;
+    CORRADE_VERIFY(!postman.newMessage.isConnected(c1));
+    CORRADE_VERIFY(!postman.paymentRequested.isConnected(c2));
+    CORRADE_VERIFY(postman.newMessage.isConnected(c3));
+    CORRADE_COMPARE(postman.newMessage.connectionCount(), 1);
+    CORRADE_VERIFY(!postman.paymentRequested.hasConnections());
+}
+
+void SignalTest::emit() {
+    Postman postman;
+    Mailbox mailbox1, mailbox2;
+    std::vector<int> order;
+    Interconnect::connect(postman.paymentRequested, [&order](int) { order.push_back(1); });
+    Interconnect::connect(postman.newMessage, mailbox1, &Mailbox::addMessage);
+    Interconnect::connect(postman.newMessage, mailbox2, &Mailbox::addMessage);
+    Interconnect::connect(postman.paymentRequested, mailbox1, &Mailbox::pay);
+    Interconnect::connect(postman.paymentRequested, [&order](int) { order.push_back(2); });
+
+    postman.newMessage.emit(60, "hello");
+    postman.paymentRequested.emit(50);
+    CORRADE_COMPARE(mailbox1.messages, std::vector<std::string>{"hello"});
+    CORRADE_COMPARE(mailbox1.money, 10);
+    CORRADE_COMPARE(mailbox2.messages, std::vector<std::string>{"hello"});
+    CORRADE_COMPARE(mailbox2.money, 60);
+    CORRADE_COMPARE(order, (std::vector<int>{1, 2}));
+}
+
+void SignalTest::emitInEmitterSubclass() {
+    /* Signal objects can coexist with Emitter signals, the type just has to be
+       fully qualified */
+    class Postman: public Emitter {
+        public:
+            Signal newMessage(int price, const std::string& message) {
+                return emit(&Postman::newMessage, price, message);
+            }
+
+            Interconnect::Signal<int> paymentRequested;
+    } postman;
+
+    Mailbox mailbox;
+    Interconnect::connect(postman, &Postman::newMessage, mailbox, &Mailbox::addMessage);
+    Interconnect::connect(postman.paymentRequested, mailbox, &Mailbox::pay);
+    CORRADE_COMPARE(postman.signalConnectionCount(), 1);
+    CORRADE_COMPARE(postman.paymentRequested.connectionCount(), 1);
+    CORRADE_COMPARE(mailbox.slotConnectionCount(), 2);
+
+    postman.newMessage(30, "hello");
+    postman.paymentRequested.emit(50);
+    CORRADE_COMPARE(mailbox.messages, std::vector<std::string>{"hello"});
+    CORRADE_COMPARE(mailbox.money, -20);
+}
+
+void SignalTest::changeConnectionsInSlot() {
+    Postman postman;
+    Mailbox mailbox1, mailbox2;
+
+    Containers::Optional<Connection> other;
+    int called = 0;
+    bool disconnected = false;
+    Interconnect::connect(postman.newMessage, [&](int, const std::string&) {
+        /* Disconnect the other connection and add a new one, which will get
+           called in this emit as well */
+        if(!called++) {
+            disconnected = Interconnect::disconnect(postman.newMessage, *other);
+            Interconnect::connect(postman.newMessage, mailbox2, &Mailbox::addMessage);
+        }
+    });
+    other = Interconnect::connect(postman.newMessage, mailbox1, &Mailbox::addMessage);
+
+    postman.newMessage.emit(10, "hello");
+    CORRADE_COMPARE(called, 1);
+    CORRADE_VERIFY(disconnected);
+    CORRADE_COMPARE(postman.newMessage.connectionCount(), 2);
+    CORRADE_COMPARE(mailbox1.messages, std::vector<std::string>{});
+    CORRADE_COMPARE(mailbox2.messages, std::vector<std::string>{"hello"});
+
+    postman.newMessage.emit(20, "again");
+    CORRADE_COMPARE(called, 2);
+    CORRADE_COMPARE(mailbox2.messages, (std::vector<std::string>{"hello", "again"}));
+}
+
+void SignalTest::deleteReceiverInSlot() {
+    class SuicideMailbox: public Interconnect::Receiver {
+        public:
+            void addMessage(int, const std::string&) {
+                delete this;
+            }
+    };
+
+    Postman postman;
+    Mailbox mailbox1, mailbox2;
+    SuicideMailbox* mailbox3 = new SuicideMailbox;
+    Interconnect::connect(postman.newMessage, mailbox1, &Mailbox::addMessage);
+    Interconnect::connect(postman.newMessage, *mailbox3, &SuicideMailbox::addMessage);
+    Interconnect::connect(postman.newMessage, mailbox2, &Mailbox::addMessage);
+    CORRADE_COMPARE(postman.newMessage.connectionCount(), 3);
+
+    /* This shouldn't crash */
+    postman.newMessage.emit(11, "hello");
+    CORRADE_COMPARE(postman.newMessage.connectionCount(), 2);
+    CORRADE_COMPARE(mailbox1.messages, std::vector<std::string>{"hello"});
+    CORRADE_COMPARE(mailbox2.messages, std::vector<std::string>{"hello"});
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Interconnect::Test::SignalTest)
@@ -25,6 +25,7 @@
 */
 
 #include <functional>
+#include <vector>
 #include <sstream>
 
 #include "Corrade/Interconnect/Emitter.h"
@@ -57,6 +58,7 @@ struct Test: TestSuite::Tester {
 
     void destroyEmitter();
     void destroyReceiver();
+    void destroyReceiverInTheMiddle();
 
     void emit();
     void emitterSubclass();
@@ -154,6 +156,7 @@ Test::Test() {
 
               &Test::destroyEmitter,
               &Test::destroyReceiver,
+              &Test::destroyReceiverInTheMiddle,
 
               &Test::emit,
               &Test::emitterSubclass,
@@ -440,6 +443,15 @@ void Test::disconnect() {
 
     /* Disconnecting the second time fails */
     CORRADE_VERIFY(!Interconnect::disconnect(postman, connection));
+
+    /* A new connection reuses the removed one internally, the old handle
+       still shouldn't match it */
+    Connection connection2 = Interconnect::connect(postman, &Postman::newMessage, mailbox1, &Mailbox::addMessage);
+    CORRADE_VERIFY(postman.isConnected(connection2));
+    CORRADE_VERIFY(!postman.isConnected(connection));
+    CORRADE_VERIFY(!Interconnect::disconnect(postman, connection));
+    CORRADE_VERIFY(postman.isConnected(connection2));
+    CORRADE_COMPARE(mailbox1.slotConnectionCount(), 2);
 }
 
 void Test::disconnectSignal() {
@@ -501,7 +513,7 @@ void Test::destroyEmitter() {
     Postman postman2;
     Mailbox mailbox;
 
-    Interconnect::connect(*postman1, &Postman::newMessage, mailbox, &Mailbox::addMessage);
+    Connection c1 = Interconnect::connect(*postman1, &Postman::newMessage, mailbox, &Mailbox::addMessage);
     Interconnect::connect(*postman1, &Postman::paymentRequested, mailbox, &Mailbox::pay);
     Connection c3 = Interconnect::connect(postman2, &Postman::newMessage, mailbox, &Mailbox::addMessage);
 
@@ -512,6 +524,13 @@ void Test::destroyEmitter() {
     CORRADE_VERIFY(postman2.isConnected(c3));
     CORRADE_COMPARE(postman2.signalConnectionCount(), 1);
     CORRADE_COMPARE(mailbox.slotConnectionCount(), 1);
+
+    /* A handle from the destroyed emitter is for the same signal but
+       shouldn't be treated as belonging to the other emitter, and its
+       connection shouldn't be accessed as it's deleted already */
+    CORRADE_VERIFY(!postman2.isConnected(c1));
+    CORRADE_VERIFY(!Interconnect::disconnect(postman2, c1));
+    CORRADE_VERIFY(postman2.isConnected(c3));
 }
 
 void Test::destroyReceiver() {
@@ -531,6 +550,50 @@ void Test::destroyReceiver() {
     CORRADE_COMPARE(mailbox2.slotConnectionCount(), 1);
 }
 
+void Test::destroyReceiverInTheMiddle() {
+    Postman postman;
+    Mailbox mailbox1;
+    Mailbox *mailbox2 = new Mailbox;
+    Mailbox mailbox3;
+
+    std::vector<int> order;
+    Connection c1 = Interconnect::connect(postman, &Postman::paymentRequested, [&order](int) { order.push_back(1); });
+    Connection c2 = Interconnect::connect(postman, &Postman::paymentRequested, mailbox1, &Mailbox::pay);
+    Connection c3 = Interconnect::connect(postman, &Postman::paymentRequested, *mailbox2, &Mailbox::pay);
+    Connection c4 = Interconnect::connect(postman, &Postman::paymentRequested, mailbox3, &Mailbox::pay);
+    Connection c5 = Interconnect::connect(postman, &Postman::paymentRequested, [&order](int) { order.push_back(5); });
+    Connection c6 = Interconnect::connect(postman, &Postman::newMessage, *mailbox2, &Mailbox::addMessage);
+    CORRADE_COMPARE(postman.signalConnectionCount(), 6);
+    CORRADE_COMPARE(postman.signalConnectionCount(&Postman::paymentRequested), 5);
+    CORRADE_COMPARE(mailbox2->slotConnectionCount(), 2);
+
+    /* Removing a connection from the middle of both the signal and the
+       receiver list keeps the remaining ones intact */
+    delete mailbox2;
+    CORRADE_VERIFY(postman.isConnected(c1));
+    CORRADE_VERIFY(postman.isConnected(c2));
+    CORRADE_VERIFY(!postman.isConnected(c3));
+    CORRADE_VERIFY(postman.isConnected(c4));
+    CORRADE_VERIFY(postman.isConnected(c5));
+    CORRADE_VERIFY(!postman.isConnected(c6));
+    CORRADE_COMPARE(postman.signalConnectionCount(), 4);
+    CORRADE_COMPARE(postman.signalConnectionCount(&Postman::paymentRequested), 4);
+    CORRADE_VERIFY(!postman.hasSignalConnections(&Postman::newMessage));
+
+    /* Then the first and the last one */
+    CORRADE_VERIFY(Interconnect::disconnect(postman, c1));
+    CORRADE_VERIFY(Interconnect::disconnect(postman, c4));
+    CORRADE_COMPARE(postman.signalConnectionCount(&Postman::paymentRequested), 2);
+    CORRADE_COMPARE(mailbox3.slotConnectionCount(), 0);
+
+    /* Slots are called in the order the connections were made */
+    c1 = Interconnect::connect(postman, &Postman::paymentRequested, [&order](int) { order.push_back(6); });
+    postman.paymentRequested(10);
+    CORRADE_COMPARE(mailbox1.money, -10);
+    CORRADE_COMPARE(mailbox3.money, 0);
+    CORRADE_COMPARE(order, (std::vector<int>{5, 6}));
+}
+
 void Test::emit() {
     Postman postman;
     Mailbox mailbox1, mailbox2, mailbox3;
@@ -47,7 +47,11 @@
 #include "Corrade/Utility/String.h"
 
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+#include <chrono>
+
 #include "Corrade/Utility/Directory.h"
+#include "Corrade/Utility/FileWatcher.h"
+#include "Corrade/Utility/FormatStl.h"
 
 #ifndef CORRADE_TARGET_WINDOWS
 #include <dlfcn.h>
@@ -103,6 +107,34 @@ struct AbstractManager::Plugin {
     std::vector<AbstractPlugin*> instances;
 
     #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    /* A binary that got replaced by reload() but still has live instances.
+       It's closed once instanceCount drops to zero. */
+    struct RetiredModule {
+        #ifndef CORRADE_TARGET_WINDOWS
+        void* module;
+        #else
+        HMODULE module;
+        #endif
+        void(*finalizer)();
+        std::string shadowFilename;
+        std::size_t generation;
+        std::size_t instanceCount;
+    };
+
+    /* Path the plugin binary was loaded from and, if hot-reload was enabled
+       at that point, path of the shadow copy that's actually opened */
+    std::string filename;
+    std::string shadowFilename;
+    Containers::Optional<Utility::FileWatcher> watcher;
+    /* Incremented every time a binary is opened, instances remember the
+       generation they were created from. Instance count is only for the
+       current generation, the rest is in retiredModules. */
+    std::size_t generation{};
+    std::size_t instanceCount{};
+    std::vector<RetiredModule> retiredModules;
+    /* How long the last successful reload took */
+    std::chrono::nanoseconds reloadDuration{};
+
     /* Constructor for dynamic plugins */
     explicit Plugin(std::string name, const std::string& metadata);
     #endif
@@ -148,8 +180,24 @@ struct AbstractManager::State {
     #ifndef CORRADE_NO_ASSERT
     std::set<AbstractManager*> externalManagerUsedBy;
     #endif
+
+    bool hotReload{};
+    LoadFlags loadFlags;
+    #endif
+};
+
+#ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+struct AbstractManager::Module {
+    #ifndef CORRADE_TARGET_WINDOWS
+    void* module;
+    #else
+    HMODULE module;
     #endif
+    Instancer instancer;
+    void(*initializer)();
+    void(*finalizer)();
 };
+#endif
 
 const int AbstractManager::Version = CORRADE_PLUGIN_VERSION;
 
@@ -352,6 +400,50 @@ AbstractManager::~AbstractManager() {
 }
 
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+namespace {
+
+/* The manager and plugin address make the name unique among all managers
+   in this process, the generation among binaries of the same plugin. Using
+   a new name for every binary is important, as opening a path that's still
+   open would give back the previous binary. */
+std::string shadowFilenameFor(const AbstractManager& manager, const AbstractManager::Plugin& plugin, const std::string& suffix) {
+    return Directory::join(Directory::tmp(), formatString("corrade-{}-{:x}-{:x}-{}{}", plugin.metadata.name(), reinterpret_cast<std::uintptr_t>(&manager), reinterpret_cast<std::uintptr_t>(&plugin), plugin.generation + 1, suffix));
+}
+
+void closeRetiredModule(const AbstractManager::Plugin& plugin, const AbstractManager::Plugin::RetiredModule& module) {
+    module.finalizer();
+
+    #ifndef CORRADE_TARGET_WINDOWS
+    if(dlclose(module.module) != 0)
+    #else
+    if(!FreeLibrary(module.module))
+    #endif
+    {
+        Error{} << "PluginManager::Manager: cannot unload a previous binary of plugin"
+            << plugin.metadata.name() << Debug::nospace << ":"
+            #ifndef CORRADE_TARGET_WINDOWS
+            << dlerror()
+            #else
+            << Utility::Implementation::windowsErrorString(GetLastError())
+            #endif
+            ;
+    }
+
+    if(!module.shadowFilename.empty()) Directory::rm(module.shadowFilename);
+}
+
+void closeUnusedRetiredModules(AbstractManager::Plugin& plugin) {
+    /* Not done directly in reregisterInstance(), as that's called from the
+       instance destructor which is still executing code of the binary */
+    for(std::size_t i = plugin.retiredModules.size(); i != 0; --i) {
+        if(plugin.retiredModules[i - 1].instanceCount) continue;
+        closeRetiredModule(plugin, plugin.retiredModules[i - 1]);
+        plugin.retiredModules.erase(plugin.retiredModules.begin() + i - 1);
+    }
+}
+
+}
+
 LoadState AbstractManager::unloadRecursiveInternal(Plugin& plugin) {
     /* If the plugin is not static and is used by others, try to unload these
        first so it can be unloaded too. This function is called from the
@@ -441,6 +533,14 @@ void AbstractManager::setPluginDirectory(std::string directory) {
 void AbstractManager::reloadPluginDirectory() {
     setPluginDirectory(pluginDirectory());
 }
+
+LoadFlags AbstractManager::loadFlags() const {
+    return _state->loadFlags;
+}
+
+void AbstractManager::setLoadFlags(const LoadFlags flags) {
+    _state->loadFlags = flags;
+}
 #endif
 
 void AbstractManager::setPreferredPlugins(const std::string& alias, const std::initializer_list<std::string> plugins) {
@@ -597,10 +697,92 @@ LoadState AbstractManager::loadInternal(Plugin& plugin, const std::string& filen
         dependencies.emplace_back(*foundDependency->second);
     }
 
+    /* Open the binary, unless it's deferred to the first instantiation */
+    plugin.filename = filename;
+    if(!(_state->loadFlags & LoadFlag::Deferred)) {
+        const LoadState state = openInternal(plugin);
+        if(state != LoadState::Loaded) return state;
+    }
+
+    /* Everything is okay, add this plugin to usedBy list of each dependency */
+    for(Plugin& dependency: dependencies)
+        dependency.metadata._usedBy.push_back(plugin.metadata._name);
+
+    /* Set state to loaded, or deferred if the binary isn't opened yet */
+    plugin.loadState = plugin.module ? LoadState::Loaded : LoadState::Deferred;
+    if(_state->hotReload)
+        plugin.watcher.emplace(filename, FileWatcher::Flag::IgnoreErrors|FileWatcher::Flag::IgnoreChangeIfEmpty);
+    return plugin.loadState;
+}
+
+LoadState AbstractManager::openInternal(Plugin& plugin) {
+    /* With LoadFlag::Deferred the dependencies might not be opened yet
+       either, open them first so their symbols are available */
+    for(const std::string& dependency: plugin.metadata._depends) {
+        AbstractManager* dependencyManager = this;
+        auto foundDependency = _state->plugins.find(dependency);
+        if(foundDependency == _state->plugins.end()) for(AbstractManager* other: _state->externalManagers) {
+            foundDependency = other->_state->plugins.find(dependency);
+            if(foundDependency != other->_state->plugins.end()) {
+                dependencyManager = other;
+                break;
+            }
+        }
+
+        /* Dependencies were already resolved in loadInternal() */
+        Plugin& dependencyPlugin = *foundDependency->second;
+        if(dependencyPlugin.loadState == LoadState::Deferred) {
+            const LoadState state = dependencyManager->openInternal(dependencyPlugin);
+            if(state != LoadState::Loaded) return state;
+        }
+    }
+
+    /* If hot-reload is enabled, open a shadow copy instead of the file
+       itself so the original can be overwritten while the plugin is loaded */
+    std::string shadowFilename;
+    if(_state->hotReload) {
+        shadowFilename = shadowFilenameFor(*this, plugin, _state->pluginSuffix);
+        if(!Directory::copy(plugin.filename, shadowFilename)) {
+            Error{} << "PluginManager::Manager::load(): cannot create a shadow copy of plugin" << plugin.metadata._name << "in" << shadowFilename;
+            return LoadState::LoadFailed;
+        }
+    }
+
+    Module module;
+    const LoadState state = openInternal(plugin, shadowFilename.empty() ? plugin.filename : shadowFilename, module);
+    if(state != LoadState::Loaded) {
+        if(!shadowFilename.empty()) Directory::rm(shadowFilename);
+        return state;
+    }
+
+    /* Initialize plugin */
+    module.initializer();
+
+    /* Update plugin object */
+    plugin.module = module.module;
+    plugin.instancer = module.instancer;
+    plugin.finalizer = module.finalizer;
+    plugin.shadowFilename = std::move(shadowFilename);
+    plugin.instanceCount = 0;
+    ++plugin.generation;
+
+    /* A deferred plugin is now fully loaded. In loadInternal() the state is
+       still NotLoaded at this point and gets set after. */
+    if(plugin.loadState == LoadState::Deferred)
+        plugin.loadState = LoadState::Loaded;
+    return LoadState::Loaded;
+}
+
+LoadState AbstractManager::openInternal(Plugin& plugin, const std::string& filename, Module& out) {
     /* Open plugin file, make symbols globally available for next libs (which
        may depend on this) */
     #ifndef CORRADE_TARGET_WINDOWS
-    void* module = dlopen(filename.data(), RTLD_NOW|RTLD_GLOBAL);
+    int flags = (_state->loadFlags & LoadFlag::Lazy ? RTLD_LAZY : RTLD_NOW)|
+                (_state->loadFlags & LoadFlag::Local ? RTLD_LOCAL : RTLD_GLOBAL);
+    #ifdef RTLD_NODELETE
+    if(_state->loadFlags & LoadFlag::NoDelete) flags |= RTLD_NODELETE;
+    #endif
+    void* module = dlopen(filename.data(), flags);
     #else
     HMODULE module = LoadLibraryW(widen(filename).data());
     #endif
@@ -777,20 +959,110 @@ LoadState AbstractManager::loadInternal(Plugin& plugin, const std::string& filen
         return LoadState::LoadFailed;
     }
 
-    /* Initialize plugin */
-    initializer();
+    out.module = module;
+    out.instancer = instancer;
+    out.initializer = initializer;
+    out.finalizer = finalizer;
+    return LoadState::Loaded;
+}
 
-    /* Everything is okay, add this plugin to usedBy list of each dependency */
-    for(Plugin& dependency: dependencies)
-        dependency.metadata._usedBy.push_back(plugin.metadata._name);
+LoadState AbstractManager::reloadInternal(Plugin& plugin) {
+    /* Static plugins can't be reloaded and there's nothing to reload for
+       plugins that aren't loaded. If the plugin was loaded with
+       LoadFlag::Deferred and not opened yet, the current binary will get
+       picked up on first instantiation. */
+    if(plugin.loadState != LoadState::Loaded)
+        return plugin.loadState;
+
+    closeUnusedRetiredModules(plugin);
+
+    /* Plugins depending on this one may reference its symbols, don't reload */
+    if(!plugin.metadata._usedBy.empty()) {
+        Error{} << "PluginManager::Manager::reload(): plugin"
+                << plugin.metadata._name << "is required by other plugins:"
+                << plugin.metadata._usedBy;
+        return LoadState::Required;
+    }
+
+    const std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+    /* Always open a fresh shadow copy -- opening the original file again
+       would give back the same handle if the previous binary is still loaded
+       from there */
+    const std::string shadowFilename = shadowFilenameFor(*this, plugin, _state->pluginSuffix);
+    if(!Directory::copy(plugin.filename, shadowFilename)) {
+        Error{} << "PluginManager::Manager::reload(): cannot create a shadow copy of plugin" << plugin.metadata._name << "in" << shadowFilename;
+        return LoadState::LoadFailed;
+    }
+
+    Module module;
+    const LoadState state = openInternal(plugin, shadowFilename, module);
+    if(state != LoadState::Loaded) {
+        Directory::rm(shadowFilename);
+        return state;
+    }
 
-    /* Update plugin object, set state to loaded */
-    plugin.loadState = LoadState::Loaded;
-    plugin.module = module;
-    plugin.instancer = instancer;
-    plugin.finalizer = finalizer;
+    /* If there are no instances of the previous binary, close it right away.
+       Otherwise keep it loaded until the last instance is gone. */
+    Plugin::RetiredModule previous{plugin.module, plugin.finalizer, std::move(plugin.shadowFilename), plugin.generation, plugin.instanceCount};
+    if(previous.instanceCount) plugin.retiredModules.push_back(std::move(previous));
+    else closeRetiredModule(plugin, previous);
+
+    /* Initialize the new binary and use it from now on */
+    module.initializer();
+    plugin.module = module.module;
+    plugin.instancer = module.instancer;
+    plugin.finalizer = module.finalizer;
+    plugin.shadowFilename = shadowFilename;
+    plugin.instanceCount = 0;
+    ++plugin.generation;
+    plugin.reloadDuration = std::chrono::steady_clock::now() - begin;
     return LoadState::Loaded;
 }
+
+LoadState AbstractManager::reload(const std::string& plugin) {
+    auto found = _state->aliases.find(plugin);
+    if(found != _state->aliases.end())
+        return reloadInternal(found->second);
+
+    Error() << "PluginManager::Manager::reload(): plugin" << plugin << "was not found";
+    return LoadState::NotFound;
+}
+
+bool AbstractManager::isHotReloadEnabled() const {
+    return _state->hotReload;
+}
+
+void AbstractManager::setHotReloadEnabled(const bool enabled) {
+    _state->hotReload = enabled;
+
+    /* Watch plugins that are already loaded or stop watching everything */
+    for(std::pair<const std::string, Containers::Pointer<Plugin>>& plugin: _state->plugins) {
+        if(!enabled) plugin.second->watcher = Containers::NullOpt;
+        else if((plugin.second->loadState == LoadState::Loaded || plugin.second->loadState == LoadState::Deferred) && !plugin.second->watcher)
+            plugin.second->watcher.emplace(plugin.second->filename, FileWatcher::Flag::IgnoreErrors|FileWatcher::Flag::IgnoreChangeIfEmpty);
+    }
+}
+
+std::vector<std::string> AbstractManager::reloadChangedPlugins() {
+    std::vector<std::string> reloaded;
+    for(std::pair<const std::string, Containers::Pointer<Plugin>>& plugin: _state->plugins) {
+        closeUnusedRetiredModules(*plugin.second);
+
+        if(!plugin.second->watcher || !plugin.second->watcher->hasChanged())
+            continue;
+
+        if(reloadInternal(*plugin.second) & LoadState::Loaded)
+            reloaded.push_back(plugin.first);
+    }
+
+    return reloaded;
+}
+
+std::chrono::nanoseconds AbstractManager::reloadDuration(const std::string& plugin) const {
+    auto found = _state->aliases.find(plugin);
+    return found == _state->aliases.end() ? std::chrono::nanoseconds{} : found->second.reloadDuration;
+}
 #endif
 
 LoadState AbstractManager::unload(const std::string& plugin) {
@@ -814,7 +1086,7 @@ LoadState AbstractManager::unloadInternal(Plugin& plugin) {
        just return that load state) or when its metadata file is broken (which
        is not good, but what can we do). All other states (such as UnloadFailed
        etc.) are transient -- not saved into the local state, only returned. */
-    if(plugin.loadState != LoadState::Loaded) {
+    if(plugin.loadState != LoadState::Loaded && plugin.loadState != LoadState::Deferred) {
         CORRADE_INTERNAL_ASSERT(plugin.loadState & (LoadState::Static|LoadState::NotLoaded|LoadState::WrongMetadataFile));
         return plugin.loadState;
     }
@@ -844,6 +1116,10 @@ LoadState AbstractManager::unloadInternal(Plugin& plugin) {
             delete plugin.instances[i-1];
     }
 
+    /* With all instances gone, no previous binaries are needed anymore */
+    closeUnusedRetiredModules(plugin);
+    CORRADE_INTERNAL_ASSERT(plugin.retiredModules.empty());
+
     /* Remove this plugin from "used by" list of dependencies. If not found
        in this manager, try in registered external managers. */
     for(auto it = plugin.metadata.depends().cbegin(); it != plugin.metadata.depends().cend(); ++it) {
@@ -867,14 +1143,13 @@ LoadState AbstractManager::unloadInternal(Plugin& plugin) {
         dependency->metadata._usedBy.erase(uit);
     }
 
-    /* Finalize plugin */
-    plugin.finalizer();
-
-    /* Close the module */
+    /* Finalize plugin and close the module, unless it was deferred and never
+       opened */
+    if(plugin.module) plugin.finalizer();
     #ifndef CORRADE_TARGET_WINDOWS
-    if(dlclose(plugin.module) != 0)
+    if(plugin.module && dlclose(plugin.module) != 0)
     #else
-    if(!FreeLibrary(plugin.module))
+    if(plugin.module && !FreeLibrary(plugin.module))
     #endif
     {
         /* This is hard to test, the only possibility I can think of is
@@ -899,6 +1174,11 @@ LoadState AbstractManager::unloadInternal(Plugin& plugin) {
     plugin.module = nullptr;
     plugin.instancer = nullptr;
     plugin.finalizer = nullptr;
+    if(!plugin.shadowFilename.empty()) {
+        Directory::rm(plugin.shadowFilename);
+        plugin.shadowFilename = {};
+    }
+    plugin.watcher = Containers::NullOpt;
     return LoadState::NotLoaded;
 }
 #endif
@@ -940,7 +1220,7 @@ void AbstractManager::registerDynamicPlugin(const std::string& name, Containers:
 
 /* This function takes an alias name, since at the time of instantiation the
    real plugin name is not yet known */
-void AbstractManager::registerInstance(const std::string& plugin, AbstractPlugin& instance, const PluginMetadata*& metadata) {
+void AbstractManager::registerInstance(const std::string& plugin, AbstractPlugin& instance, const PluginMetadata*& metadata, std::size_t& generation) {
     /** @todo assert proper interface */
     auto found = _state->aliases.find(plugin);
     CORRADE_ASSERT(found != _state->aliases.end(),
@@ -948,13 +1228,19 @@ void AbstractManager::registerInstance(const std::string& plugin, AbstractPlugin
 
     found->second.instances.push_back(&instance);
     metadata = &found->second.metadata;
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    generation = found->second.generation;
+    ++found->second.instanceCount;
+    #else
+    static_cast<void>(generation);
+    #endif
 }
 
 /* This function however takes the real name, taken from the metadata. This is
    done in order to avoid a nasty interaction with setPreferredPlugins() and
    potential other APIs that redirect an alias to some other plugin, which
    would then lead to the instance not being found */
-void AbstractManager::reregisterInstance(const std::string& plugin, AbstractPlugin& oldInstance, AbstractPlugin* const newInstance) {
+void AbstractManager::reregisterInstance(const std::string& plugin, AbstractPlugin& oldInstance, AbstractPlugin* const newInstance, const std::size_t generation) {
     auto found = _state->plugins.find(plugin);
     CORRADE_INTERNAL_ASSERT(found != _state->plugins.end());
 
@@ -963,8 +1249,32 @@ void AbstractManager::reregisterInstance(const std::string& plugin, AbstractPlug
 
     /* If the plugin is being moved, replace the instance pointer. Otherwise
        remove it from the list, and if the list is empty, delete it fully. */
-    if(newInstance) *pos = newInstance;
-    else found->second->instances.erase(pos);
+    if(newInstance) {
+        *pos = newInstance;
+        return;
+    }
+
+    found->second->instances.erase(pos);
+
+    /* Update the instance count of the binary the instance came from. If it
+       was a binary replaced by a reload, it gets closed later once the
+       destructor finishes executing its code. */
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    if(generation == found->second->generation) {
+        --found->second->instanceCount;
+        return;
+    }
+
+    for(Plugin::RetiredModule& module: found->second->retiredModules) {
+        if(module.generation != generation) continue;
+        --module.instanceCount;
+        return;
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    #else
+    static_cast<void>(generation);
+    #endif
 }
 
 Containers::Pointer<AbstractPlugin> AbstractManager::instantiateInternal(const std::string& plugin) {
@@ -973,7 +1283,17 @@ Containers::Pointer<AbstractPlugin> AbstractManager::instantiateInternal(const s
     CORRADE_ASSERT(found != _state->aliases.end() && (found->second.loadState & LoadState::Loaded),
         "PluginManager::Manager::instantiate(): plugin" << plugin << "is not loaded", nullptr);
 
-    return Containers::pointer(static_cast<AbstractPlugin*>(found->second.instancer(*this, plugin)));
+    return instantiateInternal(found->second, plugin);
+}
+
+Containers::Pointer<AbstractPlugin> AbstractManager::instantiateInternal(Plugin& plugin, const std::string& name) {
+    /* Plugins loaded with LoadFlag::Deferred get opened on first use */
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    if(plugin.loadState == LoadState::Deferred && !(openInternal(plugin) & LoadState::Loaded))
+        return nullptr;
+    #endif
+
+    return Containers::pointer(static_cast<AbstractPlugin*>(plugin.instancer(*this, name)));
 }
 
 Containers::Pointer<AbstractPlugin> AbstractManager::loadAndInstantiateInternal(const std::string& plugin) {
@@ -986,16 +1306,37 @@ Containers::Pointer<AbstractPlugin> AbstractManager::loadAndInstantiateInternal(
         const std::string name = filename.substr(0, filename.length() - _state->pluginSuffix.size());
         auto found = _state->aliases.find(name);
         CORRADE_INTERNAL_ASSERT(found != _state->aliases.end());
-        return Containers::pointer(static_cast<AbstractPlugin*>(found->second.instancer(*this, name)));
+        return instantiateInternal(found->second, name);
     }
     #endif
 
     auto found = _state->aliases.find(plugin);
     CORRADE_INTERNAL_ASSERT(found != _state->aliases.end());
-    return Containers::pointer(static_cast<AbstractPlugin*>(found->second.instancer(*this, plugin)));
+    return instantiateInternal(found->second, plugin);
 }
 
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+Containers::Pointer<AbstractPlugin> AbstractManager::reinstantiateInternal(AbstractPlugin& instance) {
+    auto found = instance.metadata() ? _state->plugins.find(instance.metadata()->name()) : _state->plugins.end();
+    CORRADE_ASSERT(found != _state->plugins.end() && std::find(found->second->instances.begin(), found->second->instances.end(), &instance) != found->second->instances.end(),
+        "PluginManager::Manager::reinstantiate(): the instance wasn't created by this manager", nullptr);
+    CORRADE_ASSERT(found->second->loadState & LoadState::Loaded,
+        "PluginManager::Manager::reinstantiate(): plugin" << found->first << "is not loaded", nullptr);
+
+    /* Keep the alias the instance was created with, unless it got redirected
+       to some other plugin in the meantime */
+    auto alias = _state->aliases.find(instance.plugin());
+    const std::string& name = alias != _state->aliases.end() && &alias->second == found->second.get() ? instance.plugin() : found->first;
+
+    Containers::Pointer<AbstractPlugin> out = instantiateInternal(*found->second, name);
+    if(!out) return nullptr;
+    out->configuration() = instance.configuration();
+    Utility::ConfigurationGroup state;
+    instance.saveReloadState(state);
+    out->restoreReloadState(state);
+    return out;
+}
+
 AbstractManager::Plugin::Plugin(std::string name, const std::string& metadata): configuration{metadata, Utility::Configuration::Flag::ReadOnly}, metadata{std::move(name), configuration}, instancer{nullptr}, module{nullptr} {
     /* If the path is empty, we don't use any plugin configuration file, so
        don't do any checks. */
@@ -1038,6 +1379,7 @@ Utility::Debug& operator<<(Utility::Debug& debug, LoadState value) {
         _c(Static)
         #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
         _c(Used)
+        _c(Deferred)
         #endif
         #undef _c
         /* LCOV_EXCL_STOP */
@@ -1055,6 +1397,8 @@ Utility::Debug& operator<<(Utility::Debug& debug, const LoadStates value) {
         LoadState::WrongMetadataFile,
         LoadState::UnresolvedDependency,
         LoadState::LoadFailed,
+        /* Deferred has to be before Loaded, as it's a superset of it */
+        LoadState::Deferred,
         LoadState::Loaded,
         LoadState::NotLoaded,
         LoadState::UnloadFailed,
@@ -1067,6 +1411,31 @@ Utility::Debug& operator<<(Utility::Debug& debug, const LoadStates value) {
         });
 }
 
+#ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+Utility::Debug& operator<<(Utility::Debug& debug, const LoadFlag value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case LoadFlag::value: return debug << "PluginManager::LoadFlag::" #value;
+        _c(Lazy)
+        _c(Local)
+        _c(NoDelete)
+        _c(Deferred)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "PluginManager::LoadFlag(" << Debug::nospace << reinterpret_cast<void*>(std::uint8_t(value)) << Debug::nospace << ")";
+}
+
+Utility::Debug& operator<<(Utility::Debug& debug, const LoadFlags value) {
+    return Containers::enumSetDebugOutput(debug, value, "PluginManager::LoadFlags{}", {
+        LoadFlag::Lazy,
+        LoadFlag::Local,
+        LoadFlag::NoDelete,
+        LoadFlag::Deferred});
+}
+#endif
+
 #endif
 
 }}
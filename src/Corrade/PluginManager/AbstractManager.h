@@ -38,6 +38,10 @@
 #include "Corrade/Utility/StlForwardVector.h"
 #include "Corrade/Utility/Utility.h"
 
+#ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+#include <chrono>
+#endif
+
 #ifdef CORRADE_TARGET_WINDOWS
 /* I didn't find a better way to circumvent the need for including windows.h */
 struct HINSTANCE__;
@@ -164,7 +168,21 @@ enum class LoadState: unsigned short {
      * @partialsupport Not available on platforms without
      *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
      */
-    Used = 1 << 11
+    Used = 1 << 11,
+
+    /**
+     * The plugin is loaded with @ref LoadFlag::Deferred, meaning its metadata
+     * are available and its dependencies are loaded, but its binary isn't
+     * opened yet. That happens on the first @ref Manager::instantiate(),
+     * after which the state changes to @ref LoadState::Loaded. Returned by
+     * @ref AbstractManager::loadState(), @ref AbstractManager::load() and
+     * @ref AbstractManager::reload(). The value includes the value of
+     * @ref LoadState::Loaded, see @ref LoadStates for more information.
+     * @m_since_latest
+     * @partialsupport Not available on platforms without
+     *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+     */
+    Deferred = (1 << 12) | LoadState::Loaded
     #endif
 };
 
@@ -183,6 +201,9 @@ Note that @ref LoadState::Loaded includes the value of @ref LoadState::Static,
 so you can use @cpp loadState & PluginManager::LoadState::Loaded @ce instead of
 much more verbose
 @cpp loadState & (PluginManager::LoadState::Loaded|PluginManager::LoadState::Static) @ce.
+Similarly, @ref LoadState::Deferred includes the value of
+@ref LoadState::Loaded, so the same check is true also for plugins with
+deferred loading.
 @see @ref AbstractManager::loadState(), @ref AbstractManager::load(),
     @ref AbstractManager::unload()
 */
@@ -193,6 +214,71 @@ CORRADE_ENUMSET_OPERATORS(LoadStates)
 /** @debugoperatorenum{LoadStates} */
 CORRADE_PLUGINMANAGER_EXPORT Utility::Debug& operator<<(Utility::Debug& debug, PluginManager::LoadStates value);
 
+#ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+/**
+@brief Plugin load flag
+@m_since_latest
+
+@see @ref LoadFlags, @ref AbstractManager::setLoadFlags()
+@partialsupport Not available on platforms without
+    @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+*/
+enum class LoadFlag: unsigned char {
+    /**
+     * Resolve function symbols of the plugin binary lazily on first call
+     * instead of all at once when it's opened. Corresponds to `RTLD_LAZY`,
+     * ignored on Windows.
+     */
+    Lazy = 1 << 0,
+
+    /**
+     * Don't make symbols of the plugin binary available for resolving
+     * references in binaries opened later. Corresponds to `RTLD_LOCAL`,
+     * ignored on Windows. Avoids polluting the global symbol table, but
+     * plugins that depend on symbols of other plugins can't be loaded
+     * with this flag set.
+     */
+    Local = 1 << 1,
+
+    /**
+     * Don't unmap the plugin binary from memory on unload, which makes
+     * loading it again cheap. Corresponds to `RTLD_NODELETE`, ignored on
+     * Windows.
+     */
+    NoDelete = 1 << 2,
+
+    /**
+     * Don't open the plugin binary in @ref AbstractManager::load(), only
+     * resolve and load its dependencies. The plugin is then in the
+     * @ref LoadState::Deferred state and its binary is opened and the
+     * plugin initialized on the first @ref Manager::instantiate() instead.
+     * This makes loading of many rarely used plugins cheap, with a downside
+     * that errors such as @ref LoadState::WrongPluginVersion are not
+     * reported until the first instantiation, which returns
+     * @cpp nullptr @ce in that case.
+     */
+    Deferred = 1 << 3
+};
+
+/** @debugoperatorenum{LoadFlag} */
+CORRADE_PLUGINMANAGER_EXPORT Utility::Debug& operator<<(Utility::Debug& debug, PluginManager::LoadFlag value);
+
+/**
+@brief Plugin load flags
+@m_since_latest
+
+@see @ref AbstractManager::setLoadFlags()
+@partialsupport Not available on platforms without
+    @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+*/
+typedef Containers::EnumSet<LoadFlag> LoadFlags;
+
+CORRADE_ENUMSET_OPERATORS(LoadFlags)
+
+/** @debugoperatorenum{LoadFlags} */
+CORRADE_PLUGINMANAGER_EXPORT Utility::Debug& operator<<(Utility::Debug& debug, PluginManager::LoadFlags value);
+#endif
+
 namespace Implementation {
     struct StaticPlugin;
 }
@@ -257,6 +343,32 @@ class CORRADE_PLUGINMANAGER_EXPORT AbstractManager {
          *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
          */
         void reloadPluginDirectory();
+
+        /**
+         * @brief Plugin load flags
+         * @m_since_latest
+         *
+         * Empty by default, which means plugin binaries are opened right
+         * away, with all symbols resolved immediately and made globally
+         * available.
+         * @see @ref setLoadFlags()
+         * @partialsupport Not available on platforms without
+         *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+         */
+        LoadFlags loadFlags() const;
+
+        /**
+         * @brief Set plugin load flags
+         * @m_since_latest
+         *
+         * Affects only plugins loaded after this call. Note that the flags
+         * are not propagated to other managers registered through
+         * @ref registerExternalManager().
+         * @see @ref loadFlags()
+         * @partialsupport Not available on platforms without
+         *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+         */
+        void setLoadFlags(LoadFlags flags);
         #endif
 
         /**
@@ -306,7 +418,9 @@ class CORRADE_PLUGINMANAGER_EXPORT AbstractManager {
          * @brief Load state of a plugin
          *
          * Returns @ref LoadState::Loaded if the plugin is loaded or
-         * @ref LoadState::NotLoaded if not. For static plugins returns always
+         * @ref LoadState::NotLoaded if not. For plugins loaded with
+         * @ref LoadFlag::Deferred that weren't instantiated yet returns
+         * @ref LoadState::Deferred. For static plugins returns always
          * @ref LoadState::Static. On failure returns @ref LoadState::NotFound
          * or @ref LoadState::WrongMetadataFile.
          * @see @ref load(), @ref unload()
@@ -317,7 +431,9 @@ class CORRADE_PLUGINMANAGER_EXPORT AbstractManager {
          * @brief Load a plugin
          *
          * Returns @ref LoadState::Loaded if the plugin is already loaded or if
-         * loading succeeded. For static plugins returns always
+         * loading succeeded. If @ref LoadFlag::Deferred is set, returns
+         * @ref LoadState::Deferred instead, unless the plugin binary was
+         * already opened. For static plugins returns always
          * @ref LoadState::Static. On failure returns @ref LoadState::NotFound,
          * @ref LoadState::WrongPluginVersion,
          * @ref LoadState::WrongInterfaceVersion,
@@ -375,6 +491,99 @@ class CORRADE_PLUGINMANAGER_EXPORT AbstractManager {
          */
         void registerExternalManager(AbstractManager& manager);
 
+        #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+        /**
+         * @brief Whether plugin hot-reload is enabled
+         * @m_since_latest
+         *
+         * Disabled by default.
+         * @see @ref setHotReloadEnabled()
+         * @partialsupport Not available on platforms without
+         *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+         */
+        bool isHotReloadEnabled() const;
+
+        /**
+         * @brief Enable or disable plugin hot-reload
+         * @m_since_latest
+         *
+         * If enabled, dynamic plugins loaded afterwards are not opened
+         * directly but from a uniquely named shadow copy in
+         * @ref Utility::Directory::tmp(), which means the original binary can
+         * be overwritten by the buildsystem while the plugin is loaded. A
+         * @ref Utility::FileWatcher is then attached to the original binary
+         * of every loaded dynamic plugin, including plugins that were loaded
+         * before hot-reload got enabled, and @ref reloadChangedPlugins()
+         * reloads the ones that changed. Disabling the hot-reload removes the
+         * watchers, plugins already loaded from a shadow copy stay loaded from
+         * it.
+         * @see @ref isHotReloadEnabled(), @ref reload()
+         * @partialsupport Not available on platforms without
+         *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+         */
+        void setHotReloadEnabled(bool enabled);
+
+        /**
+         * @brief Reload a plugin
+         * @m_since_latest
+         *
+         * Opens the current version of the plugin binary from a new shadow
+         * copy and makes all subsequent instantiations use it. Existing
+         * instances are not affected --- they keep using the code of the
+         * previous binary, which is kept loaded until the last of them is
+         * destroyed. Use @ref Manager::reinstantiate() to migrate them to the
+         * new binary. Plugin metadata are not reloaded.
+         *
+         * Returns @ref LoadState::Loaded if the reload succeeded. For static
+         * plugins returns always @ref LoadState::Static and for plugins that
+         * are not loaded @ref LoadState::NotLoaded, without doing anything.
+         * Plugins in the @ref LoadState::Deferred state don't have any binary
+         * opened yet, so for these the state is returned as well. If
+         * another plugin depends on this plugin, prints a message to
+         * @ref Utility::Error and returns @ref LoadState::Required, as its
+         * symbols may be referenced from the dependent plugins. If opening
+         * the new binary fails, returns one of the failure states documented
+         * in @ref load() and the previous binary stays in use.
+         *
+         * The time a successful reload took is available through
+         * @ref reloadDuration().
+         * @see @ref setHotReloadEnabled(), @ref reloadChangedPlugins()
+         * @partialsupport Not available on platforms without
+         *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+         */
+        LoadState reload(const std::string& plugin);
+
+        /**
+         * @brief Reload plugins whose binaries changed
+         * @m_since_latest
+         *
+         * Meant to be called periodically, for example once per frame. Checks
+         * the binaries of all loaded dynamic plugins for changes and calls
+         * @ref reload() on those that changed. Returns names of plugins that
+         * were successfully reloaded, use @ref reloadDuration() to query how
+         * long each reload took. If hot-reload is not enabled, does nothing
+         * and returns an empty list.
+         * @see @ref setHotReloadEnabled()
+         * @partialsupport Not available on platforms without
+         *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+         */
+        std::vector<std::string> reloadChangedPlugins();
+
+        /**
+         * @brief Duration of the last plugin reload
+         * @m_since_latest
+         *
+         * Time it took for the last successful @ref reload() of given plugin,
+         * either explicit or through @ref reloadChangedPlugins(), to create
+         * the shadow copy, open the new binary and initialize it. Returns a
+         * zero duration if the plugin wasn't reloaded yet or if it's not
+         * found.
+         * @partialsupport Not available on platforms without
+         *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+         */
+        std::chrono::nanoseconds reloadDuration(const std::string& plugin) const;
+        #endif
+
     protected:
         /**
          * @brief Destructor
@@ -408,18 +617,29 @@ class CORRADE_PLUGINMANAGER_EXPORT AbstractManager {
 
         Containers::Pointer<AbstractPlugin> instantiateInternal(const std::string& plugin);
         Containers::Pointer<AbstractPlugin> loadAndInstantiateInternal(const std::string& plugin);
+        #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+        Containers::Pointer<AbstractPlugin> reinstantiateInternal(AbstractPlugin& instance);
+        #endif
 
     private:
         struct State;
+        #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+        struct Module;
+        #endif
 
         CORRADE_PLUGINMANAGER_LOCAL void registerDynamicPlugin(const std::string& name, Containers::Pointer<Plugin>&& plugin);
 
-        CORRADE_PLUGINMANAGER_LOCAL void registerInstance(const std::string& plugin, AbstractPlugin& instance, const PluginMetadata*& metadata);
-        CORRADE_PLUGINMANAGER_LOCAL void reregisterInstance(const std::string& plugin, AbstractPlugin& oldInstance, AbstractPlugin* newInstance);
+        CORRADE_PLUGINMANAGER_LOCAL Containers::Pointer<AbstractPlugin> instantiateInternal(Plugin& plugin, const std::string& name);
+
+        CORRADE_PLUGINMANAGER_LOCAL void registerInstance(const std::string& plugin, AbstractPlugin& instance, const PluginMetadata*& metadata, std::size_t& generation);
+        CORRADE_PLUGINMANAGER_LOCAL void reregisterInstance(const std::string& plugin, AbstractPlugin& oldInstance, AbstractPlugin* newInstance, std::size_t generation);
 
         #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
         CORRADE_PLUGINMANAGER_LOCAL LoadState loadInternal(Plugin& plugin);
         CORRADE_PLUGINMANAGER_LOCAL LoadState loadInternal(Plugin& plugin, const std::string& filename);
+        CORRADE_PLUGINMANAGER_LOCAL LoadState openInternal(Plugin& plugin);
+        CORRADE_PLUGINMANAGER_LOCAL LoadState openInternal(Plugin& plugin, const std::string& filename, Module& out);
+        CORRADE_PLUGINMANAGER_LOCAL LoadState reloadInternal(Plugin& plugin);
         CORRADE_PLUGINMANAGER_LOCAL LoadState unloadInternal(Plugin& plugin);
         CORRADE_PLUGINMANAGER_LOCAL LoadState unloadRecursiveInternal(Plugin& plugin);
         #endif
@@ -504,7 +724,7 @@ of application execution. It's also safe to call this macro more than once.
     resourceFinalizer_##name();
 
 /** @brief Plugin version */
-#define CORRADE_PLUGIN_VERSION 6
+#define CORRADE_PLUGIN_VERSION 7
 
 /** @hideinitializer
 @brief Register a static or dynamic plugin
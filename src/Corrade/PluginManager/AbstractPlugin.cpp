@@ -42,6 +42,8 @@ struct AbstractPlugin::State {
     std::string plugin;
     const PluginMetadata* metadata{};
     Utility::ConfigurationGroup configuration{};
+    /* Used by the manager to track which binary the instance comes from */
+    std::size_t generation{};
 };
 
 std::string AbstractPlugin::pluginInterface() { return {}; }
@@ -63,7 +65,7 @@ AbstractPlugin::AbstractPlugin(): _state{InPlaceInit} {}
 AbstractPlugin::AbstractPlugin(AbstractManager& manager, const std::string& plugin): _state{InPlaceInit} {
     _state->manager = &manager;
     _state->plugin = plugin;
-    manager.registerInstance(plugin, *this, _state->metadata);
+    manager.registerInstance(plugin, *this, _state->metadata, _state->generation);
     _state->configuration = _state->metadata->configuration();
 }
 
@@ -80,7 +82,7 @@ AbstractPlugin::AbstractPlugin(AbstractPlugin&& other) noexcept: _state{std::mov
     if(_state && _state->manager && _state->metadata)
         /* Takes the real name, not the alias -- see this function source
            for details why */
-        _state->manager->reregisterInstance(_state->metadata->name(), other, this);
+        _state->manager->reregisterInstance(_state->metadata->name(), other, this, _state->generation);
 }
 
 AbstractPlugin::~AbstractPlugin() {
@@ -92,11 +94,17 @@ AbstractPlugin::~AbstractPlugin() {
     if(_state && _state->manager && _state->metadata)
         /* Takes the real name, not the alias -- see this function source
            for details why */
-        _state->manager->reregisterInstance(_state->metadata->name(), *this, nullptr);
+        _state->manager->reregisterInstance(_state->metadata->name(), *this, nullptr, _state->generation);
 }
 
 bool AbstractPlugin::canBeDeleted() { return false; }
 
+#ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+void AbstractPlugin::saveReloadState(Utility::ConfigurationGroup&) {}
+
+void AbstractPlugin::restoreReloadState(const Utility::ConfigurationGroup&) {}
+#endif
+
 const std::string& AbstractPlugin::plugin() const {
     CORRADE_ASSERT(_state, "PluginManager::AbstractPlugin::plugin(): can't be called on a moved-out plugin", _state->plugin);
     return _state->plugin;
@@ -272,6 +272,37 @@ class CORRADE_PLUGINMANAGER_EXPORT AbstractPlugin {
          */
         virtual bool canBeDeleted();
 
+        #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+        /**
+         * @brief Save internal state for a reload
+         * @m_since_latest
+         *
+         * Called from @ref Manager::reinstantiate() on the instance that's
+         * being migrated to a reloaded plugin binary. The implementation is
+         * expected to serialize all state that should survive the reload into
+         * @p state, which is then passed to @ref restoreReloadState() of the
+         * new instance. As the two instances come from different binaries,
+         * the state should not contain any pointers to code or data owned by
+         * the plugin. The @ref configuration() is transferred implicitly.
+         * Default implementation does nothing.
+         * @partialsupport Not available on platforms without
+         *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+         */
+        virtual void saveReloadState(Utility::ConfigurationGroup& state);
+
+        /**
+         * @brief Restore internal state after a reload
+         * @m_since_latest
+         *
+         * Called from @ref Manager::reinstantiate() on the newly created
+         * instance with @p state filled by @ref saveReloadState() of the
+         * original instance. Default implementation does nothing.
+         * @partialsupport Not available on platforms without
+         *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+         */
+        virtual void restoreReloadState(const Utility::ConfigurationGroup& state);
+        #endif
+
         /**
          * @brief Identifier string
          *
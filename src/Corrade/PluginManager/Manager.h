@@ -176,7 +176,14 @@ template<class T> class Manager: public AbstractManager {
          *
          * Returns new instance of given plugin. The plugin must be already
          * successfully loaded by this manager. The returned value is never
-         * @cpp nullptr @ce.
+         * @cpp nullptr @ce, except for plugins in the
+         * @ref LoadState::Deferred state. For these the plugin binary is
+         * opened here and the state changes to @ref LoadState::Loaded. If
+         * opening fails, a message is printed to @ref Utility::Error,
+         * @cpp nullptr @ce is returned and the plugin stays in the
+         * @ref LoadState::Deferred state --- subsequent calls will attempt to
+         * open the binary again and the plugin can be unloaded with
+         * @ref AbstractManager::unload() "unload()" as usual.
          * @see @ref loadAndInstantiate(),
          *      @ref AbstractManager::loadState() "loadState()",
          *      @ref AbstractManager::load() "load()"
@@ -198,6 +205,31 @@ template<class T> class Manager: public AbstractManager {
         Containers::Pointer<T> loadAndInstantiate(const std::string& plugin) {
             return Containers::pointerCast<T>(loadAndInstantiateInternal(plugin));
         }
+
+        #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+        /**
+         * @brief Instantiate a plugin again from its current binary
+         * @m_since_latest
+         *
+         * Meant to be used for migrating instances after a
+         * @ref AbstractManager::reload() "reload()". Creates a new instance of
+         * the same plugin as @p instance using the currently loaded binary,
+         * copies @ref AbstractPlugin::configuration() over and transfers
+         * internal state using @ref AbstractPlugin::saveReloadState() and
+         * @ref AbstractPlugin::restoreReloadState(). The @p instance is
+         * expected to be created by this manager and its plugin to be still
+         * loaded. Once the last instance coming from a previous binary is
+         * destroyed, the previous binary gets unloaded:
+         *
+         * @snippet PluginManager.cpp Manager-reinstantiate
+         *
+         * @partialsupport Not available on platforms without
+         *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+         */
+        Containers::Pointer<T> reinstantiate(T& instance) {
+            return Containers::pointerCast<T>(reinstantiateInternal(instance));
+        }
+        #endif
 };
 
 }}
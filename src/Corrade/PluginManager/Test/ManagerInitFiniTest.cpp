@@ -44,6 +44,7 @@ struct ManagerInitFiniTest: TestSuite::Tester {
     void staticPlugin();
     #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
     void dynamicPlugin();
+    void dynamicPluginDeferred();
     #endif
 };
 
@@ -51,6 +52,7 @@ ManagerInitFiniTest::ManagerInitFiniTest() {
     addTests({&ManagerInitFiniTest::staticPlugin,
               #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
               &ManagerInitFiniTest::dynamicPlugin,
+              &ManagerInitFiniTest::dynamicPluginDeferred,
               #endif
               });
 
@@ -101,6 +103,39 @@ void ManagerInitFiniTest::dynamicPlugin() {
        destruction */
     CORRADE_COMPARE(out.str(), "Static plugin finalized\n");
 }
+
+void ManagerInitFiniTest::dynamicPluginDeferred() {
+    std::ostringstream out;
+    Debug redirectDebug{&out};
+
+    {
+        PluginManager::Manager<InitFini> manager;
+        manager.setLoadFlags(LoadFlag::Deferred);
+
+        /* With deferred loading the plugin isn't initialized on load... */
+        out.str({});
+        CORRADE_COMPARE(manager.load("InitFiniDynamic"), LoadState::Deferred);
+        CORRADE_COMPARE(out.str(), "");
+
+        /* ... but only on first instantiation */
+        CORRADE_VERIFY(manager.instantiate("InitFiniDynamic"));
+        CORRADE_COMPARE(out.str(), "Dynamic plugin initialized\n");
+
+        /* Not again on a second one */
+        out.str({});
+        CORRADE_VERIFY(manager.instantiate("InitFiniDynamic"));
+        CORRADE_COMPARE(out.str(), "");
+
+        CORRADE_COMPARE(manager.unload("InitFiniDynamic"), LoadState::NotLoaded);
+        CORRADE_COMPARE(out.str(), "Dynamic plugin finalized\n");
+
+        /* If never instantiated, it's not finalized either */
+        out.str({});
+        CORRADE_COMPARE(manager.load("InitFiniDynamic"), LoadState::Deferred);
+        CORRADE_COMPARE(manager.unload("InitFiniDynamic"), LoadState::NotLoaded);
+        CORRADE_COMPARE(out.str(), "");
+    }
+}
 #endif
 
 }}}}
@@ -123,6 +123,15 @@ struct ManagerTest: TestSuite::Tester {
 
     #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
     void utf8Path();
+
+    void reload();
+    void reloadRequired();
+    void reloadNotLoaded();
+    void hotReload();
+
+    void loadFlags();
+    void loadFlagsDeferred();
+    void loadFlagsDeferredFailed();
     #endif
 
     void twoManagerInstances();
@@ -132,6 +141,10 @@ struct ManagerTest: TestSuite::Tester {
 
     void debugLoadState();
     void debugLoadStates();
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    void debugLoadFlag();
+    void debugLoadFlags();
+    #endif
 };
 
 ManagerTest::ManagerTest() {
@@ -198,6 +211,15 @@ ManagerTest::ManagerTest() {
 
               #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
               &ManagerTest::utf8Path,
+
+              &ManagerTest::reload,
+              &ManagerTest::reloadRequired,
+              &ManagerTest::reloadNotLoaded,
+              &ManagerTest::hotReload,
+
+              &ManagerTest::loadFlags,
+              &ManagerTest::loadFlagsDeferred,
+              &ManagerTest::loadFlagsDeferredFailed,
               #endif
 
               &ManagerTest::twoManagerInstances,
@@ -206,7 +228,12 @@ ManagerTest::ManagerTest() {
               &ManagerTest::disabledMetadata,
 
               &ManagerTest::debugLoadState,
-              &ManagerTest::debugLoadStates});
+              &ManagerTest::debugLoadStates,
+              #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+              &ManagerTest::debugLoadFlag,
+              &ManagerTest::debugLoadFlags,
+              #endif
+              });
 
     importPlugin();
 }
@@ -369,7 +396,7 @@ void ManagerTest::wrongPluginVersion() {
     PluginManager::Manager<AbstractFood> foodManager;
     CORRADE_COMPARE(foodManager.load("OldBread"), PluginManager::LoadState::WrongPluginVersion);
     CORRADE_COMPARE(foodManager.loadState("OldBread"), PluginManager::LoadState::NotLoaded);
-    CORRADE_COMPARE(out.str(), "PluginManager::Manager::load(): wrong version of plugin OldBread, expected 6 but got 0\n");
+    CORRADE_COMPARE(out.str(), "PluginManager::Manager::load(): wrong version of plugin OldBread, expected 7 but got 0\n");
 }
 
 void ManagerTest::noPluginInterface() {
@@ -1080,6 +1107,217 @@ void ManagerTest::utf8Path() {
 
     CORRADE_COMPARE(manager.unload("Dog"), LoadState::NotLoaded);
 }
+
+void ManagerTest::reload() {
+    #if defined(__has_feature)
+    #if __has_feature(address_sanitizer)
+    CORRADE_SKIP("Because the same shared object is loaded from two different paths, its globals (the vtable) are loaded twice. Skipping to avoid AddressSanitizer complain about ODR violation.");
+    #endif
+    #endif
+
+    PluginManager::Manager<AbstractAnimal> manager;
+    CORRADE_VERIFY(!manager.isHotReloadEnabled());
+    CORRADE_COMPARE(manager.load("Dog"), LoadState::Loaded);
+
+    Containers::Pointer<AbstractAnimal> animal = manager.instantiate("AGoodBoy");
+    animal->configuration().setValue("mood", "sleepy");
+
+    /* Explicit reload works even without hot-reload enabled */
+    CORRADE_COMPARE(manager.reload("Dog"), LoadState::Loaded);
+    CORRADE_COMPARE(manager.loadState("Dog"), LoadState::Loaded);
+
+    /* The existing instance is still usable */
+    CORRADE_COMPARE(animal->name(), "Doug");
+
+    /* Migrating the instance keeps the alias and configuration */
+    animal = manager.reinstantiate(*animal);
+    CORRADE_COMPARE(animal->name(), "Doug");
+    CORRADE_COMPARE(animal->plugin(), "AGoodBoy");
+    CORRADE_COMPARE(animal->metadata()->name(), "Dog");
+    CORRADE_COMPARE(animal->configuration().value("mood"), "sleepy");
+
+    /* Unloading closes also the previous binary */
+    animal = nullptr;
+    CORRADE_COMPARE(manager.unload("Dog"), LoadState::NotLoaded);
+}
+
+void ManagerTest::reloadRequired() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    CORRADE_COMPARE(manager.load("PitBull"), LoadState::Loaded);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_COMPARE(manager.reload("Dog"), LoadState::Required);
+    CORRADE_COMPARE(out.str(), "PluginManager::Manager::reload(): plugin Dog is required by other plugins: {PitBull}\n");
+}
+
+void ManagerTest::reloadNotLoaded() {
+    PluginManager::Manager<AbstractAnimal> manager;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_COMPARE(manager.reload("Canary"), LoadState::Static);
+    CORRADE_COMPARE(manager.reload("Dog"), LoadState::NotLoaded);
+    CORRADE_COMPARE(manager.reload("Nonexistent"), LoadState::NotFound);
+    CORRADE_COMPARE(out.str(), "PluginManager::Manager::reload(): plugin Nonexistent was not found\n");
+}
+
+void ManagerTest::hotReload() {
+    #if defined(__has_feature)
+    #if __has_feature(address_sanitizer)
+    CORRADE_SKIP("Because the same shared object is loaded from two different paths, its globals (the vtable) are loaded twice. Skipping to avoid AddressSanitizer complain about ODR violation.");
+    #endif
+    #endif
+
+    /* Copy the doggo plugin to a location where it can be overwritten */
+    const std::string hotReloadDir = Utility::Directory::join(PLUGINS_DIR, "hot-reload");
+    const std::string filename = Utility::Directory::join(hotReloadDir, "Doggo" + AbstractPlugin::pluginSuffix());
+    CORRADE_VERIFY(Utility::Directory::mkpath(hotReloadDir));
+    CORRADE_VERIFY(Utility::Directory::copy(DOGGO_PLUGIN_FILENAME, filename));
+    CORRADE_VERIFY(Utility::Directory::copy(
+        Utility::Directory::join(Utility::Directory::path(DOGGO_PLUGIN_FILENAME), "Doggo.conf"),
+        Utility::Directory::join(hotReloadDir, "Doggo.conf")));
+
+    PluginManager::Manager<AbstractAnimal> manager{"nonexistent"};
+    manager.setHotReloadEnabled(true);
+    CORRADE_VERIFY(manager.isHotReloadEnabled());
+
+    CORRADE_COMPARE(manager.load(filename), LoadState::Loaded);
+    Containers::Pointer<AbstractAnimal> animal = manager.instantiate("Doggo");
+    CORRADE_COMPARE(animal->name(), "Doggo");
+    animal->configuration().setValue("mood", "sleepy");
+
+    /* Nothing changed yet */
+    CORRADE_COMPARE(manager.reloadChangedPlugins(), std::vector<std::string>{});
+    CORRADE_VERIFY(manager.reloadDuration("Doggo") == std::chrono::nanoseconds{});
+
+    /* So we don't write at the same nanosecond, see FileWatcherTest for
+       details. Then overwrite the plugin with a binary of a different one,
+       which is possible because the manager opened a shadow copy. */
+    #if defined(CORRADE_TARGET_APPLE) || defined(CORRADE_TARGET_WINDOWS)
+    Utility::System::sleep(1100);
+    #else
+    Utility::System::sleep(10);
+    #endif
+    CORRADE_VERIFY(Utility::Directory::copy(DOG_PLUGIN_FILENAME, filename));
+
+    CORRADE_COMPARE(manager.reloadChangedPlugins(), std::vector<std::string>{"Doggo"});
+    const std::chrono::nanoseconds reloadDuration = manager.reloadDuration("Doggo");
+    CORRADE_VERIFY(reloadDuration > std::chrono::nanoseconds{});
+    CORRADE_VERIFY(manager.reloadDuration("Nonexistent") == std::chrono::nanoseconds{});
+
+    /* The existing instance still runs code of the previous binary, new
+       instances use the new one */
+    CORRADE_COMPARE(animal->name(), "Doggo");
+    CORRADE_COMPARE(manager.instantiate("Doggo")->name(), "Doug");
+
+    /* Migrating the instance transfers the configuration and the state saved
+       by the previous binary */
+    animal = manager.reinstantiate(*animal);
+    CORRADE_COMPARE(animal->name(), "Doug");
+    CORRADE_COMPARE(animal->configuration().value("mood"), "sleepy");
+    CORRADE_COMPARE(animal->configuration().value("reloadedFrom"), "Doggo");
+
+    /* No further changes, the duration stays from the last reload */
+    CORRADE_COMPARE(manager.reloadChangedPlugins(), std::vector<std::string>{});
+    CORRADE_VERIFY(manager.reloadDuration("Doggo") == reloadDuration);
+
+    /* Disabling removes the watchers, so further changes are not picked up */
+    manager.setHotReloadEnabled(false);
+    #if defined(CORRADE_TARGET_APPLE) || defined(CORRADE_TARGET_WINDOWS)
+    Utility::System::sleep(1100);
+    #else
+    Utility::System::sleep(10);
+    #endif
+    CORRADE_VERIFY(Utility::Directory::copy(DOGGO_PLUGIN_FILENAME, filename));
+    CORRADE_COMPARE(manager.reloadChangedPlugins(), std::vector<std::string>{});
+}
+
+void ManagerTest::loadFlags() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    CORRADE_COMPARE(manager.loadFlags(), LoadFlags{});
+
+    manager.setLoadFlags(LoadFlag::Lazy|LoadFlag::Local|LoadFlag::NoDelete);
+    CORRADE_COMPARE(manager.loadFlags(), LoadFlag::Lazy|LoadFlag::Local|LoadFlag::NoDelete);
+
+    CORRADE_COMPARE(manager.load("Dog"), LoadState::Loaded);
+    {
+        Containers::Pointer<AbstractAnimal> animal = manager.instantiate("Dog");
+        CORRADE_VERIFY(animal);
+        CORRADE_COMPARE(animal->name(), "Doug");
+    }
+    CORRADE_COMPARE(manager.unload("Dog"), LoadState::NotLoaded);
+
+    /* Loading again is fine as well */
+    CORRADE_COMPARE(manager.load("Dog"), LoadState::Loaded);
+    CORRADE_COMPARE(manager.instantiate("Dog")->name(), "Doug");
+}
+
+void ManagerTest::loadFlagsDeferred() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    manager.setLoadFlags(LoadFlag::Deferred);
+
+    /* Dependencies get loaded and registered right away, but the binaries
+       aren't opened yet */
+    CORRADE_COMPARE(manager.load("PitBull"), LoadState::Deferred);
+    CORRADE_COMPARE(manager.loadState("PitBull"), LoadState::Deferred);
+    CORRADE_COMPARE(manager.loadState("Dog"), LoadState::Deferred);
+    CORRADE_VERIFY(manager.loadState("PitBull") & LoadState::Loaded);
+    CORRADE_COMPARE(manager.metadata("Dog")->usedBy(), std::vector<std::string>{"PitBull"});
+
+    /* Loading again doesn't change anything */
+    CORRADE_COMPARE(manager.load("PitBull"), LoadState::Deferred);
+
+    /* The binary is opened on first instantiation, together with its
+       dependency, as the plugin refers to its symbols */
+    {
+        Containers::Pointer<AbstractAnimal> animal = manager.instantiate("PitBull");
+        CORRADE_VERIFY(animal);
+        CORRADE_COMPARE(animal->name(), "Rodriguez");
+        CORRADE_COMPARE(animal->legCount(), 4);
+    }
+    CORRADE_COMPARE(manager.loadState("PitBull"), LoadState::Loaded);
+    CORRADE_COMPARE(manager.loadState("Dog"), LoadState::Loaded);
+    CORRADE_COMPARE(manager.load("PitBull"), LoadState::Loaded);
+    CORRADE_COMPARE(manager.instantiate("Dog")->name(), "Doug");
+
+    CORRADE_COMPARE(manager.unload("PitBull"), LoadState::NotLoaded);
+    CORRADE_COMPARE(manager.unload("Dog"), LoadState::NotLoaded);
+
+    /* Unloading a plugin that was never opened is fine */
+    CORRADE_COMPARE(manager.load("Dog"), LoadState::Deferred);
+    CORRADE_COMPARE(manager.unload("Dog"), LoadState::NotLoaded);
+    CORRADE_COMPARE(manager.loadState("Dog"), LoadState::NotLoaded);
+}
+
+void ManagerTest::loadFlagsDeferredFailed() {
+    PluginManager::Manager<AbstractFood> foodManager;
+    foodManager.setLoadFlags(LoadFlag::Deferred);
+
+    /* The error is discovered only on instantiation */
+    CORRADE_COMPARE(foodManager.load("OldBread"), LoadState::Deferred);
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!foodManager.instantiate("OldBread"));
+    }
+    CORRADE_COMPARE(out.str(), "PluginManager::Manager::load(): wrong version of plugin OldBread, expected 7 but got 0\n");
+
+    /* The plugin stays deferred, so it's distinguishable from a really loaded
+       plugin, and a subsequent instantiation attempts to open it again */
+    CORRADE_COMPARE(foodManager.loadState("OldBread"), LoadState::Deferred);
+    out.str({});
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!foodManager.instantiate("OldBread"));
+    }
+    CORRADE_COMPARE(out.str(), "PluginManager::Manager::load(): wrong version of plugin OldBread, expected 7 but got 0\n");
+
+    /* It can be unloaded as usual */
+    CORRADE_COMPARE(foodManager.unload("OldBread"), LoadState::NotLoaded);
+    CORRADE_COMPARE(foodManager.loadState("OldBread"), LoadState::NotLoaded);
+}
 #endif
 
 void ManagerTest::twoManagerInstances() {
@@ -1211,8 +1449,31 @@ void ManagerTest::debugLoadStates() {
 
     Debug{&out} << (LoadState::Static|LoadState::NotFound) << LoadStates{};
     CORRADE_COMPARE(out.str(), "PluginManager::LoadState::NotFound|PluginManager::LoadState::Static PluginManager::LoadStates{}\n");
+
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    /* Deferred is a superset of Loaded, which is a superset of Static */
+    out.str({});
+    Debug{&out} << LoadStates{LoadState::Deferred} << LoadStates{LoadState::Loaded};
+    CORRADE_COMPARE(out.str(), "PluginManager::LoadState::Deferred PluginManager::LoadState::Loaded\n");
+    #endif
 }
 
+#ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+void ManagerTest::debugLoadFlag() {
+    std::ostringstream out;
+
+    Debug{&out} << LoadFlag::NoDelete << LoadFlag(0xbe);
+    CORRADE_COMPARE(out.str(), "PluginManager::LoadFlag::NoDelete PluginManager::LoadFlag(0xbe)\n");
+}
+
+void ManagerTest::debugLoadFlags() {
+    std::ostringstream out;
+
+    Debug{&out} << (LoadFlag::Lazy|LoadFlag::Deferred) << LoadFlags{};
+    CORRADE_COMPARE(out.str(), "PluginManager::LoadFlag::Lazy|PluginManager::LoadFlag::Deferred PluginManager::LoadFlags{}\n");
+}
+#endif
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::PluginManager::Test::ManagerTest)
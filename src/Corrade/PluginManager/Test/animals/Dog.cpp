@@ -27,6 +27,7 @@
 #include "Dog.h"
 
 #include "Corrade/PluginManager/AbstractManager.h"
+#include "Corrade/Utility/ConfigurationGroup.h"
 #include "Corrade/Utility/Debug.h"
 
 namespace Corrade { namespace PluginManager { namespace Test {
@@ -35,6 +36,10 @@ std::string Dog::name() { return "Doug"; }
 bool Dog::hasTail() { return true; }
 int Dog::legCount() { return 4; }
 
+void Dog::restoreReloadState(const Utility::ConfigurationGroup& state) {
+    configuration().setValue("reloadedFrom", state.value("name"));
+}
+
 }}}
 
 CORRADE_PLUGIN_REGISTER(Dog, Corrade::PluginManager::Test::Dog,
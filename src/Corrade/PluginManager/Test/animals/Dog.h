@@ -46,6 +46,7 @@ class DOG_EXPORT Dog: public AbstractAnimal {
         std::string name() override;
         int legCount() override;
         bool hasTail() override;
+        void restoreReloadState(const Utility::ConfigurationGroup& state) override;
 };
 
 }}}
@@ -27,6 +27,7 @@
 #include "../AbstractAnimal.h"
 
 #include "Corrade/PluginManager/AbstractManager.h"
+#include "Corrade/Utility/ConfigurationGroup.h"
 
 namespace Corrade { namespace PluginManager { namespace Test {
 
@@ -37,6 +38,10 @@ class Doggo: public AbstractAnimal {
         std::string name() override { return "Doggo"; }
         int legCount() override { return 0; }
         bool hasTail() override { return false; }
+
+        void saveReloadState(Utility::ConfigurationGroup& state) override {
+            state.setValue("name", name());
+        }
 };
 
 }}}
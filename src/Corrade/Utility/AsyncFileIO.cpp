@@ -0,0 +1,596 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AsyncFileIO.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+/* The syscall numbers are there only if the kernel headers are new enough */
+#ifdef __NR_io_uring_setup
+#define CORRADE_UTILITY_ASYNCFILEIO_IO_URING
+#include <csignal> /* _NSIG */
+#include <linux/io_uring.h>
+#endif
+#endif
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/DebugStl.h"
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+#include "Corrade/Utility/Unicode.h"
+#endif
+
+namespace Corrade { namespace Utility {
+
+namespace {
+
+struct Operation {
+    std::string filename;
+    /* Null for writes */
+    Containers::Array<char>* out;
+    /* For reads points to the allocated output, which is put into `out` only
+       once the whole file is read */
+    Containers::Array<char> readData;
+    Containers::ArrayView<const char> writeData;
+    std::size_t offset{};
+    /* Nonzero if the operation failed */
+    int error{};
+    #ifdef CORRADE_UTILITY_ASYNCFILEIO_IO_URING
+    int fd{-1};
+    iovec iov;
+    #endif
+};
+
+/* Used by the thread pool and the synchronous fallback. Has to not print
+   anything as it's executed from worker threads, where Error redirection
+   set up by the user doesn't apply. */
+void executeBlocking(Operation& operation) {
+    /* Special case for "Unicode" Windows support */
+    #ifndef CORRADE_TARGET_WINDOWS
+    std::FILE* const f = std::fopen(operation.filename.data(), operation.out ? "rb" : "wb");
+    #else
+    std::FILE* const f = _wfopen(Unicode::widen(operation.filename).data(), operation.out ? L"rb" : L"wb");
+    #endif
+    if(!f) {
+        operation.error = errno;
+        return;
+    }
+
+    if(operation.out) {
+        std::fseek(f, 0, SEEK_END);
+        const long size = std::ftell(f);
+        std::fseek(f, 0, SEEK_SET);
+        if(size < 0) {
+            operation.error = errno;
+            std::fclose(f);
+            return;
+        }
+
+        operation.readData = Containers::Array<char>{NoInit, std::size_t(size)};
+        operation.offset = std::fread(operation.readData.data(), 1, operation.readData.size(), f);
+        if(std::ferror(f)) operation.error = errno ? errno : EIO;
+    } else {
+        operation.offset = std::fwrite(operation.writeData.data(), 1, operation.writeData.size(), f);
+        if(operation.offset != operation.writeData.size())
+            operation.error = errno ? errno : EIO;
+    }
+
+    std::fclose(f);
+}
+
+/* Puts the read data into the output, shrinking it if the file got shorter
+   since its size was queried */
+void finishRead(Operation& operation) {
+    if(operation.offset != operation.readData.size()) {
+        Containers::Array<char> shrunk{NoInit, operation.offset};
+        if(operation.offset)
+            std::memcpy(shrunk.data(), operation.readData.data(), operation.offset);
+        operation.readData = std::move(shrunk);
+    }
+    *operation.out = std::move(operation.readData);
+}
+
+#ifdef CORRADE_UTILITY_ASYNCFILEIO_IO_URING
+struct Ring {
+    int fd{-1};
+    void* ringPtr{};
+    std::size_t ringSize{};
+    void* completionRingPtr{};
+    std::size_t completionRingSize{};
+    io_uring_sqe* entries{};
+    std::size_t entriesSize{};
+
+    unsigned* submissionHead;
+    unsigned* submissionTail;
+    unsigned submissionMask;
+    unsigned* submissionArray;
+    unsigned* completionHead;
+    unsigned* completionTail;
+    unsigned completionMask;
+    io_uring_cqe* completions;
+
+    unsigned entryCount;
+    /* Count of operations that are currently in the ring */
+    std::size_t inFlight{};
+    /* How many of them are in the submission queue but not consumed by the
+       kernel yet. These are always the last ones before the tail. */
+    unsigned pending{};
+    /* Next submitted operation to put into the ring */
+    std::size_t next{};
+    /* Operations that are done */
+    std::size_t completed{};
+};
+#endif
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+struct Pool {
+    std::mutex mutex;
+    std::condition_variable workAvailable, workDone;
+    std::deque<Operation*> queue;
+    std::size_t completed{};
+    bool quit{};
+    std::vector<std::thread> threads;
+};
+#endif
+
+}
+
+struct AsyncFileIO::State {
+    explicit State(Backend backend, std::size_t queueSize): backend{backend}, queueSize{queueSize} {}
+
+    Backend backend;
+    std::size_t queueSize;
+
+    /* A deque so the operations don't move in memory when more are added,
+       as the worker threads or the kernel reference them. Operations
+       [0, submitted) were handed over to the backend, the remaining ones are
+       queued. */
+    std::deque<Operation> operations;
+    std::size_t submitted{};
+
+    #ifdef CORRADE_UTILITY_ASYNCFILEIO_IO_URING
+    Ring ring;
+    #endif
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    Pool pool;
+    #endif
+};
+
+namespace {
+
+#ifdef CORRADE_UTILITY_ASYNCFILEIO_IO_URING
+/* Opens the file for given operation and puts it into the ring. Returns
+   false if the operation finished already, either because the file couldn't
+   be opened or because there's nothing to read or write. */
+bool prepareRingOperation(Operation& operation) {
+    if(operation.out) {
+        operation.fd = open(operation.filename.data(), O_RDONLY|O_CLOEXEC);
+        struct stat st;
+        if(operation.fd == -1 || fstat(operation.fd, &st) != 0) {
+            operation.error = errno;
+            if(operation.fd != -1) close(operation.fd);
+            return false;
+        }
+
+        operation.readData = Containers::Array<char>{NoInit, std::size_t(st.st_size)};
+    } else {
+        operation.fd = open(operation.filename.data(), O_WRONLY|O_CREAT|O_TRUNC|O_CLOEXEC, 0666);
+        if(operation.fd == -1) {
+            operation.error = errno;
+            return false;
+        }
+    }
+
+    if(!(operation.out ? operation.readData.size() : operation.writeData.size())) {
+        close(operation.fd);
+        if(operation.out) finishRead(operation);
+        return false;
+    }
+
+    return true;
+}
+
+void pushRingOperation(Ring& ring, Operation& operation) {
+    const unsigned tail = *ring.submissionTail;
+    const unsigned index = tail & ring.submissionMask;
+    io_uring_sqe& entry = ring.entries[index];
+    std::memset(&entry, 0, sizeof(io_uring_sqe));
+
+    if(operation.out) {
+        entry.opcode = IORING_OP_READV;
+        operation.iov.iov_base = operation.readData.data() + operation.offset;
+        operation.iov.iov_len = operation.readData.size() - operation.offset;
+    } else {
+        entry.opcode = IORING_OP_WRITEV;
+        operation.iov.iov_base = const_cast<char*>(operation.writeData.data()) + operation.offset;
+        operation.iov.iov_len = operation.writeData.size() - operation.offset;
+    }
+    entry.fd = operation.fd;
+    entry.addr = reinterpret_cast<std::uintptr_t>(&operation.iov);
+    entry.len = 1;
+    entry.off = operation.offset;
+    entry.user_data = reinterpret_cast<std::uintptr_t>(&operation);
+
+    ring.submissionArray[index] = index;
+    /* Make the entry visible to the kernel before the tail update */
+    __atomic_store_n(ring.submissionTail, tail + 1, __ATOMIC_RELEASE);
+}
+
+int enterRing(const int fd, const unsigned submitCount, const unsigned waitCount) {
+    return syscall(__NR_io_uring_enter, fd, submitCount, waitCount, waitCount ? IORING_ENTER_GETEVENTS : 0u, nullptr, _NSIG/8);
+}
+
+/* Submits pending entries to the kernel, optionally waiting for a
+   completion. The kernel may consume only some of them or none at all --
+   when interrupted by a signal, temporarily out of memory or with EBUSY if
+   completions have to be reaped first. The rest stays in the submission
+   queue for the next call. Returns the enterRing() result. */
+int submitRing(Ring& ring, const bool wait) {
+    const int result = enterRing(ring.fd, ring.pending, wait);
+    if(result >= 0) ring.pending -= result;
+    else if(errno != EINTR && errno != EAGAIN && errno != EBUSY)
+        CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    return result;
+}
+
+/* Removes the pending entries from the submission queue again and fails
+   their operations with given error */
+void failPendingRing(Ring& ring, const int error) {
+    unsigned tail = *ring.submissionTail;
+    for(; ring.pending; --ring.pending) {
+        --tail;
+        Operation& operation = *reinterpret_cast<Operation*>(ring.entries[tail & ring.submissionMask].user_data);
+        operation.error = error;
+        close(operation.fd);
+
+        --ring.inFlight;
+        ++ring.completed;
+    }
+    __atomic_store_n(ring.submissionTail, tail, __ATOMIC_RELEASE);
+}
+
+/* Fills the ring with as many submitted operations as it can take and
+   submits them to the kernel */
+void fillRing(Ring& ring, std::deque<Operation>& operations, const std::size_t submitted) {
+    while(ring.inFlight < ring.entryCount && ring.next < submitted) {
+        Operation& operation = operations[ring.next++];
+        if(!prepareRingOperation(operation)) {
+            ++ring.completed;
+            continue;
+        }
+
+        pushRingOperation(ring, operation);
+        ++ring.inFlight;
+        ++ring.pending;
+    }
+
+    /* Whatever the kernel doesn't take now gets submitted in reapRing() */
+    if(ring.pending) submitRing(ring, false);
+}
+
+/* Submits what's pending, waits for at least one completion if there's
+   anything in the kernel and processes all completions that are available */
+void reapRing(Ring& ring) {
+    /* Waiting with nothing in the kernel would block forever if none of the
+       pending entries get consumed */
+    const bool inKernel = ring.inFlight != ring.pending;
+    const int submitted = submitRing(ring, inKernel);
+    /* Saved as close() below may overwrite it */
+    const int submitError = submitted < 0 ? errno : 0;
+
+    unsigned head = *ring.completionHead;
+    bool reaped = false;
+    while(head != __atomic_load_n(ring.completionTail, __ATOMIC_ACQUIRE)) {
+        const io_uring_cqe& completion = ring.completions[head & ring.completionMask];
+        Operation& operation = *reinterpret_cast<Operation*>(completion.user_data);
+        const int result = completion.res;
+        ++head;
+        reaped = true;
+
+        const std::size_t size = operation.out ? operation.readData.size() : operation.writeData.size();
+        if(result > 0) operation.offset += result;
+
+        /* Partial read or write, continue where it stopped. The ring slot
+           occupied by this operation just got freed so it can be reused. */
+        if(result > 0 && operation.offset < size) {
+            pushRingOperation(ring, operation);
+            ++ring.pending;
+            continue;
+        }
+
+        if(result < 0) operation.error = -result;
+        /* A zero-sized write means the disk is full */
+        else if(!operation.out && operation.offset != size)
+            operation.error = ENOSPC;
+        close(operation.fd);
+        if(operation.out && !operation.error) finishRead(operation);
+
+        --ring.inFlight;
+        ++ring.completed;
+    }
+
+    __atomic_store_n(ring.completionHead, head, __ATOMIC_RELEASE);
+
+    /* If the kernel consumed nothing, there was nothing to wait for and no
+       completions to process, retrying would spin forever without making
+       any progress. Fail the pending operations instead. A signal
+       interruption is fine to retry. */
+    if(!inKernel && !reaped && ring.pending && submitted <= 0 && submitError != EINTR)
+        failPendingRing(ring, submitted < 0 ? submitError : EAGAIN);
+}
+#endif
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void worker(Pool& pool) {
+    for(;;) {
+        Operation* operation;
+        {
+            std::unique_lock<std::mutex> lock{pool.mutex};
+            pool.workAvailable.wait(lock, [&pool]{
+                return pool.quit || !pool.queue.empty();
+            });
+            if(pool.queue.empty()) return;
+            operation = pool.queue.front();
+            pool.queue.pop_front();
+        }
+
+        executeBlocking(*operation);
+        if(operation->out && !operation->error) finishRead(*operation);
+
+        {
+            std::lock_guard<std::mutex> lock{pool.mutex};
+            ++pool.completed;
+        }
+        pool.workDone.notify_all();
+    }
+}
+#endif
+
+}
+
+AsyncFileIO::AsyncFileIO(Backend backend, const std::size_t queueSize): _state{InPlaceInit, backend, queueSize} {
+    CORRADE_ASSERT(queueSize,
+        "Utility::AsyncFileIO: queue size expected to be non-zero", );
+
+    #ifdef CORRADE_UTILITY_ASYNCFILEIO_IO_URING
+    if(backend == Backend::IoUring) {
+        auto& ring = _state->ring;
+        io_uring_params params{};
+        /* The kernel limits the ring size to 4096 entries before 5.4 */
+        ring.fd = syscall(__NR_io_uring_setup, unsigned(std::min(queueSize, std::size_t{4096})), &params);
+        if(ring.fd != -1) {
+            ring.entryCount = params.sq_entries;
+            ring.ringSize = params.sq_off.array + params.sq_entries*sizeof(unsigned);
+            ring.completionRingSize = params.cq_off.cqes + params.cq_entries*sizeof(io_uring_cqe);
+            /* Since 5.4 both rings can be mapped with a single call */
+            #ifdef IORING_FEAT_SINGLE_MMAP
+            const bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+            if(singleMap) ring.ringSize = ring.completionRingSize =
+                std::max(ring.ringSize, ring.completionRingSize);
+            #else
+            constexpr bool singleMap = false;
+            #endif
+
+            ring.ringPtr = mmap(nullptr, ring.ringSize, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, ring.fd, IORING_OFF_SQ_RING);
+            if(ring.ringPtr != MAP_FAILED) {
+                ring.completionRingPtr = singleMap ? ring.ringPtr : mmap(nullptr, ring.completionRingSize, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, ring.fd, IORING_OFF_CQ_RING);
+                ring.entriesSize = params.sq_entries*sizeof(io_uring_sqe);
+                ring.entries = static_cast<io_uring_sqe*>(mmap(nullptr, ring.entriesSize, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, ring.fd, IORING_OFF_SQES));
+            }
+
+            if(ring.ringPtr != MAP_FAILED && ring.completionRingPtr != MAP_FAILED && ring.entries != MAP_FAILED) {
+                char* const submission = static_cast<char*>(ring.ringPtr);
+                ring.submissionHead = reinterpret_cast<unsigned*>(submission + params.sq_off.head);
+                ring.submissionTail = reinterpret_cast<unsigned*>(submission + params.sq_off.tail);
+                ring.submissionMask = *reinterpret_cast<unsigned*>(submission + params.sq_off.ring_mask);
+                ring.submissionArray = reinterpret_cast<unsigned*>(submission + params.sq_off.array);
+                char* const completion = static_cast<char*>(ring.completionRingPtr);
+                ring.completionHead = reinterpret_cast<unsigned*>(completion + params.cq_off.head);
+                ring.completionTail = reinterpret_cast<unsigned*>(completion + params.cq_off.tail);
+                ring.completionMask = *reinterpret_cast<unsigned*>(completion + params.cq_off.ring_mask);
+                ring.completions = reinterpret_cast<io_uring_cqe*>(completion + params.cq_off.cqes);
+                return;
+            }
+
+            /* LCOV_EXCL_START */
+            if(ring.entries && ring.entries != MAP_FAILED)
+                munmap(ring.entries, ring.entriesSize);
+            if(ring.completionRingPtr && ring.completionRingPtr != MAP_FAILED && ring.completionRingPtr != ring.ringPtr)
+                munmap(ring.completionRingPtr, ring.completionRingSize);
+            if(ring.ringPtr != MAP_FAILED)
+                munmap(ring.ringPtr, ring.ringSize);
+            close(ring.fd);
+            ring.fd = -1;
+            /* LCOV_EXCL_STOP */
+        }
+    }
+    #endif
+
+    _state->backend = Backend::ThreadPool;
+}
+
+AsyncFileIO::AsyncFileIO(AsyncFileIO&&) noexcept = default;
+
+AsyncFileIO::~AsyncFileIO() {
+    /* Moved-out instance */
+    if(!_state) return;
+
+    if(!_state->operations.empty()) wait();
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    {
+        std::lock_guard<std::mutex> lock{_state->pool.mutex};
+        _state->pool.quit = true;
+    }
+    _state->pool.workAvailable.notify_all();
+    for(std::thread& thread: _state->pool.threads) thread.join();
+    #endif
+
+    #ifdef CORRADE_UTILITY_ASYNCFILEIO_IO_URING
+    auto& ring = _state->ring;
+    if(ring.fd != -1) {
+        munmap(ring.entries, ring.entriesSize);
+        if(ring.completionRingPtr != ring.ringPtr)
+            munmap(ring.completionRingPtr, ring.completionRingSize);
+        munmap(ring.ringPtr, ring.ringSize);
+        close(ring.fd);
+    }
+    #endif
+}
+
+AsyncFileIO& AsyncFileIO::operator=(AsyncFileIO&&) noexcept = default;
+
+AsyncFileIO::Backend AsyncFileIO::backend() const { return _state->backend; }
+
+std::size_t AsyncFileIO::queueSize() const { return _state->queueSize; }
+
+std::size_t AsyncFileIO::operationCount() const {
+    return _state->operations.size();
+}
+
+void AsyncFileIO::read(const std::string& filename, Containers::Array<char>& out) {
+    _state->operations.emplace_back();
+    Operation& operation = _state->operations.back();
+    operation.filename = filename;
+    operation.out = &out;
+}
+
+void AsyncFileIO::write(const std::string& filename, const Containers::ArrayView<const void> data) {
+    _state->operations.emplace_back();
+    Operation& operation = _state->operations.back();
+    operation.filename = filename;
+    operation.out = nullptr;
+    operation.writeData = Containers::arrayCast<const char>(data);
+}
+
+void AsyncFileIO::submit() {
+    State& state = *_state;
+    const std::size_t begin = state.submitted;
+    state.submitted = state.operations.size();
+    if(begin == state.submitted) return;
+
+    #ifdef CORRADE_UTILITY_ASYNCFILEIO_IO_URING
+    if(state.backend == Backend::IoUring) {
+        fillRing(state.ring, state.operations, state.submitted);
+        return;
+    }
+    #endif
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    auto& pool = state.pool;
+    {
+        std::lock_guard<std::mutex> lock{pool.mutex};
+        for(std::size_t i = begin; i != state.submitted; ++i)
+            pool.queue.push_back(&state.operations[i]);
+    }
+    pool.workAvailable.notify_all();
+
+    /* Spawn more threads if there's enough work for them */
+    const std::size_t threadCount = std::min({state.queueSize,
+        std::size_t(std::max(std::thread::hardware_concurrency(), 1u)),
+        state.submitted - begin});
+    while(pool.threads.size() < threadCount)
+        pool.threads.emplace_back(worker, std::ref(pool));
+    #else
+    for(std::size_t i = begin; i != state.submitted; ++i) {
+        Operation& operation = state.operations[i];
+        executeBlocking(operation);
+        if(operation.out && !operation.error) finishRead(operation);
+    }
+    #endif
+}
+
+bool AsyncFileIO::wait() {
+    submit();
+
+    State& state = *_state;
+
+    #ifdef CORRADE_UTILITY_ASYNCFILEIO_IO_URING
+    if(state.backend == Backend::IoUring) {
+        while(state.ring.completed != state.submitted) {
+            reapRing(state.ring);
+            fillRing(state.ring, state.operations, state.submitted);
+        }
+        state.ring.next = state.ring.completed = 0;
+    } else
+    #endif
+    {
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        auto& pool = state.pool;
+        std::unique_lock<std::mutex> lock{pool.mutex};
+        pool.workDone.wait(lock, [&]{
+            return pool.completed == state.submitted;
+        });
+        pool.completed = 0;
+        #endif
+    }
+
+    bool success = true;
+    for(const Operation& operation: state.operations) {
+        if(!operation.error) continue;
+
+        Error{} << (operation.out ? "Utility::AsyncFileIO::wait(): can't read" : "Utility::AsyncFileIO::wait(): can't write") << operation.filename << Debug::nospace << ":" << std::strerror(operation.error);
+        success = false;
+    }
+
+    state.operations.clear();
+    state.submitted = 0;
+    return success;
+}
+
+Debug& operator<<(Debug& debug, const AsyncFileIO::Backend value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case AsyncFileIO::Backend::value: return debug << "Utility::AsyncFileIO::Backend::" #value;
+        _c(IoUring)
+        _c(ThreadPool)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "Utility::AsyncFileIO::Backend(" << Debug::nospace << reinterpret_cast<void*>(std::uint8_t(value)) << Debug::nospace << ")";
+}
+
+}}
@@ -0,0 +1,197 @@
+#ifndef Corrade_Utility_AsyncFileIO_h
+#define Corrade_Utility_AsyncFileIO_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Utility::AsyncFileIO
+ * @m_since_latest
+ */
+
+#include <string>
+
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/Utility/Utility.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Utility {
+
+#if defined(DOXYGEN_GENERATING_OUTPUT) || defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)) || defined(CORRADE_TARGET_EMSCRIPTEN)
+/**
+@brief Asynchronous batched file I/O
+@m_since_latest
+
+Unlike @ref Directory::read() or @ref Directory::write(), which process a
+single file at a time and block until it's done, this class queues any number
+of whole-file reads and writes, submits them all at once and lets them
+complete in the background while the caller does other work. That's
+beneficial especially when loading many small files, where a blocking loop
+keeps the disk queue nearly idle. Example usage:
+
+@snippet Utility.cpp AsyncFileIO
+
+Operations are queued with @ref read() and @ref write(), handed over to the
+backend with @ref submit() and completed with @ref wait(). The output arrays
+passed to @ref read() and the views passed to @ref write() have to stay in
+scope until @ref wait() returns. Operations that fail don't affect the others,
+they're reported via @ref Error in @ref wait() from the calling thread.
+
+@section Utility-AsyncFileIO-backends Backends
+
+On Linux 5.1 and newer, the operations are executed by the kernel through an
+@m_class{m-doc-external} [io_uring](https://man7.org/linux/man-pages/man7/io_uring.7.html)
+submission queue, without any additional threads. Opening of the files is done
+on the calling thread and at most @ref queueSize() files are open at the same
+time.
+
+Everywhere else, or if the kernel doesn't support io_uring or denies access to
+it (which is common in containers), the operations are executed by a pool of
+worker threads, of which there's at most @ref queueSize() and at most as many
+as there are hardware threads. The threads are created on the first
+@ref submit() and live until the instance is destroyed. On
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten" there are no threads and the
+operations are executed synchronously in @ref submit().
+
+@partialsupport Available only on @ref CORRADE_TARGET_UNIX "Unix" and non-RT
+    @ref CORRADE_TARGET_WINDOWS "Windows" platforms and on
+    @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+*/
+class CORRADE_UTILITY_EXPORT AsyncFileIO {
+    public:
+        /**
+         * @brief Backend
+         *
+         * @see @ref AsyncFileIO(Backend, std::size_t), @ref backend()
+         */
+        enum class Backend: std::uint8_t {
+            /**
+             * Linux io_uring. If not available, @ref Backend::ThreadPool is
+             * used instead.
+             */
+            IoUring = 1,
+
+            /** Pool of worker threads */
+            ThreadPool
+        };
+
+        /**
+         * @brief Constructor
+         * @param backend       Preferred backend
+         * @param queueSize     Max count of operations in flight at the same
+         *      time. Expected to be non-zero.
+         *
+         * If @p backend is @ref Backend::IoUring and io_uring isn't
+         * available, falls back to @ref Backend::ThreadPool. Use
+         * @ref backend() to check which backend got used.
+         */
+        explicit AsyncFileIO(Backend backend = Backend::IoUring, std::size_t queueSize = 64);
+
+        /** @brief Copying is not allowed */
+        AsyncFileIO(const AsyncFileIO&) = delete;
+
+        /** @brief Move constructor */
+        AsyncFileIO(AsyncFileIO&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref wait() if there are any operations queued or in flight.
+         */
+        ~AsyncFileIO();
+
+        /** @brief Copying is not allowed */
+        AsyncFileIO& operator=(const AsyncFileIO&) = delete;
+
+        /** @brief Move assignment */
+        AsyncFileIO& operator=(AsyncFileIO&&) noexcept;
+
+        /** @brief Backend used */
+        Backend backend() const;
+
+        /** @brief Max count of operations in flight at the same time */
+        std::size_t queueSize() const;
+
+        /**
+         * @brief Count of queued and submitted operations
+         *
+         * Includes also operations that were already completed but not
+         * yet collected by @ref wait().
+         */
+        std::size_t operationCount() const;
+
+        /**
+         * @brief Queue a file read
+         *
+         * Once the operation completes, @p out contains the whole file
+         * contents. The reference has to stay valid until @ref wait()
+         * returns. If the file can't be read, @p out is left untouched.
+         * Expects that the filename is in UTF-8.
+         */
+        void read(const std::string& filename, Containers::Array<char>& out);
+
+        /**
+         * @brief Queue a file write
+         *
+         * Once the operation completes, the file contains exactly @p data,
+         * replacing any previous contents. The memory referenced by @p data
+         * has to stay valid until @ref wait() returns. Expects that the
+         * filename is in UTF-8.
+         */
+        void write(const std::string& filename, Containers::ArrayView<const void> data);
+
+        /**
+         * @brief Submit queued operations
+         *
+         * Hands all operations queued with @ref read() and @ref write() over
+         * to the backend and returns without waiting for them to finish.
+         */
+        void submit();
+
+        /**
+         * @brief Wait for all operations to complete
+         *
+         * Calls @ref submit() if there are any queued operations and then
+         * blocks until all of them complete. Prints a message to @ref Error
+         * for every operation that failed and returns @cpp false @ce if any
+         * did, @cpp true @ce otherwise. After this function returns,
+         * @ref operationCount() is zero.
+         */
+        bool wait();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+/** @debugoperatorclassenum{AsyncFileIO,AsyncFileIO::Backend} */
+CORRADE_UTILITY_EXPORT Debug& operator<<(Debug& debug, AsyncFileIO::Backend value);
+#else
+#error this header is available only on Unix, non-RT Windows and Emscripten
+#endif
+
+}}
+
+#endif
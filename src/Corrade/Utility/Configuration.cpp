@@ -27,11 +27,19 @@
 #include "Configuration.h"
 
 #include <algorithm>
-#include <sstream>
+#include <cstring>
+#include <istream>
+#include <ostream>
 #include <utility>
 #include <vector>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <atomic>
+#include <thread>
+#endif
 
 #include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/Optional.h"
+#include "Corrade/Containers/String.h"
 #include "Corrade/Utility/Assert.h"
 #include "Corrade/Utility/DebugStl.h"
 #include "Corrade/Utility/Directory.h"
@@ -51,7 +59,14 @@ Configuration::Configuration(const std::string& filename, const Flags flags): Co
         return;
     }
 
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    /* Memory-map the file for parallel parsing. Mapping an empty file fails,
+       so those are read the usual way. */
+    const Containers::Optional<std::size_t> size = flags & Flag::ParallelParse ? Directory::fileSize(filename) : Containers::NullOpt;
+    if(size && *size ? parse(Directory::mapRead(filename)) : parse(Directory::read(filename))) return;
+    #else
     if(parse(Directory::read(filename))) return;
+    #endif
 
     /* Error, reset everything back */
     _filename = {};
@@ -77,6 +92,14 @@ Configuration::Configuration(Configuration&& other): ConfigurationGroup{std::mov
 
 Configuration::~Configuration() { if(_flags & InternalFlag::Changed) save(); }
 
+Configuration::Flags Configuration::publicFlags() const {
+    const InternalFlags publicMask = InternalFlag::PreserveBom|
+        InternalFlag::ForceUnixEol|InternalFlag::ForceWindowsEol|
+        InternalFlag::Truncate|InternalFlag::SkipComments|
+        InternalFlag::ReadOnly|InternalFlag::ParallelParse;
+    return Flag(std::uint32_t(_flags & publicMask));
+}
+
 Configuration& Configuration::operator=(Configuration&& other) {
     ConfigurationGroup::operator=(std::move(other));
     _filename = std::move(other._filename);
@@ -112,17 +135,153 @@ bool Configuration::parse(Containers::ArrayView<const char> in) {
     }
 
     /* Parse file */
-    std::pair<Containers::ArrayView<const char>, const char*> parsed = parse(in, this, {});
-    if(parsed.second) {
-        Error() << "Utility::Configuration::Configuration():" << parsed.second;
+    const char* error;
+    if(_flags & InternalFlag::ParallelParse)
+        error = parseParallel(in);
+    else {
+        std::pair<Containers::ArrayView<const char>, const char*> parsed = parse(in, this, {});
+        CORRADE_INTERNAL_ASSERT(parsed.second || parsed.first.empty());
+        error = parsed.second;
+    }
+
+    if(error) {
+        Error() << "Utility::Configuration::Configuration():" << error;
         clear();
         return false;
     }
 
-    CORRADE_INTERNAL_ASSERT(parsed.first.empty());
     return true;
 }
 
+namespace {
+    /* Approximate size of pieces the file is split into with
+       Flag::ParallelParse. Files smaller than twice this are parsed
+       sequentially, as spawning the threads would take longer than the
+       parsing itself. */
+    constexpr std::size_t ParallelParsePieceSize = 256*1024;
+}
+
+const char* Configuration::parseParallel(const Containers::ArrayView<const char> in) {
+    using namespace Containers::Literals;
+
+    /* Split the file into pieces at boundaries of top-level groups closest
+       after evenly spaced offsets. This is a simplified variant of the loop
+       in parse() that doesn't allocate and only keeps track of multi-line
+       values and top-level group names, malformed lines are skipped and
+       left to be diagnosed by parse() later. */
+    std::vector<std::size_t> pieceOffsets{0};
+    if(in.size() >= 2*ParallelParsePieceSize) {
+        const Containers::StringView data{in.data(), in.size()};
+        Containers::StringView topLevelGroup;
+        bool hasTopLevelGroup = false;
+        bool multiLineValue = false;
+        std::size_t nextOffset = ParallelParsePieceSize;
+        for(std::size_t lineBegin = 0, lineEnd; lineBegin < data.size(); lineBegin = lineEnd + 1) {
+            const void* const newline = std::memchr(data.data() + lineBegin, '\n', data.size() - lineBegin);
+            lineEnd = newline ? static_cast<const char*>(newline) - data.data() : data.size();
+            const Containers::StringView line = data.slice(lineBegin, lineEnd).trimmed();
+
+            if(multiLineValue) {
+                if(line == "\"\"\""_s) multiLineValue = false;
+                continue;
+            }
+
+            if(line.isEmpty() || line[0] == '#' || line[0] == ';') continue;
+
+            /* Key/value pair, check for start of a multi-line value */
+            if(line[0] != '[') {
+                const Containers::StringView equals = line.find('=');
+                if(equals.data() && line.suffix(equals.end()).trimmed() == "\"\"\""_s)
+                    multiLineValue = true;
+                continue;
+            }
+
+            if(line[line.size() - 1] != ']') continue;
+
+            /* A group header that's not a subgroup of the current top-level
+               group starts a new top-level group */
+            const Containers::StringView name = line.slice(1, line.size() - 1).trimmed();
+            if(hasTopLevelGroup && name.size() > topLevelGroup.size() && name.hasPrefix(topLevelGroup) && name[topLevelGroup.size()] == '/')
+                continue;
+
+            const Containers::StringView slash = name.find('/');
+            topLevelGroup = slash.data() ? name.prefix(slash.begin()) : name;
+            hasTopLevelGroup = true;
+            if(lineBegin >= nextOffset) {
+                pieceOffsets.push_back(lineBegin);
+                nextOffset = lineBegin + ParallelParsePieceSize;
+            }
+        }
+    }
+
+    /* Just one piece, parse directly */
+    if(pieceOffsets.size() == 1) {
+        std::pair<Containers::ArrayView<const char>, const char*> parsed = parse(in, this, {});
+        CORRADE_INTERNAL_ASSERT(parsed.second || parsed.first.empty());
+        return parsed.second;
+    }
+
+    /* Parse each piece into a separate instance with the same flags, so the
+       threads don't share any state. All pieces except the last are marked
+       as such, so empty lines at their end are preserved the same way as if
+       the whole file was parsed at once. */
+    pieceOffsets.push_back(in.size());
+    const std::size_t pieceCount = pieceOffsets.size() - 1;
+    const Flags flags = publicFlags();
+    std::vector<Configuration> pieces;
+    pieces.reserve(pieceCount);
+    for(std::size_t i = 0; i != pieceCount; ++i) {
+        pieces.emplace_back(flags);
+        if(i + 1 != pieceCount) pieces.back()._flags |= InternalFlag::NotLastPiece;
+    }
+
+    /* Each thread (including this one) takes the next unparsed piece until
+       there's none left */
+    std::vector<const char*> errors(pieceCount);
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    std::atomic<std::size_t> nextPiece{0};
+    #else
+    std::size_t nextPiece = 0;
+    #endif
+    const auto parsePieces = [&]() {
+        for(std::size_t i; (i = nextPiece++) < pieceCount; ) {
+            std::pair<Containers::ArrayView<const char>, const char*> parsed = pieces[i].parse(in.slice(pieceOffsets[i], pieceOffsets[i + 1]), &pieces[i], {});
+            CORRADE_INTERNAL_ASSERT(parsed.second || parsed.first.empty());
+            errors[i] = parsed.second;
+        }
+    };
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    std::vector<std::thread> threads;
+    const std::size_t threadCount = std::min(std::size_t(std::max(std::thread::hardware_concurrency(), 1u)), pieceCount);
+    threads.reserve(threadCount - 1);
+    for(std::size_t i = 1; i < threadCount; ++i)
+        threads.emplace_back(parsePieces);
+    #endif
+    parsePieces();
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    for(std::thread& thread: threads) thread.join();
+    #endif
+
+    /* Report the first error in the file, if any */
+    for(const char* const error: errors) if(error) return error;
+
+    /* Stitch the pieces together. Only the first piece can have values in
+       the root group, the others start with a group header. */
+    _values = std::move(pieces[0]._values);
+    for(Configuration& piece: pieces) {
+        CORRADE_INTERNAL_ASSERT(&piece == &pieces[0] || piece._values.empty());
+        _flags |= piece._flags & InternalFlag::WindowsEol;
+        for(ConfigurationGroup::Group& group: piece._groups)
+            _groups.push_back(std::move(group));
+        piece._groups.clear();
+    }
+
+    /* Redirect configuration pointer from the pieces to this instance */
+    setConfigurationPointer(this);
+    return nullptr;
+}
+
 std::pair<Containers::ArrayView<const char>, const char*> Configuration::parse(Containers::ArrayView<const char> in, ConfigurationGroup* group, const std::string& fullPath) {
     CORRADE_INTERNAL_ASSERT(fullPath.empty() || String::endsWith(fullPath, '/'));
 
@@ -173,7 +332,8 @@ std::pair<Containers::ArrayView<const char>, const char*> Configuration::parse(C
             if(_flags & InternalFlag::SkipComments) continue;
 
             /* Save it only if this is not the last one */
-            if(in) group->_values.emplace_back();
+            if(in || (_flags & InternalFlag::NotLastPiece))
+                group->_values.emplace_back();
 
         /* Group header */
         } else if(buffer[0] == '[') {
@@ -270,12 +430,8 @@ std::pair<Containers::ArrayView<const char>, const char*> Configuration::parse(C
 }
 
 bool Configuration::save(const std::string& filename) {
-    /* Save to a stringstream and then write it as a string to the file. Doing
-       it this way to avoid issues with Unicode filenames on Windows. */
-    /** @todo get rid of streams altogether */
-    std::ostringstream out;
-    save(out);
-    if(Directory::writeString(filename, out.str()))
+    const Containers::String out = saveToString();
+    if(Directory::write(filename, {out.data(), out.size()}))
         return true;
 
     Error() << "Utility::Configuration::save(): cannot open file" << filename;
@@ -283,20 +439,37 @@ bool Configuration::save(const std::string& filename) {
 }
 
 void Configuration::save(std::ostream& out) {
+    const Containers::String string = saveToString();
+    out.write(string.data(), string.size());
+}
+
+Containers::String Configuration::saveToString() const {
+    using namespace Containers::Literals;
+
     /* BOM, if user explicitly wants that crap */
-    if((_flags & InternalFlag::PreserveBom) && (_flags & InternalFlag::HasBom))
-        out.write(Bom, 3);
+    const bool bom = (_flags & InternalFlag::PreserveBom) && (_flags & InternalFlag::HasBom);
 
     /* EOL character */
-    std::string eol;
-    if(_flags & (InternalFlag::ForceWindowsEol|InternalFlag::WindowsEol) && !(_flags & InternalFlag::ForceUnixEol)) eol = "\r\n";
-    else eol = "\n";
+    const Containers::StringView eol =
+        _flags & (InternalFlag::ForceWindowsEol|InternalFlag::WindowsEol) && !(_flags & InternalFlag::ForceUnixEol) ? "\r\n"_s : "\n"_s;
+
+    /* Calculate the output size first so everything can be written into a
+       single allocation */
+    const std::size_t size = (bom ? 3 : 0) + saveSize(eol.size(), *this, 0);
+    Containers::String out{NoInit, size};
+    char* it = out.data();
+    if(bom) {
+        std::memcpy(it, Bom, 3);
+        it += 3;
+    }
 
-    /** @todo Checking file.good() after every operation */
-    /** @todo Backup file */
+    /* Recursively save all groups. The group path is built in a single
+       string that gets appended to and truncated back on the way. */
+    std::string fullPath;
+    it = save(it, eol, *this, fullPath);
+    CORRADE_INTERNAL_ASSERT(it == out.data() + out.size());
 
-    /* Recursively save all groups */
-    save(out, eol, this, {});
+    return out;
 }
 
 bool Configuration::save() {
@@ -308,60 +481,284 @@ namespace {
     constexpr bool isWhitespace(char c) {
         return c == ' ' || c == '\t' || c == '\f' || c == '\v' || c == '\r' || c == '\n';
     }
+
+    inline char* write(char* out, const char* data, const std::size_t size) {
+        /* memcpy() with a null pointer is UB even if the size is zero */
+        if(size) std::memcpy(out, data, size);
+        return out + size;
+    }
+
+    inline char* write(char* out, const std::string& string) {
+        return write(out, string.data(), string.size());
+    }
+
+    inline char* write(char* out, const Containers::StringView string) {
+        return write(out, string.data(), string.size());
+    }
+
+    inline char* write(char* out, const char c) {
+        *out = c;
+        return out + 1;
+    }
 }
 
-void Configuration::save(std::ostream& out, const std::string& eol, ConfigurationGroup* group, const std::string& fullPath) const {
-    CORRADE_INTERNAL_ASSERT(group->configuration() == this);
-    std::string buffer;
+/* Has to be kept in sync with save() below */
+std::size_t Configuration::saveSize(const std::size_t eolSize, const ConfigurationGroup& group, const std::size_t fullPathSize) const {
+    std::size_t size = 0;
 
     /* Foreach all items in the group */
-    for(const Value& value: group->_values) {
+    for(const Value& value: group._values) {
+        /* Key/value pair */
+        if(!value.key.empty()) {
+            const std::size_t newlineCount = std::count(value.value.begin(), value.value.end(), '\n');
+
+            /* Multi-line value, with newlines replaced with `eol` and wrapped
+               in """ on separate lines */
+            if(newlineCount)
+                size += value.key.size() + 4 + eolSize + value.value.size() + newlineCount*(eolSize - 1) + eolSize + 3 + eolSize;
+
+            /* Value with leading/trailing spaces, wrapped in " */
+            else if(!value.value.empty() && (isWhitespace(value.value.front()) || isWhitespace(value.value.back())))
+                size += value.key.size() + 2 + value.value.size() + 1 + eolSize;
+
+            /* Value without spaces */
+            else size += value.key.size() + 1 + value.value.size() + eolSize;
+        }
+
+        /* Comment / empty line */
+        else size += value.value.size() + eolSize;
+    }
+
+    /* Recursively process all subgroups */
+    for(std::size_t i = 0; i != group._groups.size(); ++i) {
+        const Group& g = group._groups[i];
+        const std::size_t nameSize = (fullPathSize ? fullPathSize + 1 : 0) + g.name.size();
+
+        if(!((i == 0 || group._groups[i - 1].name != g.name) && g.group->_values.empty() && !g.group->_groups.empty()))
+            size += 1 + nameSize + 1 + eolSize;
+
+        size += saveSize(eolSize, *g.group, nameSize);
+    }
+
+    return size;
+}
+
+char* Configuration::save(char* out, const Containers::StringView eol, const ConfigurationGroup& group, std::string& fullPath) const {
+    CORRADE_INTERNAL_ASSERT(group.configuration() == this);
+
+    /* Foreach all items in the group */
+    for(const Value& value: group._values) {
         /* Key/value pair */
         if(!value.key.empty()) {
             /* Multi-line value */
             if(value.value.find_first_of('\n') != std::string::npos) {
+                out = write(out, value.key);
+                out = write(out, "=\"\"\"", 4);
+                out = write(out, eol);
+
                 /* Replace \n with `eol` */
-                /** @todo fixme: ugly and slow */
-                std::string valueString = value.value;
-                std::size_t pos = 0;
-                while((pos = valueString.find_first_of('\n', pos)) != std::string::npos) {
-                    valueString.replace(pos, 1, eol);
-                    pos += eol.size();
+                std::size_t prev = 0, pos;
+                while((pos = value.value.find_first_of('\n', prev)) != std::string::npos) {
+                    out = write(out, value.value.data() + prev, pos - prev);
+                    out = write(out, eol);
+                    prev = pos + 1;
                 }
+                out = write(out, value.value.data() + prev, value.value.size() - prev);
 
-                buffer = value.key + "=\"\"\"" + eol + valueString + eol + "\"\"\"" + eol;
+                out = write(out, eol);
+                out = write(out, "\"\"\"", 3);
 
             /* Value with leading/trailing spaces */
             } else if(!value.value.empty() && (isWhitespace(value.value.front()) || isWhitespace(value.value.back()))) {
-                buffer = value.key + "=\"" + value.value + '"' + eol;
+                out = write(out, value.key);
+                out = write(out, "=\"", 2);
+                out = write(out, value.value);
+                out = write(out, '"');
 
             /* Value without spaces */
-            } else buffer = value.key + '=' + value.value + eol;
+            } else {
+                out = write(out, value.key);
+                out = write(out, '=');
+                out = write(out, value.value);
+            }
         }
 
         /* Comment / empty line */
-        else buffer = value.value + eol;
+        else out = write(out, value.value);
 
-        out.write(buffer.data(), buffer.size());
+        out = write(out, eol);
     }
 
     /* Recursively process all subgroups */
-    for(std::size_t i = 0; i != group->_groups.size(); ++i) {
-        const Group& g = group->_groups[i];
+    for(std::size_t i = 0; i != group._groups.size(); ++i) {
+        const Group& g = group._groups[i];
 
         /* Subgroup name */
-        std::string name = g.name;
-        if(!fullPath.empty()) name = fullPath + '/' + name;
+        const std::size_t fullPathSize = fullPath.size();
+        if(fullPathSize) fullPath += '/';
+        fullPath += g.name;
 
         /* Omit the name if the group is a first subgroup of given name, has no
            values and only subgroups */
-        if(!((i == 0 || group->_groups[i - 1].name != g.name) && g.group->_values.empty() && !g.group->_groups.empty())) {
-            buffer = '[' + name + ']' + eol;
-            out.write(buffer.data(), buffer.size());
+        if(!((i == 0 || group._groups[i - 1].name != g.name) && g.group->_values.empty() && !g.group->_groups.empty())) {
+            out = write(out, '[');
+            out = write(out, fullPath);
+            out = write(out, ']');
+            out = write(out, eol);
+        }
+
+        out = save(out, eol, *g.group, fullPath);
+        fullPath.resize(fullPathSize);
+    }
+
+    return out;
+}
+
+namespace {
+
+constexpr std::size_t NotFound = ~std::size_t{};
+
+/* Pairs up items of the two lists by their name and index among items of the
+   same name, calling the callback with indices of both, or with NotFound if
+   the item is only in one of them. Items with an empty name (i.e., comments)
+   are skipped. The lists are walked sorted by name, so it's O(n log n)
+   instead of a quadratic lookup of every item by its name. */
+template<class T, class Name, class Callback> void matchByName(const std::vector<T>& a, const std::vector<T>& b, Name name, Callback callback) {
+    const auto sortedIndices = [&name](const std::vector<T>& items) {
+        std::vector<std::size_t> out;
+        out.reserve(items.size());
+        for(std::size_t i = 0; i != items.size(); ++i)
+            if(!name(items[i]).empty()) out.push_back(i);
+        /* Stable sort to preserve the order of items of the same name */
+        std::stable_sort(out.begin(), out.end(), [&items, &name](std::size_t first, std::size_t second) {
+            return name(items[first]) < name(items[second]);
+        });
+        return out;
+    };
+    const std::vector<std::size_t> sortedA = sortedIndices(a);
+    const std::vector<std::size_t> sortedB = sortedIndices(b);
+
+    const std::string* previous = nullptr;
+    unsigned int index = 0;
+    for(std::size_t i = 0, j = 0; i != sortedA.size() || j != sortedB.size(); ) {
+        const int order =
+            i == sortedA.size() ? 1 :
+            j == sortedB.size() ? -1 :
+            name(a[sortedA[i]]).compare(name(b[sortedB[j]]));
+        const std::string& current = order <= 0 ? name(a[sortedA[i]]) : name(b[sortedB[j]]);
+        index = previous && *previous == current ? index + 1 : 0;
+        previous = &current;
+
+        if(order == 0) {
+            callback(sortedA[i], sortedB[j], index);
+            ++i;
+            ++j;
+        } else if(order < 0) {
+            callback(sortedA[i], NotFound, index);
+            ++i;
+        } else {
+            callback(NotFound, sortedB[j], index);
+            ++j;
         }
+    }
+}
+
+}
+
+bool Configuration::reload(const std::string& filename, std::vector<Change>& changes) {
+    if(!Directory::exists(filename)) {
+        Error{} << "Utility::Configuration::reload(): file" << filename << "doesn't exist";
+        return false;
+    }
+
+    /* Parse into a temporary instance with the same flags. Truncation would
+       make it empty, so that one is ignored. */
+    Configuration parsed{filename, publicFlags() & ~Flag::Truncate};
+    if(!parsed.isValid()) return false;
+
+    reload(*this, parsed, changes);
+
+    /* The state now matches the file, take over the detected BOM and line
+       endings and mark it as unchanged */
+    _flags &= ~(InternalFlag::HasBom|InternalFlag::WindowsEol|InternalFlag::Changed);
+    _flags |= parsed._flags & (InternalFlag::HasBom|InternalFlag::WindowsEol);
+    _flags |= InternalFlag::IsValid;
+    return true;
+}
+
+bool Configuration::reload(std::vector<Change>& changes) {
+    if(_filename.empty()) {
+        Error{} << "Utility::Configuration::reload(): no filename set";
+        return false;
+    }
+
+    return reload(_filename, changes);
+}
+
+void Configuration::reload(ConfigurationGroup& group, ConfigurationGroup& parsed, std::vector<Change>& changes) {
+    /* Values are stored directly in the group and there's no way to get a
+       pointer to them, so after reporting the differences the parsed values
+       (including comments) are simply taken over */
+    matchByName(group._values, parsed._values,
+        [](const ConfigurationGroup::Value& value) -> const std::string& {
+            return value.key;
+        },
+        [&](std::size_t a, std::size_t b, unsigned int index) {
+            if(a == NotFound)
+                changes.push_back({ChangeType::ValueAdded, &group, parsed._values[b].key, index});
+            else if(b == NotFound)
+                changes.push_back({ChangeType::ValueRemoved, &group, group._values[a].key, index});
+            else if(group._values[a].value != parsed._values[b].value)
+                changes.push_back({ChangeType::ValueChanged, &group, group._values[a].key, index});
+        });
+    group._values = std::move(parsed._values);
+
+    /* Groups present in both are updated recursively and then put in place of
+       the parsed ones, added groups are taken from the parsed tree and
+       removed groups deleted */
+    std::vector<ConfigurationGroup*> kept(parsed._groups.size());
+    matchByName(group._groups, parsed._groups,
+        [](const ConfigurationGroup::Group& group) -> const std::string& {
+            return group.name;
+        },
+        [&](std::size_t a, std::size_t b, unsigned int index) {
+            if(a == NotFound) {
+                changes.push_back({ChangeType::GroupAdded, &group, parsed._groups[b].name, index});
+            } else if(b == NotFound) {
+                changes.push_back({ChangeType::GroupRemoved, &group, group._groups[a].name, index});
+                delete group._groups[a].group;
+            } else {
+                kept[b] = group._groups[a].group;
+                reload(*kept[b], *parsed._groups[b].group, changes);
+            }
+        });
+    for(std::size_t i = 0; i != parsed._groups.size(); ++i) {
+        ConfigurationGroup*& parsedGroup = parsed._groups[i].group;
+        if(kept[i]) {
+            delete parsedGroup;
+            parsedGroup = kept[i];
+        } else setConfigurationPointer(parsedGroup);
+    }
+    group._groups = std::move(parsed._groups);
+    parsed._groups.clear();
+}
 
-        save(out, eol, g.group, name);
+Debug& operator<<(Debug& debug, const Configuration::ChangeType value) {
+    debug << "Utility::Configuration::ChangeType" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case Configuration::ChangeType::value: return debug << "::" #value;
+        _c(ValueAdded)
+        _c(ValueRemoved)
+        _c(ValueChanged)
+        _c(GroupAdded)
+        _c(GroupRemoved)
+        #undef _c
+        /* LCOV_EXCL_STOP */
     }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(std::uint8_t(value)) << Debug::nospace << ")";
 }
 
 }}
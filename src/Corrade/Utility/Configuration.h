@@ -33,6 +33,7 @@
 #include <cstdint>
 #include <string>
 #include <iosfwd>
+#include <vector>
 
 #include "Corrade/Containers/EnumSet.h"
 #include "Corrade/Utility/ConfigurationGroup.h"
@@ -257,7 +258,23 @@ class CORRADE_UTILITY_EXPORT Configuration: public ConfigurationGroup {
              * and less memory used. Filename is not saved to avoid overwriting
              * the file with @ref save(). See also @ref Flag::SkipComments.
              */
-            ReadOnly        = 1 << 5
+            ReadOnly        = 1 << 5,
+
+            /**
+             * Parse large files in parallel. The file is memory-mapped
+             * instead of read into a newly allocated memory and split at
+             * top-level group boundaries into pieces of a few hundred
+             * kilobytes. The pieces are parsed independently on as many
+             * threads as there are hardware threads and then put together in
+             * the original order. The resulting configuration is identical to
+             * what sequential parsing produces. Files smaller than a few
+             * hundred kilobytes and files with just a single top-level group
+             * are parsed sequentially. On
+             * @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten" the pieces are
+             * parsed one after another on the calling thread.
+             * @m_since_latest
+             */
+            ParallelParse   = 1 << 6
         };
 
         /**
@@ -268,6 +285,65 @@ class CORRADE_UTILITY_EXPORT Configuration: public ConfigurationGroup {
         /* For some reason @ref Configuration() doesn't work since 1.8.17 */
         typedef Containers::EnumSet<Flag> Flags;
 
+        /**
+         * @brief Change type
+         * @m_since_latest
+         *
+         * @see @ref Change, @ref reload()
+         */
+        enum class ChangeType: std::uint8_t {
+            /** A value was added */
+            ValueAdded,
+
+            /** A value was removed */
+            ValueRemoved,
+
+            /** A value was changed */
+            ValueChanged,
+
+            /** A group was added */
+            GroupAdded,
+
+            /**
+             * A group was removed. Changes to values and subgroups of the
+             * removed group are not reported.
+             */
+            GroupRemoved
+        };
+
+        /**
+         * @brief Configuration change
+         * @m_since_latest
+         *
+         * @see @ref reload()
+         */
+        struct Change {
+            /** @brief Change type */
+            ChangeType type;
+
+            /**
+             * @brief Group in which the change happened
+             *
+             * For @ref ChangeType::GroupAdded and
+             * @ref ChangeType::GroupRemoved it's the parent group. Stays
+             * valid after the reload.
+             */
+            ConfigurationGroup* group;
+
+            /** @brief Key of the value or name of the subgroup */
+            std::string name;
+
+            /**
+             * @brief Index among values or subgroups of the same name
+             *
+             * Can be passed to @ref ConfigurationGroup::value() or
+             * @ref ConfigurationGroup::group() together with @ref name to
+             * access the value or group after the reload. For removed values
+             * and groups it's the index they had before the reload.
+             */
+            unsigned int index;
+        };
+
         /**
          * @brief Default constructor
          *
@@ -340,6 +416,52 @@ class CORRADE_UTILITY_EXPORT Configuration: public ConfigurationGroup {
         /** @brief Save configuration to stream */
         void save(std::ostream& out);
 
+        /**
+         * @brief Save configuration to a string
+         * @m_since_latest
+         *
+         * Produces the same output as @ref save(std::ostream&). The output
+         * size is calculated upfront, so the whole configuration is
+         * serialized into a single allocation without any temporaries. Both
+         * @ref save(std::ostream&) and @ref save(const std::string&) are
+         * implemented through this function.
+         */
+        Containers::String saveToString() const;
+
+        /**
+         * @brief Incrementally reload the configuration from a file
+         * @param[in]  filename Filename in UTF-8
+         * @param[out] changes  Where to put the list of changes
+         * @m_since_latest
+         *
+         * Parses the file and compares it with the current state. Values and
+         * subgroups are matched by their name and index among values or
+         * subgroups of the same name, added, removed and changed items are
+         * appended to @p changes and then applied in place. In contrast to
+         * recreating the whole instance, groups that are present in both
+         * states are kept, so pointers returned from @ref group() and
+         * @ref ConfigurationGroup::group() stay valid for them. Order of the
+         * reported changes is unspecified.
+         *
+         * Any modifications made since the last save are discarded, and the
+         * configuration is marked as unchanged, meaning it won't be saved on
+         * destruction. If the file doesn't exist or can't be parsed, prints a
+         * message to @relativeref{Corrade,Utility::Error}, returns
+         * @cpp false @ce and leaves the configuration and @p changes
+         * untouched.
+         */
+        bool reload(const std::string& filename, std::vector<Change>& changes);
+
+        /**
+         * @brief Incrementally reload the configuration from its file
+         * @m_since_latest
+         *
+         * Equivalent to calling @ref reload(const std::string&, std::vector<Change>&)
+         * with @ref filename(). If the filename is empty, prints a message to
+         * @relativeref{Corrade,Utility::Error} and returns @cpp false @ce.
+         */
+        bool reload(std::vector<Change>& changes);
+
         /**
          * @brief Save configuration
          *
@@ -356,22 +478,32 @@ class CORRADE_UTILITY_EXPORT Configuration: public ConfigurationGroup {
             Truncate        = std::uint32_t(Flag::Truncate),
             SkipComments    = std::uint32_t(Flag::SkipComments),
             ReadOnly        = std::uint32_t(Flag::ReadOnly),
+            ParallelParse   = std::uint32_t(Flag::ParallelParse),
 
             IsValid = 1 << 16,
             HasBom = 1 << 17,
             WindowsEol = 1 << 18,
-            Changed = 1 << 19
+            Changed = 1 << 19,
+            /* Set when parsing a piece of the file in parallel that's
+               followed by more data */
+            NotLastPiece = 1 << 20
         };
 
         typedef Containers::EnumSet<InternalFlag> InternalFlags;
 
         CORRADE_ENUMSET_FRIEND_OPERATORS(InternalFlags)
 
+        /* Public subset of _flags, with internal state bits masked away */
+        CORRADE_UTILITY_LOCAL Flags publicFlags() const;
+
         CORRADE_UTILITY_LOCAL bool parse(Containers::ArrayView<const char> in);
+        CORRADE_UTILITY_LOCAL const char* parseParallel(Containers::ArrayView<const char> in);
         CORRADE_UTILITY_LOCAL std::pair<Containers::ArrayView<const char>, const char*> parse(Containers::ArrayView<const char> in, ConfigurationGroup* group, const std::string& fullPath);
-        CORRADE_UTILITY_LOCAL void save(std::ostream& out, const std::string& eol, ConfigurationGroup* group, const std::string& fullPath) const;
+        CORRADE_UTILITY_LOCAL std::size_t saveSize(std::size_t eolSize, const ConfigurationGroup& group, std::size_t fullPathSize) const;
+        CORRADE_UTILITY_LOCAL char* save(char* out, Containers::StringView eol, const ConfigurationGroup& group, std::string& fullPath) const;
 
         CORRADE_UTILITY_LOCAL void setConfigurationPointer(ConfigurationGroup* group);
+        CORRADE_UTILITY_LOCAL void reload(ConfigurationGroup& group, ConfigurationGroup& parsed, std::vector<Change>& changes);
 
         std::string _filename;
         InternalFlags _flags;
@@ -379,6 +511,12 @@ class CORRADE_UTILITY_EXPORT Configuration: public ConfigurationGroup {
 
 CORRADE_ENUMSET_OPERATORS(Configuration::Flags)
 
+/**
+@debugoperatorclassenum{Configuration,Configuration::ChangeType}
+@m_since_latest
+*/
+CORRADE_UTILITY_EXPORT Debug& operator<<(Debug& debug, Configuration::ChangeType value);
+
 }}
 
 #endif
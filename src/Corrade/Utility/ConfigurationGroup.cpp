@@ -145,7 +145,7 @@ auto ConfigurationGroup::groups() const -> BasicGroups<const ConfigurationGroup>
         BasicGroups<const ConfigurationGroup>{&_groups[0], &_groups[0] + _groups.size()};
 }
 
-auto ConfigurationGroup::findGroup(const std::string& name, const unsigned int index) -> std::vector<Group>::iterator {
+auto ConfigurationGroup::findGroup(Containers::StringView name, const unsigned int index) -> std::vector<Group>::iterator {
     unsigned int foundIndex = 0;
     for(auto it = _groups.begin(); it != _groups.end(); ++it)
         if(it->name == name && foundIndex++ == index) return it;
@@ -153,7 +153,7 @@ auto ConfigurationGroup::findGroup(const std::string& name, const unsigned int i
     return _groups.end();
 }
 
-auto ConfigurationGroup::findGroup(const std::string& name, const unsigned int index) const -> std::vector<Group>::const_iterator {
+auto ConfigurationGroup::findGroup(Containers::StringView name, const unsigned int index) const -> std::vector<Group>::const_iterator {
     unsigned int foundIndex = 0;
     for(auto it = _groups.begin(); it != _groups.end(); ++it)
         if(it->name == name && foundIndex++ == index) return it;
@@ -161,11 +161,11 @@ auto ConfigurationGroup::findGroup(const std::string& name, const unsigned int i
     return _groups.end();
 }
 
-bool ConfigurationGroup::hasGroup(const std::string& name, const unsigned int index) const {
+bool ConfigurationGroup::hasGroup(Containers::StringView name, const unsigned int index) const {
     return findGroup(name, index) != _groups.end();
 }
 
-unsigned int ConfigurationGroup::groupCount(const std::string& name) const {
+unsigned int ConfigurationGroup::groupCount(Containers::StringView name) const {
     unsigned int count = 0;
     for(const Group& group: _groups)
         if(group.name == name) ++count;
@@ -173,17 +173,17 @@ unsigned int ConfigurationGroup::groupCount(const std::string& name) const {
     return count;
 }
 
-ConfigurationGroup* ConfigurationGroup::group(const std::string& name, const unsigned int index) {
+ConfigurationGroup* ConfigurationGroup::group(Containers::StringView name, const unsigned int index) {
     const auto it = findGroup(name, index);
     return it != _groups.end() ? it->group : nullptr;
 }
 
-const ConfigurationGroup* ConfigurationGroup::group(const std::string& name, unsigned int index) const {
+const ConfigurationGroup* ConfigurationGroup::group(Containers::StringView name, unsigned int index) const {
     const auto it = findGroup(name, index);
     return it != _groups.end() ? it->group : nullptr;
 }
 
-std::vector<ConfigurationGroup*> ConfigurationGroup::groups(const std::string& name) {
+std::vector<ConfigurationGroup*> ConfigurationGroup::groups(Containers::StringView name) {
     std::vector<ConfigurationGroup*> found;
 
     for(Group& group: _groups)
@@ -192,7 +192,7 @@ std::vector<ConfigurationGroup*> ConfigurationGroup::groups(const std::string& n
     return found;
 }
 
-std::vector<const ConfigurationGroup*> ConfigurationGroup::groups(const std::string& name) const {
+std::vector<const ConfigurationGroup*> ConfigurationGroup::groups(Containers::StringView name) const {
     std::vector<const ConfigurationGroup*> found;
 
     for(const Group& group: _groups)
@@ -222,7 +222,7 @@ ConfigurationGroup* ConfigurationGroup::addGroup(const std::string& name) {
     return group;
 }
 
-bool ConfigurationGroup::removeGroup(const std::string& name, unsigned int index) {
+bool ConfigurationGroup::removeGroup(Containers::StringView name, unsigned int index) {
     const auto it = findGroup(name, index);
     if(it == _groups.end()) return false;
 
@@ -245,7 +245,7 @@ bool ConfigurationGroup::removeGroup(ConfigurationGroup* const group) {
     return false;
 }
 
-void ConfigurationGroup::removeAllGroups(const std::string& name) {
+void ConfigurationGroup::removeAllGroups(Containers::StringView name) {
     for(int i = _groups.size()-1; i >= 0; --i) {
         if(_groups[i].name != name) continue;
         delete (_groups.begin()+i)->group;
@@ -261,7 +261,7 @@ auto ConfigurationGroup::values() const -> Values {
         Values{&_values[0], &_values[0] + _values.size()};
 }
 
-auto ConfigurationGroup::findValue(const std::string& key, const unsigned int index) const -> std::vector<Value>::const_iterator {
+auto ConfigurationGroup::findValue(Containers::StringView key, const unsigned int index) const -> std::vector<Value>::const_iterator {
     unsigned int foundIndex = 0;
     for(auto it = _values.begin(); it != _values.end(); ++it)
         if(it->key == key && foundIndex++ == index) return it;
@@ -269,7 +269,7 @@ auto ConfigurationGroup::findValue(const std::string& key, const unsigned int in
     return _values.end();
 }
 
-auto ConfigurationGroup::findValue(const std::string& key, const unsigned int index) -> std::vector<Value>::iterator {
+auto ConfigurationGroup::findValue(Containers::StringView key, const unsigned int index) -> std::vector<Value>::iterator {
     unsigned int foundIndex = 0;
     for(auto it = _values.begin(); it != _values.end(); ++it)
         if(it->key == key && foundIndex++ == index) return it;
@@ -292,11 +292,11 @@ unsigned int ConfigurationGroup::valueCount() const {
     return count;
 }
 
-bool ConfigurationGroup::hasValue(const std::string& key, const unsigned int index) const {
+bool ConfigurationGroup::hasValue(Containers::StringView key, const unsigned int index) const {
     return findValue(key, index) != _values.end();
 }
 
-unsigned int ConfigurationGroup::valueCount(const std::string& key) const {
+unsigned int ConfigurationGroup::valueCount(Containers::StringView key) const {
     unsigned int count = 0;
     for(const Value& value: _values)
         if(value.key == key) ++count;
@@ -304,12 +304,17 @@ unsigned int ConfigurationGroup::valueCount(const std::string& key) const {
     return count;
 }
 
-const std::string* ConfigurationGroup::valueInternal(const std::string& key, const unsigned int index, ConfigurationValueFlags) const {
+const std::string* ConfigurationGroup::valueInternal(Containers::StringView key, const unsigned int index, ConfigurationValueFlags) const {
     const auto it = findValue(key, index);
     return it != _values.end() ? &it->value : nullptr;
 }
 
-std::vector<std::string> ConfigurationGroup::valuesInternal(const std::string& key, ConfigurationValueFlags) const {
+Containers::StringView ConfigurationGroup::valueView(const Containers::StringView key, const unsigned int index) const {
+    const auto it = findValue(key, index);
+    return it != _values.end() ? Containers::StringView{it->value} : Containers::StringView{};
+}
+
+std::vector<std::string> ConfigurationGroup::valuesInternal(Containers::StringView key, ConfigurationValueFlags) const {
     std::vector<std::string> found;
 
     for(const Value& value: _values)
@@ -318,9 +323,9 @@ std::vector<std::string> ConfigurationGroup::valuesInternal(const std::string& k
     return found;
 }
 
-bool ConfigurationGroup::setValueInternal(const std::string& key, std::string value, const unsigned int index, ConfigurationValueFlags) {
-    CORRADE_ASSERT(!key.empty(), "Utility::ConfigurationGroup::setValue(): empty key", false);
-    CORRADE_ASSERT(key.find_first_of("\n=") == std::string::npos,
+bool ConfigurationGroup::setValueInternal(Containers::StringView key, std::string value, const unsigned int index, ConfigurationValueFlags) {
+    CORRADE_ASSERT(!key.isEmpty(), "Utility::ConfigurationGroup::setValue(): empty key", false);
+    CORRADE_ASSERT(!key.contains('\n') && !key.contains('='),
         "Utility::ConfigurationGroup::setValue(): disallowed character in key", false);
 
     unsigned int foundIndex = 0;
@@ -336,7 +341,7 @@ bool ConfigurationGroup::setValueInternal(const std::string& key, std::string va
     if(index > foundIndex) return false;
 
     /* No value with that name was found, add new */
-    _values.push_back({key, std::move(value)});
+    _values.push_back({std::string{key}, std::move(value)});
 
     if(_configuration) _configuration->_flags |= Configuration::InternalFlag::Changed;
     return true;
@@ -352,8 +357,8 @@ void ConfigurationGroup::addValueInternal(std::string key, std::string value, Co
     if(_configuration) _configuration->_flags |= Configuration::InternalFlag::Changed;
 }
 
-bool ConfigurationGroup::removeValue(const std::string& key, const unsigned int index) {
-    CORRADE_ASSERT(!key.empty(), "Utility::ConfigurationGroup::removeValue(): empty key", false);
+bool ConfigurationGroup::removeValue(Containers::StringView key, const unsigned int index) {
+    CORRADE_ASSERT(!key.isEmpty(), "Utility::ConfigurationGroup::removeValue(): empty key", false);
 
     const auto it = findValue(key, index);
     if(it == _values.end()) return false;
@@ -363,8 +368,8 @@ bool ConfigurationGroup::removeValue(const std::string& key, const unsigned int
     return true;
 }
 
-void ConfigurationGroup::removeAllValues(const std::string& key) {
-    CORRADE_ASSERT(!key.empty(), "Utility::ConfigurationGroup::removeAllValues(): empty key", );
+void ConfigurationGroup::removeAllValues(Containers::StringView key) {
+    CORRADE_ASSERT(!key.isEmpty(), "Utility::ConfigurationGroup::removeAllValues(): empty key", );
 
     /** @todo Do it better & faster */
     for(int i = _values.size()-1; i >= 0; --i) {
@@ -186,14 +186,14 @@ class CORRADE_UTILITY_EXPORT ConfigurationGroup {
          * @see @ref isEmpty(), @ref hasGroups(), @ref groupCount(),
          *      @ref hasValue()
          */
-        bool hasGroup(const std::string& name, unsigned int index = 0) const;
+        bool hasGroup(Containers::StringView name, unsigned int index = 0) const;
 
         /**
          * @brief Count of groups with given name
          *
          * @see @ref hasGroup(), @ref valueCount()
          */
-        unsigned int groupCount(const std::string& name) const;
+        unsigned int groupCount(Containers::StringView name) const;
 
         /**
          * @brief Group of given name
@@ -203,12 +203,12 @@ class CORRADE_UTILITY_EXPORT ConfigurationGroup {
          * Returns pointer to group on success, @cpp nullptr @ce otherwise.
          * @see @ref groups()
          */
-        ConfigurationGroup* group(const std::string& name, unsigned int index = 0);
-        const ConfigurationGroup* group(const std::string& name, unsigned int index = 0) const; /**< @overload */
+        ConfigurationGroup* group(Containers::StringView name, unsigned int index = 0);
+        const ConfigurationGroup* group(Containers::StringView name, unsigned int index = 0) const; /**< @overload */
 
         /** @brief All groups with given name */
-        std::vector<ConfigurationGroup*> groups(const std::string& name);
-        std::vector<const ConfigurationGroup*> groups(const std::string& name) const; /**< @overload */
+        std::vector<ConfigurationGroup*> groups(Containers::StringView name);
+        std::vector<const ConfigurationGroup*> groups(Containers::StringView name) const; /**< @overload */
 
         /**
          * @brief Add new group
@@ -240,7 +240,7 @@ class CORRADE_UTILITY_EXPORT ConfigurationGroup {
          * @cpp false @ce otherwise.
          * @see @ref removeAllGroups(), @ref clear()
          */
-        bool removeGroup(const std::string& name, unsigned int index = 0);
+        bool removeGroup(Containers::StringView name, unsigned int index = 0);
 
         /**
          * @brief Remove group
@@ -256,7 +256,7 @@ class CORRADE_UTILITY_EXPORT ConfigurationGroup {
          *
          * @see @ref removeGroup(), @ref clear()
          */
-        void removeAllGroups(const std::string& name);
+        void removeAllGroups(Containers::StringView name);
 
         /* Since 1.8.17, the original short-hand group closing doesn't work
            anymore. FFS. */
@@ -297,14 +297,14 @@ class CORRADE_UTILITY_EXPORT ConfigurationGroup {
          * @see @ref isEmpty(), @ref hasValues(), @ref valueCount(),
          *      @ref hasGroup()
          */
-        bool hasValue(const std::string& key, unsigned int index = 0) const;
+        bool hasValue(Containers::StringView key, unsigned int index = 0) const;
 
         /**
          * @brief Count of values with given key
          *
          * @see @ref hasValue(), @ref groupCount()
          */
-        unsigned int valueCount(const std::string& key) const;
+        unsigned int valueCount(Containers::StringView key) const;
 
         /**
          * @brief Value
@@ -318,15 +318,29 @@ class CORRADE_UTILITY_EXPORT ConfigurationGroup {
          * type.
          * @see @ref hasValue()
          */
-        template<class T = std::string> T value(const std::string& key, unsigned int index = 0, ConfigurationValueFlags flags = ConfigurationValueFlags()) const;
+        template<class T = std::string> T value(Containers::StringView key, unsigned int index = 0, ConfigurationValueFlags flags = ConfigurationValueFlags()) const;
 
         /** @overload
          * Calls the above with @p index set to `0`.
          */
-        template<class T = std::string> T value(const std::string& key, ConfigurationValueFlags flags) const {
+        template<class T = std::string> T value(Containers::StringView key, ConfigurationValueFlags flags) const {
             return value<T>(key, 0, flags);
         }
 
+        /**
+         * @brief View on a value
+         * @param key       Key
+         * @param index     Value index. Default is first found value.
+         * @m_since_latest
+         *
+         * Unlike @ref value(), returns a view on the stored value instead of
+         * making a copy, and doesn't apply any @ref ConfigurationValueFlags.
+         * If the key is not found, returns an empty view. The view is valid
+         * only until the value is changed or removed.
+         * @see @ref hasValue()
+         */
+        Containers::StringView valueView(Containers::StringView key, unsigned int index = 0) const;
+
         /**
          * @brief All values with given key
          * @param key       Key
@@ -336,7 +350,7 @@ class CORRADE_UTILITY_EXPORT ConfigurationGroup {
          * @ref ConfigurationValue::fromString() to convert the value to given
          * type.
          */
-        template<class T = std::string> std::vector<T> values(const std::string& key, ConfigurationValueFlags flags = ConfigurationValueFlags()) const;
+        template<class T = std::string> std::vector<T> values(Containers::StringView key, ConfigurationValueFlags flags = ConfigurationValueFlags()) const;
 
         /**
          * @brief Set string value
@@ -351,26 +365,26 @@ class CORRADE_UTILITY_EXPORT ConfigurationGroup {
          * @cpp false @ce if @p index is larger than actual value count,
          * @cpp true @ce otherwise.
          */
-        bool setValue(const std::string& key, std::string value, unsigned int index = 0, ConfigurationValueFlags flags = ConfigurationValueFlags()) {
+        bool setValue(Containers::StringView key, std::string value, unsigned int index = 0, ConfigurationValueFlags flags = ConfigurationValueFlags()) {
             return setValueInternal(key, std::move(value), index, flags);
         }
 
         /** @overload */
-        bool setValue(const std::string& key, const char* value, unsigned int index = 0, ConfigurationValueFlags flags = ConfigurationValueFlags()) {
+        bool setValue(Containers::StringView key, const char* value, unsigned int index = 0, ConfigurationValueFlags flags = ConfigurationValueFlags()) {
             return setValueInternal(key, value, index, flags);
         }
 
         /** @overload
          * Calls the above with @p index set to `0`.
          */
-        bool setValue(const std::string& key, std::string value, ConfigurationValueFlags flags) {
+        bool setValue(Containers::StringView key, std::string value, ConfigurationValueFlags flags) {
             return setValue(key, std::move(value), 0, flags);
         }
 
         /** @overload
          * Calls the above with @p index set to `0`.
          */
-        bool setValue(const std::string& key, const char* value, ConfigurationValueFlags flags) {
+        bool setValue(Containers::StringView key, const char* value, ConfigurationValueFlags flags) {
             return setValue(key, value, 0, flags);
         }
 
@@ -378,17 +392,17 @@ class CORRADE_UTILITY_EXPORT ConfigurationGroup {
          * @brief Set value converted from given type
          *
          * Uses @ref ConfigurationValue::toString() to convert the value from
-         * given type. See @ref setValue(const std::string&, std::string, unsigned int, ConfigurationValueFlags)
+         * given type. See @ref setValue(Containers::StringView, std::string, unsigned int, ConfigurationValueFlags)
          * for more information.
          */
-        template<class T> bool setValue(const std::string& key, const T& value, unsigned int index = 0, ConfigurationValueFlags flags = ConfigurationValueFlags()) {
+        template<class T> bool setValue(Containers::StringView key, const T& value, unsigned int index = 0, ConfigurationValueFlags flags = ConfigurationValueFlags()) {
             return setValueInternal(key, ConfigurationValue<T>::toString(value, flags), index, flags);
         }
 
         /** @overload
          * Calls the above with @p index set to `0`.
          */
-        template<class T> bool setValue(const std::string& key, const T& value, ConfigurationValueFlags flags) {
+        template<class T> bool setValue(Containers::StringView key, const T& value, ConfigurationValueFlags flags) {
             return setValue<T>(key, value, 0, flags);
         }
 
@@ -431,14 +445,14 @@ class CORRADE_UTILITY_EXPORT ConfigurationGroup {
          * @cpp false @ce otherwise.
          * @see @ref removeAllValues(), @ref clear()
          */
-        bool removeValue(const std::string& key, unsigned int index = 0);
+        bool removeValue(Containers::StringView key, unsigned int index = 0);
 
         /**
          * @brief Remove all values with given key
          *
          * @see @ref removeValue(), @ref clear()
          */
-        void removeAllValues(const std::string& key);
+        void removeAllValues(Containers::StringView key);
 
         /* Since 1.8.17, the original short-hand group closing doesn't work
            anymore. FFS. */
@@ -466,15 +480,15 @@ class CORRADE_UTILITY_EXPORT ConfigurationGroup {
 
         CORRADE_UTILITY_LOCAL explicit ConfigurationGroup(Configuration* configuration);
 
-        CORRADE_UTILITY_LOCAL std::vector<Group>::iterator findGroup(const std::string& name, unsigned int index);
-        CORRADE_UTILITY_LOCAL std::vector<Group>::const_iterator findGroup(const std::string& name, unsigned int index) const;
-        CORRADE_UTILITY_LOCAL std::vector<Value>::iterator findValue(const std::string& key, unsigned int index);
-        CORRADE_UTILITY_LOCAL std::vector<Value>::const_iterator findValue(const std::string& key, unsigned int index) const;
+        CORRADE_UTILITY_LOCAL std::vector<Group>::iterator findGroup(Containers::StringView name, unsigned int index);
+        CORRADE_UTILITY_LOCAL std::vector<Group>::const_iterator findGroup(Containers::StringView name, unsigned int index) const;
+        CORRADE_UTILITY_LOCAL std::vector<Value>::iterator findValue(Containers::StringView key, unsigned int index);
+        CORRADE_UTILITY_LOCAL std::vector<Value>::const_iterator findValue(Containers::StringView key, unsigned int index) const;
 
         /* Returns nullptr in case the key is not found */
-        const std::string* valueInternal(const std::string& key, unsigned int index, ConfigurationValueFlags flags) const;
-        std::vector<std::string> valuesInternal(const std::string& key, ConfigurationValueFlags flags) const;
-        bool setValueInternal(const std::string& key, std::string value, unsigned int number, ConfigurationValueFlags flags);
+        const std::string* valueInternal(Containers::StringView key, unsigned int index, ConfigurationValueFlags flags) const;
+        std::vector<std::string> valuesInternal(Containers::StringView key, ConfigurationValueFlags flags) const;
+        bool setValueInternal(Containers::StringView key, std::string value, unsigned int number, ConfigurationValueFlags flags);
         void addValueInternal(std::string key, std::string value, ConfigurationValueFlags flags);
 
         std::vector<Value> _values;
@@ -666,18 +680,18 @@ class ConfigurationGroup::Values {
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
 /* Shorthand template specialization for string values, delete unwanted ones */
-template<> bool ConfigurationGroup::setValue(const std::string&, const std::string&, unsigned int, ConfigurationValueFlags) = delete;
+template<> bool ConfigurationGroup::setValue(Containers::StringView, const std::string&, unsigned int, ConfigurationValueFlags) = delete;
 template<> void ConfigurationGroup::addValue(std::string, const std::string&, ConfigurationValueFlags) = delete;
-template<> inline std::string ConfigurationGroup::value(const std::string& key, unsigned int index, const ConfigurationValueFlags flags) const {
+template<> inline std::string ConfigurationGroup::value(Containers::StringView key, unsigned int index, const ConfigurationValueFlags flags) const {
     const std::string* value = valueInternal(key, index, flags);
     return value ? *value : std::string{};
 }
-template<> inline std::vector<std::string> ConfigurationGroup::values(const std::string& key, const ConfigurationValueFlags flags) const {
+template<> inline std::vector<std::string> ConfigurationGroup::values(Containers::StringView key, const ConfigurationValueFlags flags) const {
     return valuesInternal(key, flags);
 }
 #endif
 
-template<class T> inline T ConfigurationGroup::value(const std::string& key, const unsigned int index, const ConfigurationValueFlags flags) const {
+template<class T> inline T ConfigurationGroup::value(Containers::StringView key, const unsigned int index, const ConfigurationValueFlags flags) const {
     const std::string* value = valueInternal(key, index, flags);
     /* Can't do value ? *value : std::string{} BECAUSE THAT MAKES A COPY! C++
        YOU'RE FIRED */
@@ -685,7 +699,7 @@ template<class T> inline T ConfigurationGroup::value(const std::string& key, con
     return ConfigurationValue<T>::fromString(value ? *value : empty, flags);
 }
 
-template<class T> std::vector<T> ConfigurationGroup::values(const std::string& key, const ConfigurationValueFlags flags) const {
+template<class T> std::vector<T> ConfigurationGroup::values(Containers::StringView key, const ConfigurationValueFlags flags) const {
     std::vector<std::string> stringValues = valuesInternal(key, flags);
     std::vector<T> values;
     values.reserve(stringValues.size());
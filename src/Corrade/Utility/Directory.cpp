@@ -58,9 +58,18 @@
 #include <dlfcn.h> /* dladdr(), needs also -ldl */
 #endif
 
+/* Kernel-side file copy */
+#ifdef __linux__
+#include <linux/fs.h> /* FICLONE */
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h> /* SYS_copy_file_range */
+#endif
+
 /* Unix, Emscripten file & directory access */
 #if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN)
 #include <cerrno>
+#include <climits> /* PATH_MAX */
 #include <cstring>
 #include <sys/stat.h>
 #include <dirent.h>
@@ -90,6 +99,8 @@
 #include "Corrade/Containers/Array.h"
 #include "Corrade/Containers/ScopeGuard.h"
 #include "Corrade/Containers/Optional.h"
+#include "Corrade/Containers/StringStl.h"
+#include "Corrade/Utility/Assert.h"
 #include "Corrade/Utility/Debug.h"
 #include "Corrade/Utility/DebugStl.h"
 #include "Corrade/Utility/String.h"
@@ -373,6 +384,124 @@ bool isDirectory(const std::string& path) {
     #endif
 }
 
+bool fileInfo(const std::string& directory, const Containers::ArrayView<const Containers::StringView> paths, const Containers::ArrayView<FileType> types, const Containers::ArrayView<std::uint64_t> sizes, const Containers::ArrayView<std::uint64_t> modificationTimes) {
+    CORRADE_ASSERT(types.size() == paths.size(),
+        "Utility::Directory::fileInfo(): expected" << paths.size() << "types but got" << types.size(), {});
+    CORRADE_ASSERT(sizes.empty() || sizes.size() == paths.size(),
+        "Utility::Directory::fileInfo(): expected either no or" << paths.size() << "sizes but got" << sizes.size(), {});
+    CORRADE_ASSERT(modificationTimes.empty() || modificationTimes.size() == paths.size(),
+        "Utility::Directory::fileInfo(): expected either no or" << paths.size() << "modification times but got" << modificationTimes.size(), {});
+
+    #if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    /* Open the directory just once and then query everything relative to it,
+       which avoids path prefix resolution for every file */
+    int directoryFd = AT_FDCWD;
+    if(!directory.empty()) {
+        directoryFd = open(directory.data(), O_RDONLY|O_DIRECTORY|O_CLOEXEC);
+        if(directoryFd == -1) {
+            Error{} << "Utility::Directory::fileInfo(): can't open" << directory;
+            return false;
+        }
+    }
+
+    /* Non-null-terminated paths are copied here to avoid allocations */
+    char buffer[PATH_MAX];
+    for(std::size_t i = 0; i != paths.size(); ++i) {
+        const Containers::StringView path = paths[i];
+        const char* name = path.data();
+        struct stat st;
+        bool found = false;
+        if(path.flags() & Containers::StringViewFlag::NullTerminated)
+            found = fstatat(directoryFd, name, &st, 0) == 0;
+        /* Paths that don't fit are reported as nonexistent, which is what
+           fstatat() would do for them as well */
+        else if(path.size() < PATH_MAX) {
+            std::memcpy(buffer, path.data(), path.size());
+            buffer[path.size()] = '\0';
+            found = fstatat(directoryFd, buffer, &st, 0) == 0;
+        }
+
+        if(!found) {
+            types[i] = FileType::Nonexistent;
+            if(!sizes.empty()) sizes[i] = 0;
+            if(!modificationTimes.empty()) modificationTimes[i] = 0;
+            continue;
+        }
+
+        if(S_ISREG(st.st_mode)) types[i] = FileType::File;
+        else if(S_ISDIR(st.st_mode)) types[i] = FileType::Directory;
+        else types[i] = FileType::Special;
+        if(!sizes.empty()) sizes[i] = st.st_size;
+        /* See FileWatcher::hasChanged() for details about the platform
+           differences */
+        if(!modificationTimes.empty()) modificationTimes[i] =
+            #ifdef CORRADE_TARGET_APPLE
+            std::uint64_t(st.st_mtimespec.tv_sec)*1000000000 + std::uint64_t(st.st_mtimespec.tv_nsec)
+            #elif defined(st_mtime)
+            std::uint64_t(st.st_mtim.tv_sec)*1000000000 + std::uint64_t(st.st_mtim.tv_nsec)
+            #else
+            std::uint64_t(st.st_mtime)*1000000000
+            #endif
+            ;
+    }
+
+    if(directoryFd != AT_FDCWD) close(directoryFd);
+    return true;
+
+    #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+    if(!directory.empty() && !isDirectory(directory)) {
+        Error{} << "Utility::Directory::fileInfo(): can't open" << directory;
+        return false;
+    }
+
+    for(std::size_t i = 0; i != paths.size(); ++i) {
+        struct _stat64 st;
+        if(_wstat64(widen(join(directory, paths[i])).data(), &st) != 0) {
+            types[i] = FileType::Nonexistent;
+            if(!sizes.empty()) sizes[i] = 0;
+            if(!modificationTimes.empty()) modificationTimes[i] = 0;
+            continue;
+        }
+
+        if((st.st_mode & _S_IFMT) == _S_IFREG) types[i] = FileType::File;
+        else if((st.st_mode & _S_IFMT) == _S_IFDIR) types[i] = FileType::Directory;
+        else types[i] = FileType::Special;
+        if(!sizes.empty()) sizes[i] = st.st_size;
+        if(!modificationTimes.empty())
+            modificationTimes[i] = std::uint64_t(st.st_mtime)*1000000000;
+    }
+
+    return true;
+
+    #else
+    static_cast<void>(directory);
+    static_cast<void>(sizes);
+    static_cast<void>(modificationTimes);
+    Warning() << "Utility::Directory::fileInfo(): not implemented on this platform";
+    for(FileType& type: types) type = FileType::Nonexistent;
+    return true;
+    #endif
+}
+
+bool fileInfo(const Containers::ArrayView<const Containers::StringView> paths, const Containers::ArrayView<FileType> types, const Containers::ArrayView<std::uint64_t> sizes, const Containers::ArrayView<std::uint64_t> modificationTimes) {
+    return fileInfo({}, paths, types, sizes, modificationTimes);
+}
+
+Debug& operator<<(Debug& debug, const FileType value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case FileType::value: return debug << "Utility::Directory::FileType::" #value;
+        _c(Nonexistent)
+        _c(File)
+        _c(Directory)
+        _c(Special)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "Utility::Directory::FileType(" << Debug::nospace << reinterpret_cast<void*>(static_cast<unsigned char>(value)) << Debug::nospace << ")";
+}
+
 bool isSandboxed() {
     #if defined(CORRADE_TARGET_IOS) || defined(CORRADE_TARGET_ANDROID) || defined(CORRADE_TARGET_EMSCRIPTEN) || defined(CORRADE_TARGET_WINDOWS_RT)
     return true;
@@ -814,6 +943,56 @@ bool copy(const std::string& from, const std::string& to) {
 
     Containers::ScopeGuard exitOut{out, std::fclose};
 
+    #ifdef __linux__
+    /* Try to let the kernel do the copy without any data going through
+       userspace. None of the FILE streams has read or written anything yet,
+       so their positions are in sync with the file descriptors and whatever
+       the kernel doesn't manage to copy is picked up by the fread() loop
+       below. */
+    {
+        const int inFd = fileno(in);
+        const int outFd = fileno(out);
+
+        /* On copy-on-write filesystems (Btrfs, XFS) the file can be just
+           reflinked, sharing the data blocks until either copy is modified */
+        #ifdef FICLONE
+        if(ioctl(outFd, FICLONE, inFd) == 0) return true;
+        #endif
+
+        struct stat st;
+        if(fstat(inFd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            std::size_t remaining = st.st_size;
+
+            /* copy_file_range() does an in-kernel copy and can make use of
+               server-side copy on network filesystems. Called through
+               syscall() because the glibc wrapper is only since 2.27. Fails
+               with EXDEV across filesystems on kernels before 5.3, with
+               ENOSYS on kernels before 4.5 or EINVAL on special files, in
+               which case we fall back to sendfile(). */
+            #ifdef SYS_copy_file_range
+            while(remaining) {
+                const long copied = syscall(SYS_copy_file_range, inFd, nullptr, outFd, nullptr, remaining, 0u);
+                if(copied <= 0) break;
+                remaining -= copied;
+            }
+            #endif
+
+            /* sendfile() is able to write into a regular file since Linux
+               2.6.33 */
+            while(remaining) {
+                const ssize_t copied = sendfile(outFd, inFd, nullptr, remaining);
+                if(copied <= 0) break;
+                remaining -= copied;
+            }
+
+            /* The file might have grown in the meantime, so still go through
+               the loop below to catch the rest */
+            if(!remaining && st.st_size == lseek(inFd, 0, SEEK_END)) return true;
+            lseek(inFd, st.st_size - remaining, SEEK_SET);
+        }
+    }
+    #endif
+
     #if defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200112L
     /* As noted in https://eklitzke.org/efficient-file-copying-on-linux, might
        make the file reading faster. Didn't make any difference in the 100 MB
@@ -834,6 +1013,29 @@ bool copy(const std::string& from, const std::string& to) {
     return true;
 }
 
+bool copy(const std::vector<std::pair<std::string, std::string>>& files) {
+    bool success = true;
+    for(std::size_t i = 0; i != files.size(); ++i) {
+        /* Ask the kernel to start reading the next file in the background
+           while this one is being copied, so the disk isn't idle between the
+           copies. The page cache outlives the file descriptor, so it can be
+           closed right away. */
+        #if defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200112L
+        if(i + 1 != files.size()) {
+            const int fd = open(files[i + 1].first.data(), O_RDONLY);
+            if(fd != -1) {
+                posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+                close(fd);
+            }
+        }
+        #endif
+
+        if(!copy(files[i].first, files[i].second)) success = false;
+    }
+
+    return success;
+}
+
 #ifdef CORRADE_TARGET_UNIX
 void MapDeleter::operator()(const char* const data, const std::size_t size) {
     if(data && munmap(const_cast<char*>(data), size) == -1)
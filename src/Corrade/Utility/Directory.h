@@ -31,11 +31,13 @@
  */
 
 #include <initializer_list>
+#include <utility> /* std::pair */
 
 #include "Corrade/Containers/Containers.h"
 #include "Corrade/Containers/EnumSet.h"
 #include "Corrade/Utility/StlForwardString.h"
 #include "Corrade/Utility/StlForwardVector.h"
+#include "Corrade/Utility/Utility.h"
 #include "Corrade/Utility/visibility.h"
 
 #ifdef CORRADE_BUILD_DEPRECATED
@@ -429,6 +431,90 @@ Expects that the filename is in UTF-8.
 */
 CORRADE_UTILITY_EXPORT Containers::Optional<std::size_t> fileSize(const std::string& filename);
 
+/**
+@brief File type
+@m_since_latest
+
+@see @ref fileInfo()
+*/
+enum class FileType: unsigned char {
+    /** The path doesn't exist or isn't accessible */
+    Nonexistent,
+
+    /** Regular file */
+    File,
+
+    /** Directory */
+    Directory,
+
+    /**
+     * Anything else, such as a device, a socket or a pipe. On
+     * @ref CORRADE_TARGET_WINDOWS "Windows" this is reported for character
+     * devices such as @cpp "NUL" @ce and for pipes, on
+     * @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten" for devices of the
+     * emulated filesystem such as @cpp "/dev/null" @ce.
+     * @partialsupport Not reported on
+     *      @ref CORRADE_TARGET_WINDOWS_RT "Windows RT", where
+     *      @ref fileInfo() isn't implemented.
+     */
+    Special
+};
+
+/**
+@debugoperatorenum{FileType}
+@m_since_latest
+*/
+CORRADE_UTILITY_EXPORT Debug& operator<<(Debug& debug, FileType value);
+
+/**
+@brief Query type, size and modification time of a batch of paths
+@m_since_latest
+@param[in]  directory   Directory the @p paths are relative to. If empty,
+    they're relative to the current working directory. Absolute @p paths
+    ignore it.
+@param[in]  paths       Paths to query, expected to be in UTF-8
+@param[out] types       Where to put file types
+@param[out] sizes       Where to put file sizes in bytes. Can be empty, in
+    which case the sizes aren't written.
+@param[out] modificationTimes Where to put modification times in nanoseconds
+    since the Unix epoch. Can be empty, in which case the times aren't
+    written.
+
+A batch counterpart to @ref exists(), @ref isDirectory() and @ref fileSize()
+that's meant to be used when querying many paths at once. Expects that
+@p types has the same size as @p paths and @p sizes and @p modificationTimes
+are either empty or have the same size as well. Paths that don't exist or
+aren't accessible get @ref FileType::Nonexistent and zero size and time.
+Symlinks are followed. Prints a message to @ref Error and returns
+@cpp false @ce if @p directory can't be opened, @cpp true @ce otherwise.
+
+On @ref CORRADE_TARGET_UNIX "Unix" platforms and on
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", @p directory is opened just once
+and the paths are queried relative to it using
+@m_class{m-doc-external} [fstatat()](https://man7.org/linux/man-pages/man2/fstatat.2.html),
+which saves the kernel from resolving the directory prefix over and over
+again. Null-terminated @p paths are used directly and the others are copied to
+a stack buffer, so no allocations happen. The function has no global state,
+so large batches can be split into slices queried from multiple threads in
+parallel.
+
+Windows doesn't have the concept of a directory-relative query and there the
+paths get joined with @p directory and queried one by one.
+@partialsupport Not implemented on
+    @ref CORRADE_TARGET_WINDOWS_RT "Windows RT", all paths are reported as
+    nonexistent there.
+*/
+CORRADE_UTILITY_EXPORT bool fileInfo(const std::string& directory, Containers::ArrayView<const Containers::StringView> paths, Containers::ArrayView<FileType> types, Containers::ArrayView<std::uint64_t> sizes, Containers::ArrayView<std::uint64_t> modificationTimes);
+
+/**
+@brief Query type, size and modification time of a batch of paths
+@m_since_latest
+
+Same as calling @ref fileInfo(const std::string&, Containers::ArrayView<const Containers::StringView>, Containers::ArrayView<FileType>, Containers::ArrayView<std::uint64_t>, Containers::ArrayView<std::uint64_t>)
+with an empty @p directory, always returns @cpp true @ce.
+*/
+CORRADE_UTILITY_EXPORT bool fileInfo(Containers::ArrayView<const Containers::StringView> paths, Containers::ArrayView<FileType> types, Containers::ArrayView<std::uint64_t> sizes, Containers::ArrayView<std::uint64_t> modificationTimes);
+
 /**
 @brief Read file into an array
 
@@ -497,6 +583,14 @@ directories. Returns @cpp false @ce and prints a message to @ref Error if
 @p from can't be read or @p to can't be written, @cpp true @ce otherwise.
 Expects that the filename is in UTF-8.
 
+On Linux the copy is first attempted without the data going through userspace
+at all --- if the filesystem supports copy-on-write, the file is reflinked
+using the @m_class{m-doc-external} [FICLONE ioctl](https://man7.org/linux/man-pages/man2/ioctl_ficlone.2.html),
+otherwise @m_class{m-doc-external} [copy_file_range()](https://man7.org/linux/man-pages/man2/copy_file_range.2.html)
+and then @m_class{m-doc-external} [sendfile()](https://man7.org/linux/man-pages/man2/sendfile.2.html)
+is tried. Whatever these don't manage to copy is then copied through the
+128 kB buffer, which is also what's used on all other platforms.
+
 Note that the following might be slightly faster on some systems where
 memory-mapping is supported and virtual memory is large enough for given file
 size:
@@ -507,6 +601,19 @@ size:
 */
 CORRADE_UTILITY_EXPORT bool copy(const std::string& from, const std::string& to);
 
+/**
+@brief Copy a batch of files
+@m_since_latest
+
+Calls @ref copy(const std::string&, const std::string&) for each pair of
+source and destination filename in @p files. On Unix platforms the kernel is
+told to start reading each next file in the background while the previous one
+is being copied, overlapping the reads with the writes. A failure to copy one
+file doesn't stop the remaining files from being copied. Returns
+@cpp false @ce if any of the copies failed, @cpp true @ce otherwise.
+*/
+CORRADE_UTILITY_EXPORT bool copy(const std::vector<std::pair<std::string, std::string>>& files);
+
 #if defined(DOXYGEN_GENERATING_OUTPUT) || defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
 /**
 @brief Map file for reading and writing
@@ -0,0 +1,282 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FileAppender.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN)
+#include <sys/uio.h>
+#include <unistd.h>
+#elif defined(CORRADE_TARGET_WINDOWS)
+#include <io.h>
+#endif
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/EnumSet.hpp"
+#include "Corrade/Containers/StringView.h"
+#include "Corrade/Utility/DebugStl.h"
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+#include "Corrade/Utility/Unicode.h"
+#endif
+
+namespace Corrade { namespace Utility {
+
+namespace {
+
+struct AppenderState {
+    explicit AppenderState(const std::string& filename, std::size_t bufferSize, FileAppender::Flags flags): filename{filename}, buffer{NoInit, bufferSize}, flags{flags} {}
+
+    std::string filename;
+    Containers::Array<char> buffer;
+    std::size_t bufferedSize{};
+    std::chrono::steady_clock::time_point bufferedSince;
+    std::uint32_t flushInterval{};
+    FileAppender::Flags flags;
+    int fd{-1};
+    mutable std::mutex mutex;
+};
+
+/* Writes the buffered data followed by the extra data, retrying on partial
+   writes and interrupts. Returns false and leaves errno set on failure. */
+bool writeAll(const int fd, const char* buffered, std::size_t bufferedSize, const char* extra, std::size_t extraSize) {
+    #if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    while(bufferedSize || extraSize) {
+        iovec iov[2];
+        int count = 0;
+        if(bufferedSize) {
+            iov[count].iov_base = const_cast<char*>(buffered);
+            iov[count].iov_len = bufferedSize;
+            ++count;
+        }
+        if(extraSize) {
+            iov[count].iov_base = const_cast<char*>(extra);
+            iov[count].iov_len = extraSize;
+            ++count;
+        }
+
+        const ssize_t written = writev(fd, iov, count);
+        if(written < 0) {
+            if(errno == EINTR) continue;
+            return false;
+        }
+
+        /* Advance past what got written, possibly ending in the middle of
+           either part */
+        std::size_t remaining = written;
+        const std::size_t fromBuffered = std::min(remaining, bufferedSize);
+        buffered += fromBuffered;
+        bufferedSize -= fromBuffered;
+        remaining -= fromBuffered;
+        extra += remaining;
+        extraSize -= remaining;
+    }
+    #elif defined(CORRADE_TARGET_WINDOWS)
+    for(const char** data: {&buffered, &extra}) {
+        std::size_t& size = data == &buffered ? bufferedSize : extraSize;
+        while(size) {
+            /* _write() takes at most an unsigned int */
+            const int written = _write(fd, *data, unsigned(std::min(size, std::size_t{0x7fffffff})));
+            if(written < 0) return false;
+            *data += written;
+            size -= written;
+        }
+    }
+    #else
+    #error
+    #endif
+
+    return true;
+}
+
+bool syncFile(const int fd) {
+    #if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    return fsync(fd) == 0;
+    #elif defined(CORRADE_TARGET_WINDOWS)
+    return _commit(fd) == 0;
+    #else
+    #error
+    #endif
+}
+
+/* Expects the state mutex to be locked */
+bool flushLocked(AppenderState& state, const char* const extra, const std::size_t extraSize, const char* const function) {
+    if(state.fd == -1) {
+        Error{} << "Utility::FileAppender::" << Debug::nospace << function << Debug::nospace << "(): file" << state.filename << "is not open";
+        return false;
+    }
+
+    if(!state.bufferedSize && !extraSize) return true;
+
+    const bool written = writeAll(state.fd, state.buffer.data(), state.bufferedSize, extra, extraSize);
+    /* Discard the buffer even if the write failed, as it'd most probably
+       fail again and there's no way to recover the data anyway */
+    state.bufferedSize = 0;
+    if(!written) {
+        Error{} << "Utility::FileAppender::" << Debug::nospace << function << Debug::nospace << "(): can't write to" << state.filename << Debug::nospace << ":" << std::strerror(errno);
+        return false;
+    }
+
+    if(state.flags & FileAppender::Flag::SyncOnFlush && !syncFile(state.fd)) {
+        Error{} << "Utility::FileAppender::" << Debug::nospace << function << Debug::nospace << "(): can't sync" << state.filename << Debug::nospace << ":" << std::strerror(errno);
+        return false;
+    }
+
+    return true;
+}
+
+}
+
+struct FileAppender::State: AppenderState {
+    using AppenderState::AppenderState;
+};
+
+FileAppender::FileAppender(const std::string& filename, const std::size_t bufferSize, const Flags flags): _state{InPlaceInit, filename, bufferSize, flags} {
+    #if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    _state->fd = open(filename.data(), O_WRONLY|O_CREAT|O_APPEND|O_CLOEXEC|(flags & Flag::Truncate ? O_TRUNC : 0), 0666);
+    #elif defined(CORRADE_TARGET_WINDOWS)
+    _state->fd = _wopen(Unicode::widen(filename).data(), _O_WRONLY|_O_CREAT|_O_APPEND|_O_BINARY|(flags & Flag::Truncate ? _O_TRUNC : 0), _S_IREAD|_S_IWRITE);
+    #else
+    #error
+    #endif
+    if(_state->fd == -1)
+        Error{} << "Utility::FileAppender: can't open" << filename << Debug::nospace << ":" << std::strerror(errno);
+}
+
+FileAppender::FileAppender(FileAppender&&) noexcept = default;
+
+FileAppender::~FileAppender() {
+    /* Moved-out instance */
+    if(!_state || _state->fd == -1) return;
+
+    flushLocked(*_state, nullptr, 0, "flush");
+    #if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    close(_state->fd);
+    #elif defined(CORRADE_TARGET_WINDOWS)
+    _close(_state->fd);
+    #else
+    #error
+    #endif
+}
+
+FileAppender& FileAppender::operator=(FileAppender&&) noexcept = default;
+
+bool FileAppender::isOpen() const { return _state->fd != -1; }
+
+FileAppender::Flags FileAppender::flags() const { return _state->flags; }
+
+std::size_t FileAppender::bufferSize() const { return _state->buffer.size(); }
+
+std::size_t FileAppender::bufferedSize() const {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    return _state->bufferedSize;
+}
+
+std::uint32_t FileAppender::flushInterval() const {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    return _state->flushInterval;
+}
+
+FileAppender& FileAppender::setFlushInterval(const std::uint32_t milliseconds) {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    _state->flushInterval = milliseconds;
+    return *this;
+}
+
+bool FileAppender::append(const Containers::ArrayView<const void> data) {
+    State& state = *_state;
+    std::lock_guard<std::mutex> lock{state.mutex};
+
+    if(!data.size() && state.fd != -1) return true;
+
+    /* Doesn't fit, write the buffer together with the data. Not checking
+       whether the file is open before as that's done in there. */
+    if(state.fd == -1 || state.bufferedSize + data.size() > state.buffer.size())
+        return flushLocked(state, static_cast<const char*>(data.data()), data.size(), "append");
+
+    if(!state.bufferedSize)
+        state.bufferedSince = std::chrono::steady_clock::now();
+    std::memcpy(state.buffer.data() + state.bufferedSize, data.data(), data.size());
+    state.bufferedSize += data.size();
+
+    if(state.flushInterval && std::chrono::steady_clock::now() - state.bufferedSince >= std::chrono::milliseconds{state.flushInterval})
+        return flushLocked(state, nullptr, 0, "append");
+
+    return true;
+}
+
+bool FileAppender::appendString(const Containers::StringView data) {
+    return append({data.data(), data.size()});
+}
+
+bool FileAppender::flush() {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    return flushLocked(*_state, nullptr, 0, "flush");
+}
+
+bool FileAppender::sync() {
+    State& state = *_state;
+    std::lock_guard<std::mutex> lock{state.mutex};
+    if(!flushLocked(state, nullptr, 0, "sync")) return false;
+
+    /* Already synced in flushLocked() in this case */
+    if(state.flags & Flag::SyncOnFlush) return true;
+
+    if(!syncFile(state.fd)) {
+        Error{} << "Utility::FileAppender::sync(): can't sync" << state.filename << Debug::nospace << ":" << std::strerror(errno);
+        return false;
+    }
+
+    return true;
+}
+
+Debug& operator<<(Debug& debug, const FileAppender::Flag value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case FileAppender::Flag::value: return debug << "Utility::FileAppender::Flag::" #value;
+        _c(Truncate)
+        _c(SyncOnFlush)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "Utility::FileAppender::Flag(" << Debug::nospace << reinterpret_cast<void*>(std::uint8_t(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const FileAppender::Flags value) {
+    return Containers::enumSetDebugOutput(debug, value, "Utility::FileAppender::Flags{}", {
+        FileAppender::Flag::Truncate,
+        FileAppender::Flag::SyncOnFlush});
+}
+
+}}
@@ -0,0 +1,221 @@
+#ifndef Corrade_Utility_FileAppender_h
+#define Corrade_Utility_FileAppender_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Utility::FileAppender
+ * @m_since_latest
+ */
+
+#include <string>
+
+#include "Corrade/Containers/EnumSet.h"
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/Utility/Utility.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Utility {
+
+#if defined(DOXYGEN_GENERATING_OUTPUT) || defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)) || defined(CORRADE_TARGET_EMSCRIPTEN)
+/**
+@brief Buffered file appender
+@m_since_latest
+
+While @ref Directory::append() opens the file, writes the data and closes it
+again on every call, this class keeps the file open and collects appended data
+in a memory buffer, writing it out only once the buffer is full, once given
+time interval passes or on an explicit @ref flush(). Appending a small record
+is thus usually just a copy to the buffer instead of three syscalls. Example
+usage:
+
+@snippet Utility.cpp FileAppender
+
+@section Utility-FileAppender-behavior Behavior
+
+Data that don't fit into the remaining buffer space are written together with
+the buffer contents in a single vectored write, without copying them to the
+buffer first. The file is opened in append mode, so each such write is placed
+at the end of the file even if other processes append to it as well.
+
+The time interval set via @ref setFlushInterval() is checked only when new
+data are appended, there's no background thread flushing the buffer. Call
+@ref flush() periodically if data appended before a long pause need to reach
+the file. With @ref Flag::SyncOnFlush, every write to the file is followed by
+an @m_class{m-doc-external} [fsync()](https://man7.org/linux/man-pages/man2/fsync.2.html),
+otherwise the data are synchronized to the disk only on an explicit
+@ref sync().
+
+All functions are thread-safe, data appended by a single @ref append() call
+are never interleaved with data from other threads.
+
+@partialsupport Available only on @ref CORRADE_TARGET_UNIX "Unix" and non-RT
+    @ref CORRADE_TARGET_WINDOWS "Windows" platforms and on
+    @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten". On Windows, the buffer and
+    the overflowing data are written with two separate calls.
+*/
+class CORRADE_UTILITY_EXPORT FileAppender {
+    public:
+        /**
+         * @brief Appender flag
+         *
+         * @see @ref Flags, @ref FileAppender(const std::string&, std::size_t, Flags),
+         *      @ref flags()
+         */
+        enum class Flag: std::uint8_t {
+            /** Truncate the file on opening instead of appending to it */
+            Truncate = 1 << 0,
+
+            /** Synchronize the file to the disk after every write */
+            SyncOnFlush = 1 << 1
+        };
+
+        /**
+         * @brief Appender flags
+         *
+         * @see @ref FileAppender(const std::string&, std::size_t, Flags),
+         *      @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /**
+         * @brief Constructor
+         * @param filename      File to append to. Created if it doesn't exist.
+         *      Expected to be in UTF-8.
+         * @param bufferSize    Buffer size in bytes. If zero, all data are
+         *      written to the file right away.
+         * @param flags         Flags
+         *
+         * If the file can't be opened, prints a message to @ref Error and
+         * @ref isOpen() returns @cpp false @ce.
+         */
+        explicit FileAppender(const std::string& filename, std::size_t bufferSize = 64*1024, Flags flags = {});
+
+        /** @brief Copying is not allowed */
+        FileAppender(const FileAppender&) = delete;
+
+        /** @brief Move constructor */
+        FileAppender(FileAppender&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref flush() and closes the file.
+         */
+        ~FileAppender();
+
+        /** @brief Copying is not allowed */
+        FileAppender& operator=(const FileAppender&) = delete;
+
+        /** @brief Move assignment */
+        FileAppender& operator=(FileAppender&&) noexcept;
+
+        /** @brief Whether the file is open */
+        bool isOpen() const;
+
+        /** @brief Flags */
+        Flags flags() const;
+
+        /** @brief Buffer size */
+        std::size_t bufferSize() const;
+
+        /** @brief Count of buffered bytes not yet written to the file */
+        std::size_t bufferedSize() const;
+
+        /**
+         * @brief Flush interval in milliseconds
+         *
+         * Zero means data are flushed only when the buffer gets full. Default
+         * is @cpp 0 @ce.
+         */
+        std::uint32_t flushInterval() const;
+
+        /**
+         * @brief Set flush interval in milliseconds
+         * @return Reference to self (for method chaining)
+         *
+         * If more than @p milliseconds passed since the oldest buffered data
+         * were appended, the buffer is flushed during the next @ref append().
+         * Zero means data are flushed only when the buffer gets full.
+         */
+        FileAppender& setFlushInterval(std::uint32_t milliseconds);
+
+        /**
+         * @brief Append data
+         *
+         * If @p data don't fit into the remaining buffer space, they're
+         * written together with the buffer contents. If that fails or the
+         * file isn't open, prints a message to @ref Error and returns
+         * @cpp false @ce, otherwise returns @cpp true @ce.
+         */
+        bool append(Containers::ArrayView<const void> data);
+
+        /**
+         * @brief Append a string
+         *
+         * Equivalent to calling @ref append() with the string data.
+         */
+        bool appendString(Containers::StringView data);
+
+        /**
+         * @brief Flush the buffer
+         *
+         * Writes all buffered data to the file. With @ref Flag::SyncOnFlush
+         * the file is synchronized to the disk as well. If the write fails or
+         * the file isn't open, prints a message to @ref Error and returns
+         * @cpp false @ce, otherwise returns @cpp true @ce.
+         */
+        bool flush();
+
+        /**
+         * @brief Flush the buffer and synchronize the file to the disk
+         *
+         * Unlike @ref flush(), always synchronizes the file regardless of
+         * @ref Flag::SyncOnFlush being set. If that fails or the file isn't
+         * open, prints a message to @ref Error and returns @cpp false @ce,
+         * otherwise returns @cpp true @ce.
+         */
+        bool sync();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+CORRADE_ENUMSET_OPERATORS(FileAppender::Flags)
+
+/** @debugoperatorclassenum{FileAppender,FileAppender::Flag} */
+CORRADE_UTILITY_EXPORT Debug& operator<<(Debug& debug, FileAppender::Flag value);
+
+/** @debugoperatorclassenum{FileAppender,FileAppender::Flags} */
+CORRADE_UTILITY_EXPORT Debug& operator<<(Debug& debug, FileAppender::Flags value);
+#else
+#error this header is available only on Unix, non-RT Windows and Emscripten
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,652 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Json.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Containers/Optional.h"
+#include "Corrade/Containers/StaticArray.h"
+#include "Corrade/Containers/String.h"
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/Directory.h"
+#include "Corrade/Utility/Move.h"
+#include "Corrade/Utility/Unicode.h"
+
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#ifdef CORRADE_TARGET_MSVC
+#include <intrin.h>
+#endif
+#endif
+
+namespace Corrade { namespace Utility {
+
+namespace {
+
+#ifdef CORRADE_TARGET_SSE2
+inline int popcount(unsigned int mask) {
+    #if defined(CORRADE_TARGET_GCC) || defined(CORRADE_TARGET_CLANG)
+    return __builtin_popcount(mask);
+    #else
+    int count = 0;
+    for(; mask; mask &= mask - 1) ++count;
+    return count;
+    #endif
+}
+
+/* Expects that at least one bit is set */
+inline int firstSetBit(unsigned int mask) {
+    #if defined(CORRADE_TARGET_GCC) || defined(CORRADE_TARGET_CLANG)
+    return __builtin_ctz(mask);
+    #elif defined(CORRADE_TARGET_MSVC)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+    #else
+    int index = 0;
+    for(; !(mask & 1); mask >>= 1) ++index;
+    return index;
+    #endif
+}
+#endif
+
+/* Each token except the root is preceded by one of `[`, `{`, `,` or `:`
+   (ignoring whitespace), so their count plus one is an upper bound for the
+   token count. Characters inside strings get counted as well, which only
+   makes the bound less tight. */
+std::size_t tokenCountUpperBound(const char* const data, const std::size_t size) {
+    std::size_t count = 1;
+    std::size_t i = 0;
+    #ifdef CORRADE_TARGET_SSE2
+    const __m128i squareBracket = _mm_set1_epi8('[');
+    const __m128i curlyBracket = _mm_set1_epi8('{');
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i colon = _mm_set1_epi8(':');
+    for(; i + 16 <= size; i += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i matches = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, squareBracket),
+                         _mm_cmpeq_epi8(chunk, curlyBracket)),
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, comma),
+                         _mm_cmpeq_epi8(chunk, colon)));
+        count += popcount(_mm_movemask_epi8(matches));
+    }
+    #endif
+    for(; i != size; ++i) {
+        const char c = data[i];
+        if(c == '[' || c == '{' || c == ',' || c == ':') ++count;
+    }
+    return count;
+}
+
+inline bool isWhitespace(const char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+std::size_t skipWhitespace(const char* const data, const std::size_t size, std::size_t i) {
+    /* Most values are separated by at most a single space, check that first
+       before going wide */
+    if(i == size || !isWhitespace(data[i])) return i;
+    ++i;
+    #ifdef CORRADE_TARGET_SSE2
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i carriageReturn = _mm_set1_epi8('\r');
+    for(; i + 16 <= size; i += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i whitespace = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, space),
+                         _mm_cmpeq_epi8(chunk, tab)),
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, newline),
+                         _mm_cmpeq_epi8(chunk, carriageReturn)));
+        const unsigned int mask = ~_mm_movemask_epi8(whitespace) & 0xffff;
+        if(mask) return i + firstSetBit(mask);
+    }
+    #endif
+    for(; i != size && isWhitespace(data[i]); ++i);
+    return i;
+}
+
+/* Finds the first quote, backslash or a control character, which are the
+   only characters that need attention inside a string */
+std::size_t findStringSpecial(const char* const data, const std::size_t size, std::size_t i) {
+    #ifdef CORRADE_TARGET_SSE2
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i controlMax = _mm_set1_epi8(0x1f);
+    for(; i + 16 <= size; i += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        /* There's no unsigned comparison in SSE2, so checking for
+           max(c, 0x1f) == 0x1f instead */
+        const __m128i special = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                         _mm_cmpeq_epi8(chunk, backslash)),
+            _mm_cmpeq_epi8(_mm_max_epu8(chunk, controlMax), controlMax));
+        const unsigned int mask = _mm_movemask_epi8(special);
+        if(mask) return i + firstSetBit(mask);
+    }
+    #endif
+    for(; i < size; ++i) {
+        const char c = data[i];
+        if(c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20)
+            return i;
+    }
+    return size;
+}
+
+inline bool isDigit(const char c) {
+    return c >= '0' && c <= '9';
+}
+
+inline bool isNumberCharacter(const char c) {
+    return isDigit(c) || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+/* Validates the number against the JSON grammar, optionally allowing just
+   integers */
+bool isValidNumber(const Containers::StringView data, const bool integerOnly, const bool allowNegative) {
+    const std::size_t size = data.size();
+    std::size_t i = 0;
+    if(i < size && data[i] == '-') {
+        if(!allowNegative) return false;
+        ++i;
+    }
+    if(i == size) return false;
+    if(data[i] == '0') ++i;
+    else if(isDigit(data[i])) while(i < size && isDigit(data[i])) ++i;
+    else return false;
+    if(integerOnly) return i == size;
+
+    if(i < size && data[i] == '.') {
+        ++i;
+        if(i == size || !isDigit(data[i])) return false;
+        while(i < size && isDigit(data[i])) ++i;
+    }
+    if(i < size && (data[i] == 'e' || data[i] == 'E')) {
+        ++i;
+        if(i < size && (data[i] == '+' || data[i] == '-')) ++i;
+        if(i == size || !isDigit(data[i])) return false;
+        while(i < size && isDigit(data[i])) ++i;
+    }
+    return i == size;
+}
+
+/* The token data aren't null-terminated and may be at the very end of the
+   input, so the C conversion functions can't be used on them directly */
+struct NullTerminated {
+    explicit NullTerminated(const Containers::StringView data) {
+        if(data.size() < sizeof(buffer)) {
+            std::memcpy(buffer, data.data(), data.size());
+            buffer[data.size()] = '\0';
+            pointer = buffer;
+        } else {
+            string.assign(data.data(), data.size());
+            pointer = string.data();
+        }
+    }
+
+    char buffer[64];
+    std::string string;
+    const char* pointer;
+};
+
+}
+
+Containers::StringView JsonToken::data() const {
+    return {_data, _sizeTypeEscaped & SizeMask};
+}
+
+JsonToken::Type JsonToken::type() const {
+    return Type((_sizeTypeEscaped & TypeMask) >> TypeShift);
+}
+
+bool JsonToken::isEscaped() const {
+    return _sizeTypeEscaped & EscapedFlag;
+}
+
+Containers::Optional<bool> JsonToken::parseBool() const {
+    if(type() != Type::Bool) {
+        Error{} << "Utility::JsonToken::parseBool(): expected a bool, got" << type();
+        return {};
+    }
+
+    return *_data == 't';
+}
+
+namespace {
+
+Containers::Optional<double> parseDoubleInternal(const char* const messagePrefix, const JsonToken& token) {
+    if(token.type() != JsonToken::Type::Number) {
+        Error{} << messagePrefix << "expected a number, got" << token.type();
+        return {};
+    }
+
+    const Containers::StringView data = token.data();
+    if(!isValidNumber(data, false, true)) {
+        Error{} << messagePrefix << "invalid floating-point literal" << data;
+        return {};
+    }
+
+    return std::strtod(NullTerminated{data}.pointer, nullptr);
+}
+
+}
+
+Containers::Optional<double> JsonToken::parseDouble() const {
+    return parseDoubleInternal("Utility::JsonToken::parseDouble():", *this);
+}
+
+Containers::Optional<float> JsonToken::parseFloat() const {
+    const Containers::Optional<double> out = parseDoubleInternal("Utility::JsonToken::parseFloat():", *this);
+    if(!out) return {};
+    return float(*out);
+}
+
+Containers::Optional<std::int64_t> JsonToken::parseLong() const {
+    if(type() != Type::Number) {
+        Error{} << "Utility::JsonToken::parseLong(): expected a number, got" << type();
+        return {};
+    }
+
+    const Containers::StringView data = this->data();
+    if(!isValidNumber(data, true, true)) {
+        Error{} << "Utility::JsonToken::parseLong(): invalid integer literal" << data;
+        return {};
+    }
+
+    errno = 0;
+    const long long out = std::strtoll(NullTerminated{data}.pointer, nullptr, 10);
+    if(errno == ERANGE) {
+        Error{} << "Utility::JsonToken::parseLong(): too large integer literal" << data;
+        return {};
+    }
+
+    return std::int64_t(out);
+}
+
+Containers::Optional<std::uint64_t> JsonToken::parseUnsignedLong() const {
+    if(type() != Type::Number) {
+        Error{} << "Utility::JsonToken::parseUnsignedLong(): expected a number, got" << type();
+        return {};
+    }
+
+    const Containers::StringView data = this->data();
+    if(!isValidNumber(data, true, false)) {
+        Error{} << "Utility::JsonToken::parseUnsignedLong(): invalid unsigned integer literal" << data;
+        return {};
+    }
+
+    errno = 0;
+    const unsigned long long out = std::strtoull(NullTerminated{data}.pointer, nullptr, 10);
+    if(errno == ERANGE) {
+        Error{} << "Utility::JsonToken::parseUnsignedLong(): too large integer literal" << data;
+        return {};
+    }
+
+    return std::uint64_t(out);
+}
+
+Containers::StringView JsonToken::asString() const {
+    CORRADE_ASSERT(type() == Type::String,
+        "Utility::JsonToken::asString(): expected a string, got" << type(), {});
+    CORRADE_ASSERT(!isEscaped(),
+        "Utility::JsonToken::asString(): string is escaped, use parseString() instead", {});
+    return data().slice(1, data().size() - 1);
+}
+
+namespace {
+
+/* Returns a value larger than 0xffff on failure */
+std::uint32_t parseHex4(const char* const data) {
+    std::uint32_t out = 0;
+    for(std::size_t i = 0; i != 4; ++i) {
+        const char c = data[i];
+        out <<= 4;
+        if(c >= '0' && c <= '9') out |= c - '0';
+        else if(c >= 'a' && c <= 'f') out |= c - 'a' + 10;
+        else if(c >= 'A' && c <= 'F') out |= c - 'A' + 10;
+        else return 0xffffffffu;
+    }
+    return out;
+}
+
+}
+
+Containers::Optional<Containers::String> JsonToken::parseString() const {
+    if(type() != Type::String) {
+        Error{} << "Utility::JsonToken::parseString(): expected a string, got" << type();
+        return {};
+    }
+
+    const Containers::StringView in = data().slice(1, data().size() - 1);
+    if(!isEscaped()) return Containers::String{in};
+
+    /* The unescaped string is never longer than the escaped one --- the
+       longest UTF-8 sequence is four bytes, while \u escapes are at least
+       six */
+    Containers::Array<char> out{NoInit, in.size()};
+    std::size_t outSize = 0;
+    for(std::size_t i = 0; i < in.size(); ++i) {
+        const char c = in[i];
+        if(c != '\\') {
+            out[outSize++] = c;
+            continue;
+        }
+
+        const std::size_t begin = i;
+        if(++i == in.size()) {
+            Error{} << "Utility::JsonToken::parseString(): invalid escape sequence" << in.suffix(begin);
+            return {};
+        }
+
+        switch(in[i]) {
+            case '"': out[outSize++] = '"'; break;
+            case '\\': out[outSize++] = '\\'; break;
+            case '/': out[outSize++] = '/'; break;
+            case 'b': out[outSize++] = '\b'; break;
+            case 'f': out[outSize++] = '\f'; break;
+            case 'n': out[outSize++] = '\n'; break;
+            case 'r': out[outSize++] = '\r'; break;
+            case 't': out[outSize++] = '\t'; break;
+            case 'u': {
+                std::uint32_t character = in.size() - i > 4 ? parseHex4(in.data() + i + 1) : 0xffffffffu;
+                if(character <= 0xffff) i += 4;
+
+                /* A high surrogate has to be followed by a low one */
+                if(character >= 0xd800 && character <= 0xdbff) {
+                    const std::uint32_t low = in.size() - i > 6 && in[i + 1] == '\\' && in[i + 2] == 'u' ? parseHex4(in.data() + i + 3) : 0xffffffffu;
+                    if(low >= 0xdc00 && low <= 0xdfff) {
+                        character = 0x10000 + ((character - 0xd800) << 10) + (low - 0xdc00);
+                        i += 6;
+                    } else character = 0xffffffffu;
+                } else if(character >= 0xdc00 && character <= 0xdfff)
+                    character = 0xffffffffu;
+
+                if(character > 0x10ffff) {
+                    Error{} << "Utility::JsonToken::parseString(): invalid unicode escape sequence" << in.slice(begin, begin + 6 < in.size() ? begin + 6 : in.size());
+                    return {};
+                }
+
+                outSize += Unicode::utf8(character, Containers::StaticArrayView<4, char>{out.data() + outSize});
+                break;
+            }
+            default:
+                Error{} << "Utility::JsonToken::parseString(): invalid escape sequence" << in.slice(begin, begin + 2);
+                return {};
+        }
+    }
+
+    return Containers::String{out.data(), outSize};
+}
+
+Debug& operator<<(Debug& debug, const JsonToken::Type value) {
+    debug << "Utility::JsonToken::Type" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case JsonToken::Type::value: return debug << "::" #value;
+        _c(Object)
+        _c(Array)
+        _c(Null)
+        _c(Bool)
+        _c(Number)
+        _c(String)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(std::uint8_t(value)) << Debug::nospace << ")";
+}
+
+Json::Json(): _tokenCount{} {}
+
+Json::Json(Json&&) noexcept = default;
+
+Json::~Json() = default;
+
+Json& Json::operator=(Json&&) noexcept = default;
+
+Containers::ArrayView<const JsonToken> Json::tokens() const {
+    return _tokens.prefix(_tokenCount);
+}
+
+const JsonToken& Json::root() const {
+    return _tokens[0];
+}
+
+Containers::Optional<Json> Json::fromString(const Containers::StringView string) {
+    return tokenize(string, "<in>", nullptr);
+}
+
+Containers::Optional<Json> Json::fromFile(const std::string& filename) {
+    Containers::Array<char> data = Directory::read(filename);
+    if(!data) {
+        Error{} << "Utility::Json::fromFile(): can't read" << filename;
+        return {};
+    }
+
+    /* The view stays valid after moving the array */
+    const Containers::StringView view{data, data.size()};
+    return tokenize(view, filename.data(), Utility::move(data));
+}
+
+namespace {
+
+void printError(const char* const data, const std::size_t size, const std::size_t position, const char* const filename, const char* const message, const bool printGot) {
+    std::size_t line = 1, column = 1;
+    for(std::size_t i = 0; i != position; ++i) {
+        if(data[i] == '\n') {
+            ++line;
+            column = 1;
+        } else ++column;
+    }
+
+    Error err;
+    err << "Utility::Json:" << message;
+    if(printGot) {
+        if(position == size) err << "but got end of input";
+        else err << "but got" << Containers::StringView{data + position, 1};
+    }
+    err << "at" << filename << Debug::nospace << ":" << Debug::nospace << line << Debug::nospace << ":" << Debug::nospace << column;
+}
+
+}
+
+Containers::Optional<Json> Json::tokenize(const Containers::StringView string, const char* const filename, Containers::Array<char>&& storage) {
+    const char* const data = string.data();
+    const std::size_t size = string.size();
+    if(size > JsonToken::SizeMask) {
+        Error{} << "Utility::Json:" << filename << "is too large," << size << "bytes";
+        return {};
+    }
+
+    Json out;
+    out._storage = Utility::move(storage);
+    out._tokens = Containers::Array<JsonToken>{NoInit, tokenCountUpperBound(data, size)};
+    JsonToken* const tokens = out._tokens.data();
+    std::size_t tokenCount = 0;
+
+    /* Indices of objects, arrays and keys that are not closed yet. A key is
+       always directly above its object. */
+    Containers::Array<std::size_t> stack;
+
+    enum class Expecting {
+        Value,
+        ValueOrArrayEnd,
+        Key,
+        KeyOrObjectEnd,
+        Colon,
+        CommaOrEnd,
+        DocumentEnd
+    } expecting = Expecting::Value;
+
+    std::size_t i = 0;
+    for(;;) {
+        i = skipWhitespace(data, size, i);
+        if(i == size && expecting == Expecting::DocumentEnd) break;
+
+        const char c = i == size ? '\0' : data[i];
+        const JsonToken::Type parentType = stack.empty() ? JsonToken::Type::Null : JsonToken::Type((tokens[stack.back()]._sizeTypeEscaped & JsonToken::TypeMask) >> JsonToken::TypeShift);
+
+        /* Closing an object or an array */
+        if(i != size && (
+            (c == '}' && (expecting == Expecting::KeyOrObjectEnd || (expecting == Expecting::CommaOrEnd && parentType == JsonToken::Type::Object))) ||
+            (c == ']' && (expecting == Expecting::ValueOrArrayEnd || (expecting == Expecting::CommaOrEnd && parentType == JsonToken::Type::Array)))))
+        {
+            const std::size_t parent = stack.back();
+            arrayRemoveSuffix(stack);
+            JsonToken& token = tokens[parent];
+            token._childCount = tokenCount - parent - 1;
+            token._sizeTypeEscaped |= std::size_t(data + i + 1 - token._data);
+            ++i;
+
+        } else if(expecting == Expecting::CommaOrEnd) {
+            if(c != ',') {
+                printError(data, size, i, filename, parentType == JsonToken::Type::Object ? "expected , or }" : "expected , or ]", true);
+                return {};
+            }
+            expecting = parentType == JsonToken::Type::Object ? Expecting::Key : Expecting::Value;
+            ++i;
+            continue;
+
+        } else if(expecting == Expecting::Colon) {
+            if(c != ':') {
+                printError(data, size, i, filename, "expected :", true);
+                return {};
+            }
+            expecting = Expecting::Value;
+            ++i;
+            continue;
+
+        } else if(expecting == Expecting::DocumentEnd) {
+            printError(data, size, i, filename, "expected end of input", true);
+            return {};
+
+        /* A string, either a key or a value */
+        } else if(c == '"' && i != size) {
+            std::size_t end = i + 1;
+            bool escaped = false;
+            for(;;) {
+                end = findStringSpecial(data, size, end);
+                if(end >= size) {
+                    printError(data, size, i, filename, "unterminated string", false);
+                    return {};
+                }
+                if(data[end] == '"') break;
+                if(data[end] == '\\') {
+                    escaped = true;
+                    end += 2;
+                    continue;
+                }
+
+                printError(data, size, end, filename, "unexpected control character in a string", false);
+                return {};
+            }
+
+            CORRADE_INTERNAL_ASSERT(tokenCount < out._tokens.size());
+            JsonToken& token = tokens[tokenCount];
+            token._data = data + i;
+            token._sizeTypeEscaped = (end + 1 - i)|(std::size_t(JsonToken::Type::String) << JsonToken::TypeShift)|(escaped ? std::size_t(JsonToken::EscapedFlag) : 0);
+            token._childCount = 0;
+            i = end + 1;
+
+            /* A key, the value is parsed next */
+            if(expecting == Expecting::Key || expecting == Expecting::KeyOrObjectEnd) {
+                arrayAppend(stack, tokenCount++);
+                expecting = Expecting::Colon;
+                continue;
+            }
+
+            ++tokenCount;
+
+        } else if(expecting == Expecting::Key || expecting == Expecting::KeyOrObjectEnd) {
+            printError(data, size, i, filename, "expected a string key", true);
+            return {};
+
+        /* Other values */
+        } else {
+            CORRADE_INTERNAL_ASSERT(tokenCount < out._tokens.size());
+            JsonToken& token = tokens[tokenCount];
+            token._data = data + i;
+            token._childCount = 0;
+
+            if(c == '{' || c == '[') {
+                /* Size gets filled once the object / array is closed */
+                token._sizeTypeEscaped = std::size_t(c == '{' ? JsonToken::Type::Object : JsonToken::Type::Array) << JsonToken::TypeShift;
+                arrayAppend(stack, tokenCount++);
+                expecting = c == '{' ? Expecting::KeyOrObjectEnd : Expecting::ValueOrArrayEnd;
+                ++i;
+                continue;
+            }
+
+            JsonToken::Type type;
+            std::size_t end;
+            if(c == 't' || c == 'f' || c == 'n') {
+                const char* const literal = c == 't' ? "true" : c == 'f' ? "false" : "null";
+                const std::size_t literalSize = c == 'f' ? 5 : 4;
+                if(size - i < literalSize || std::memcmp(data + i, literal, literalSize) != 0) {
+                    printError(data, size, i, filename, "invalid literal", false);
+                    return {};
+                }
+                type = c == 'n' ? JsonToken::Type::Null : JsonToken::Type::Bool;
+                end = i + literalSize;
+            } else if(c == '-' || isDigit(c)) {
+                /* Validated only when parsed */
+                end = i + 1;
+                while(end < size && isNumberCharacter(data[end])) ++end;
+                type = JsonToken::Type::Number;
+            } else {
+                printError(data, size, i, filename, "expected a value", true);
+                return {};
+            }
+
+            token._sizeTypeEscaped = (end - i)|(std::size_t(type) << JsonToken::TypeShift);
+            ++tokenCount;
+            i = end;
+        }
+
+        /* A value got finished. If it's an object value, close its key as
+           well */
+        if(!stack.empty() && JsonToken::Type((tokens[stack.back()]._sizeTypeEscaped & JsonToken::TypeMask) >> JsonToken::TypeShift) == JsonToken::Type::String) {
+            tokens[stack.back()]._childCount = tokenCount - stack.back() - 1;
+            arrayRemoveSuffix(stack);
+        }
+
+        expecting = stack.empty() ? Expecting::DocumentEnd : Expecting::CommaOrEnd;
+    }
+
+    out._tokenCount = tokenCount;
+    return Containers::Optional<Json>{Utility::move(out)};
+}
+
+}}
@@ -0,0 +1,319 @@
+#ifndef Corrade_Utility_Json_h
+#define Corrade_Utility_Json_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Utility::Json, @ref Corrade::Utility::JsonToken
+ * @m_since_latest
+ */
+
+#include <cstdint>
+#include <string>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/StringView.h"
+#include "Corrade/Utility/Utility.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Utility {
+
+/**
+@brief JSON token
+@m_since_latest
+
+A single value, object or array in a @ref Json document. Tokens are stored in
+a flat array in the order in which they appear in the file, with children of
+objects and arrays directly following their parent. Object keys are tokens of
+type @ref Type::String with exactly one child, which is the value
+corresponding to the key.
+
+The token only references the input data, no values are converted during
+tokenization. Use @ref parseBool(), @ref parseDouble(), @ref parseLong(),
+@ref parseString() etc. to convert the value on access.
+@see @ref Json::tokens()
+*/
+class CORRADE_UTILITY_EXPORT JsonToken {
+    public:
+        /**
+         * @brief Token type
+         *
+         * @see @ref type()
+         */
+        enum class Type: std::uint8_t {
+            /** An object, @cb{.json} {} @ce */
+            Object,
+
+            /** An array, @cb{.json} [] @ce */
+            Array,
+
+            /** A @cb{.json} null @ce value */
+            Null,
+
+            /** A @cb{.json} true @ce or @cb{.json} false @ce value */
+            Bool,
+
+            /** A number */
+            Number,
+
+            /** A string or an object key */
+            String
+        };
+
+        /**
+         * @brief Token data
+         *
+         * Raw slice of the input corresponding to the token, including the
+         * quotes for strings, and including all children for objects and
+         * arrays. Object keys don't include their value.
+         */
+        Containers::StringView data() const;
+
+        /** @brief Token type */
+        Type type() const;
+
+        /**
+         * @brief Whether the string contains escape sequences
+         *
+         * Returns @cpp false @ce for tokens that are not
+         * @ref Type::String. If @cpp true @ce, the value can be retrieved
+         * only with @ref parseString(), not @ref asString().
+         */
+        bool isEscaped() const;
+
+        /**
+         * @brief Count of all child tokens
+         *
+         * Includes nested children as well, i.e. the count of tokens until
+         * the next sibling. For object keys it's the count of tokens of the
+         * value plus one. Always @cpp 0 @ce for other values.
+         */
+        std::size_t childCount() const { return _childCount; }
+
+        /**
+         * @brief All child tokens
+         *
+         * Contains @ref childCount() tokens directly following this one.
+         */
+        Containers::ArrayView<const JsonToken> children() const {
+            return {this + 1, _childCount};
+        }
+
+        /**
+         * @brief First child token
+         *
+         * Returns @cpp nullptr @ce if the token has no children.
+         */
+        const JsonToken* firstChild() const {
+            return _childCount ? this + 1 : nullptr;
+        }
+
+        /**
+         * @brief Next sibling token
+         *
+         * Points right after all children of this token. If this is the last
+         * child of its parent, the returned pointer points to the next
+         * sibling of the parent or to the end of @ref Json::tokens().
+         */
+        const JsonToken* next() const { return this + _childCount + 1; }
+
+        /**
+         * @brief Parse a boolean value
+         *
+         * If the token is not a @ref Type::Bool, prints a message to
+         * @ref Error and returns @ref Containers::NullOpt.
+         */
+        Containers::Optional<bool> parseBool() const;
+
+        /**
+         * @brief Parse a double-precision floating-point value
+         *
+         * If the token is not a @ref Type::Number or the number isn't valid
+         * according to the JSON grammar, prints a message to @ref Error and
+         * returns @ref Containers::NullOpt.
+         */
+        Containers::Optional<double> parseDouble() const;
+
+        /**
+         * @brief Parse a single-precision floating-point value
+         *
+         * Same as @ref parseDouble(), converted to a @cpp float @ce.
+         */
+        Containers::Optional<float> parseFloat() const;
+
+        /**
+         * @brief Parse a signed integer value
+         *
+         * If the token is not a @ref Type::Number, the number has a fractional
+         * part or an exponent or doesn't fit into the type, prints a message
+         * to @ref Error and returns @ref Containers::NullOpt.
+         */
+        Containers::Optional<std::int64_t> parseLong() const;
+
+        /**
+         * @brief Parse an unsigned integer value
+         *
+         * Same as @ref parseLong(), except that negative values are treated
+         * as an error as well.
+         */
+        Containers::Optional<std::uint64_t> parseUnsignedLong() const;
+
+        /**
+         * @brief String value
+         *
+         * Returns a view on the input data without the surrounding quotes.
+         * Expects that the token is a @ref Type::String and
+         * @ref isEscaped() is @cpp false @ce.
+         * @see @ref parseString()
+         */
+        Containers::StringView asString() const;
+
+        /**
+         * @brief Parse a string value
+         *
+         * Unescapes the string, converting `\u` escape sequences to UTF-8.
+         * If the token is not a @ref Type::String or contains an invalid
+         * escape sequence, prints a message to @ref Error and returns
+         * @ref Containers::NullOpt. If the string isn't escaped, it's better
+         * to use the allocation-less @ref asString() instead.
+         */
+        Containers::Optional<Containers::String> parseString() const;
+
+    private:
+        friend Json;
+
+        enum: std::size_t {
+            TypeShift = sizeof(std::size_t)*8 - 4,
+            TypeMask = std::size_t{0x7} << TypeShift,
+            EscapedFlag = std::size_t{1} << (sizeof(std::size_t)*8 - 1),
+            SizeMask = (std::size_t{1} << TypeShift) - 1
+        };
+
+        const char* _data;
+        /* Upper three bits are the type, topmost bit is the escaped flag */
+        std::size_t _sizeTypeEscaped;
+        std::size_t _childCount;
+};
+
+/**
+@debugoperatorclassenum{JsonToken,JsonToken::Type}
+@m_since_latest
+*/
+CORRADE_UTILITY_EXPORT Debug& operator<<(Debug& debug, JsonToken::Type value);
+
+/**
+@brief JSON document
+@m_since_latest
+
+Tokenizes a JSON document into a flat array of @ref JsonToken instances,
+allocated at once for the whole document. The tokens reference the input
+data, so the parsing is zero-copy and strings without escape sequences can be
+accessed through @ref JsonToken::asString() without any allocation. Numbers
+aren't converted until accessed, which means that documents where only a
+small subset of values is needed are processed considerably faster than with
+parsers that convert everything upfront.
+
+@snippet Utility.cpp Json
+
+@section Utility-Json-performance Performance
+
+Structural characters and string boundaries are searched for 16 bytes at a
+time using SSE2 instructions on @ref CORRADE_TARGET_SSE2 "SSE2" targets, with
+a scalar fallback elsewhere. Before tokenizing, the input is scanned once to
+calculate an upper bound of the token count in order to allocate the token
+array just once. Each token is 24 bytes on 64-bit platforms.
+
+As @ref fromString() doesn't copy the input, a memory-mapped file returned by
+@ref Directory::mapRead() can be tokenized with no further memory needed
+except for the token array, as long as the mapping outlives the @ref Json
+instance. The @ref fromFile() variant reads the file into an owned memory
+instead.
+
+@section Utility-Json-limitations Limitations
+
+The tokenizer validates the overall document structure and that strings and
+literals are terminated, but number literals and string escape sequences are
+checked only when the value is parsed. Strings are not checked for UTF-8
+validity. On 32-bit platforms, the input is limited to 256 MB.
+*/
+class CORRADE_UTILITY_EXPORT Json {
+    public:
+        /**
+         * @brief Tokenize a JSON string
+         *
+         * The @p string is expected to stay in scope for the whole lifetime
+         * of the returned instance. If the document is not valid, prints a
+         * message to @ref Error with a line and column of the error and
+         * returns @ref Containers::NullOpt.
+         */
+        static Containers::Optional<Json> fromString(Containers::StringView string);
+
+        /**
+         * @brief Tokenize a JSON file
+         *
+         * Reads the file into an owned memory. If the file can't be read or
+         * the document is not valid, prints a message to @ref Error and
+         * returns @ref Containers::NullOpt.
+         */
+        static Containers::Optional<Json> fromFile(const std::string& filename);
+
+        /** @brief Copying is not allowed */
+        Json(const Json&) = delete;
+
+        /** @brief Move constructor */
+        Json(Json&&) noexcept;
+
+        ~Json();
+
+        /** @brief Copying is not allowed */
+        Json& operator=(const Json&) = delete;
+
+        /** @brief Move assignment */
+        Json& operator=(Json&&) noexcept;
+
+        /**
+         * @brief All tokens
+         *
+         * The first token is the document root.
+         */
+        Containers::ArrayView<const JsonToken> tokens() const;
+
+        /** @brief Root token */
+        const JsonToken& root() const;
+
+    private:
+        explicit Json();
+
+        static Containers::Optional<Json> tokenize(Containers::StringView string, const char* filename, Containers::Array<char>&& storage);
+
+        Containers::Array<char> _storage;
+        Containers::Array<JsonToken> _tokens;
+        std::size_t _tokenCount;
+};
+
+}}
+
+#endif
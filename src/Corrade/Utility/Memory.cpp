@@ -0,0 +1,276 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Memory.h"
+
+#include "Corrade/Containers/EnumSet.hpp"
+#include "Corrade/Utility/Debug.h"
+
+#ifdef CORRADE_TARGET_UNIX
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <cstdio>
+#include <sys/syscall.h> /* SYS_mbind */
+#endif
+#elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+#include <windows.h>
+#include "Corrade/Utility/Implementation/WindowsError.h"
+#endif
+
+namespace Corrade { namespace Utility {
+
+Debug& operator<<(Debug& debug, const PageAllocationFlag value) {
+    debug << "Utility::PageAllocationFlag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case PageAllocationFlag::value: return debug << "::" #value;
+        _c(HugePages)
+        _c(ExplicitHugePages)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(std::uint8_t(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const PageAllocationFlags value) {
+    return Containers::enumSetDebugOutput(debug, value, "Utility::PageAllocationFlags{}", {
+        PageAllocationFlag::HugePages,
+        PageAllocationFlag::ExplicitHugePages});
+}
+
+namespace Implementation {
+
+namespace {
+
+#if defined(CORRADE_TARGET_UNIX)
+/* The most common transparent huge page size on both x86 and ARM, transparent
+   huge pages are only used for regions aligned to it. Where it's larger (such
+   as 512 MB on ARM64 with 64 kB base pages), the alignment is still valid,
+   the allocation just doesn't get backed by huge pages. */
+constexpr std::size_t TransparentHugePageSize = 2*1024*1024;
+
+std::size_t roundUp(const std::size_t size, const std::size_t to) {
+    return (size + to - 1)/to*to;
+}
+
+std::size_t pageSize() {
+    static const std::size_t size = sysconf(_SC_PAGESIZE);
+    return size;
+}
+#endif
+
+#ifdef __linux__
+/* Default size of explicit huge pages, which is what MAP_HUGETLB allocates if
+   no MAP_HUGE_* size is specified. Can be 2 MB, 1 GB or for example 512 MB on
+   ARM64 with 64 kB base pages, so it's queried from the system and used for
+   both rounding the allocation size and unmapping it. Zero if the kernel
+   doesn't support explicit huge pages. */
+std::size_t explicitHugePageSize() {
+    static const std::size_t size = [] {
+        std::size_t out = 0;
+        if(std::FILE* const f = std::fopen("/proc/meminfo", "rb")) {
+            char line[128];
+            unsigned long kB;
+            while(std::fgets(line, sizeof(line), f)) {
+                if(std::sscanf(line, "Hugepagesize: %lu kB", &kB) == 1) {
+                    out = std::size_t(kB)*1024;
+                    break;
+                }
+            }
+            std::fclose(f);
+        }
+        return out;
+    }();
+    return size;
+}
+#endif
+
+}
+
+void* allocatePages(const std::size_t size, const PageAllocationFlags flags, const int node) {
+    const char* const function = node < 0 ?
+        "Utility::allocatePages():" : "Utility::allocatePagesOnNumaNode():";
+
+    #ifdef CORRADE_TARGET_UNIX
+    #ifndef __linux__
+    if(flags & PageAllocationFlag::ExplicitHugePages) {
+        Error{} << function << "explicit huge pages not implemented on this platform";
+        return nullptr;
+    }
+    if(node >= 0) {
+        Error{} << function << "NUMA placement not implemented on this platform";
+        return nullptr;
+    }
+    #endif
+
+    void* data;
+    std::size_t allocationSize;
+    #ifdef __linux__
+    if(flags & PageAllocationFlag::ExplicitHugePages) {
+        const std::size_t hugePageSize = explicitHugePageSize();
+        if(!hugePageSize) {
+            Error{} << function << "explicit huge pages not supported by the system";
+            return nullptr;
+        }
+        allocationSize = roundUp(size, hugePageSize);
+        data = mmap(nullptr, allocationSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB, -1, 0);
+        if(data == MAP_FAILED) {
+            Error{} << function << "can't allocate" << allocationSize << "bytes of explicit huge pages:" << std::strerror(errno);
+            return nullptr;
+        }
+    } else
+    #endif
+    if(flags & PageAllocationFlag::HugePages) {
+        /* Map one huge page more and then unmap the parts before and after
+           the 2 MB-aligned range */
+        allocationSize = roundUp(size, TransparentHugePageSize);
+        char* const mapped = static_cast<char*>(mmap(nullptr, allocationSize + TransparentHugePageSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0));
+        if(mapped == MAP_FAILED) {
+            Error{} << function << "can't allocate" << allocationSize << "bytes:" << std::strerror(errno);
+            return nullptr;
+        }
+        char* const aligned = reinterpret_cast<char*>(roundUp(reinterpret_cast<std::size_t>(mapped), TransparentHugePageSize));
+        if(const std::size_t before = aligned - mapped)
+            munmap(mapped, before);
+        if(const std::size_t after = mapped + allocationSize + TransparentHugePageSize - (aligned + allocationSize))
+            munmap(aligned + allocationSize, after);
+        data = aligned;
+
+        /* Just a hint, so the failure is not fatal (for example if transparent
+           huge pages are disabled in the kernel) */
+        #ifdef MADV_HUGEPAGE
+        madvise(data, allocationSize, MADV_HUGEPAGE);
+        #endif
+    } else {
+        allocationSize = roundUp(size, pageSize());
+        data = mmap(nullptr, allocationSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+        if(data == MAP_FAILED) {
+            Error{} << function << "can't allocate" << allocationSize << "bytes:" << std::strerror(errno);
+            return nullptr;
+        }
+    }
+
+    #ifdef __linux__
+    /* Called directly through syscall() as the wrapper is in libnuma, which
+       might not be available. Has to be done before the pages are first
+       touched, otherwise they're already placed by the first-touch policy. */
+    if(node >= 0) {
+        constexpr int MpolPreferred = 1;
+        constexpr std::size_t MaxNodes = 1024;
+        if(std::size_t(node) >= MaxNodes) {
+            munmap(data, allocationSize);
+            Error{} << function << "node" << node << "out of range for" << MaxNodes << "nodes";
+            return nullptr;
+        }
+        unsigned long mask[MaxNodes/(sizeof(unsigned long)*8)]{};
+        mask[node/(sizeof(unsigned long)*8)] |= 1ul << (node % (sizeof(unsigned long)*8));
+        /* The kernel expects the max node count to be one more than the
+           count of bits in the mask */
+        if(syscall(SYS_mbind, data, allocationSize, MpolPreferred, mask, MaxNodes + 1, 0) != 0) {
+            const int error = errno;
+            munmap(data, allocationSize);
+            Error{} << function << "can't place the allocation on node" << node << Debug::nospace << ":" << std::strerror(error);
+            return nullptr;
+        }
+    }
+    #endif
+
+    return data;
+
+    #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+    /* Transparent huge pages are not a thing on Windows */
+    SIZE_T allocationSize = size;
+    DWORD type = MEM_RESERVE|MEM_COMMIT;
+    if(flags & PageAllocationFlag::ExplicitHugePages) {
+        const SIZE_T largePageSize = GetLargePageMinimum();
+        if(!largePageSize) {
+            Error{} << function << "explicit huge pages not supported by the system";
+            return nullptr;
+        }
+        allocationSize = (size + largePageSize - 1)/largePageSize*largePageSize;
+        type |= MEM_LARGE_PAGES;
+    }
+
+    void* const data = node < 0 ?
+        VirtualAlloc(nullptr, allocationSize, type, PAGE_READWRITE) :
+        VirtualAllocExNuma(GetCurrentProcess(), nullptr, allocationSize, type, PAGE_READWRITE, node);
+    if(!data) {
+        Error{} << function << "can't allocate" << allocationSize << "bytes:" << Implementation::windowsErrorString(GetLastError());
+        return nullptr;
+    }
+
+    return data;
+
+    #else
+    static_cast<void>(size);
+    static_cast<void>(flags);
+    Error{} << function << "not implemented on this platform";
+    return nullptr;
+    #endif
+}
+
+void deallocatePages(void* const data, const std::size_t size) {
+    #ifdef CORRADE_TARGET_UNIX
+    munmap(data, roundUp(size, pageSize()));
+    #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+    static_cast<void>(size);
+    VirtualFree(data, 0, MEM_RELEASE);
+    #else
+    static_cast<void>(data);
+    static_cast<void>(size);
+    #endif
+}
+
+void deallocateHugePages(void* const data, const std::size_t size) {
+    #ifdef CORRADE_TARGET_UNIX
+    munmap(data, roundUp(size, TransparentHugePageSize));
+    #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+    static_cast<void>(size);
+    VirtualFree(data, 0, MEM_RELEASE);
+    #else
+    static_cast<void>(data);
+    static_cast<void>(size);
+    #endif
+}
+
+void deallocateExplicitHugePages(void* const data, const std::size_t size) {
+    #ifdef __linux__
+    munmap(data, roundUp(size, explicitHugePageSize()));
+    #else
+    /* Explicit huge pages are implemented only on Linux and Windows, where
+       the size is ignored */
+    deallocateHugePages(data, size);
+    #endif
+}
+
+}
+
+}}
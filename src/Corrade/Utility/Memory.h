@@ -27,7 +27,7 @@
 */
 
 /** @file
- * @brief Function @ref Corrade::Utility::allocateAligned()
+ * @brief Function @ref Corrade::Utility::allocateAligned(), @ref Corrade::Utility::allocatePages(), @ref Corrade::Utility::allocatePagesOnNumaNode(), enum @ref Corrade::Utility::PageAllocationFlag, enum set @ref Corrade::Utility::PageAllocationFlags
  * @m_since_latest
  */
 
@@ -36,7 +36,10 @@
    containers or magic ring buffers */
 
 #include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/EnumSet.h"
+#include "Corrade/Containers/Optional.h"
 #include "Corrade/Containers/initializeHelpers.h"
+#include "Corrade/Utility/Utility.h"
 #include "Corrade/Utility/visibility.h"
 
 #ifdef CORRADE_TARGET_UNIX
@@ -291,6 +294,165 @@ template<class T, std::size_t alignment> inline Containers::Array<T> allocateAli
     return allocateAligned<T, alignment>(ValueInit, size);
 }
 
+/**
+@brief Page allocation flag
+@m_since_latest
+
+@see @ref PageAllocationFlags, @ref allocatePages(),
+    @ref allocatePagesOnNumaNode()
+*/
+enum class PageAllocationFlag: std::uint8_t {
+    /**
+     * Align the allocation to 2 MB and advise the system to back it with
+     * transparent huge pages, reducing TLB pressure for large working sets.
+     * It's just a hint, if transparent huge pages are disabled in the system,
+     * the memory is backed with regular pages. Implemented on Linux, ignored
+     * elsewhere.
+     */
+    HugePages = 1 << 0,
+
+    /**
+     * Back the allocation with explicit huge pages. Unlike
+     * @ref PageAllocationFlag::HugePages, the allocation fails if the system
+     * doesn't have enough huge pages reserved or, on Windows, if the process
+     * doesn't have the privilege to lock pages in memory. The size is
+     * rounded up to the default huge page size of the system, which on Linux
+     * is the `Hugepagesize` value from `/proc/meminfo`. Implemented on Linux
+     * and Windows.
+     */
+    ExplicitHugePages = 1 << 1
+};
+
+/**
+@brief Page allocation flags
+@m_since_latest
+
+@see @ref allocatePages(), @ref allocatePagesOnNumaNode()
+*/
+typedef Containers::EnumSet<PageAllocationFlag> PageAllocationFlags;
+
+CORRADE_ENUMSET_OPERATORS(PageAllocationFlags)
+
+/**
+@debugoperatorenum{PageAllocationFlag}
+@m_since_latest
+*/
+CORRADE_UTILITY_EXPORT Debug& operator<<(Debug& debug, PageAllocationFlag value);
+
+/**
+@debugoperatorenum{PageAllocationFlags}
+@m_since_latest
+*/
+CORRADE_UTILITY_EXPORT Debug& operator<<(Debug& debug, PageAllocationFlags value);
+
+/**
+@brief Allocate whole memory pages and value-initialize them
+@tparam T       Type of the returned array
+@param size     Count of @p T items to allocate. If @cpp 0 @ce, no
+    allocation is done.
+@param flags    Allocation flags
+@m_since_latest
+
+Compared to @ref allocateAligned(), the memory is requested directly from the
+operating system with @m_class{m-doc-external} [mmap()](https://man.archlinux.org/man/mmap.2)
+on @ref CORRADE_TARGET_UNIX "UNIX" systems and @m_class{m-doc-external} [VirtualAlloc()](https://docs.microsoft.com/en-us/windows/win32/api/memoryapi/nf-memoryapi-virtualalloc)
+on @ref CORRADE_TARGET_WINDOWS "Windows", which makes it aligned at least to
+the page size and allows backing it with huge pages, which is useful for
+working sets that are large enough for TLB misses to matter:
+
+@snippet Utility.cpp allocatePages
+
+The system provides the pages already zero-filled, so for trivial types there's
+no initialization step and the pages get physically allocated only once they're
+first written to. Non-trivial types get their default constructor called.
+The returned @ref Containers::Array has a custom deleter that calls destructors
+on non-trivial types and then returns the pages back to the system.
+
+If the allocation fails, prints a message to @ref Error and returns
+@ref Containers::NullOpt. On platforms other than UNIX and Windows (such as
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten") always fails.
+@see @ref allocatePagesOnNumaNode()
+*/
+template<class T> Containers::Optional<Containers::Array<T>> allocatePages(std::size_t size, PageAllocationFlags flags = {});
+
+/**
+@brief Allocate whole memory pages on given NUMA node and value-initialize them
+@m_since_latest
+
+Like @ref allocatePages(), but in addition the pages are preferably placed on
+given NUMA @p node instead of the node of the CPU that first writes to them.
+If the node runs out of memory, the pages are placed on other nodes. On Linux
+implemented using @m_class{m-doc-external} [mbind()](https://man.archlinux.org/man/mbind.2)
+with @cpp MPOL_PREFERRED @ce, on Windows with @m_class{m-doc-external} [VirtualAllocExNuma()](https://docs.microsoft.com/en-us/windows/win32/api/memoryapi/nf-memoryapi-virtualallocexnuma).
+On other platforms prints a message to @ref Error and returns
+@ref Containers::NullOpt. Use @ref System::numaNodeCount() to query the
+available nodes and @ref System::numaNodeCpus() together with
+@ref System::setThreadAffinity() to run the code that uses the memory on the
+same node.
+*/
+template<class T> Containers::Optional<Containers::Array<T>> allocatePagesOnNumaNode(std::size_t size, unsigned int node, PageAllocationFlags flags = {});
+
+namespace Implementation {
+
+/* Returns nullptr on failure. The node is ignored if negative. */
+CORRADE_UTILITY_EXPORT void* allocatePages(std::size_t size, PageAllocationFlags flags, int node);
+CORRADE_UTILITY_EXPORT void deallocatePages(void* data, std::size_t size);
+/* 2 MB-aligned transparent huge page allocations and explicit huge page
+   allocations are rounded up to a different size than regular pages and to a
+   different size from each other, so each needs its own deleter */
+CORRADE_UTILITY_EXPORT void deallocateHugePages(void* data, std::size_t size);
+CORRADE_UTILITY_EXPORT void deallocateExplicitHugePages(void* data, std::size_t size);
+
+template<class T> void pageDeleter(typename std::enable_if<std::is_trivially_destructible<T>::value, T>::type* const data, std::size_t size) {
+    deallocatePages(data, size*sizeof(T));
+}
+template<class T> void pageDeleter(typename std::enable_if<!std::is_trivially_destructible<T>::value, T>::type* const data, std::size_t size) {
+    for(std::size_t i = 0; i != size; ++i) data[i].~T();
+    deallocatePages(data, size*sizeof(T));
+}
+template<class T> void hugePageDeleter(typename std::enable_if<std::is_trivially_destructible<T>::value, T>::type* const data, std::size_t size) {
+    deallocateHugePages(data, size*sizeof(T));
+}
+template<class T> void hugePageDeleter(typename std::enable_if<!std::is_trivially_destructible<T>::value, T>::type* const data, std::size_t size) {
+    for(std::size_t i = 0; i != size; ++i) data[i].~T();
+    deallocateHugePages(data, size*sizeof(T));
+}
+template<class T> void explicitHugePageDeleter(typename std::enable_if<std::is_trivially_destructible<T>::value, T>::type* const data, std::size_t size) {
+    deallocateExplicitHugePages(data, size*sizeof(T));
+}
+template<class T> void explicitHugePageDeleter(typename std::enable_if<!std::is_trivially_destructible<T>::value, T>::type* const data, std::size_t size) {
+    for(std::size_t i = 0; i != size; ++i) data[i].~T();
+    deallocateExplicitHugePages(data, size*sizeof(T));
+}
+
+template<class T> Containers::Optional<Containers::Array<T>> allocatePages(const std::size_t size, const PageAllocationFlags flags, const int node) {
+    /* Not allocating anything for zero size, but it's not a failure either */
+    if(!size) return Containers::Array<T>{};
+
+    T* const data = static_cast<T*>(allocatePages(size*sizeof(T), flags, node));
+    if(!data) return {};
+
+    /* The pages are zero-filled already, so default initialization is
+       enough -- it's a no-op for trivial types and leaves zeros in members
+       not touched by the constructor elsewhere */
+    Containers::Implementation::arrayConstruct(DefaultInit, data, data + size);
+
+    return Containers::Array<T>{data, size,
+        flags & PageAllocationFlag::ExplicitHugePages ? explicitHugePageDeleter<T> :
+        flags & PageAllocationFlag::HugePages ? hugePageDeleter<T> :
+        pageDeleter<T>};
+}
+
+}
+
+template<class T> inline Containers::Optional<Containers::Array<T>> allocatePages(const std::size_t size, const PageAllocationFlags flags) {
+    return Implementation::allocatePages<T>(size, flags, -1);
+}
+
+template<class T> inline Containers::Optional<Containers::Array<T>> allocatePagesOnNumaNode(const std::size_t size, const unsigned int node, const PageAllocationFlags flags) {
+    return Implementation::allocatePages<T>(size, flags, int(node));
+}
+
 }}
 
 #endif
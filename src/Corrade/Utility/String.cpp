@@ -27,13 +27,21 @@
 #include "String.h"
 
 #include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <limits>
+#include <type_traits>
 
 #include "Corrade/Containers/GrowableArray.h"
 #include "Corrade/Containers/Optional.h"
 #include "Corrade/Containers/StaticArray.h"
 #include "Corrade/Containers/StringStl.h"
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/Debug.h"
+#include "Corrade/Utility/TypeTraits.h"
 
 namespace Corrade { namespace Utility { namespace String {
 
@@ -357,4 +365,401 @@ Containers::Optional<Containers::Array<std::uint32_t>> parseNumberSequence(const
     return Containers::optional(std::move(out));
 }
 
+
+namespace {
+
+inline bool isNumberDelimiter(const char c) {
+    return c == ',' || c == ';' || c == ' ' || c == '\t' || c == '\f' || c == '\v' || c == '\r' || c == '\n';
+}
+
+inline bool isDigit(const char c) {
+    return c >= '0' && c <= '9';
+}
+
+/* Converts eight ASCII digits at once using SWAR, returns ~0u if any of
+   them isn't a digit. Based on
+   https://lemire.me/blog/2022/01/21/swar-explained-parsing-eight-digits/ */
+inline std::uint32_t parseEightDigits(const char* const data) {
+    std::uint64_t value;
+    std::memcpy(&value, data, 8);
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    value = __builtin_bswap64(value);
+    #endif
+    /* All bytes have to be in the 0x30 - 0x39 range */
+    if((((value & 0xf0f0f0f0f0f0f0f0ull)|(((value + 0x0606060606060606ull) & 0xf0f0f0f0f0f0f0f0ull) >> 4))) != 0x3333333333333333ull)
+        return ~std::uint32_t{};
+    value = (value & 0x0f0f0f0f0f0f0f0full)*2561 >> 8;
+    value = (value & 0x00ff00ff00ff00ffull)*6553601 >> 16;
+    return std::uint32_t((value & 0x0000ffff0000ffffull)*42949672960001ull >> 32);
+}
+
+/* Accumulates digits starting at i into value, eight at a time where
+   possible. Stops at the first non-digit or once maxDigits are consumed,
+   returns the count of consumed digits. */
+inline std::size_t parseDigits(const char* const data, const std::size_t size, std::size_t i, std::uint64_t& value, const std::size_t maxDigits) {
+    const std::size_t begin = i;
+    while(size - i >= 8 && i - begin + 8 <= maxDigits) {
+        const std::uint32_t eight = parseEightDigits(data + i);
+        if(eight == ~std::uint32_t{}) break;
+        value = value*100000000ull + eight;
+        i += 8;
+    }
+    while(i < size && i - begin < maxDigits && isDigit(data[i])) {
+        value = value*10 + (data[i] - '0');
+        ++i;
+    }
+    return i - begin;
+}
+
+/* The data aren't null-terminated, so the C library functions can't be used
+   on them directly */
+struct NullTerminated {
+    explicit NullTerminated(const Containers::StringView data) {
+        if(data.size() < sizeof(buffer)) {
+            std::memcpy(buffer, data.data(), data.size());
+            buffer[data.size()] = '\0';
+            pointer = buffer;
+        } else {
+            string.assign(data.data(), data.size());
+            pointer = string.data();
+        }
+    }
+
+    char buffer[64];
+    std::string string;
+    const char* pointer;
+};
+
+/* Exactly representable powers of ten and the max mantissa for which the
+   Clinger fast path gives a correctly rounded result */
+template<class> struct FloatTraits;
+template<> struct FloatTraits<float> {
+    enum: std::uint64_t { MaxMantissa = 1ull << 24 };
+    enum: int { MaxExponent = 10 };
+    static float pow10(int exponent) {
+        constexpr float Powers[]{1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+        return Powers[exponent];
+    }
+    static float fallback(const char* data) {
+        return std::strtof(data, nullptr);
+    }
+};
+template<> struct FloatTraits<double> {
+    enum: std::uint64_t { MaxMantissa = 1ull << 53 };
+    enum: int { MaxExponent = 22 };
+    static double pow10(int exponent) {
+        constexpr double Powers[]{1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        return Powers[exponent];
+    }
+    static double fallback(const char* data) {
+        return std::strtod(data, nullptr);
+    }
+};
+
+enum class ParseResult {
+    Success,
+    Invalid,
+    OutOfRange
+};
+
+template<class T> ParseResult parseNumber(const Containers::StringView value, T& out, typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr) {
+    const char* const data = value.data();
+    const std::size_t size = value.size();
+    std::size_t i = 0;
+
+    const bool negative = data[i] == '-';
+    if(data[i] == '-' || data[i] == '+') ++i;
+
+    /* At most 19 digits fit into 64 bits, the rest is counted only to adjust
+       the exponent and to decide whether the fast path can be used */
+    std::uint64_t mantissa = 0;
+    int exponent = 0;
+    std::size_t significantDigits = 0;
+    bool truncated = false;
+
+    std::size_t integerDigits = parseDigits(data, size, i, mantissa, 19);
+    i += integerDigits;
+    if(integerDigits == 19 && i < size && isDigit(data[i])) {
+        truncated = true;
+        while(i < size && isDigit(data[i])) {
+            ++exponent;
+            ++integerDigits;
+            ++i;
+        }
+    }
+    significantDigits = integerDigits < 19 ? integerDigits : 19;
+
+    std::size_t fractionDigits = 0;
+    if(i < size && data[i] == '.') {
+        ++i;
+        if(!truncated) {
+            fractionDigits = parseDigits(data, size, i, mantissa, 19 - significantDigits);
+            i += fractionDigits;
+            exponent -= int(fractionDigits);
+        }
+        while(i < size && isDigit(data[i])) {
+            truncated = true;
+            ++fractionDigits;
+            ++i;
+        }
+    }
+
+    if(!integerDigits && !fractionDigits) return ParseResult::Invalid;
+
+    if(i < size && (data[i] == 'e' || data[i] == 'E')) {
+        ++i;
+        const bool negativeExponent = i < size && data[i] == '-';
+        if(i < size && (data[i] == '-' || data[i] == '+')) ++i;
+        if(i == size || !isDigit(data[i])) return ParseResult::Invalid;
+        int explicitExponent = 0;
+        for(; i < size && isDigit(data[i]); ++i)
+            if(explicitExponent < 100000) explicitExponent = explicitExponent*10 + (data[i] - '0');
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+
+    if(i != size) return ParseResult::Invalid;
+
+    /* Clinger's fast path -- both the mantissa and the power of ten are
+       exactly representable, so a single multiplication or division gives
+       a correctly rounded result */
+    if(!truncated && mantissa <= FloatTraits<T>::MaxMantissa && exponent >= -FloatTraits<T>::MaxExponent && exponent <= FloatTraits<T>::MaxExponent) {
+        T result = T(mantissa);
+        if(exponent < 0) result /= FloatTraits<T>::pow10(-exponent);
+        else result *= FloatTraits<T>::pow10(exponent);
+        out = negative ? -result : result;
+        return ParseResult::Success;
+    }
+
+    out = FloatTraits<T>::fallback(NullTerminated{value}.pointer);
+    return ParseResult::Success;
+}
+
+template<class T> ParseResult parseNumber(const Containers::StringView value, T& out, typename std::enable_if<std::is_integral<T>::value>::type* = nullptr) {
+    const char* const data = value.data();
+    const std::size_t size = value.size();
+    std::size_t i = 0;
+
+    const bool negative = data[i] == '-';
+    if(negative && !std::is_signed<T>::value) return ParseResult::Invalid;
+    if(data[i] == '-' || data[i] == '+') ++i;
+
+    /* Skip leading zeros so they don't count towards the digit limit */
+    const std::size_t begin = i;
+    while(i < size && data[i] == '0') ++i;
+
+    /* Ten digits are enough for 32-bit values, eleven are parsed to detect
+       an overflow in the magnitude check, anything more is an overflow
+       always */
+    std::uint64_t magnitude = 0;
+    i += parseDigits(data, size, i, magnitude, 11);
+    bool overflow = false;
+    for(; i < size && isDigit(data[i]); ++i) overflow = true;
+    if(i == begin || i != size) return ParseResult::Invalid;
+
+    const std::uint64_t max = negative ? std::uint64_t(std::numeric_limits<T>::max()) + 1 : std::uint64_t(std::numeric_limits<T>::max());
+    if(overflow || magnitude > max) return ParseResult::OutOfRange;
+
+    out = negative ? T(0 - magnitude) : T(magnitude);
+    return ParseResult::Success;
+}
+
+template<class T> Containers::Optional<std::size_t> parseNumbersInternal(const Containers::StringView string, const Containers::ArrayView<T> out) {
+    const char* const data = string.data();
+    const std::size_t size = string.size();
+    std::size_t count = 0;
+    std::size_t i = 0;
+    for(;;) {
+        while(i < size && isNumberDelimiter(data[i])) ++i;
+        if(i == size) break;
+
+        const std::size_t begin = i;
+        while(i < size && !isNumberDelimiter(data[i])) ++i;
+        const Containers::StringView value = string.slice(begin, i);
+
+        if(count == out.size()) {
+            Error{} << "Utility::String::parseNumbers(): expected at most" << out.size() << "values";
+            return {};
+        }
+
+        const ParseResult result = parseNumber(value, out[count]);
+        if(result == ParseResult::Invalid) {
+            Error{} << "Utility::String::parseNumbers(): invalid" << (std::is_floating_point<T>::value ? "floating-point" : "integer") << "literal" << value;
+            return {};
+        }
+        if(result == ParseResult::OutOfRange) {
+            Error{} << "Utility::String::parseNumbers(): integer literal" << value << "out of range";
+            return {};
+        }
+        ++count;
+    }
+
+    return count;
+}
+
+}
+
+Containers::Optional<std::size_t> parseNumbers(const Containers::StringView string, const Containers::ArrayView<float> out) {
+    return parseNumbersInternal(string, out);
+}
+
+Containers::Optional<std::size_t> parseNumbers(const Containers::StringView string, const Containers::ArrayView<double> out) {
+    return parseNumbersInternal(string, out);
+}
+
+Containers::Optional<std::size_t> parseNumbers(const Containers::StringView string, const Containers::ArrayView<std::int32_t> out) {
+    return parseNumbersInternal(string, out);
+}
+
+Containers::Optional<std::size_t> parseNumbers(const Containers::StringView string, const Containers::ArrayView<std::uint32_t> out) {
+    return parseNumbersInternal(string, out);
+}
+
+
+namespace {
+
+constexpr char DigitPairs[]{
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899"};
+
+/* Writes digits two at a time from the end of a temporary buffer */
+std::size_t formatUnsigned(char* const out, std::uint64_t value) {
+    char buffer[20];
+    char* const end = buffer + sizeof(buffer);
+    char* begin = end;
+    while(value >= 100) {
+        const std::size_t pair = (value % 100)*2;
+        value /= 100;
+        begin -= 2;
+        begin[0] = DigitPairs[pair];
+        begin[1] = DigitPairs[pair + 1];
+    }
+    if(value >= 10) {
+        begin -= 2;
+        begin[0] = DigitPairs[value*2];
+        begin[1] = DigitPairs[value*2 + 1];
+    } else *--begin = char('0' + value);
+
+    const std::size_t size = end - begin;
+    std::memcpy(out, begin, size);
+    return size;
+}
+
+/* Max size of a formatted value, including the sign. Floats with the
+   default precision are at most `-1.17549e-38`, doubles at most
+   `-2.22507385850720e-308`. */
+template<class> struct FormatTraits;
+template<> struct FormatTraits<float> {
+    enum: std::size_t { MaxSize = 16 };
+    /* Integral values below this are formatted without an exponent */
+    constexpr static float integralMax() { return 1.0e6f; }
+};
+template<> struct FormatTraits<double> {
+    enum: std::size_t { MaxSize = 24 };
+    constexpr static double integralMax() { return 1.0e15; }
+};
+template<> struct FormatTraits<std::int32_t> {
+    enum: std::size_t { MaxSize = 11 };
+};
+template<> struct FormatTraits<std::uint32_t> {
+    enum: std::size_t { MaxSize = 10 };
+};
+
+template<class T> std::size_t formatNumber(char* const out, const T value, typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr) {
+    /* Integral values with less digits than the precision are printed by
+       %g without a decimal point or an exponent, same as integers. That
+       includes a negative zero. */
+    if(std::abs(value) < FormatTraits<T>::integralMax() && T(std::int64_t(value)) == value) {
+        const bool negative = std::signbit(value);
+        if(negative) *out = '-';
+        return std::size_t(negative) + formatUnsigned(out + negative, std::uint64_t(std::abs(std::int64_t(value))));
+    }
+
+    /* Same as Utility::format() does */
+    char buffer[FormatTraits<T>::MaxSize + 1];
+    const int size = std::snprintf(buffer, sizeof(buffer), "%.*g", int(Utility::Implementation::FloatPrecision<T>::Digits), double(value));
+    std::memcpy(out, buffer, size);
+    return size;
+}
+
+template<class T> std::size_t formatNumber(char* const out, const T value, typename std::enable_if<std::is_integral<T>::value>::type* = nullptr) {
+    if(value < 0) {
+        *out = '-';
+        return 1 + formatUnsigned(out + 1, 0 - std::uint64_t(value));
+    }
+    return formatUnsigned(out, std::uint64_t(value));
+}
+
+template<class T> std::size_t formatNumbersIntoInternal(const Containers::MutableStringView buffer, const Containers::ArrayView<const T> values, const char delimiter) {
+    char* const out = buffer.data();
+    std::size_t size = 0;
+    for(std::size_t i = 0; i != values.size(); ++i) {
+        /* If there's enough space for the largest possible value, write
+           directly, otherwise go through a temporary buffer and check */
+        const std::size_t delimiterSize = i ? 1 : 0;
+        if(buffer.size() - size >= delimiterSize + FormatTraits<T>::MaxSize) {
+            if(delimiterSize) out[size++] = delimiter;
+            size += formatNumber(out + size, values[i]);
+            continue;
+        }
+
+        char temporary[FormatTraits<T>::MaxSize];
+        const std::size_t valueSize = formatNumber(temporary, values[i]);
+        CORRADE_ASSERT(buffer.size() - size >= delimiterSize + valueSize,
+            "Utility::String::formatNumbersInto(): buffer too small, expected at least" << size + delimiterSize + valueSize << "bytes but got" << buffer.size(), {});
+        if(delimiterSize) out[size++] = delimiter;
+        std::memcpy(out + size, temporary, valueSize);
+        size += valueSize;
+    }
+
+    return size;
+}
+
+template<class T> Containers::String formatNumbersInternal(const Containers::ArrayView<const T> values, const char delimiter) {
+    Containers::Array<char> out{NoInit, values.size()*(FormatTraits<T>::MaxSize + 1)};
+    const std::size_t size = formatNumbersIntoInternal<T>({out, out.size()}, values, delimiter);
+    return Containers::String{Containers::StringView{out, size}};
+}
+
+}
+
+std::size_t formatNumbersInto(const Containers::MutableStringView buffer, const Containers::ArrayView<const float> values, const char delimiter) {
+    return formatNumbersIntoInternal(buffer, values, delimiter);
+}
+
+std::size_t formatNumbersInto(const Containers::MutableStringView buffer, const Containers::ArrayView<const double> values, const char delimiter) {
+    return formatNumbersIntoInternal(buffer, values, delimiter);
+}
+
+std::size_t formatNumbersInto(const Containers::MutableStringView buffer, const Containers::ArrayView<const std::int32_t> values, const char delimiter) {
+    return formatNumbersIntoInternal(buffer, values, delimiter);
+}
+
+std::size_t formatNumbersInto(const Containers::MutableStringView buffer, const Containers::ArrayView<const std::uint32_t> values, const char delimiter) {
+    return formatNumbersIntoInternal(buffer, values, delimiter);
+}
+
+Containers::String formatNumbers(const Containers::ArrayView<const float> values, const char delimiter) {
+    return formatNumbersInternal(values, delimiter);
+}
+
+Containers::String formatNumbers(const Containers::ArrayView<const double> values, const char delimiter) {
+    return formatNumbersInternal(values, delimiter);
+}
+
+Containers::String formatNumbers(const Containers::ArrayView<const std::int32_t> values, const char delimiter) {
+    return formatNumbersInternal(values, delimiter);
+}
+
+Containers::String formatNumbers(const Containers::ArrayView<const std::uint32_t> values, const char delimiter) {
+    return formatNumbersInternal(values, delimiter);
+}
+
 }}}
@@ -685,6 +685,112 @@ Example usage:
 */
 CORRADE_UTILITY_EXPORT Containers::Optional<Containers::Array<std::uint32_t>> parseNumberSequence(Containers::StringView string, std::uint32_t min, std::uint32_t max);
 
+/**
+@brief Parse delimited numbers into a pre-allocated array
+@return Count of numbers written to @p out
+@m_since_latest
+
+Parses a string containing numbers delimited by commas (`,`), semicolons
+(`;`) or an arbitrary whitespace character, same as
+@ref parseNumberSequence(). Multiple consecutive delimiters are treated as
+one, an empty string results in @cpp 0 @ce returned. Compared to converting
+each value with @ref std::strtof() or @ref std::istringstream, there's no
+null-terminated copy or stream state involved, eight digits at a time are
+converted using SWAR (SIMD within a register) arithmetic, and floating-point
+values with at most 19 significant digits and a small enough exponent are
+converted with an exact fast path, falling back to @ref std::strtof() /
+@ref std::strtod() only for the remaining cases.
+
+Accepted floating-point values are an optional sign, digits with an optional
+decimal point and an optional exponent, with at least one digit before or
+after the decimal point. Integers are an optional sign followed by digits,
+with a @cpp - @ce sign allowed only for signed types. If a value is not valid,
+doesn't fit into the output type or there's more values than the size of
+@p out, the function prints a message to @ref Error and returns
+@relativeref{Corrade,Containers::NullOpt}. The contents of @p out are
+unspecified in that case.
+@see @ref formatNumbersInto()
+*/
+CORRADE_UTILITY_EXPORT Containers::Optional<std::size_t> parseNumbers(Containers::StringView string, Containers::ArrayView<float> out);
+
+/**
+@overload
+@m_since_latest
+*/
+CORRADE_UTILITY_EXPORT Containers::Optional<std::size_t> parseNumbers(Containers::StringView string, Containers::ArrayView<double> out);
+
+/**
+@overload
+@m_since_latest
+*/
+CORRADE_UTILITY_EXPORT Containers::Optional<std::size_t> parseNumbers(Containers::StringView string, Containers::ArrayView<std::int32_t> out);
+
+/**
+@overload
+@m_since_latest
+*/
+CORRADE_UTILITY_EXPORT Containers::Optional<std::size_t> parseNumbers(Containers::StringView string, Containers::ArrayView<std::uint32_t> out);
+
+/**
+@brief Format numbers into a delimited string
+@return Count of bytes written to @p buffer
+@m_since_latest
+
+Writes @p values separated by @p delimiter to @p buffer, without a trailing
+delimiter and without a null terminator. The output is the same as with
+@ref Utility::format() with the default precision for each value, but
+integers and integral floating-point values are written directly using a
+digit lookup table instead of going through @ref std::snprintf(). Expects
+that @p buffer is large enough.
+@see @ref formatNumbers(), @ref parseNumbers()
+*/
+CORRADE_UTILITY_EXPORT std::size_t formatNumbersInto(Containers::MutableStringView buffer, Containers::ArrayView<const float> values, char delimiter = ' ');
+
+/**
+@overload
+@m_since_latest
+*/
+CORRADE_UTILITY_EXPORT std::size_t formatNumbersInto(Containers::MutableStringView buffer, Containers::ArrayView<const double> values, char delimiter = ' ');
+
+/**
+@overload
+@m_since_latest
+*/
+CORRADE_UTILITY_EXPORT std::size_t formatNumbersInto(Containers::MutableStringView buffer, Containers::ArrayView<const std::int32_t> values, char delimiter = ' ');
+
+/**
+@overload
+@m_since_latest
+*/
+CORRADE_UTILITY_EXPORT std::size_t formatNumbersInto(Containers::MutableStringView buffer, Containers::ArrayView<const std::uint32_t> values, char delimiter = ' ');
+
+/**
+@brief Format numbers into a delimited string
+@m_since_latest
+
+Like @ref formatNumbersInto(), but allocates a string large enough for the
+output.
+*/
+CORRADE_UTILITY_EXPORT Containers::String formatNumbers(Containers::ArrayView<const float> values, char delimiter = ' ');
+
+/**
+@overload
+@m_since_latest
+*/
+CORRADE_UTILITY_EXPORT Containers::String formatNumbers(Containers::ArrayView<const double> values, char delimiter = ' ');
+
+/**
+@overload
+@m_since_latest
+*/
+CORRADE_UTILITY_EXPORT Containers::String formatNumbers(Containers::ArrayView<const std::int32_t> values, char delimiter = ' ');
+
+/**
+@overload
+@m_since_latest
+*/
+CORRADE_UTILITY_EXPORT Containers::String formatNumbers(Containers::ArrayView<const std::uint32_t> values, char delimiter = ' ');
+
 }}}
 
 #endif
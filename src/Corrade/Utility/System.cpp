@@ -26,10 +26,37 @@
 
 #include "System.h"
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Containers/StringView.h"
+#include "Corrade/Utility/Debug.h"
+
 #ifndef CORRADE_TARGET_WINDOWS
 #include "unistd.h"
 #else
 #include <windows.h>
+#include "Corrade/Utility/Unicode.h"
+#include "Corrade/Utility/Implementation/WindowsError.h"
+#endif
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h> /* SYS_gettid */
+#endif
+
+#ifdef CORRADE_TARGET_APPLE
+#include <pthread.h>
+#include <sys/sysctl.h>
+#include <sys/types.h>
 #endif
 
 namespace Corrade { namespace Utility { namespace System {
@@ -42,4 +69,353 @@ void sleep(const std::size_t ms) {
     #endif
 }
 
+namespace {
+
+#ifdef __linux__
+/* Returns an empty string if the file doesn't exist. Files in /sys report
+   a size of 4096 regardless of the contents, so it's read in a loop until the
+   end. */
+std::string readSysFile(const std::string& filename) {
+    std::FILE* const f = std::fopen(filename.data(), "rb");
+    if(!f) return {};
+
+    std::string out;
+    char buffer[4096];
+    std::size_t size;
+    while((size = std::fread(buffer, 1, sizeof(buffer), f)))
+        out.append(buffer, size);
+    std::fclose(f);
+
+    /* Drop the trailing newline */
+    while(!out.empty() && (out.back() == '\n' || out.back() == ' '))
+        out.pop_back();
+    return out;
+}
+
+/* Parses a list in the format of "0-3,8,10-11" as used for CPU and node
+   lists in /sys. Returns false if the list is malformed. */
+bool parseCpuList(const std::string& list, Containers::Array<unsigned int>& out) {
+    const char* i = list.data();
+    const char* const end = list.data() + list.size();
+    while(i < end) {
+        char* next;
+        const unsigned long first = std::strtoul(i, &next, 10);
+        if(next == i) return false;
+        unsigned long last = first;
+        if(next != end && *next == '-') {
+            i = next + 1;
+            last = std::strtoul(i, &next, 10);
+            if(next == i || last < first) return false;
+        }
+        for(unsigned long cpu = first; cpu <= last; ++cpu)
+            arrayAppend(out, static_cast<unsigned int>(cpu));
+
+        if(next != end && *next != ',') return false;
+        i = next + 1;
+    }
+    return true;
+}
+
+Containers::Array<unsigned int> onlineCpus() {
+    Containers::Array<unsigned int> out;
+    parseCpuList(readSysFile("/sys/devices/system/cpu/online"), out);
+    return out;
+}
+#endif
+
+#if defined(CORRADE_TARGET_APPLE)
+std::size_t sysctlValue(const char* name) {
+    std::int64_t value = 0;
+    std::size_t size = sizeof(value);
+    if(sysctlbyname(name, &value, &size, nullptr, 0) != 0) return 0;
+    /* Some of the values are 32-bit */
+    if(size == sizeof(std::int32_t)) return std::int32_t(value);
+    return std::size_t(value);
+}
+#elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> logicalProcessorInformation() {
+    DWORD size = 0;
+    GetLogicalProcessorInformation(nullptr, &size);
+    std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> out(size/sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+    if(out.empty() || !GetLogicalProcessorInformation(out.data(), &size))
+        return {};
+    out.resize(size/sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+    return out;
+}
+#endif
+
+}
+
+std::size_t logicalCoreCount() {
+    #if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    const long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? count : 1;
+    #elif defined(CORRADE_TARGET_WINDOWS)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors ? info.dwNumberOfProcessors : 1;
+    #else
+    return 1;
+    #endif
+}
+
+std::size_t physicalCoreCount() {
+    const std::size_t logical = logicalCoreCount();
+
+    #ifdef __linux__
+    /* Cores are identified by a package and core ID pair, hardware threads of
+       the same core share it */
+    std::vector<std::pair<std::string, std::string>> cores;
+    for(const unsigned int cpu: onlineCpus()) {
+        const std::string prefix = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+        std::string coreId = readSysFile(prefix + "core_id");
+        if(coreId.empty()) return logical;
+        cores.emplace_back(readSysFile(prefix + "physical_package_id"), std::move(coreId));
+    }
+    std::sort(cores.begin(), cores.end());
+    const std::size_t count = std::unique(cores.begin(), cores.end()) - cores.begin();
+    #elif defined(CORRADE_TARGET_APPLE)
+    const std::size_t count = sysctlValue("hw.physicalcpu");
+    #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+    std::size_t count = 0;
+    for(const SYSTEM_LOGICAL_PROCESSOR_INFORMATION& info: logicalProcessorInformation())
+        if(info.Relationship == RelationProcessorCore) ++count;
+    #else
+    const std::size_t count = 0;
+    #endif
+
+    return count && count <= logical ? count : logical;
+}
+
+std::size_t cacheSize(const unsigned int level) {
+    #ifdef __linux__
+    for(std::size_t i = 0; ; ++i) {
+        const std::string prefix = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(i) + "/";
+        const std::string cacheLevel = readSysFile(prefix + "level");
+        if(cacheLevel.empty()) return 0;
+        if(std::strtoul(cacheLevel.data(), nullptr, 10) != level ||
+           readSysFile(prefix + "type") == "Instruction")
+            continue;
+
+        /* The size is in the form of 32K, 8192K or 4M */
+        const std::string size = readSysFile(prefix + "size");
+        char* end;
+        std::size_t out = std::strtoul(size.data(), &end, 10);
+        if(*end == 'K') out *= 1024;
+        else if(*end == 'M') out *= 1024*1024;
+        return out;
+    }
+    #elif defined(CORRADE_TARGET_APPLE)
+    if(level == 1) return sysctlValue("hw.l1dcachesize");
+    if(level == 2) return sysctlValue("hw.l2cachesize");
+    if(level == 3) return sysctlValue("hw.l3cachesize");
+    return 0;
+    #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+    for(const SYSTEM_LOGICAL_PROCESSOR_INFORMATION& info: logicalProcessorInformation()) {
+        if(info.Relationship != RelationCache || info.Cache.Level != level ||
+           info.Cache.Type == CacheInstruction)
+            continue;
+        return info.Cache.Size;
+    }
+    return 0;
+    #else
+    static_cast<void>(level);
+    return 0;
+    #endif
+}
+
+std::size_t numaNodeCount() {
+    #ifdef __linux__
+    Containers::Array<unsigned int> nodes;
+    if(!parseCpuList(readSysFile("/sys/devices/system/node/online"), nodes) || nodes.empty())
+        return 1;
+    return nodes.back() + 1;
+    #else
+    return 1;
+    #endif
+}
+
+Containers::Array<unsigned int> numaNodeCpus(const unsigned int node) {
+    Containers::Array<unsigned int> out;
+
+    #ifdef __linux__
+    /* Machines without NUMA support don't have the /sys/devices/system/node
+       directory at all, treat them as a single node */
+    if(node == 0 && readSysFile("/sys/devices/system/node/online").empty())
+        return onlineCpus();
+
+    const std::string list = readSysFile("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    if(list.empty() || !parseCpuList(list, out)) {
+        Error{} << "Utility::System::numaNodeCpus(): can't read CPUs of node" << node;
+        return {};
+    }
+    #else
+    if(node != 0) {
+        Error{} << "Utility::System::numaNodeCpus(): can't read CPUs of node" << node;
+        return {};
+    }
+    for(std::size_t i = 0, count = logicalCoreCount(); i != count; ++i)
+        arrayAppend(out, static_cast<unsigned int>(i));
+    #endif
+
+    /* Convert back to a default deleter */
+    arrayShrink(out);
+    return out;
+}
+
+bool setThreadAffinity(const Containers::ArrayView<const unsigned int> cpus) {
+    if(cpus.empty()) {
+        Error{} << "Utility::System::setThreadAffinity(): expected at least one CPU";
+        return false;
+    }
+
+    #ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for(const unsigned int cpu: cpus) {
+        if(cpu >= CPU_SETSIZE) {
+            Error{} << "Utility::System::setThreadAffinity(): CPU" << cpu << "out of range for" << CPU_SETSIZE << "CPUs";
+            return false;
+        }
+        CPU_SET(cpu, &set);
+    }
+    /* Not using pthread_setaffinity_np() as it's not available on Android.
+       On Linux, PID 0 refers to the calling thread, not the whole process. */
+    if(sched_setaffinity(0, sizeof(set), &set) != 0) {
+        Error{} << "Utility::System::setThreadAffinity(): error:" << std::strerror(errno);
+        return false;
+    }
+    return true;
+    #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+    DWORD_PTR mask = 0;
+    for(const unsigned int cpu: cpus) {
+        if(cpu >= sizeof(DWORD_PTR)*8) {
+            Error{} << "Utility::System::setThreadAffinity(): CPU" << cpu << "out of range for" << sizeof(DWORD_PTR)*8 << "CPUs";
+            return false;
+        }
+        mask |= DWORD_PTR(1) << cpu;
+    }
+    if(!SetThreadAffinityMask(GetCurrentThread(), mask)) {
+        Error{} << "Utility::System::setThreadAffinity(): error:" << Implementation::windowsErrorString(GetLastError());
+        return false;
+    }
+    return true;
+    #else
+    Error{} << "Utility::System::setThreadAffinity(): not implemented on this platform";
+    return false;
+    #endif
+}
+
+Containers::Array<unsigned int> threadAffinity() {
+    #ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    /* Same as in setThreadAffinity(), pthread_getaffinity_np() isn't
+       available on Android */
+    if(sched_getaffinity(0, sizeof(set), &set) != 0) {
+        Error{} << "Utility::System::threadAffinity(): error:" << std::strerror(errno);
+        return {};
+    }
+
+    Containers::Array<unsigned int> out;
+    for(unsigned int cpu = 0; cpu != CPU_SETSIZE; ++cpu)
+        if(CPU_ISSET(cpu, &set)) arrayAppend(out, cpu);
+
+    /* Convert back to a default deleter */
+    arrayShrink(out);
+    return out;
+    #else
+    Error{} << "Utility::System::threadAffinity(): not implemented on this platform";
+    return {};
+    #endif
+}
+
+bool setThreadName(const Containers::StringView name) {
+    #if defined(__linux__) || defined(CORRADE_TARGET_APPLE)
+    /* The name has to be null-terminated. The limit on Linux is 16 bytes
+       including the null terminator, Apple allows 64. */
+    char buffer[64];
+    #ifdef __linux__
+    const std::size_t size = std::min(name.size(), std::size_t(15));
+    #else
+    const std::size_t size = std::min(name.size(), sizeof(buffer) - 1);
+    #endif
+    std::memcpy(buffer, name.data(), size);
+    buffer[size] = '\0';
+
+    #ifdef __linux__
+    if(const int error = pthread_setname_np(pthread_self(), buffer))
+    #else
+    if(const int error = pthread_setname_np(buffer))
+    #endif
+    {
+        Error{} << "Utility::System::setThreadName(): error:" << std::strerror(error);
+        return false;
+    }
+    return true;
+    #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+    /* Available only since Windows 10 1607, so it has to be queried at
+       runtime */
+    typedef HRESULT(WINAPI *SetThreadDescriptionFunction)(HANDLE, PCWSTR);
+    const auto setThreadDescription = reinterpret_cast<SetThreadDescriptionFunction>(reinterpret_cast<void*>(GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "SetThreadDescription")));
+    if(!setThreadDescription) {
+        Error{} << "Utility::System::setThreadName(): not supported on this Windows version";
+        return false;
+    }
+    const HRESULT result = setThreadDescription(GetCurrentThread(), Unicode::widen(Containers::ArrayView<const char>{name.data(), name.size()}).data());
+    if(FAILED(result)) {
+        Error{} << "Utility::System::setThreadName(): error:" << Implementation::windowsErrorString(result);
+        return false;
+    }
+    return true;
+    #else
+    static_cast<void>(name);
+    Error{} << "Utility::System::setThreadName(): not implemented on this platform";
+    return false;
+    #endif
+}
+
+bool setThreadPriority(const ThreadPriority priority) {
+    #ifdef __linux__
+    /* On Linux, the nice value is per-thread */
+    int nice = 0;
+    if(priority == ThreadPriority::Low) nice = 10;
+    else if(priority == ThreadPriority::High) nice = -10;
+    if(setpriority(PRIO_PROCESS, syscall(SYS_gettid), nice) != 0) {
+        Error{} << "Utility::System::setThreadPriority(): can't set" << priority << Debug::nospace << ":" << std::strerror(errno);
+        return false;
+    }
+    return true;
+    #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+    int value = THREAD_PRIORITY_NORMAL;
+    if(priority == ThreadPriority::Low) value = THREAD_PRIORITY_BELOW_NORMAL;
+    else if(priority == ThreadPriority::High) value = THREAD_PRIORITY_ABOVE_NORMAL;
+    if(!SetThreadPriority(GetCurrentThread(), value)) {
+        Error{} << "Utility::System::setThreadPriority(): can't set" << priority << Debug::nospace << ":" << Implementation::windowsErrorString(GetLastError());
+        return false;
+    }
+    return true;
+    #else
+    static_cast<void>(priority);
+    Error{} << "Utility::System::setThreadPriority(): not implemented on this platform";
+    return false;
+    #endif
+}
+
+Debug& operator<<(Debug& debug, const ThreadPriority value) {
+    debug << "Utility::System::ThreadPriority" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case ThreadPriority::value: return debug << "::" #value;
+        _c(Low)
+        _c(Normal)
+        _c(High)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(std::uint8_t(value)) << Debug::nospace << ")";
+}
+
 }}}
@@ -31,7 +31,10 @@
  */
 
 #include <cstddef>
+#include <cstdint>
 
+#include "Corrade/Containers/Containers.h"
+#include "Corrade/Utility/Utility.h"
 #include "Corrade/Utility/visibility.h"
 
 namespace Corrade { namespace Utility {
@@ -51,12 +54,152 @@ target_link_libraries(your-app PRIVATE Corrade::Utility)
 @endcode
 
 See also @ref building-corrade and @ref corrade-cmake for more information.
+
+@section Utility-System-topology CPU topology and thread placement
+
+The @ref logicalCoreCount(), @ref physicalCoreCount(), @ref cacheSize(),
+@ref numaNodeCount() and @ref numaNodeCpus() functions describe the machine the
+code runs on, while @ref setThreadAffinity(), @ref threadAffinity(),
+@ref setThreadName() and @ref setThreadPriority() allow placing work of the
+current thread deliberately. For example, pinning a worker thread to all CPUs
+of the first NUMA node:
+
+@snippet Utility.cpp System-setThreadAffinity
+
+On Linux the topology is queried from `/sys/devices/system/cpu` and
+`/sys/devices/system/node`. If the information isn't available on given
+platform, the machine queries fall back to reasonable defaults. The thread
+functions, on the other hand, print a message to @ref Error and return
+@cpp false @ce or an empty array on platforms where they aren't implemented.
+See the documentation of each function for details.
 */
 namespace System {
 
 /** @brief Sleep for given time */
 CORRADE_UTILITY_EXPORT void sleep(std::size_t ms);
 
+/**
+@brief Count of logical cores
+@m_since_latest
+
+Includes all hardware threads on cores with SMT. Always at least
+@cpp 1 @ce.
+@see @ref physicalCoreCount()
+*/
+CORRADE_UTILITY_EXPORT std::size_t logicalCoreCount();
+
+/**
+@brief Count of physical cores
+@m_since_latest
+
+Counts each core with multiple hardware threads just once. Always at least
+@cpp 1 @ce and never more than @ref logicalCoreCount(). If the information
+isn't available, returns @ref logicalCoreCount().
+*/
+CORRADE_UTILITY_EXPORT std::size_t physicalCoreCount();
+
+/**
+@brief Data cache size
+@m_since_latest
+
+Returns size in bytes of the data or unified cache of given @p level (with
+@cpp 1 @ce being the L1 cache) that belongs to the first CPU. If there's no
+cache of given level or the information isn't available, returns @cpp 0 @ce.
+*/
+CORRADE_UTILITY_EXPORT std::size_t cacheSize(unsigned int level);
+
+/**
+@brief Count of NUMA nodes
+@m_since_latest
+
+Always at least @cpp 1 @ce. Implemented only on Linux, on other platforms
+returns @cpp 1 @ce.
+@see @ref numaNodeCpus()
+*/
+CORRADE_UTILITY_EXPORT std::size_t numaNodeCount();
+
+/**
+@brief CPUs belonging to a NUMA node
+@m_since_latest
+
+Returns indices of logical cores in given @p node, which is expected to be
+less than @ref numaNodeCount(). On a failure prints a message to
+@ref Error and returns an empty array. On platforms other than Linux returns
+all logical cores for node @cpp 0 @ce.
+@see @ref setThreadAffinity()
+*/
+CORRADE_UTILITY_EXPORT Containers::Array<unsigned int> numaNodeCpus(unsigned int node);
+
+/**
+@brief Set affinity of the current thread
+@m_since_latest
+
+Restricts the current thread to run only on logical cores listed in @p cpus,
+which is expected to be non-empty. Returns @cpp false @ce and prints a
+message to @ref Error if the operation fails. Implemented on Linux and Windows,
+where on the latter only the first 64 logical cores can be used; on other
+platforms prints a message to @ref Error and returns @cpp false @ce.
+@see @ref threadAffinity(), @ref numaNodeCpus()
+*/
+CORRADE_UTILITY_EXPORT bool setThreadAffinity(Containers::ArrayView<const unsigned int> cpus);
+
+/**
+@brief Affinity of the current thread
+@m_since_latest
+
+Returns indices of logical cores the current thread is allowed to run on. On
+a failure prints a message to @ref Error and returns an empty array.
+Implemented on Linux only, on other platforms prints a message to
+@ref Error and returns an empty array.
+@see @ref setThreadAffinity()
+*/
+CORRADE_UTILITY_EXPORT Containers::Array<unsigned int> threadAffinity();
+
+/**
+@brief Set name of the current thread
+@m_since_latest
+
+The name is shown in debuggers and profilers. On Linux the name is truncated
+to 15 bytes, which is the system limit. Returns @cpp false @ce and prints a
+message to @ref Error if the operation fails. Implemented on Linux, Apple
+platforms and Windows 10 1607+, on other platforms prints a message to
+@ref Error and returns @cpp false @ce.
+*/
+CORRADE_UTILITY_EXPORT bool setThreadName(Containers::StringView name);
+
+/**
+@brief Thread priority
+@m_since_latest
+
+@see @ref setThreadPriority()
+*/
+enum class ThreadPriority: std::uint8_t {
+    Low,        /**< Lower than default */
+    Normal,     /**< Default */
+    High        /**< Higher than default */
+};
+
+/**
+@debugoperatorenum{ThreadPriority}
+@m_since_latest
+*/
+CORRADE_UTILITY_EXPORT Debug& operator<<(Debug& debug, ThreadPriority value);
+
+/**
+@brief Set priority of the current thread
+@m_since_latest
+
+On Linux maps to a nice value of @cpp 10 @ce, @cpp 0 @ce and @cpp -10 @ce
+for the current thread, on Windows to @cpp THREAD_PRIORITY_BELOW_NORMAL @ce,
+@cpp THREAD_PRIORITY_NORMAL @ce and @cpp THREAD_PRIORITY_ABOVE_NORMAL @ce.
+Note that on Linux raising the priority usually requires elevated
+privileges, and once lowered, the priority can't be raised back without them
+either. Returns @cpp false @ce and prints a message to @ref Error if the
+operation fails. On other platforms prints a message to @ref Error and returns
+@cpp false @ce.
+*/
+CORRADE_UTILITY_EXPORT bool setThreadPriority(ThreadPriority priority);
+
 }}}
 
 #endif
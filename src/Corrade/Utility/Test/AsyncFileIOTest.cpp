@@ -0,0 +1,276 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/StringStl.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/FileToString.h"
+#include "Corrade/Utility/AsyncFileIO.h"
+#include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/Directory.h"
+#include "Corrade/Utility/FormatStl.h"
+
+#include "configure.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct AsyncFileIOTest: TestSuite::Tester {
+    explicit AsyncFileIOTest();
+
+    void construct();
+    void constructMove();
+
+    void readWrite();
+    void readEmpty();
+    void readNonexistent();
+    void writeNoPermission();
+    void submitMultipleTimes();
+    void waitEmpty();
+    void destructWithPending();
+
+    void debugBackend();
+};
+
+const struct {
+    const char* name;
+    AsyncFileIO::Backend backend;
+} BackendData[]{
+    {"io_uring", AsyncFileIO::Backend::IoUring},
+    {"thread pool", AsyncFileIO::Backend::ThreadPool}
+};
+
+AsyncFileIOTest::AsyncFileIOTest() {
+    addInstancedTests({&AsyncFileIOTest::construct,
+                       &AsyncFileIOTest::constructMove,
+
+                       &AsyncFileIOTest::readWrite,
+                       &AsyncFileIOTest::readEmpty,
+                       &AsyncFileIOTest::readNonexistent,
+                       &AsyncFileIOTest::writeNoPermission,
+                       &AsyncFileIOTest::submitMultipleTimes,
+                       &AsyncFileIOTest::waitEmpty,
+                       &AsyncFileIOTest::destructWithPending},
+        Containers::arraySize(BackendData));
+
+    addTests({&AsyncFileIOTest::debugBackend});
+
+    Directory::mkpath(ASYNCFILEIO_WRITE_TEST_DIR);
+}
+
+void AsyncFileIOTest::construct() {
+    auto&& data = BackendData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    AsyncFileIO io{data.backend, 16};
+    /* io_uring may not be available, in which case it falls back */
+    if(data.backend == AsyncFileIO::Backend::ThreadPool)
+        CORRADE_COMPARE(io.backend(), AsyncFileIO::Backend::ThreadPool);
+    CORRADE_COMPARE(io.queueSize(), 16);
+    CORRADE_COMPARE(io.operationCount(), 0);
+
+    if(io.backend() != data.backend)
+        CORRADE_SKIP("io_uring not available, using" << io.backend() << "instead.");
+}
+
+void AsyncFileIOTest::constructMove() {
+    auto&& data = BackendData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<char> out;
+    AsyncFileIO a{data.backend, 16};
+    const AsyncFileIO::Backend backend = a.backend();
+    a.write(Directory::join(ASYNCFILEIO_WRITE_TEST_DIR, "move.txt"), Containers::arrayView("hello", 5));
+    a.submit();
+
+    AsyncFileIO b = std::move(a);
+    CORRADE_COMPARE(b.backend(), backend);
+    CORRADE_COMPARE(b.queueSize(), 16);
+    CORRADE_COMPARE(b.operationCount(), 1);
+
+    AsyncFileIO c{data.backend, 4};
+    c = std::move(b);
+    CORRADE_COMPARE(c.queueSize(), 16);
+    CORRADE_COMPARE(c.operationCount(), 1);
+
+    CORRADE_VERIFY(c.wait());
+    CORRADE_COMPARE_AS(Directory::join(ASYNCFILEIO_WRITE_TEST_DIR, "move.txt"),
+        "hello", TestSuite::Compare::FileToString);
+}
+
+void AsyncFileIOTest::readWrite() {
+    auto&& data = BackendData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Queue size smaller than the file count to verify the operations get
+       refilled as the previous ones finish */
+    AsyncFileIO io{data.backend, 4};
+
+    /* One of the files is large to exercise partial reads and writes */
+    std::string contents[17];
+    for(std::size_t i = 0; i != Containers::arraySize(contents); ++i)
+        contents[i] = formatString("file {} contents", i);
+    contents[7] = std::string(3*1024*1024 + 17, 'a');
+    for(std::size_t i = 0; i < contents[7].size(); i += 4096)
+        contents[7][i] = 'b';
+
+    for(std::size_t i = 0; i != Containers::arraySize(contents); ++i)
+        io.write(Directory::join(ASYNCFILEIO_WRITE_TEST_DIR, formatString("{}.txt", i)), Containers::arrayView(contents[i].data(), contents[i].size()));
+    CORRADE_COMPARE(io.operationCount(), 17);
+    CORRADE_VERIFY(io.wait());
+    CORRADE_COMPARE(io.operationCount(), 0);
+
+    for(std::size_t i = 0; i != Containers::arraySize(contents); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_AS(Directory::join(ASYNCFILEIO_WRITE_TEST_DIR, formatString("{}.txt", i)),
+            contents[i], TestSuite::Compare::FileToString);
+    }
+
+    Containers::Array<char> out[17];
+    for(std::size_t i = 0; i != Containers::arraySize(contents); ++i)
+        io.read(Directory::join(ASYNCFILEIO_WRITE_TEST_DIR, formatString("{}.txt", i)), out[i]);
+    CORRADE_VERIFY(io.wait());
+
+    for(std::size_t i = 0; i != Containers::arraySize(contents); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE((Containers::StringView{out[i].data(), out[i].size()}), contents[i]);
+    }
+}
+
+void AsyncFileIOTest::readEmpty() {
+    auto&& data = BackendData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const std::string filename = Directory::join(ASYNCFILEIO_WRITE_TEST_DIR, "empty.txt");
+    CORRADE_VERIFY(Directory::writeString(filename, ""));
+
+    Containers::Array<char> out{3};
+    AsyncFileIO io{data.backend};
+    io.read(filename, out);
+    CORRADE_VERIFY(io.wait());
+    CORRADE_COMPARE(out.size(), 0);
+}
+
+void AsyncFileIOTest::readNonexistent() {
+    auto&& data = BackendData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const std::string filename = Directory::join(ASYNCFILEIO_WRITE_TEST_DIR, "existent.txt");
+    CORRADE_VERIFY(Directory::writeString(filename, "hello"));
+
+    Containers::Array<char> a{3}, b;
+    AsyncFileIO io{data.backend};
+    io.read("nonexistent", a);
+    io.read(filename, b);
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!io.wait());
+    }
+    CORRADE_COMPARE(out.str(), "Utility::AsyncFileIO::wait(): can't read nonexistent: No such file or directory\n");
+
+    /* The failed output is left untouched, the other one is read */
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE((Containers::StringView{b.data(), b.size()}), "hello");
+}
+
+void AsyncFileIOTest::writeNoPermission() {
+    auto&& data = BackendData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(Directory::home() == "/root")
+        CORRADE_SKIP("Running under root, can't test for permissions.");
+
+    AsyncFileIO io{data.backend};
+    io.write("/root/writtenFile", Containers::arrayView("hello", 5));
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!io.wait());
+    }
+    CORRADE_COMPARE(out.str(), "Utility::AsyncFileIO::wait(): can't write /root/writtenFile: Permission denied\n");
+}
+
+void AsyncFileIOTest::submitMultipleTimes() {
+    auto&& data = BackendData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const std::string a = Directory::join(ASYNCFILEIO_WRITE_TEST_DIR, "a.txt");
+    const std::string b = Directory::join(ASYNCFILEIO_WRITE_TEST_DIR, "b.txt");
+    CORRADE_VERIFY(Directory::writeString(a, "first"));
+    CORRADE_VERIFY(Directory::writeString(b, "second"));
+
+    Containers::Array<char> outA, outB;
+    AsyncFileIO io{data.backend};
+    io.read(a, outA);
+    io.submit();
+    io.read(b, outB);
+    CORRADE_COMPARE(io.operationCount(), 2);
+    io.submit();
+    CORRADE_VERIFY(io.wait());
+    CORRADE_COMPARE((Containers::StringView{outA.data(), outA.size()}), "first");
+    CORRADE_COMPARE((Containers::StringView{outB.data(), outB.size()}), "second");
+}
+
+void AsyncFileIOTest::waitEmpty() {
+    auto&& data = BackendData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    AsyncFileIO io{data.backend};
+    io.submit();
+    CORRADE_VERIFY(io.wait());
+}
+
+void AsyncFileIOTest::destructWithPending() {
+    auto&& data = BackendData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const std::string filename = Directory::join(ASYNCFILEIO_WRITE_TEST_DIR, "pending.txt");
+    if(Directory::exists(filename)) CORRADE_VERIFY(Directory::rm(filename));
+
+    {
+        AsyncFileIO io{data.backend};
+        io.write(filename, Containers::arrayView("pending", 7));
+        io.submit();
+    }
+
+    /* The destructor waited for the operation to finish */
+    CORRADE_COMPARE_AS(filename, "pending",
+        TestSuite::Compare::FileToString);
+}
+
+void AsyncFileIOTest::debugBackend() {
+    std::ostringstream out;
+    Debug{&out} << AsyncFileIO::Backend::ThreadPool << AsyncFileIO::Backend(0xf0);
+    CORRADE_COMPARE(out.str(), "Utility::AsyncFileIO::Backend::ThreadPool Utility::AsyncFileIO::Backend(0xf0)\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::AsyncFileIOTest)
@@ -24,6 +24,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -32,6 +33,8 @@
 #include "Corrade/Containers/GrowableArray.h"
 #include "Corrade/Containers/Pair.h"
 #include "Corrade/Containers/Reference.h"
+#include "Corrade/Containers/String.h"
+#include "Corrade/Containers/StringStl.h"
 #include "Corrade/TestSuite/Tester.h"
 #include "Corrade/TestSuite/Compare/Container.h"
 #include "Corrade/TestSuite/Compare/File.h"
@@ -57,9 +60,13 @@ struct ConfigurationTest: TestSuite::Tester {
     void parseHierarchicEmptySubgroup();
     void parseHierarchicMissingBracket();
     void utf8Filename();
+    void parseParallel();
+    void parseParallelError();
 
     void groupIndex();
     void valueIndex();
+    void valueView();
+    void stringViewKeys();
 
     void names();
 
@@ -74,6 +81,12 @@ struct ConfigurationTest: TestSuite::Tester {
 
     void multiLineValue();
     void multiLineValueCrlf();
+    void saveToString();
+
+    void reload();
+    void reloadNonexistent();
+    void reloadInvalid();
+    void reloadNoFilename();
 
     void standaloneGroup();
     void copy();
@@ -87,6 +100,8 @@ struct ConfigurationTest: TestSuite::Tester {
     void iterateValuesRangeFor();
     void iterateValuesEmpty();
     void iterateValuesCommentsOnly();
+
+    void debugChangeType();
 };
 
 using namespace Containers::Literals;
@@ -102,9 +117,13 @@ ConfigurationTest::ConfigurationTest() {
               &ConfigurationTest::parseHierarchicEmptySubgroup,
               &ConfigurationTest::parseHierarchicMissingBracket,
               &ConfigurationTest::utf8Filename,
+              &ConfigurationTest::parseParallel,
+              &ConfigurationTest::parseParallelError,
 
               &ConfigurationTest::groupIndex,
               &ConfigurationTest::valueIndex,
+              &ConfigurationTest::valueView,
+              &ConfigurationTest::stringViewKeys,
 
               &ConfigurationTest::names,
 
@@ -119,6 +138,12 @@ ConfigurationTest::ConfigurationTest() {
 
               &ConfigurationTest::multiLineValue,
               &ConfigurationTest::multiLineValueCrlf,
+              &ConfigurationTest::saveToString,
+
+              &ConfigurationTest::reload,
+              &ConfigurationTest::reloadNonexistent,
+              &ConfigurationTest::reloadInvalid,
+              &ConfigurationTest::reloadNoFilename,
 
               &ConfigurationTest::standaloneGroup,
               &ConfigurationTest::copy,
@@ -131,7 +156,9 @@ ConfigurationTest::ConfigurationTest() {
               &ConfigurationTest::iterateValues,
               &ConfigurationTest::iterateValuesRangeFor,
               &ConfigurationTest::iterateValuesEmpty,
-              &ConfigurationTest::iterateValuesCommentsOnly});
+              &ConfigurationTest::iterateValuesCommentsOnly,
+
+              &ConfigurationTest::debugChangeType});
 
     /* Create testing dir */
     Directory::mkpath(CONFIGURATION_WRITE_TEST_DIR);
@@ -338,6 +365,85 @@ void ConfigurationTest::utf8Filename() {
                        TestSuite::Compare::File);
 }
 
+void ConfigurationTest::parseParallel() {
+    /* Generate a file large enough to be split into multiple pieces, with
+       root values, empty lines and comments at the end of groups, multi-line
+       values containing things that look like group headers, hierarchic
+       shorthands spanning multiple headers and repeated group names */
+    std::string data =
+        "# root comment\n"
+        "root=value\n"
+        "\n";
+    for(std::size_t i = 0; i != 5000; ++i) {
+        const std::string number = std::to_string(i);
+        data += "[group" + number + "]\n"
+            "key=value" + number + "\n"
+            "multiline=\"\"\"\n"
+            "[notAGroup" + number + "]\n"
+            "  indented\n"
+            "\"\"\"\n"
+            "[group" + number + "/sub]\n"
+            "# comment\n"
+            "quoted=\"  spaces  \"\n"
+            "[group" + number + "/sub/deeper]\n"
+            "[group" + number + "/another]\n"
+            "key=another\n"
+            "\n"
+            "[repeated]\n"
+            "index=" + number + "\n"
+            "\n";
+    }
+    data += "[last/shorthand]\nkey=last\n";
+    /* Should be split into at least three pieces */
+    CORRADE_VERIFY(data.size() > 3*256*1024);
+
+    const std::string filename = Directory::join(CONFIGURATION_WRITE_TEST_DIR, "parallel.conf");
+    CORRADE_VERIFY(Directory::writeString(filename, data));
+
+    Configuration sequential{filename, Configuration::Flag::ReadOnly};
+    Configuration parallel{filename, Configuration::Flag::ReadOnly|Configuration::Flag::ParallelParse};
+    CORRADE_VERIFY(sequential.isValid());
+    CORRADE_VERIFY(parallel.isValid());
+
+    CORRADE_COMPARE(parallel.value("root"), "value");
+    CORRADE_COMPARE(parallel.groupCount(), 10001);
+    CORRADE_COMPARE(parallel.groupCount("repeated"), 5000);
+    CORRADE_COMPARE(parallel.group("repeated", 4999)->value("index"), "4999");
+    CORRADE_COMPARE(parallel.group("group2500")->value("multiline"), "[notAGroup2500]\n  indented");
+    CORRADE_COMPARE(parallel.group("group2500")->groupCount(), 2);
+    CORRADE_VERIFY(parallel.group("group2500")->group("sub")->hasGroup("deeper"));
+    CORRADE_COMPARE(parallel.group("last")->group("shorthand")->value("key"), "last");
+    CORRADE_COMPARE(parallel.group("group3000")->group("another")->configuration(), &parallel);
+
+    /* The result is the same as with sequential parsing, including comments
+       and empty lines */
+    CORRADE_COMPARE(parallel.saveToString(), sequential.saveToString());
+    CORRADE_COMPARE(parallel.saveToString(), data);
+}
+
+void ConfigurationTest::parseParallelError() {
+    /* Error in a group far from the start, which should be found regardless
+       of what piece it ends up in. The first error in the file is
+       reported. */
+    std::string data;
+    for(std::size_t i = 0; i != 40000; ++i) {
+        data += "[group" + std::to_string(i) + "]\nkey=value\n";
+        if(i == 25000) data += "this is not a value\n";
+        if(i == 35000) data += "[unterminated\n";
+    }
+    CORRADE_VERIFY(data.size() > 3*256*1024);
+
+    const std::string filename = Directory::join(CONFIGURATION_WRITE_TEST_DIR, "parallel-error.conf");
+    CORRADE_VERIFY(Directory::writeString(filename, data));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Configuration conf{filename, Configuration::Flag::ParallelParse};
+    CORRADE_VERIFY(!conf.isValid());
+    CORRADE_VERIFY(conf.isEmpty());
+    CORRADE_COMPARE(out.str(), "Utility::Configuration::Configuration(): missing equals for a value\n");
+}
+
 void ConfigurationTest::groupIndex() {
     std::istringstream in("[a]\n[a]\n");
     Configuration conf(in);
@@ -366,6 +472,65 @@ void ConfigurationTest::valueIndex() {
     CORRADE_VERIFY(conf.setValue("a", "foo", 2));
 }
 
+void ConfigurationTest::valueView() {
+    std::istringstream in("a=hello\na=  \"world\"  \nb=0x1f\n");
+    const Configuration conf(in);
+    CORRADE_VERIFY(conf.isValid());
+
+    Containers::StringView a0 = conf.valueView("a");
+    Containers::StringView a1 = conf.valueView("a", 1);
+    CORRADE_COMPARE(a0, "hello");
+    CORRADE_COMPARE(a1, "world");
+
+    /* The view points to the stored value, no copy is made */
+    CORRADE_COMPARE(conf.valueView("a").data(), a0.data());
+    CORRADE_COMPARE(conf.valueView("a", 1).data(), a1.data());
+
+    /* No flags are applied */
+    CORRADE_COMPARE(conf.valueView("b"), "0x1f");
+
+    /* Nonexistent values result in an empty view */
+    CORRADE_COMPARE(conf.valueView("a", 2), "");
+    CORRADE_COMPARE(conf.valueView("c"), "");
+}
+
+void ConfigurationTest::stringViewKeys() {
+    Configuration conf;
+    conf.addGroup("group")->setValue("key", 42);
+    conf.group("group")->addValue("key", 1337);
+
+    /* Slices that aren't null-terminated */
+    const Containers::StringView data = "group:key"_s;
+    const Containers::StringView group = data.prefix(5);
+    const Containers::StringView key = data.suffix(6);
+    CORRADE_VERIFY(!(group.flags() & Containers::StringViewFlag::NullTerminated));
+
+    CORRADE_VERIFY(conf.hasGroup(group));
+    CORRADE_COMPARE(conf.groupCount(group), 1);
+    CORRADE_COMPARE(conf.groups(group).size(), 1);
+
+    ConfigurationGroup* g = conf.group(group);
+    CORRADE_VERIFY(g);
+    CORRADE_VERIFY(g->hasValue(key, 1));
+    CORRADE_COMPARE(g->valueCount(key), 2);
+    CORRADE_COMPARE(g->value<int>(key), 42);
+    CORRADE_COMPARE(g->value<int>(key, 1), 1337);
+    CORRADE_COMPARE_AS(g->values<int>(key),
+        (std::vector<int>{42, 1337}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(g->valueView(key, 1), "1337");
+
+    CORRADE_VERIFY(g->setValue(key, 7, 1));
+    CORRADE_COMPARE(g->valueView(key, 1), "7");
+    CORRADE_VERIFY(g->removeValue(key));
+    CORRADE_COMPARE(g->valueCount(key), 1);
+    g->removeAllValues(key);
+    CORRADE_VERIFY(!g->hasValues());
+
+    CORRADE_VERIFY(conf.removeGroup(group));
+    CORRADE_VERIFY(!conf.hasGroup(group));
+}
+
 void ConfigurationTest::names() {
     #ifdef CORRADE_NO_ASSERT
     CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
@@ -570,6 +735,163 @@ void ConfigurationTest::multiLineValueCrlf() {
                        TestSuite::Compare::File);
 }
 
+void ConfigurationTest::saveToString() {
+    /* Hierarchic groups, multi-line values and CRLF line endings, all of
+       which should end up byte-identical to what gets saved to a file and to
+       a stream */
+    Configuration conf{Configuration::Flag::ForceWindowsEol};
+    conf.setValue("value", "hello");
+    conf.setValue("multiline", " Hello\n people how\n are you?");
+    conf.addGroup("a")->addGroup("b")->setValue("key", "val");
+    conf.addGroup("a")->setValue("key2", "val2");
+
+    Containers::String out = conf.saveToString();
+    CORRADE_COMPARE(out,
+        "value=hello\r\n"
+        "multiline=\"\"\"\r\n"
+        " Hello\r\n"
+        " people how\r\n"
+        " are you?\r\n"
+        "\"\"\"\r\n"
+        /* The [a] header is omitted as it has no values and is the first
+           of its name */
+        "[a/b]\r\n"
+        "key=val\r\n"
+        "[a]\r\n"
+        "key2=val2\r\n");
+
+    std::ostringstream stream;
+    conf.save(stream);
+    CORRADE_COMPARE(stream.str(), out);
+
+    CORRADE_VERIFY(conf.save(Directory::join(CONFIGURATION_WRITE_TEST_DIR, "save-to-string.conf")));
+    CORRADE_COMPARE_AS(Directory::join(CONFIGURATION_WRITE_TEST_DIR, "save-to-string.conf"),
+        out, TestSuite::Compare::FileToString);
+
+    /* Empty configuration results in an empty string */
+    CORRADE_COMPARE(Configuration{}.saveToString(), "");
+}
+
+void ConfigurationTest::reload() {
+    const std::string filename = Directory::join(CONFIGURATION_WRITE_TEST_DIR, "reload.conf");
+    CORRADE_VERIFY(Directory::writeString(filename,
+        "# a comment\n"
+        "a=1\n"
+        "b=2\n"
+        "b=3\n"
+        "[g]\n"
+        "x=1\n"
+        "[g/sub]\n"
+        "y=2\n"
+        "[h]\n"
+        "z=3\n"
+        "[removed]\n"
+        "w=4\n"));
+
+    Configuration conf{filename};
+    CORRADE_VERIFY(conf.isValid());
+    ConfigurationGroup* g = conf.group("g");
+    ConfigurationGroup* sub = conf.group("g")->group("sub");
+    ConfigurationGroup* h = conf.group("h");
+    CORRADE_VERIFY(g);
+    CORRADE_VERIFY(sub);
+    CORRADE_VERIFY(h);
+
+    const std::string modified =
+        "# a changed comment\r\n"
+        "a=1\r\n"
+        "b=2\r\n"
+        "c=5\r\n"
+        "[g]\r\n"
+        "x=10\r\n"
+        "[g/sub]\r\n"
+        "y=2\r\n"
+        "[h]\r\n"
+        "z=3\r\n"
+        "[added]\r\n"
+        "v=6\r\n";
+    CORRADE_VERIFY(Directory::writeString(filename, modified));
+
+    std::vector<Configuration::Change> changes;
+    CORRADE_VERIFY(conf.reload(changes));
+
+    /* The order is unspecified, so compare a sorted textual representation */
+    std::vector<std::string> changesString;
+    for(const Configuration::Change& change: changes) {
+        std::ostringstream out;
+        Debug{&out, Debug::Flag::NoNewlineAtTheEnd} << change.type << change.name << change.index;
+        changesString.push_back(out.str());
+
+        if(change.name == "x") CORRADE_COMPARE(change.group, g);
+        else CORRADE_COMPARE(change.group, &conf);
+    }
+    std::sort(changesString.begin(), changesString.end());
+    CORRADE_COMPARE_AS(changesString, (std::vector<std::string>{
+        "Utility::Configuration::ChangeType::GroupAdded added 0",
+        "Utility::Configuration::ChangeType::GroupRemoved removed 0",
+        "Utility::Configuration::ChangeType::ValueAdded c 0",
+        "Utility::Configuration::ChangeType::ValueChanged x 0",
+        "Utility::Configuration::ChangeType::ValueRemoved b 1"
+    }), TestSuite::Compare::Container);
+
+    /* Groups present in both stayed at the same address */
+    CORRADE_COMPARE(conf.group("g"), g);
+    CORRADE_COMPARE(conf.group("g")->group("sub"), sub);
+    CORRADE_COMPARE(conf.group("h"), h);
+    CORRADE_COMPARE(g->value("x"), "10");
+    CORRADE_COMPARE(sub->value("y"), "2");
+    CORRADE_VERIFY(!conf.hasGroup("removed"));
+    CORRADE_VERIFY(conf.hasGroup("added"));
+    CORRADE_COMPARE(conf.group("added")->configuration(), &conf);
+    CORRADE_COMPARE(conf.valueCount("b"), 1);
+    CORRADE_COMPARE(conf.value("c"), "5");
+
+    /* Comments and line endings are taken over from the file as well, so
+       saving results in the same file */
+    CORRADE_COMPARE(conf.saveToString(), modified);
+
+    /* Reloading the same file again results in no changes */
+    changes.clear();
+    CORRADE_VERIFY(conf.reload(changes));
+    CORRADE_VERIFY(changes.empty());
+}
+
+void ConfigurationTest::reloadNonexistent() {
+    Configuration conf;
+    conf.setValue("a", "b");
+
+    std::vector<Configuration::Change> changes;
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!conf.reload("nonexistent.conf", changes));
+    CORRADE_VERIFY(changes.empty());
+    CORRADE_COMPARE(conf.value("a"), "b");
+    CORRADE_COMPARE(out.str(), "Utility::Configuration::reload(): file nonexistent.conf doesn't exist\n");
+}
+
+void ConfigurationTest::reloadInvalid() {
+    Configuration conf;
+    conf.setValue("a", "b");
+
+    std::vector<Configuration::Change> changes;
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!conf.reload(Directory::join(CONFIGURATION_TEST_DIR, "missing-equals.conf"), changes));
+    CORRADE_VERIFY(changes.empty());
+    CORRADE_COMPARE(conf.value("a"), "b");
+    CORRADE_COMPARE(out.str(), "Utility::Configuration::Configuration(): missing equals for a value\n");
+}
+
+void ConfigurationTest::reloadNoFilename() {
+    Configuration conf;
+
+    std::vector<Configuration::Change> changes;
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!conf.reload(changes));
+    CORRADE_COMPARE(out.str(), "Utility::Configuration::reload(): no filename set\n");
+}
+
 void ConfigurationTest::standaloneGroup() {
     ConfigurationGroup group;
     CORRADE_VERIFY(!group.configuration());
@@ -765,6 +1087,12 @@ void ConfigurationTest::iterateValuesCommentsOnly() {
     CORRADE_VERIFY(commentsOnly->values().begin() == commentsOnly->values().end());
 }
 
+void ConfigurationTest::debugChangeType() {
+    std::ostringstream out;
+    Debug{&out} << Configuration::ChangeType::GroupRemoved << Configuration::ChangeType(0xde);
+    CORRADE_COMPARE(out.str(), "Utility::Configuration::ChangeType::GroupRemoved Utility::Configuration::ChangeType(0xde)\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::Utility::Test::ConfigurationTest)
@@ -30,6 +30,7 @@
 #include "Corrade/Containers/Array.h"
 #include "Corrade/Containers/Optional.h"
 #include "Corrade/Containers/ScopeGuard.h"
+#include "Corrade/Containers/StringStl.h"
 #include "Corrade/TestSuite/Tester.h"
 #include "Corrade/TestSuite/Compare/Container.h"
 #include "Corrade/TestSuite/Compare/File.h"
@@ -125,6 +126,13 @@ struct DirectoryTest: TestSuite::Tester {
     void fileSizeNonexistent();
     void fileSizeUtf8();
 
+    void fileInfo();
+    void fileInfoRelative();
+    void fileInfoNonNullTerminated();
+    void fileInfoNoSizesTimes();
+    void fileInfoDirectoryNonexistent();
+    void debugFileType();
+
     void read();
     void readEmpty();
     void readNonSeekable();
@@ -149,6 +157,8 @@ struct DirectoryTest: TestSuite::Tester {
     void copyNonexistent();
     void copyNoPermission();
     void copyUtf8();
+    void copyBatch();
+    void copyBatchNonexistent();
 
     #ifndef CORRADE_TARGET_EMSCRIPTEN
     void prepareFileToBenchmarkCopy();
@@ -250,6 +260,13 @@ DirectoryTest::DirectoryTest() {
               &DirectoryTest::fileSizeNonexistent,
               &DirectoryTest::fileSizeUtf8,
 
+              &DirectoryTest::fileInfo,
+              &DirectoryTest::fileInfoRelative,
+              &DirectoryTest::fileInfoNonNullTerminated,
+              &DirectoryTest::fileInfoNoSizesTimes,
+              &DirectoryTest::fileInfoDirectoryNonexistent,
+              &DirectoryTest::debugFileType,
+
               &DirectoryTest::read,
               &DirectoryTest::readEmpty,
               &DirectoryTest::readNonSeekable,
@@ -275,7 +292,9 @@ DirectoryTest::DirectoryTest() {
     addTests({&DirectoryTest::copyEmpty,
               &DirectoryTest::copyNonexistent,
               &DirectoryTest::copyNoPermission,
-              &DirectoryTest::copyUtf8});
+              &DirectoryTest::copyUtf8,
+              &DirectoryTest::copyBatch,
+              &DirectoryTest::copyBatchNonexistent});
 
     #ifndef CORRADE_TARGET_EMSCRIPTEN
     addBenchmarks({
@@ -1193,6 +1212,105 @@ void DirectoryTest::fileSizeUtf8() {
         Containers::arraySize(Data));
 }
 
+void DirectoryTest::fileInfo() {
+    const std::string file = Directory::join(_testDir, "file");
+    const std::string dir = Directory::join(_testDir, "dir");
+    const std::string empty = Directory::join(_testDir, "dir/dummy");
+    const Containers::StringView paths[]{
+        file, dir, "nonexistent", empty, "", "/dev/null"
+    };
+    Directory::FileType types[6];
+    std::uint64_t sizes[6];
+    std::uint64_t times[6];
+    CORRADE_VERIFY(Directory::fileInfo(paths, types, sizes, times));
+
+    const Directory::FileType expected[]{
+        Directory::FileType::File,
+        Directory::FileType::Directory,
+        Directory::FileType::Nonexistent,
+        Directory::FileType::File,
+        Directory::FileType::Nonexistent,
+        #if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN)
+        Directory::FileType::Special
+        #else
+        Directory::FileType::Nonexistent
+        #endif
+    };
+    CORRADE_COMPARE_AS(Containers::arrayView(types),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(sizes[0], Containers::arraySize(Data));
+    CORRADE_COMPARE(sizes[2], 0);
+    CORRADE_COMPARE(sizes[3], 0);
+    CORRADE_VERIFY(times[0]);
+    CORRADE_VERIFY(times[1]);
+    CORRADE_COMPARE(times[2], 0);
+}
+
+void DirectoryTest::fileInfoRelative() {
+    const Containers::StringView paths[]{
+        "file", "dir", "dir/dummy", "nonexistent", "."
+    };
+    Directory::FileType types[5];
+    std::uint64_t sizes[5];
+    CORRADE_VERIFY(Directory::fileInfo(_testDir, paths, types, sizes, nullptr));
+    CORRADE_COMPARE_AS(Containers::arrayView(types), Containers::arrayView({
+        Directory::FileType::File,
+        Directory::FileType::Directory,
+        Directory::FileType::File,
+        Directory::FileType::Nonexistent,
+        Directory::FileType::Directory
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(sizes[0], Containers::arraySize(Data));
+
+    /* Absolute paths ignore the directory */
+    const std::string file = Directory::join(_testDir, "file");
+    const Containers::StringView absolute[]{file};
+    CORRADE_VERIFY(Directory::fileInfo(_writeTestDir, absolute, Containers::arrayView(types).prefix(1), nullptr, nullptr));
+    CORRADE_COMPARE(types[0], Directory::FileType::File);
+}
+
+void DirectoryTest::fileInfoNonNullTerminated() {
+    /* The paths are slices of a bigger string, with the filename followed by
+       garbage that shouldn't get used */
+    const std::string all = "filexdirx";
+    const Containers::StringView paths[]{
+        Containers::StringView{all}.prefix(4),
+        Containers::StringView{all}.slice(5, 8)
+    };
+    CORRADE_VERIFY(!(paths[0].flags() & Containers::StringViewFlag::NullTerminated));
+    Directory::FileType types[2];
+    CORRADE_VERIFY(Directory::fileInfo(_testDir, paths, types, nullptr, nullptr));
+    CORRADE_COMPARE(types[0], Directory::FileType::File);
+    CORRADE_COMPARE(types[1], Directory::FileType::Directory);
+}
+
+void DirectoryTest::fileInfoNoSizesTimes() {
+    const std::string file = Directory::join(_testDir, "file");
+    const Containers::StringView paths[]{file};
+    Directory::FileType types[1];
+    CORRADE_VERIFY(Directory::fileInfo(paths, types, nullptr, nullptr));
+    CORRADE_COMPARE(types[0], Directory::FileType::File);
+}
+
+void DirectoryTest::fileInfoDirectoryNonexistent() {
+    const Containers::StringView paths[]{"file"};
+    Directory::FileType types[1];
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!Directory::fileInfo("nonexistent", paths, types, nullptr, nullptr));
+    }
+    CORRADE_COMPARE(out.str(), "Utility::Directory::fileInfo(): can't open nonexistent\n");
+}
+
+void DirectoryTest::debugFileType() {
+    std::ostringstream out;
+    Debug{&out} << Directory::FileType::Directory << Directory::FileType(0xde);
+    CORRADE_COMPARE(out.str(), "Utility::Directory::FileType::Directory Utility::Directory::FileType(0xde)\n");
+}
+
 void DirectoryTest::read() {
     /* Existing file, check if we are reading it as binary (CR+LF is not
        converted to LF) and nothing after \0 gets lost */
@@ -1422,6 +1540,42 @@ void DirectoryTest::copyUtf8() {
         TestSuite::Compare::File);
 }
 
+void DirectoryTest::copyBatch() {
+    std::string a = Directory::join(_writeTestDir, "copyBatchA.txt");
+    std::string b = Directory::join(_writeTestDir, "copyBatchB.txt");
+    std::string aOut = Directory::join(_writeTestDir, "copyBatchA.out");
+    std::string bOut = Directory::join(_writeTestDir, "copyBatchB.out");
+    CORRADE_VERIFY(Directory::writeString(a, "hello"));
+    CORRADE_VERIFY(Directory::writeString(b, "world!"));
+    if(Directory::exists(aOut)) CORRADE_VERIFY(Directory::rm(aOut));
+    if(Directory::exists(bOut)) CORRADE_VERIFY(Directory::rm(bOut));
+
+    CORRADE_VERIFY(Directory::copy({{a, aOut}, {b, bOut}}));
+    CORRADE_COMPARE_AS(aOut, "hello",
+        TestSuite::Compare::FileToString);
+    CORRADE_COMPARE_AS(bOut, "world!",
+        TestSuite::Compare::FileToString);
+}
+
+void DirectoryTest::copyBatchNonexistent() {
+    std::string b = Directory::join(_writeTestDir, "copyBatchB.txt");
+    std::string bOut = Directory::join(_writeTestDir, "copyBatchB.out");
+    CORRADE_VERIFY(Directory::writeString(b, "world!"));
+    if(Directory::exists(bOut)) CORRADE_VERIFY(Directory::rm(bOut));
+
+    /* The failure shouldn't prevent the other file from being copied */
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!Directory::copy({
+            {"nonexistent", Directory::join(_writeTestDir, "empty")},
+            {b, bOut}}));
+    }
+    CORRADE_COMPARE(out.str(), "Utility::Directory::copy(): can't open nonexistent\n");
+    CORRADE_COMPARE_AS(bOut, "world!",
+        TestSuite::Compare::FileToString);
+}
+
 #ifndef CORRADE_TARGET_EMSCRIPTEN
 void DirectoryTest::prepareFileToBenchmarkCopy() {
     if(Directory::exists(Directory::join(_writeTestDir, "copyBenchmarkSource.dat")))
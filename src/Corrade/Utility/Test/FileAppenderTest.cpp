@@ -0,0 +1,303 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+
+#include "Corrade/Containers/StringStl.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/FileToString.h"
+#include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/Directory.h"
+#include "Corrade/Utility/FileAppender.h"
+#include "Corrade/Utility/FormatStl.h"
+#include "Corrade/Utility/System.h"
+
+#include "configure.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct FileAppenderTest: TestSuite::Tester {
+    explicit FileAppenderTest();
+
+    void construct();
+    void constructTruncate();
+    void constructCantOpen();
+    void constructMove();
+
+    void append();
+    void appendLargerThanBuffer();
+    void appendNoBuffer();
+    void appendNotOpen();
+    void flushInterval();
+    void flushSyncOnFlush();
+    void sync();
+    void destructFlushes();
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    void threads();
+    #endif
+
+    void debugFlag();
+    void debugFlags();
+
+    std::string _filename;
+};
+
+FileAppenderTest::FileAppenderTest() {
+    addTests({&FileAppenderTest::construct,
+              &FileAppenderTest::constructTruncate,
+              &FileAppenderTest::constructCantOpen,
+              &FileAppenderTest::constructMove,
+
+              &FileAppenderTest::append,
+              &FileAppenderTest::appendLargerThanBuffer,
+              &FileAppenderTest::appendNoBuffer,
+              &FileAppenderTest::appendNotOpen,
+              &FileAppenderTest::flushInterval,
+              &FileAppenderTest::flushSyncOnFlush,
+              &FileAppenderTest::sync,
+              &FileAppenderTest::destructFlushes,
+              #ifndef CORRADE_TARGET_EMSCRIPTEN
+              &FileAppenderTest::threads,
+              #endif
+
+              &FileAppenderTest::debugFlag,
+              &FileAppenderTest::debugFlags});
+
+    Directory::mkpath(FILEAPPENDER_WRITE_TEST_DIR);
+    _filename = Directory::join(FILEAPPENDER_WRITE_TEST_DIR, "file.log");
+}
+
+void FileAppenderTest::construct() {
+    CORRADE_VERIFY(Directory::writeString(_filename, "hello"));
+
+    FileAppender appender{_filename, 16, FileAppender::Flag::SyncOnFlush};
+    CORRADE_VERIFY(appender.isOpen());
+    CORRADE_COMPARE(appender.flags(), FileAppender::Flag::SyncOnFlush);
+    CORRADE_COMPARE(appender.bufferSize(), 16);
+    CORRADE_COMPARE(appender.bufferedSize(), 0);
+    CORRADE_COMPARE(appender.flushInterval(), 0);
+
+    /* The file is appended to by default */
+    CORRADE_VERIFY(appender.appendString(" world"));
+    CORRADE_VERIFY(appender.flush());
+    CORRADE_COMPARE_AS(_filename, "hello world",
+        TestSuite::Compare::FileToString);
+}
+
+void FileAppenderTest::constructTruncate() {
+    CORRADE_VERIFY(Directory::writeString(_filename, "hello"));
+
+    FileAppender appender{_filename, 16, FileAppender::Flag::Truncate};
+    CORRADE_VERIFY(appender.isOpen());
+    CORRADE_COMPARE_AS(_filename, "",
+        TestSuite::Compare::FileToString);
+}
+
+void FileAppenderTest::constructCantOpen() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    FileAppender appender{Directory::join(FILEAPPENDER_WRITE_TEST_DIR, "nonexistent/file.log")};
+    CORRADE_VERIFY(!appender.isOpen());
+    CORRADE_COMPARE(out.str(), Utility::formatString("Utility::FileAppender: can't open {}: No such file or directory\n", Directory::join(FILEAPPENDER_WRITE_TEST_DIR, "nonexistent/file.log")));
+}
+
+void FileAppenderTest::constructMove() {
+    FileAppender a{_filename, 16, FileAppender::Flag::Truncate};
+    CORRADE_VERIFY(a.appendString("hello"));
+
+    FileAppender b = std::move(a);
+    CORRADE_VERIFY(b.isOpen());
+    CORRADE_COMPARE(b.bufferSize(), 16);
+    CORRADE_COMPARE(b.bufferedSize(), 5);
+
+    FileAppender c{Directory::join(FILEAPPENDER_WRITE_TEST_DIR, "other.log"), 4};
+    c = std::move(b);
+    CORRADE_COMPARE(c.bufferSize(), 16);
+    CORRADE_COMPARE(c.bufferedSize(), 5);
+    CORRADE_VERIFY(c.flush());
+    CORRADE_COMPARE_AS(_filename, "hello",
+        TestSuite::Compare::FileToString);
+}
+
+void FileAppenderTest::append() {
+    FileAppender appender{_filename, 16, FileAppender::Flag::Truncate};
+    CORRADE_VERIFY(appender.appendString("hello"));
+    CORRADE_VERIFY(appender.append(Containers::arrayView(" world", 6)));
+    CORRADE_COMPARE(appender.bufferedSize(), 11);
+
+    /* Nothing written yet */
+    CORRADE_COMPARE_AS(_filename, "",
+        TestSuite::Compare::FileToString);
+
+    /* This fits exactly */
+    CORRADE_VERIFY(appender.appendString("!!!!!"));
+    CORRADE_COMPARE(appender.bufferedSize(), 16);
+    CORRADE_COMPARE_AS(_filename, "",
+        TestSuite::Compare::FileToString);
+
+    /* This doesn't, everything gets written */
+    CORRADE_VERIFY(appender.appendString("?"));
+    CORRADE_COMPARE(appender.bufferedSize(), 0);
+    CORRADE_COMPARE_AS(_filename, "hello world!!!!!?",
+        TestSuite::Compare::FileToString);
+}
+
+void FileAppenderTest::appendLargerThanBuffer() {
+    FileAppender appender{_filename, 4, FileAppender::Flag::Truncate};
+    CORRADE_VERIFY(appender.appendString("ab"));
+    CORRADE_VERIFY(appender.appendString("this is too long"));
+    CORRADE_COMPARE(appender.bufferedSize(), 0);
+    CORRADE_COMPARE_AS(_filename, "abthis is too long",
+        TestSuite::Compare::FileToString);
+}
+
+void FileAppenderTest::appendNoBuffer() {
+    FileAppender appender{_filename, 0, FileAppender::Flag::Truncate};
+    CORRADE_VERIFY(appender.appendString("a"));
+    CORRADE_VERIFY(appender.appendString(""));
+    CORRADE_VERIFY(appender.appendString("b"));
+    CORRADE_COMPARE_AS(_filename, "ab",
+        TestSuite::Compare::FileToString);
+}
+
+void FileAppenderTest::appendNotOpen() {
+    const std::string filename = Directory::join(FILEAPPENDER_WRITE_TEST_DIR, "nonexistent/file.log");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    FileAppender appender{filename};
+    out.str({});
+    CORRADE_VERIFY(!appender.appendString("hello"));
+    CORRADE_VERIFY(!appender.flush());
+    CORRADE_VERIFY(!appender.sync());
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+        "Utility::FileAppender::append(): file {0} is not open\n"
+        "Utility::FileAppender::flush(): file {0} is not open\n"
+        "Utility::FileAppender::sync(): file {0} is not open\n", filename));
+}
+
+void FileAppenderTest::flushInterval() {
+    FileAppender appender{_filename, 1024, FileAppender::Flag::Truncate};
+    CORRADE_COMPARE(&appender.setFlushInterval(5), &appender);
+    CORRADE_COMPARE(appender.flushInterval(), 5);
+
+    CORRADE_VERIFY(appender.appendString("hello"));
+    CORRADE_COMPARE_AS(_filename, "",
+        TestSuite::Compare::FileToString);
+
+    /* Once the interval passes, the next append flushes */
+    Utility::System::sleep(10);
+    CORRADE_VERIFY(appender.appendString(" world"));
+    CORRADE_COMPARE(appender.bufferedSize(), 0);
+    CORRADE_COMPARE_AS(_filename, "hello world",
+        TestSuite::Compare::FileToString);
+}
+
+void FileAppenderTest::flushSyncOnFlush() {
+    /* Can't really verify the data reached the disk, at least check that it
+       doesn't fail */
+    FileAppender appender{_filename, 1024, FileAppender::Flag::Truncate|FileAppender::Flag::SyncOnFlush};
+    CORRADE_VERIFY(appender.appendString("hello"));
+    CORRADE_VERIFY(appender.flush());
+    CORRADE_COMPARE_AS(_filename, "hello",
+        TestSuite::Compare::FileToString);
+}
+
+void FileAppenderTest::sync() {
+    FileAppender appender{_filename, 1024, FileAppender::Flag::Truncate};
+    CORRADE_VERIFY(appender.appendString("hello"));
+    CORRADE_VERIFY(appender.sync());
+    CORRADE_COMPARE(appender.bufferedSize(), 0);
+    CORRADE_COMPARE_AS(_filename, "hello",
+        TestSuite::Compare::FileToString);
+}
+
+void FileAppenderTest::destructFlushes() {
+    {
+        FileAppender appender{_filename, 1024, FileAppender::Flag::Truncate};
+        CORRADE_VERIFY(appender.appendString("hello"));
+        CORRADE_COMPARE_AS(_filename, "",
+            TestSuite::Compare::FileToString);
+    }
+
+    CORRADE_COMPARE_AS(_filename, "hello",
+        TestSuite::Compare::FileToString);
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void FileAppenderTest::threads() {
+    /* Buffer size not divisible by the record size so the records get split
+       between the buffer and the extra data */
+    FileAppender appender{_filename, 1000, FileAppender::Flag::Truncate};
+
+    std::thread threads[4];
+    for(std::size_t i = 0; i != Containers::arraySize(threads); ++i) {
+        threads[i] = std::thread{[&appender, i]{
+            const std::string record = formatString("thread {} record\n", i);
+            for(std::size_t j = 0; j != 1000; ++j)
+                appender.appendString(record);
+        }};
+    }
+    for(std::thread& thread: threads) thread.join();
+    CORRADE_VERIFY(appender.flush());
+
+    /* All records should be there, in one piece */
+    const std::string contents = Directory::readString(_filename);
+    CORRADE_COMPARE(contents.size(), 4*1000*16);
+    std::size_t counts[4]{};
+    for(std::size_t i = 0; i < contents.size(); i += 16) {
+        const std::string record = contents.substr(i, 16);
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(record.find("thread ") == 0);
+        CORRADE_COMPARE(record.substr(8), " record\n");
+        ++counts[record[7] - '0'];
+    }
+    CORRADE_COMPARE(counts[0], 1000);
+    CORRADE_COMPARE(counts[1], 1000);
+    CORRADE_COMPARE(counts[2], 1000);
+    CORRADE_COMPARE(counts[3], 1000);
+}
+#endif
+
+void FileAppenderTest::debugFlag() {
+    std::ostringstream out;
+    Debug{&out} << FileAppender::Flag::SyncOnFlush << FileAppender::Flag(0xde);
+    CORRADE_COMPARE(out.str(), "Utility::FileAppender::Flag::SyncOnFlush Utility::FileAppender::Flag(0xde)\n");
+}
+
+void FileAppenderTest::debugFlags() {
+    std::ostringstream out;
+    Debug{&out} << (FileAppender::Flag::Truncate|FileAppender::Flag::SyncOnFlush) << FileAppender::Flags{};
+    CORRADE_COMPARE(out.str(), "Utility::FileAppender::Flag::Truncate|Utility::FileAppender::Flag::SyncOnFlush Utility::FileAppender::Flags{}\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::FileAppenderTest)
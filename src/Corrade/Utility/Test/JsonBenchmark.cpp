@@ -0,0 +1,127 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+
+#include "Corrade/Containers/Optional.h"
+#include "Corrade/Containers/StringStl.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/Directory.h"
+#include "Corrade/Utility/Format.h"
+#include "Corrade/Utility/FormatStl.h"
+#include "Corrade/Utility/Json.h"
+
+#include "configure.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct JsonBenchmark: TestSuite::Tester {
+    explicit JsonBenchmark();
+
+    void tokenize();
+    void tokenizeParseNumbers();
+    void tokenizeMappedFile();
+
+    private:
+        std::string _data;
+        std::size_t _numberCount;
+};
+
+JsonBenchmark::JsonBenchmark() {
+    addBenchmarks({&JsonBenchmark::tokenize,
+                   &JsonBenchmark::tokenizeParseNumbers,
+                   &JsonBenchmark::tokenizeMappedFile}, 10);
+
+    /* A ~2 MB array of objects resembling a typical metadata file, with
+       strings, nested arrays of numbers and indentation */
+    _data = "[\n";
+    _numberCount = 0;
+    for(std::size_t i = 0; i != 5000; ++i) {
+        if(i) _data += ",\n";
+        formatInto(_data, _data.size(),
+            "  {{\n"
+            "    \"name\": \"object {0}\",\n"
+            "    \"description\": \"A somewhat longer string value to exercise the string scanning, number {0}\",\n"
+            "    \"visible\": {1},\n"
+            "    \"parent\": null,\n"
+            "    \"transformation\": [{2}, 0.0, -0.5, 1.25, 0.0, 1.0, 0.0, 0.0, {3}, 0.0, 1.0, 0.0, 15.5, -3.75, 1.0e-3, 1.0],\n"
+            "    \"children\": [{4}, {5}, {6}, {7}],\n"
+            "    \"tags\": [\"first\", \"second\", \"with \\\"escapes\\\"\"]\n"
+            "  }}",
+            i, i % 2 ? "true" : "false", i*0.25, -double(i), i*4, i*4 + 1, i*4 + 2, i*4 + 3);
+        _numberCount += 20;
+    }
+    _data += "\n]\n";
+}
+
+void JsonBenchmark::tokenize() {
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1) {
+        Containers::Optional<Json> json = Json::fromString(_data);
+        count += json->tokens().size();
+    }
+
+    CORRADE_VERIFY(count);
+}
+
+void JsonBenchmark::tokenizeParseNumbers() {
+    std::size_t count = 0;
+    double sum = 0.0;
+    CORRADE_BENCHMARK(1) {
+        Containers::Optional<Json> json = Json::fromString(_data);
+        for(const JsonToken& token: json->tokens()) {
+            if(token.type() != JsonToken::Type::Number) continue;
+            sum += *token.parseDouble();
+            ++count;
+        }
+    }
+
+    CORRADE_COMPARE(count, _numberCount);
+    CORRADE_VERIFY(sum != 0.0);
+}
+
+void JsonBenchmark::tokenizeMappedFile() {
+    #if !defined(CORRADE_TARGET_UNIX) && (!defined(CORRADE_TARGET_WINDOWS) || defined(CORRADE_TARGET_WINDOWS_RT))
+    CORRADE_SKIP("Memory-mapping not available on this platform.");
+    #else
+    const std::string filename = Directory::join(JSON_WRITE_TEST_DIR, "benchmark.json");
+    CORRADE_VERIFY(Directory::mkpath(JSON_WRITE_TEST_DIR));
+    CORRADE_VERIFY(Directory::writeString(filename, _data));
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1) {
+        const Containers::Array<const char, Directory::MapDeleter> mapped = Directory::mapRead(filename);
+        Containers::Optional<Json> json = Json::fromString({mapped, mapped.size()});
+        count += json->tokens().size();
+    }
+
+    CORRADE_VERIFY(count);
+    #endif
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::JsonBenchmark)
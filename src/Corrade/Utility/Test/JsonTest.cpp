@@ -0,0 +1,496 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019, 2020, 2021, 2022
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Corrade/Containers/Optional.h"
+#include "Corrade/Containers/StringStl.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/Directory.h"
+#include "Corrade/Utility/Json.h"
+
+#include "configure.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct JsonTest: TestSuite::Tester {
+    explicit JsonTest();
+
+    void tokenize();
+    void tokenizeEmpty();
+    void tokenizeSingleValue();
+    void tokenizeLongWhitespace();
+    void tokenizeLongString();
+    void tokenizeEscapedString();
+    void tokenizeError();
+
+    void iterate();
+
+    void parseBool();
+    void parseDouble();
+    void parseFloat();
+    void parseLong();
+    void parseUnsignedLong();
+    void parseNumberError();
+
+    void asString();
+    void asStringInvalid();
+    void parseString();
+    void parseStringError();
+
+    void fromFile();
+    void fromFileNotFound();
+
+    void debugType();
+};
+
+using namespace Containers::Literals;
+
+const struct {
+    const char* name;
+    Containers::StringView data;
+    const char* message;
+} TokenizeErrorData[]{
+    {"empty", "",
+        "expected a value but got end of input at <in>:1:1"},
+    {"whitespace only", "  \n ",
+        "expected a value but got end of input at <in>:2:2"},
+    {"invalid value", "[1, x]",
+        "expected a value but got x at <in>:1:5"},
+    {"unterminated object", "{\"a\": 1",
+        "expected , or } but got end of input at <in>:1:8"},
+    {"unterminated array", "[1, 2",
+        "expected , or ] but got end of input at <in>:1:6"},
+    {"missing colon", "{\"a\" 1}",
+        "expected : but got 1 at <in>:1:6"},
+    {"non-string key", "{1: 2}",
+        "expected a string key but got 1 at <in>:1:2"},
+    {"trailing comma in an array", "[1, ]",
+        "expected a value but got ] at <in>:1:5"},
+    {"trailing comma in an object", "{\"a\": 1,}",
+        "expected a string key but got } at <in>:1:9"},
+    {"mismatched bracket", "[1}",
+        "expected , or ] but got } at <in>:1:3"},
+    {"trailing data", "{} {}",
+        "expected end of input but got { at <in>:1:4"},
+    {"unterminated string", "[\"abc",
+        "unterminated string at <in>:1:2"},
+    {"unterminated escaped string", "\"abc\\\"",
+        "unterminated string at <in>:1:1"},
+    {"control character in a string", "\"a\tb\"",
+        "unexpected control character in a string at <in>:1:3"},
+    {"invalid literal", "[tru]",
+        "invalid literal at <in>:1:2"},
+    {"truncated literal", "fals",
+        "invalid literal at <in>:1:1"},
+    {"error on another line", "{\n  \"a\": nul\n}",
+        "invalid literal at <in>:2:8"},
+};
+
+const struct {
+    const char* name;
+    Containers::StringView data;
+    const char* message;
+} ParseNumberErrorData[]{
+    {"double, not a number", "\"3\"",
+        "Utility::JsonToken::parseDouble(): expected a number, got Utility::JsonToken::Type::String\n"},
+    {"double, leading zero", "01",
+        "Utility::JsonToken::parseDouble(): invalid floating-point literal 01\n"},
+    {"double, leading plus", "[+1]",
+        "Utility::Json: expected a value but got + at <in>:1:2\n"},
+    {"double, no fraction digits", "1.",
+        "Utility::JsonToken::parseDouble(): invalid floating-point literal 1.\n"},
+    {"double, no exponent digits", "1e+",
+        "Utility::JsonToken::parseDouble(): invalid floating-point literal 1e+\n"},
+    {"double, just a minus", "-",
+        "Utility::JsonToken::parseDouble(): invalid floating-point literal -\n"},
+    {"double, two minuses", "--1",
+        "Utility::JsonToken::parseDouble(): invalid floating-point literal --1\n"},
+};
+
+const struct {
+    const char* name;
+    Containers::StringView data;
+    const char* message;
+} ParseStringErrorData[]{
+    {"invalid escape", "\"a\\xb\"",
+        "Utility::JsonToken::parseString(): invalid escape sequence \\x\n"},
+    {"short unicode escape", "\"\\u12\"",
+        "Utility::JsonToken::parseString(): invalid unicode escape sequence \\u12\n"},
+    {"invalid unicode escape", "\"\\u12g4\"",
+        "Utility::JsonToken::parseString(): invalid unicode escape sequence \\u12g4\n"},
+    {"lone high surrogate", "\"\\ud83d abc\"",
+        "Utility::JsonToken::parseString(): invalid unicode escape sequence \\ud83d\n"},
+    {"lone low surrogate", "\"\\ude00\"",
+        "Utility::JsonToken::parseString(): invalid unicode escape sequence \\ude00\n"},
+    {"not a string", "35",
+        "Utility::JsonToken::parseString(): expected a string, got Utility::JsonToken::Type::Number\n"},
+};
+
+JsonTest::JsonTest() {
+    addTests({&JsonTest::tokenize,
+              &JsonTest::tokenizeEmpty,
+              &JsonTest::tokenizeSingleValue,
+              &JsonTest::tokenizeLongWhitespace,
+              &JsonTest::tokenizeLongString,
+              &JsonTest::tokenizeEscapedString});
+
+    addInstancedTests({&JsonTest::tokenizeError},
+        Containers::arraySize(TokenizeErrorData));
+
+    addTests({&JsonTest::iterate,
+
+              &JsonTest::parseBool,
+              &JsonTest::parseDouble,
+              &JsonTest::parseFloat,
+              &JsonTest::parseLong,
+              &JsonTest::parseUnsignedLong});
+
+    addInstancedTests({&JsonTest::parseNumberError},
+        Containers::arraySize(ParseNumberErrorData));
+
+    addTests({&JsonTest::asString,
+              &JsonTest::asStringInvalid,
+              &JsonTest::parseString});
+
+    addInstancedTests({&JsonTest::parseStringError},
+        Containers::arraySize(ParseStringErrorData));
+
+    addTests({&JsonTest::fromFile,
+              &JsonTest::fromFileNotFound,
+
+              &JsonTest::debugType});
+}
+
+void JsonTest::tokenize() {
+    Containers::StringView data = R"({"a": [1, -2.5e3, true, null], "b": {"c": "hello"}, "d": []})"_s;
+    Containers::Optional<Json> json = Json::fromString(data);
+    CORRADE_VERIFY(json);
+
+    Containers::ArrayView<const JsonToken> tokens = json->tokens();
+    CORRADE_COMPARE(tokens.size(), 13);
+    CORRADE_COMPARE(&json->root(), &tokens[0]);
+
+    /* The tokens point directly into the input */
+    CORRADE_COMPARE(tokens[0].type(), JsonToken::Type::Object);
+    CORRADE_COMPARE(tokens[0].data().data(), data.data());
+    CORRADE_COMPARE(tokens[0].data(), data);
+    CORRADE_COMPARE(tokens[0].childCount(), 12);
+
+    CORRADE_COMPARE(tokens[1].type(), JsonToken::Type::String);
+    CORRADE_COMPARE(tokens[1].data(), "\"a\"");
+    CORRADE_COMPARE(tokens[1].childCount(), 5);
+
+    CORRADE_COMPARE(tokens[2].type(), JsonToken::Type::Array);
+    CORRADE_COMPARE(tokens[2].data(), "[1, -2.5e3, true, null]");
+    CORRADE_COMPARE(tokens[2].childCount(), 4);
+
+    CORRADE_COMPARE(tokens[3].type(), JsonToken::Type::Number);
+    CORRADE_COMPARE(tokens[3].data(), "1");
+    CORRADE_COMPARE(tokens[4].type(), JsonToken::Type::Number);
+    CORRADE_COMPARE(tokens[4].data(), "-2.5e3");
+    CORRADE_COMPARE(tokens[5].type(), JsonToken::Type::Bool);
+    CORRADE_COMPARE(tokens[5].data(), "true");
+    CORRADE_COMPARE(tokens[6].type(), JsonToken::Type::Null);
+    CORRADE_COMPARE(tokens[6].data(), "null");
+    CORRADE_COMPARE(tokens[6].childCount(), 0);
+
+    CORRADE_COMPARE(tokens[7].data(), "\"b\"");
+    CORRADE_COMPARE(tokens[7].childCount(), 3);
+    CORRADE_COMPARE(tokens[8].type(), JsonToken::Type::Object);
+    CORRADE_COMPARE(tokens[8].data(), "{\"c\": \"hello\"}");
+    CORRADE_COMPARE(tokens[8].childCount(), 2);
+    CORRADE_COMPARE(tokens[9].data(), "\"c\"");
+    CORRADE_COMPARE(tokens[9].childCount(), 1);
+    CORRADE_COMPARE(tokens[10].type(), JsonToken::Type::String);
+    CORRADE_COMPARE(tokens[10].data(), "\"hello\"");
+    CORRADE_VERIFY(!tokens[10].isEscaped());
+
+    CORRADE_COMPARE(tokens[11].data(), "\"d\"");
+    CORRADE_COMPARE(tokens[11].childCount(), 1);
+    CORRADE_COMPARE(tokens[12].type(), JsonToken::Type::Array);
+    CORRADE_COMPARE(tokens[12].data(), "[]");
+    CORRADE_COMPARE(tokens[12].childCount(), 0);
+}
+
+void JsonTest::tokenizeEmpty() {
+    Containers::Optional<Json> object = Json::fromString(" {  } ");
+    CORRADE_VERIFY(object);
+    CORRADE_COMPARE(object->tokens().size(), 1);
+    CORRADE_COMPARE(object->root().type(), JsonToken::Type::Object);
+    CORRADE_COMPARE(object->root().data(), "{  }");
+    CORRADE_COMPARE(object->root().childCount(), 0);
+    CORRADE_VERIFY(!object->root().firstChild());
+
+    Containers::Optional<Json> array = Json::fromString("[]");
+    CORRADE_VERIFY(array);
+    CORRADE_COMPARE(array->tokens().size(), 1);
+    CORRADE_COMPARE(array->root().type(), JsonToken::Type::Array);
+    CORRADE_COMPARE(array->root().childCount(), 0);
+}
+
+void JsonTest::tokenizeSingleValue() {
+    Containers::Optional<Json> number = Json::fromString("\n-17.25\n");
+    CORRADE_VERIFY(number);
+    CORRADE_COMPARE(number->tokens().size(), 1);
+    CORRADE_COMPARE(number->root().type(), JsonToken::Type::Number);
+    CORRADE_COMPARE(number->root().data(), "-17.25");
+
+    /* Literal at the very end of the input */
+    Containers::Optional<Json> literal = Json::fromString("false");
+    CORRADE_VERIFY(literal);
+    CORRADE_COMPARE(literal->root().type(), JsonToken::Type::Bool);
+    CORRADE_COMPARE(literal->root().data(), "false");
+}
+
+void JsonTest::tokenizeLongWhitespace() {
+    /* Enough whitespace to go through the SIMD path several times, with the
+       value at an unaligned position */
+    Containers::Optional<Json> json = Json::fromString("[\n                                       \t\t\t\r\n                 7  \n\n\n\n\n                                   ]");
+    CORRADE_VERIFY(json);
+    CORRADE_COMPARE(json->tokens().size(), 2);
+    CORRADE_COMPARE(json->tokens()[1].data(), "7");
+}
+
+void JsonTest::tokenizeLongString() {
+    /* The quote is at various offsets relative to the 16-byte SIMD chunks */
+    for(std::size_t i = 0; i != 40; ++i) {
+        CORRADE_ITERATION(i);
+        std::string data = "[\"" + std::string(i, 'a') + "\", \"" + std::string(40 - i, 'b') + "\"]";
+        Containers::Optional<Json> json = Json::fromString(data);
+        CORRADE_VERIFY(json);
+        CORRADE_COMPARE(json->tokens().size(), 3);
+        CORRADE_COMPARE(json->tokens()[1].asString(), std::string(i, 'a'));
+        CORRADE_COMPARE(json->tokens()[2].asString(), std::string(40 - i, 'b'));
+    }
+}
+
+void JsonTest::tokenizeEscapedString() {
+    Containers::Optional<Json> json = Json::fromString(R"(["a very long string with an escaped quote \" and a backslash \\", "\\"])");
+    CORRADE_VERIFY(json);
+    CORRADE_COMPARE(json->tokens().size(), 3);
+    CORRADE_VERIFY(json->tokens()[1].isEscaped());
+    CORRADE_COMPARE(json->tokens()[1].data(), R"("a very long string with an escaped quote \" and a backslash \\")");
+    CORRADE_VERIFY(json->tokens()[2].isEscaped());
+    CORRADE_COMPARE(json->tokens()[2].data(), R"("\\")");
+}
+
+void JsonTest::tokenizeError() {
+    auto&& data = TokenizeErrorData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!Json::fromString(data.data));
+    CORRADE_COMPARE(out.str(), "Utility::Json: " + std::string{data.message} + "\n");
+}
+
+void JsonTest::iterate() {
+    Containers::Optional<Json> json = Json::fromString(R"({"a": [1, [2, 3]], "b": {"c": 4}, "d": 5})");
+    CORRADE_VERIFY(json);
+
+    /* Go through keys of the root object, skipping the nested values */
+    std::string keys;
+    const JsonToken& root = json->root();
+    for(const JsonToken* key = root.firstChild(); key != root.next(); key = key->next())
+        keys += key->asString();
+    CORRADE_COMPARE(keys, "abd");
+
+    /* Values of keys are their only child */
+    const JsonToken* d = root.firstChild()->next()->next();
+    CORRADE_COMPARE(d->asString(), "d");
+    CORRADE_COMPARE(*d->firstChild()->parseLong(), 5);
+    CORRADE_COMPARE(d->children().size(), 1);
+    CORRADE_COMPARE(d->next(), json->tokens().end());
+}
+
+void JsonTest::parseBool() {
+    Containers::Optional<Json> json = Json::fromString("[true, false, 1]");
+    CORRADE_VERIFY(json);
+    CORRADE_COMPARE(*json->tokens()[1].parseBool(), true);
+    CORRADE_COMPARE(*json->tokens()[2].parseBool(), false);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!json->tokens()[3].parseBool());
+    CORRADE_COMPARE(out.str(), "Utility::JsonToken::parseBool(): expected a bool, got Utility::JsonToken::Type::Number\n");
+}
+
+void JsonTest::parseDouble() {
+    Containers::Optional<Json> json = Json::fromString("[0, -0.5, 1.25e2, 3E-2, 12345678901234567890]");
+    CORRADE_VERIFY(json);
+    CORRADE_COMPARE(*json->tokens()[1].parseDouble(), 0.0);
+    CORRADE_COMPARE(*json->tokens()[2].parseDouble(), -0.5);
+    CORRADE_COMPARE(*json->tokens()[3].parseDouble(), 125.0);
+    CORRADE_COMPARE(*json->tokens()[4].parseDouble(), 0.03);
+    CORRADE_COMPARE(*json->tokens()[5].parseDouble(), 12345678901234567890.0);
+}
+
+void JsonTest::parseFloat() {
+    /* Number at the very end of the input, which isn't null-terminated */
+    Containers::Optional<Json> json = Json::fromString("-1.5e1x"_s.prefix(6));
+    CORRADE_VERIFY(json);
+    CORRADE_COMPARE(*json->root().parseFloat(), -15.0f);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!Json::fromString("null")->root().parseFloat());
+    CORRADE_COMPARE(out.str(), "Utility::JsonToken::parseFloat(): expected a number, got Utility::JsonToken::Type::Null\n");
+}
+
+void JsonTest::parseLong() {
+    Containers::Optional<Json> json = Json::fromString("[0, -35, 9223372036854775807, -9223372036854775808, 9223372036854775808, 1.0, 1e3]");
+    CORRADE_VERIFY(json);
+    CORRADE_COMPARE(*json->tokens()[1].parseLong(), 0);
+    CORRADE_COMPARE(*json->tokens()[2].parseLong(), -35);
+    CORRADE_COMPARE(*json->tokens()[3].parseLong(), 9223372036854775807ll);
+    CORRADE_COMPARE(*json->tokens()[4].parseLong(), -9223372036854775807ll - 1);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!json->tokens()[5].parseLong());
+    CORRADE_VERIFY(!json->tokens()[6].parseLong());
+    CORRADE_VERIFY(!json->tokens()[7].parseLong());
+    CORRADE_VERIFY(!json->tokens()[0].parseLong());
+    CORRADE_COMPARE(out.str(),
+        "Utility::JsonToken::parseLong(): too large integer literal 9223372036854775808\n"
+        "Utility::JsonToken::parseLong(): invalid integer literal 1.0\n"
+        "Utility::JsonToken::parseLong(): invalid integer literal 1e3\n"
+        "Utility::JsonToken::parseLong(): expected a number, got Utility::JsonToken::Type::Array\n");
+}
+
+void JsonTest::parseUnsignedLong() {
+    Containers::Optional<Json> json = Json::fromString("[0, 18446744073709551615, 18446744073709551616, -1]");
+    CORRADE_VERIFY(json);
+    CORRADE_COMPARE(*json->tokens()[1].parseUnsignedLong(), 0);
+    CORRADE_COMPARE(*json->tokens()[2].parseUnsignedLong(), 18446744073709551615ull);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!json->tokens()[3].parseUnsignedLong());
+    CORRADE_VERIFY(!json->tokens()[4].parseUnsignedLong());
+    CORRADE_COMPARE(out.str(),
+        "Utility::JsonToken::parseUnsignedLong(): too large integer literal 18446744073709551616\n"
+        "Utility::JsonToken::parseUnsignedLong(): invalid unsigned integer literal -1\n");
+}
+
+void JsonTest::parseNumberError() {
+    auto&& data = ParseNumberErrorData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    /* Number literals are validated only when parsed, so the tokenization
+       succeeds in most cases */
+    Containers::Optional<Json> json = Json::fromString(data.data);
+    if(json) CORRADE_VERIFY(!json->root().parseDouble());
+    CORRADE_COMPARE(out.str(), data.message);
+}
+
+void JsonTest::asString() {
+    Containers::StringView data = "{\"key\": \"\", \"long key with unicode ☃\": \"value\"}"_s;
+    Containers::Optional<Json> json = Json::fromString(data);
+    CORRADE_VERIFY(json);
+
+    Containers::StringView key = json->tokens()[1].asString();
+    CORRADE_COMPARE(key, "key");
+    CORRADE_COMPARE(key.data(), data.data() + 2);
+    CORRADE_COMPARE(json->tokens()[2].asString(), "");
+    CORRADE_COMPARE(json->tokens()[3].asString(), "long key with unicode ☃");
+    CORRADE_COMPARE(json->tokens()[4].asString(), "value");
+}
+
+void JsonTest::asStringInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Containers::Optional<Json> json = Json::fromString(R"([1, "\n"])");
+    CORRADE_VERIFY(json);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    json->tokens()[1].asString();
+    json->tokens()[2].asString();
+    CORRADE_COMPARE(out.str(),
+        "Utility::JsonToken::asString(): expected a string, got Utility::JsonToken::Type::Number\n"
+        "Utility::JsonToken::asString(): string is escaped, use parseString() instead\n");
+}
+
+void JsonTest::parseString() {
+    Containers::Optional<Json> json = Json::fromString(R"(["plain", "\"\\\/\b\f\n\r\t", "\u0041\u00e9\u2603", "\ud83d\ude00!"])");
+    CORRADE_VERIFY(json);
+    CORRADE_COMPARE(*json->tokens()[1].parseString(), Containers::String{"plain"});
+    CORRADE_COMPARE(*json->tokens()[2].parseString(), Containers::String{"\"\\/\b\f\n\r\t"});
+    CORRADE_COMPARE(*json->tokens()[3].parseString(), Containers::String{"Aé☃"});
+    CORRADE_COMPARE(*json->tokens()[4].parseString(), Containers::String{"\xf0\x9f\x98\x80!"});
+}
+
+void JsonTest::parseStringError() {
+    auto&& data = ParseStringErrorData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Optional<Json> json = Json::fromString(data.data);
+    CORRADE_VERIFY(json);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!json->root().parseString());
+    CORRADE_COMPARE(out.str(), data.message);
+}
+
+void JsonTest::fromFile() {
+    Containers::Optional<Json> json = Json::fromFile(Directory::join(JSON_TEST_DIR, "simple.json"));
+    CORRADE_VERIFY(json);
+    CORRADE_COMPARE(json->tokens().size(), 11);
+    CORRADE_COMPARE(json->tokens()[2].asString(), "Corrade");
+    CORRADE_COMPARE(*json->tokens()[5].parseUnsignedLong(), 2020);
+    CORRADE_COMPARE(json->tokens()[10].asString(), "utility");
+
+    /* The tokens stay valid after a move */
+    Json moved = std::move(*json);
+    CORRADE_COMPARE(moved.tokens()[9].asString(), "c++");
+}
+
+void JsonTest::fromFileNotFound() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!Json::fromFile("nonexistent.json"));
+    CORRADE_COMPARE(out.str(),
+        "Utility::Directory::read(): can't open nonexistent.json\n"
+        "Utility::Json::fromFile(): can't read nonexistent.json\n");
+}
+
+void JsonTest::debugType() {
+    std::ostringstream out;
+    Debug{&out} << JsonToken::Type::Number << JsonToken::Type(0xde);
+    CORRADE_COMPARE(out.str(), "Utility::JsonToken::Type::Number Utility::JsonToken::Type(0xde)\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::JsonTest)
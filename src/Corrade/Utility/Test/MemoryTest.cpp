@@ -31,6 +31,7 @@
 #include "Corrade/TestSuite/Compare/Numeric.h"
 #include "Corrade/Utility/DebugStl.h"
 #include "Corrade/Utility/Memory.h"
+#include "Corrade/Utility/String.h"
 
 namespace Corrade { namespace Utility { namespace Test { namespace {
 
@@ -55,6 +56,17 @@ struct MemoryTest: TestSuite::Tester {
 
     void allocateNotMultipleOfAlignment();
 
+    void allocatePagesTrivial();
+    void allocatePagesNontrivial();
+    void allocatePagesZeroSize();
+    void allocatePagesHugePages();
+    void allocatePagesExplicitHugePages();
+    void allocatePagesOnNumaNode();
+    void allocatePagesOnNumaNodeInvalid();
+
+    void debugPageAllocationFlag();
+    void debugPageAllocationFlags();
+
     void resetCounters();
 };
 
@@ -92,7 +104,21 @@ MemoryTest::MemoryTest() {
         &MemoryTest::allocateExplicitAlignmentDefaultInit,
         &MemoryTest::allocateExplicitAlignmentValueInit}, 100);
 
-    addTests({&MemoryTest::allocateNotMultipleOfAlignment});
+    addTests({&MemoryTest::allocateNotMultipleOfAlignment,
+
+              &MemoryTest::allocatePagesTrivial});
+
+    addTests({&MemoryTest::allocatePagesNontrivial},
+        &MemoryTest::resetCounters, &MemoryTest::resetCounters);
+
+    addTests({&MemoryTest::allocatePagesZeroSize,
+              &MemoryTest::allocatePagesHugePages,
+              &MemoryTest::allocatePagesExplicitHugePages,
+              &MemoryTest::allocatePagesOnNumaNode,
+              &MemoryTest::allocatePagesOnNumaNodeInvalid,
+
+              &MemoryTest::debugPageAllocationFlag,
+              &MemoryTest::debugPageAllocationFlags});
 }
 
 template<std::size_t alignment> struct alignas(alignment) Aligned {
@@ -263,6 +289,154 @@ void MemoryTest::allocateNotMultipleOfAlignment() {
     CORRADE_COMPARE(out.str(), "Utility::allocateAligned(): total byte size 34 not a multiple of a 32-byte alignment\n");
 }
 
+void MemoryTest::allocatePagesTrivial() {
+    #if !defined(CORRADE_TARGET_UNIX) && (!defined(CORRADE_TARGET_WINDOWS) || defined(CORRADE_TARGET_WINDOWS_RT))
+    CORRADE_SKIP("Page allocation not implemented on this platform.");
+    #else
+    Containers::Optional<Containers::Array<int>> data = allocatePages<int>(10000);
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(data->size(), 10000);
+    CORRADE_COMPARE_AS(reinterpret_cast<std::uintptr_t>(data->data()), 4096,
+        TestSuite::Compare::Divisible);
+
+    /* The memory is zero-filled by the system */
+    std::size_t nonZeroCount = 0;
+    for(int i: *data) if(i) ++nonZeroCount;
+    CORRADE_COMPARE(nonZeroCount, 0);
+
+    /* And it's writable */
+    (*data)[0] = 1;
+    (*data)[9999] = 2;
+    CORRADE_COMPARE((*data)[0], 1);
+    CORRADE_COMPARE((*data)[9999], 2);
+    #endif
+}
+
+struct Nontrivial {
+    static int constructed;
+    static int destructed;
+
+    explicit Nontrivial() { ++constructed; }
+    ~Nontrivial() { ++destructed; }
+
+    int a;
+};
+
+int Nontrivial::constructed = 0;
+int Nontrivial::destructed = 0;
+
+void MemoryTest::allocatePagesNontrivial() {
+    #if !defined(CORRADE_TARGET_UNIX) && (!defined(CORRADE_TARGET_WINDOWS) || defined(CORRADE_TARGET_WINDOWS_RT))
+    CORRADE_SKIP("Page allocation not implemented on this platform.");
+    #else
+    Nontrivial::constructed = Nontrivial::destructed = 0;
+    {
+        Containers::Optional<Containers::Array<Nontrivial>> data = allocatePages<Nontrivial>(5);
+        CORRADE_VERIFY(data);
+        CORRADE_COMPARE(data->size(), 5);
+        CORRADE_COMPARE(Nontrivial::constructed, 5);
+        /* Members not set by the constructor are zero */
+        CORRADE_COMPARE((*data)[4].a, 0);
+    }
+    CORRADE_COMPARE(Nontrivial::destructed, 5);
+    #endif
+}
+
+void MemoryTest::allocatePagesZeroSize() {
+    Containers::Optional<Containers::Array<int>> data = allocatePages<int>(0);
+    CORRADE_VERIFY(data);
+    CORRADE_VERIFY(!data->data());
+    CORRADE_COMPARE(data->size(), 0);
+}
+
+void MemoryTest::allocatePagesHugePages() {
+    #if !defined(CORRADE_TARGET_UNIX) && (!defined(CORRADE_TARGET_WINDOWS) || defined(CORRADE_TARGET_WINDOWS_RT))
+    CORRADE_SKIP("Page allocation not implemented on this platform.");
+    #else
+    /* Transparent huge pages are just a hint, so this should always pass */
+    Containers::Optional<Containers::Array<char>> data = allocatePages<char>(3*1024*1024 + 17, PageAllocationFlag::HugePages);
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(data->size(), 3*1024*1024 + 17);
+    #ifdef CORRADE_TARGET_UNIX
+    CORRADE_COMPARE_AS(reinterpret_cast<std::uintptr_t>(data->data()), 2*1024*1024,
+        TestSuite::Compare::Divisible);
+    #endif
+
+    (*data)[0] = 'a';
+    data->back() = 'b';
+    CORRADE_COMPARE((*data)[0], 'a');
+    CORRADE_COMPARE(data->back(), 'b');
+    #endif
+}
+
+void MemoryTest::allocatePagesExplicitHugePages() {
+    /* Explicit huge pages need to be reserved in the system, which usually
+       isn't, so just verify it either succeeds or fails gracefully */
+    std::ostringstream out;
+    Containers::Optional<Containers::Array<char>> data;
+    {
+        Error redirectError{&out};
+        data = allocatePages<char>(1024, PageAllocationFlag::ExplicitHugePages);
+    }
+    if(!data) {
+        CORRADE_VERIFY(String::beginsWith(out.str(), "Utility::allocatePages(): "));
+        CORRADE_SKIP("Explicit huge pages not available:" << String::stripSuffix(out.str(), "\n"));
+    }
+
+    CORRADE_COMPARE(data->size(), 1024);
+    (*data)[1023] = 'a';
+    CORRADE_COMPARE((*data)[1023], 'a');
+}
+
+void MemoryTest::allocatePagesOnNumaNode() {
+    #if !defined(__linux__) && (!defined(CORRADE_TARGET_WINDOWS) || defined(CORRADE_TARGET_WINDOWS_RT))
+    CORRADE_SKIP("NUMA placement not implemented on this platform.");
+    #else
+    /* Node 0 exists always, but the syscall may be forbidden in sandboxed
+       environments */
+    std::ostringstream out;
+    Containers::Optional<Containers::Array<int>> data;
+    {
+        Error redirectError{&out};
+        data = Utility::allocatePagesOnNumaNode<int>(10000, 0);
+    }
+    if(!data && (out.str().find("Operation not permitted") != std::string::npos || out.str().find("Function not implemented") != std::string::npos))
+        CORRADE_SKIP("NUMA placement not available:" << String::stripSuffix(out.str(), "\n"));
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(data->size(), 10000);
+    (*data)[9999] = 3;
+    CORRADE_COMPARE((*data)[9999], 3);
+    #endif
+}
+
+void MemoryTest::allocatePagesOnNumaNodeInvalid() {
+    #if !defined(__linux__)
+    CORRADE_SKIP("Checked only on Linux.");
+    #else
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!Utility::allocatePagesOnNumaNode<int>(10, 1000));
+        CORRADE_VERIFY(!Utility::allocatePagesOnNumaNode<int>(10, 4096));
+    }
+    CORRADE_COMPARE(out.str(),
+        "Utility::allocatePagesOnNumaNode(): can't place the allocation on node 1000: Invalid argument\n"
+        "Utility::allocatePagesOnNumaNode(): node 4096 out of range for 1024 nodes\n");
+    #endif
+}
+
+void MemoryTest::debugPageAllocationFlag() {
+    std::ostringstream out;
+    Debug{&out} << PageAllocationFlag::ExplicitHugePages << PageAllocationFlag(0xf0);
+    CORRADE_COMPARE(out.str(), "Utility::PageAllocationFlag::ExplicitHugePages Utility::PageAllocationFlag(0xf0)\n");
+}
+
+void MemoryTest::debugPageAllocationFlags() {
+    std::ostringstream out;
+    Debug{&out} << (PageAllocationFlag::HugePages|PageAllocationFlag::ExplicitHugePages) << PageAllocationFlags{};
+    CORRADE_COMPARE(out.str(), "Utility::PageAllocationFlag::HugePages|Utility::PageAllocationFlag::ExplicitHugePages Utility::PageAllocationFlags{}\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::Utility::Test::MemoryTest)
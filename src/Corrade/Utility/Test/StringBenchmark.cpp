@@ -25,13 +25,20 @@
 */
 
 #include <cctype>
+#include <cstdlib>
 #include <algorithm>
 #include <locale>
+#include <sstream>
 #include <string>
 
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/Optional.h"
+#include "Corrade/Containers/String.h"
 #include "Corrade/Containers/StringStl.h"
 #include "Corrade/Containers/StringView.h"
 #include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Numeric.h"
+#include "Corrade/Utility/Format.h"
 #include "Corrade/Utility/String.h"
 
 namespace Corrade { namespace Utility { namespace Test { namespace {
@@ -46,8 +53,24 @@ struct StringBenchmark: TestSuite::Tester {
     void uppercase();
     void uppercaseStl();
     void uppercaseStlFacet();
+
+    void parseNumbersFloat();
+    void parseNumbersFloatStrtof();
+    void parseNumbersFloatStream();
+    void parseNumbersInt();
+    void parseNumbersIntStrtol();
+
+    void formatNumbersFloat();
+    void formatNumbersFloatFormat();
+    void formatNumbersInt();
+    void formatNumbersIntFormat();
+
+    private:
+        Containers::String _floats, _ints;
 };
 
+enum: std::size_t { NumberCount = 10000 };
+
 using namespace Containers::Literals;
 
 constexpr Containers::StringView loremIpsum =
@@ -65,6 +88,28 @@ StringBenchmark::StringBenchmark() {
                    &StringBenchmark::uppercase,
                    &StringBenchmark::uppercaseStl,
                    &StringBenchmark::uppercaseStlFacet}, 100);
+
+    addBenchmarks({&StringBenchmark::parseNumbersFloat,
+                   &StringBenchmark::parseNumbersFloatStrtof,
+                   &StringBenchmark::parseNumbersFloatStream,
+                   &StringBenchmark::parseNumbersInt,
+                   &StringBenchmark::parseNumbersIntStrtol,
+
+                   &StringBenchmark::formatNumbersFloat,
+                   &StringBenchmark::formatNumbersFloatFormat,
+                   &StringBenchmark::formatNumbersInt,
+                   &StringBenchmark::formatNumbersIntFormat}, 10);
+
+    /* Numbers resembling what's commonly found in text-based mesh files --
+       a few decimal digits, mixed signs */
+    std::string floats, ints;
+    for(std::size_t i = 0; i != NumberCount; ++i) {
+        const int value = int((i*7919) % 200000) - 100000;
+        floats += Utility::format("{} ", value/1000.0f);
+        ints += Utility::format("{} ", value);
+    }
+    _floats = floats;
+    _ints = ints;
 }
 
 void StringBenchmark::lowercase() {
@@ -127,6 +172,138 @@ void StringBenchmark::uppercaseStlFacet() {
     CORRADE_VERIFY(!Containers::StringView{string}.contains('a'));
 }
 
+void StringBenchmark::parseNumbersFloat() {
+    Containers::Array<float> out{NoInit, NumberCount};
+
+    Containers::Optional<std::size_t> count;
+    CORRADE_BENCHMARK(1)
+        count = String::parseNumbers(_floats, out);
+
+    CORRADE_COMPARE(count, NumberCount);
+    CORRADE_COMPARE(out[1], -92.081f);
+}
+
+void StringBenchmark::parseNumbersFloatStrtof() {
+    Containers::Array<float> out{NoInit, NumberCount};
+
+    std::size_t count{};
+    CORRADE_BENCHMARK(1) {
+        count = 0;
+        const char* data = _floats.data();
+        char* end;
+        for(;;) {
+            const float value = std::strtof(data, &end);
+            if(end == data) break;
+            out[count++] = value;
+            data = end;
+        }
+    }
+
+    CORRADE_COMPARE(count, NumberCount);
+    CORRADE_COMPARE(out[1], -92.081f);
+}
+
+void StringBenchmark::parseNumbersFloatStream() {
+    Containers::Array<float> out{NoInit, NumberCount};
+
+    std::size_t count{};
+    CORRADE_BENCHMARK(1) {
+        count = 0;
+        std::istringstream in{_floats};
+        float value;
+        while(in >> value) out[count++] = value;
+    }
+
+    CORRADE_COMPARE(count, NumberCount);
+    CORRADE_COMPARE(out[1], -92.081f);
+}
+
+void StringBenchmark::parseNumbersInt() {
+    Containers::Array<std::int32_t> out{NoInit, NumberCount};
+
+    Containers::Optional<std::size_t> count;
+    CORRADE_BENCHMARK(1)
+        count = String::parseNumbers(_ints, out);
+
+    CORRADE_COMPARE(count, NumberCount);
+    CORRADE_COMPARE(out[1], -92081);
+}
+
+void StringBenchmark::parseNumbersIntStrtol() {
+    Containers::Array<std::int32_t> out{NoInit, NumberCount};
+
+    std::size_t count{};
+    CORRADE_BENCHMARK(1) {
+        count = 0;
+        const char* data = _ints.data();
+        char* end;
+        for(;;) {
+            const long value = std::strtol(data, &end, 10);
+            if(end == data) break;
+            out[count++] = value;
+            data = end;
+        }
+    }
+
+    CORRADE_COMPARE(count, NumberCount);
+    CORRADE_COMPARE(out[1], -92081);
+}
+
+void StringBenchmark::formatNumbersFloat() {
+    Containers::Array<float> values{NoInit, NumberCount};
+    CORRADE_COMPARE(String::parseNumbers(_floats, values), NumberCount);
+
+    Containers::String out;
+    CORRADE_BENCHMARK(1)
+        out = String::formatNumbers(values);
+
+    CORRADE_COMPARE_AS(out.size(), _floats.size() - 1,
+        TestSuite::Compare::LessOrEqual);
+}
+
+void StringBenchmark::formatNumbersFloatFormat() {
+    Containers::Array<float> values{NoInit, NumberCount};
+    CORRADE_COMPARE(String::parseNumbers(_floats, values), NumberCount);
+
+    Containers::String storage{NoInit, _floats.size()};
+    const Containers::MutableStringView out = storage;
+    std::size_t size{};
+    CORRADE_BENCHMARK(1) {
+        size = 0;
+        for(float value: values)
+            size += formatInto(out.suffix(size), "{} ", value);
+    }
+
+    CORRADE_COMPARE(size, _floats.size());
+}
+
+void StringBenchmark::formatNumbersInt() {
+    Containers::Array<std::int32_t> values{NoInit, NumberCount};
+    CORRADE_COMPARE(String::parseNumbers(_ints, values), NumberCount);
+
+    Containers::String out;
+    CORRADE_BENCHMARK(1)
+        out = String::formatNumbers(values);
+
+    CORRADE_COMPARE(out.size(), _ints.size() - 1);
+}
+
+void StringBenchmark::formatNumbersIntFormat() {
+    Containers::Array<std::int32_t> values{NoInit, NumberCount};
+    CORRADE_COMPARE(String::parseNumbers(_ints, values), NumberCount);
+
+    Containers::String storage{NoInit, _ints.size()};
+    const Containers::MutableStringView out = storage;
+    std::size_t size{};
+    CORRADE_BENCHMARK(1) {
+        size = 0;
+        for(std::int32_t value: values)
+            size += formatInto(out.suffix(size), "{} ", value);
+    }
+
+    CORRADE_COMPARE(size, _ints.size());
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::Utility::Test::StringBenchmark)
@@ -24,6 +24,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cmath>
+#include <cstdlib>
 #include <sstream>
 
 #include "Corrade/Containers/Array.h"
@@ -31,6 +33,7 @@
 #include "Corrade/Containers/StaticArray.h"
 #include "Corrade/Containers/StringView.h"
 #include "Corrade/Containers/String.h"
+#include "Corrade/Containers/StringStl.h"
 #include "Corrade/TestSuite/Tester.h"
 #include "Corrade/TestSuite/Compare/Container.h"
 #include "Corrade/Utility/DebugStl.h"
@@ -80,6 +83,22 @@ struct StringTest: TestSuite::Tester {
     void parseNumberSequence();
     void parseNumberSequenceOverflow();
     void parseNumberSequenceError();
+
+    void parseNumbersFloat();
+    void parseNumbersDouble();
+    void parseNumbersFastPathMatchesStrtod();
+    void parseNumbersInt();
+    void parseNumbersUnsignedInt();
+    void parseNumbersEmpty();
+    void parseNumbersError();
+
+    void formatNumbersFloat();
+    void formatNumbersDouble();
+    void formatNumbersInt();
+    void formatNumbersUnsignedInt();
+    void formatNumbersInto();
+    void formatNumbersIntoBufferTooSmall();
+    void formatNumbersParseRoundTrip();
 };
 
 const struct {
@@ -151,6 +170,37 @@ const struct {
         "17,4294967294-,25", {InPlaceInit, {17, 4294967294, 25}}},
 };
 
+const struct {
+    const char* name;
+    Containers::StringView string;
+    const char* message;
+} ParseNumbersErrorData[]{
+    {"float, two decimal points", "1.5 1.2.3",
+        "invalid floating-point literal 1.2.3"},
+    {"float, no exponent digits", "1e",
+        "invalid floating-point literal 1e"},
+    {"float, no digits", "-.e5",
+        "invalid floating-point literal -.e5"},
+    {"float, letters", "0.5 abc",
+        "invalid floating-point literal abc"},
+    {"int, fraction", "1.5",
+        "invalid integer literal 1.5"},
+    {"int, just a sign", "-",
+        "invalid integer literal -"},
+    {"int, too large", "2147483648",
+        "integer literal 2147483648 out of range"},
+    {"int, too small", "-2147483649",
+        "integer literal -2147483649 out of range"},
+    {"int, too many digits", "123456789012345678",
+        "integer literal 123456789012345678 out of range"},
+    {"unsigned int, negative", "-1",
+        "invalid integer literal -1"},
+    {"unsigned int, too large", "4294967296",
+        "integer literal 4294967296 out of range"},
+    {"too many values", "1 2 3 4 5",
+        "expected at most 4 values"},
+};
+
 StringTest::StringTest() {
     addTests({&StringTest::fromArray,
               &StringTest::trim,
@@ -194,7 +244,25 @@ StringTest::StringTest() {
     addInstancedTests({&StringTest::parseNumberSequenceOverflow},
         Containers::arraySize(ParseNumberSequenceOverflowData));
 
-    addTests({&StringTest::parseNumberSequenceError});
+    addTests({&StringTest::parseNumberSequenceError,
+
+              &StringTest::parseNumbersFloat,
+              &StringTest::parseNumbersDouble,
+              &StringTest::parseNumbersFastPathMatchesStrtod,
+              &StringTest::parseNumbersInt,
+              &StringTest::parseNumbersUnsignedInt,
+              &StringTest::parseNumbersEmpty});
+
+    addInstancedTests({&StringTest::parseNumbersError},
+        Containers::arraySize(ParseNumbersErrorData));
+
+    addTests({&StringTest::formatNumbersFloat,
+              &StringTest::formatNumbersDouble,
+              &StringTest::formatNumbersInt,
+              &StringTest::formatNumbersUnsignedInt,
+              &StringTest::formatNumbersInto,
+              &StringTest::formatNumbersIntoBufferTooSmall,
+              &StringTest::formatNumbersParseRoundTrip});
 }
 
 using namespace Containers::Literals;
@@ -755,6 +823,169 @@ void StringTest::parseNumberSequenceError() {
     CORRADE_COMPARE(out.str(), "Utility::parseNumberSequence(): unrecognized character y in 3,5y7,x,25\n");
 }
 
+
+void StringTest::parseNumbersFloat() {
+    /* Covering both the fast path and the fallback, the result should be
+       exactly the same as with strtof() */
+    const char* const values[]{"1.5", "-0.25", "3e2", "1E-3", ".5", "5.", "+7", "-0", "0.1", "16777216", "16777217", "1e10", "1e11", "3.40282347e+38", "1.17549435e-38", "123456789012345678901234", "0.0000000000000000000000000001"};
+
+    std::string string;
+    for(const char* value: values) {
+        string += value;
+        string += ",\n ";
+    }
+
+    float out[Containers::arraySize(values) + 3];
+    Containers::Optional<std::size_t> count = String::parseNumbers(string, out);
+    CORRADE_VERIFY(count);
+    CORRADE_COMPARE(*count, Containers::arraySize(values));
+    for(std::size_t i = 0; i != *count; ++i) {
+        CORRADE_ITERATION(values[i]);
+        const float expected = std::strtof(values[i], nullptr);
+        CORRADE_COMPARE(out[i], expected);
+        CORRADE_COMPARE(std::signbit(out[i]), std::signbit(expected));
+    }
+}
+
+void StringTest::parseNumbersDouble() {
+    const char* const values[]{"1.5", "-0.25", "3e2", "0.1", "0.3", "9007199254740992", "9007199254740993", "1e22", "1e23", "4.9406564584124654e-324", "1.7976931348623157e308", "3.14159265358979323846264338327950288", "1234567890123456789.5", "2.2250738585072014e-308"};
+
+    std::string string;
+    for(const char* value: values) {
+        string += value;
+        string += ';';
+    }
+
+    double out[Containers::arraySize(values)];
+    Containers::Optional<std::size_t> count = String::parseNumbers(string, out);
+    CORRADE_VERIFY(count);
+    CORRADE_COMPARE(*count, Containers::arraySize(values));
+    for(std::size_t i = 0; i != *count; ++i) {
+        CORRADE_ITERATION(values[i]);
+        CORRADE_COMPARE(out[i], std::strtod(values[i], nullptr));
+    }
+}
+
+void StringTest::parseNumbersFastPathMatchesStrtod() {
+    /* Go through a range of mantissas and exponents around the fast path
+       boundaries and verify the results are bit-exact */
+    for(std::uint64_t mantissa: {std::uint64_t{1}, std::uint64_t{3}, std::uint64_t{7}, std::uint64_t{123456789}, std::uint64_t{16777215}, std::uint64_t{16777217}, std::uint64_t{9007199254740991}, std::uint64_t{9007199254740993}}) {
+        for(int exponent = -25; exponent <= 25; ++exponent) {
+            const std::string value = std::to_string(mantissa) + "e" + std::to_string(exponent);
+            CORRADE_ITERATION(value);
+
+            float outFloat[1];
+            double outDouble[1];
+            CORRADE_COMPARE(String::parseNumbers(value, outFloat), 1);
+            CORRADE_COMPARE(String::parseNumbers(value, outDouble), 1);
+            CORRADE_COMPARE(outFloat[0], std::strtof(value.data(), nullptr));
+            CORRADE_COMPARE(outDouble[0], std::strtod(value.data(), nullptr));
+        }
+    }
+}
+
+void StringTest::parseNumbersInt() {
+    std::int32_t out[8];
+    /* The long zero-padded value goes through the eight-digit path */
+    Containers::Optional<std::size_t> count = String::parseNumbers("0 -17, +25;2147483647 -2147483648\t0000000000001234567 12345678 -0", out);
+    CORRADE_VERIFY(count);
+    CORRADE_COMPARE_AS(Containers::arrayView(out).prefix(*count), Containers::arrayView<std::int32_t>({
+        0, -17, 25, 2147483647, -2147483647 - 1, 1234567, 12345678, 0
+    }), TestSuite::Compare::Container);
+}
+
+void StringTest::parseNumbersUnsignedInt() {
+    std::uint32_t out[5];
+    Containers::Optional<std::size_t> count = String::parseNumbers("4294967295,0,,,87654321,123456789", out);
+    CORRADE_VERIFY(count);
+    CORRADE_COMPARE_AS(Containers::arrayView(out).prefix(*count), Containers::arrayView<std::uint32_t>({
+        4294967295u, 0, 87654321, 123456789
+    }), TestSuite::Compare::Container);
+}
+
+void StringTest::parseNumbersEmpty() {
+    float out[1];
+    CORRADE_COMPARE(String::parseNumbers("", out), 0);
+    CORRADE_COMPARE(String::parseNumbers(" ,;\n\t ", out), 0);
+    CORRADE_COMPARE(String::parseNumbers("", Containers::ArrayView<float>{}), 0);
+}
+
+void StringTest::parseNumbersError() {
+    auto&& data = ParseNumbersErrorData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    float outFloat[4];
+    std::int32_t outInt[4];
+    std::uint32_t outUnsignedInt[4];
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        if(Containers::StringView{data.name}.hasPrefix("float"))
+            CORRADE_VERIFY(!String::parseNumbers(data.string, outFloat));
+        else if(Containers::StringView{data.name}.hasPrefix("unsigned int"))
+            CORRADE_VERIFY(!String::parseNumbers(data.string, outUnsignedInt));
+        else
+            CORRADE_VERIFY(!String::parseNumbers(data.string, outInt));
+    }
+    CORRADE_COMPARE(out.str(), "Utility::String::parseNumbers(): " + std::string{data.message} + "\n");
+}
+
+void StringTest::formatNumbersFloat() {
+    /* Same as Utility::format() with the default precision */
+    CORRADE_COMPARE(String::formatNumbers(Containers::arrayView({1.5f, -0.25f, 100.0f, 999999.0f, 1.0e6f, 1234567.0f, -0.0f, 0.1f, 3.14159265f, -7.0f})),
+        "1.5 -0.25 100 999999 1e+06 1.23457e+06 -0 0.1 3.14159 -7");
+}
+
+void StringTest::formatNumbersDouble() {
+    CORRADE_COMPARE(String::formatNumbers(Containers::arrayView({1.5, 1.0e15, 123456789012345.0, 0.1, -2.5e-300}), ','),
+        "1.5,1e+15,123456789012345,0.1,-2.5e-300");
+}
+
+void StringTest::formatNumbersInt() {
+    CORRADE_COMPARE(String::formatNumbers(Containers::arrayView({0, -1, 2147483647, -2147483647 - 1, 99, 100}), ','),
+        "0,-1,2147483647,-2147483648,99,100");
+}
+
+void StringTest::formatNumbersUnsignedInt() {
+    CORRADE_COMPARE(String::formatNumbers(Containers::arrayView({0u, 4294967295u, 10u})),
+        "0 4294967295 10");
+    CORRADE_COMPARE(String::formatNumbers(Containers::ArrayView<const std::uint32_t>{}),
+        "");
+}
+
+void StringTest::formatNumbersInto() {
+    /* Exactly the size needed, going through the checked path at the end */
+    char buffer[11];
+    const std::int32_t values[]{17, -2, 350, 4};
+    CORRADE_COMPARE(String::formatNumbersInto(Containers::MutableStringView{buffer, 11}, values, '\t'), 11);
+    CORRADE_COMPARE(Containers::StringView(buffer, 11), "17\t-2\t350\t4");
+}
+
+void StringTest::formatNumbersIntoBufferTooSmall() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    char buffer[10];
+    const std::int32_t values[]{17, -2, 350, 4};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    String::formatNumbersInto(Containers::MutableStringView{buffer, 10}, values);
+    CORRADE_COMPARE(out.str(), "Utility::String::formatNumbersInto(): buffer too small, expected at least 11 bytes but got 10\n");
+}
+
+void StringTest::formatNumbersParseRoundTrip() {
+    const std::int32_t values[]{1, -22, 333, -4444, 55555, -666666, 7777777, -88888888, 999999999};
+    Containers::String formatted = String::formatNumbers(values, ';');
+
+    std::int32_t parsed[Containers::arraySize(values)];
+    CORRADE_COMPARE(String::parseNumbers(formatted, parsed), Containers::arraySize(values));
+    CORRADE_COMPARE_AS(Containers::arrayView(parsed), Containers::arrayView(values),
+        TestSuite::Compare::Container);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::Utility::Test::StringTest)
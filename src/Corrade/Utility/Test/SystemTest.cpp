@@ -24,19 +24,58 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
+#ifdef __linux__
+#include <pthread.h>
+#endif
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/StringView.h"
 #include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/TestSuite/Compare/Numeric.h"
+#include "Corrade/Utility/DebugStl.h" /** @todo remove when <sstream> is gone */
 #include "Corrade/Utility/System.h"
 
 namespace Corrade { namespace Utility { namespace Test { namespace {
 
+using namespace Containers::Literals;
+
 struct SystemTest: TestSuite::Tester {
     explicit SystemTest();
 
     void sleep();
+
+    void coreCount();
+    void cacheSize();
+    void numaNodes();
+    void numaNodeCpusInvalid();
+
+    void threadAffinity();
+    void threadAffinityInvalid();
+    void threadName();
+    void threadPriority();
+
+    void debugThreadPriority();
 };
 
 SystemTest::SystemTest() {
-    addTests({&SystemTest::sleep});
+    addTests({&SystemTest::sleep,
+
+              &SystemTest::coreCount,
+              &SystemTest::cacheSize,
+              &SystemTest::numaNodes,
+              &SystemTest::numaNodeCpusInvalid,
+
+              &SystemTest::threadAffinity,
+              &SystemTest::threadAffinityInvalid,
+              &SystemTest::threadName,
+              &SystemTest::threadPriority,
+
+              &SystemTest::debugThreadPriority});
 }
 
 void SystemTest::sleep() {
@@ -46,6 +85,125 @@ void SystemTest::sleep() {
     CORRADE_VERIFY(true);
 }
 
+void SystemTest::coreCount() {
+    const std::size_t logical = System::logicalCoreCount();
+    const std::size_t physical = System::physicalCoreCount();
+    CORRADE_INFO("Logical cores:" << logical << Debug::nospace << ", physical cores:" << physical);
+
+    CORRADE_COMPARE_AS(logical, 1, TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(physical, 1, TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(physical, logical, TestSuite::Compare::LessOrEqual);
+}
+
+void SystemTest::cacheSize() {
+    const std::size_t l1 = System::cacheSize(1);
+    const std::size_t l2 = System::cacheSize(2);
+    const std::size_t l3 = System::cacheSize(3);
+    CORRADE_INFO("L1 cache:" << l1 << Debug::nospace << ", L2 cache:" << l2 << Debug::nospace << ", L3 cache:" << l3);
+
+    /* The information may not be available (such as in a VM), so can't test
+       for concrete values. But there's no L0 cache and no CPU has one with
+       over a thousand levels. */
+    CORRADE_COMPARE(System::cacheSize(0), 0);
+    CORRADE_COMPARE(System::cacheSize(1000), 0);
+}
+
+void SystemTest::numaNodes() {
+    const std::size_t count = System::numaNodeCount();
+    CORRADE_INFO("NUMA nodes:" << count);
+    CORRADE_COMPARE_AS(count, 1, TestSuite::Compare::GreaterOrEqual);
+
+    /* Node 0 is always there and has at least one CPU */
+    Containers::Array<unsigned int> cpus = System::numaNodeCpus(0);
+    CORRADE_COMPARE_AS(cpus.size(), 1, TestSuite::Compare::GreaterOrEqual);
+    for(unsigned int cpu: cpus) {
+        CORRADE_ITERATION(cpu);
+        /* CPUs can be offline, so it's not possible to compare against
+           logicalCoreCount() */
+        CORRADE_COMPARE_AS(cpu, 4096, TestSuite::Compare::Less);
+    }
+}
+
+void SystemTest::numaNodeCpusInvalid() {
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(System::numaNodeCpus(4096).empty());
+    }
+    CORRADE_COMPARE(out.str(), "Utility::System::numaNodeCpus(): can't read CPUs of node 4096\n");
+}
+
+void SystemTest::threadAffinity() {
+    #if !defined(__linux__) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_SKIP("Querying thread affinity is implemented only on Linux.");
+    #else
+    /* Pin a new thread to the first CPU it's allowed to run on, so the
+       affinity of the test itself stays unaffected */
+    Containers::Array<unsigned int> original = System::threadAffinity();
+    CORRADE_COMPARE_AS(original.size(), 1, TestSuite::Compare::GreaterOrEqual);
+
+    bool set = false;
+    Containers::Array<unsigned int> affinity;
+    std::thread{[&]{
+        set = System::setThreadAffinity({original.data(), 1});
+        affinity = System::threadAffinity();
+    }}.join();
+    CORRADE_VERIFY(set);
+    CORRADE_COMPARE_AS(affinity,
+        Containers::arrayView({original[0]}),
+        TestSuite::Compare::Container);
+
+    /* The affinity of this thread stayed the same */
+    CORRADE_COMPARE_AS(System::threadAffinity(), original,
+        TestSuite::Compare::Container);
+    #endif
+}
+
+void SystemTest::threadAffinityInvalid() {
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!System::setThreadAffinity(nullptr));
+    }
+    CORRADE_COMPARE(out.str(), "Utility::System::setThreadAffinity(): expected at least one CPU\n");
+}
+
+void SystemTest::threadName() {
+    #if !defined(__linux__) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_SKIP("Querying thread name is implemented only on Linux.");
+    #else
+    bool set = false;
+    char name[16]{};
+    std::thread{[&]{
+        /* Gets truncated to 15 characters */
+        set = System::setThreadName("a very long thread name");
+        pthread_getname_np(pthread_self(), name, sizeof(name));
+    }}.join();
+    CORRADE_VERIFY(set);
+    CORRADE_COMPARE(Containers::StringView{name}, "a very long thr"_s);
+    #endif
+}
+
+void SystemTest::threadPriority() {
+    #if (!defined(__linux__) && !defined(CORRADE_TARGET_WINDOWS)) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_SKIP("Thread priority is implemented only on Linux and Windows.");
+    #else
+    /* Lowering the priority doesn't need elevated privileges. Done in a
+       separate thread as it couldn't be raised back on Linux otherwise. */
+    bool set = false;
+    std::thread{[&]{
+        set = System::setThreadPriority(System::ThreadPriority::Low);
+    }}.join();
+    CORRADE_VERIFY(set);
+    #endif
+}
+
+void SystemTest::debugThreadPriority() {
+    std::ostringstream out;
+    Debug{&out} << System::ThreadPriority::High << System::ThreadPriority(0xde);
+    CORRADE_COMPARE(out.str(), "Utility::System::ThreadPriority::High Utility::System::ThreadPriority(0xde)\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::Utility::Test::SystemTest)
@@ -33,8 +33,13 @@
 #define DIRECTORY_WRITE_TEST_DIR "${UTILITY_BINARY_TEST_DIR}/DirectoryTestFiles"
 
 #define FORMAT_WRITE_TEST_DIR "${UTILITY_BINARY_TEST_DIR}"
+#define JSON_TEST_DIR "${UTILITY_TEST_DIR}/JsonTestFiles"
+#define JSON_WRITE_TEST_DIR "${UTILITY_BINARY_TEST_DIR}/JsonTestFiles"
 #define RESOURCE_TEST_DIR "${UTILITY_TEST_DIR}/ResourceTestFiles/"
 
+#define ASYNCFILEIO_WRITE_TEST_DIR "${UTILITY_BINARY_TEST_DIR}/AsyncFileIOTestFiles"
+
+#define FILEAPPENDER_WRITE_TEST_DIR "${UTILITY_BINARY_TEST_DIR}/FileAppenderTestFiles"
 #define FILEWATCHER_WRITE_TEST_DIR "${UTILITY_BINARY_TEST_DIR}/FileWatcherTestFiles"
 
 #define TWEAKABLE_TEST_DIR "${UTILITY_TEST_DIR}"
@@ -39,6 +39,9 @@
 namespace Corrade { namespace Utility {
 
 class Arguments;
+#if defined(DOXYGEN_GENERATING_OUTPUT) || defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)) || defined(CORRADE_TARGET_EMSCRIPTEN)
+class AsyncFileIO;
+#endif
 
 template<std::size_t> class HashDigest;
 /* AbstractHash is not used directly */
@@ -49,6 +52,7 @@ enum class ConfigurationValueFlag: std::uint8_t;
 typedef Containers::EnumSet<ConfigurationValueFlag> ConfigurationValueFlags;
 template<class> struct ConfigurationValue;
 #if defined(DOXYGEN_GENERATING_OUTPUT) || defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)) || defined(CORRADE_TARGET_EMSCRIPTEN)
+class FileAppender;
 class FileWatcher;
 #endif
 
@@ -57,6 +61,9 @@ class Warning;
 class Error;
 class Fatal;
 
+class Json;
+class JsonToken;
+
 /* Endianness used only statically */
 class MurmurHash2;
 
@@ -34,6 +34,7 @@
 #cmakedefine CORRADE_BUILD_STATIC
 #cmakedefine CORRADE_BUILD_STATIC_UNIQUE_GLOBALS
 #cmakedefine CORRADE_BUILD_MULTITHREADED
+#cmakedefine CORRADE_BUILD_ALLOCATION_TRACKING
 
 #cmakedefine CORRADE_TARGET_APPLE
 #cmakedefine CORRADE_TARGET_IOS